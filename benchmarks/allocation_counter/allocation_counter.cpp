@@ -0,0 +1,116 @@
+#include "allocation_counter.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <malloc.h>
+#include <new>
+
+using namespace benchmarks::allocation_counter;
+
+namespace
+{
+	constinit thread_local AllocationCounts thread_counts{};
+
+	void* count_allocation(void* pointer)
+	{
+		if(pointer == nullptr) { throw std::bad_alloc{}; }
+
+		const uint64_t size = malloc_usable_size(pointer);
+
+		++thread_counts.allocations;
+		thread_counts.allocated_bytes += size;
+		thread_counts.live_bytes += static_cast<int64_t>(size);
+		thread_counts.peak_live_bytes = std::max(thread_counts.peak_live_bytes, thread_counts.live_bytes);
+
+		return pointer;
+	}
+
+	void count_deallocation(void* pointer)
+	{
+		if(pointer == nullptr) { return; }
+
+		thread_counts.live_bytes -= static_cast<int64_t>(malloc_usable_size(pointer));
+	}
+}
+
+AllocationCounts benchmarks::allocation_counter::get_thread_counts()
+{
+	return thread_counts;
+}
+
+AllocationScope::AllocationScope()
+	: start{thread_counts}
+{
+	// The peak of this scope, restored to include that of enclosing scopes when it ends
+	thread_counts.peak_live_bytes = thread_counts.live_bytes;
+}
+
+AllocationScope::~AllocationScope()
+{
+	thread_counts.peak_live_bytes = std::max(thread_counts.peak_live_bytes, start.peak_live_bytes);
+}
+
+AllocationCounts AllocationScope::get_counts() const
+{
+	return AllocationCounts
+	{
+		thread_counts.allocations - start.allocations,
+		thread_counts.allocated_bytes - start.allocated_bytes,
+		thread_counts.live_bytes - start.live_bytes,
+		thread_counts.peak_live_bytes - start.live_bytes
+	};
+}
+
+// Every form is replaced, as sanitizers replace them too, and their `operator delete` expects their `operator new`
+
+void* operator new(std::size_t size)
+{
+	return count_allocation(std::malloc(size == 0 ? 1 : size));
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+	const std::size_t align = static_cast<std::size_t>(alignment);
+	// `aligned_alloc` requires a multiple of the alignment
+	return count_allocation(std::aligned_alloc(align, (std::max(size, std::size_t{1}) + align - 1) / align * align));
+}
+
+void* operator new[](std::size_t size) { return operator new(size); }
+void* operator new[](std::size_t size, std::align_val_t alignment) { return operator new(size, alignment); }
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+	try { return operator new(size); }
+	catch(const std::bad_alloc&) { return nullptr; }
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+	try { return operator new(size, alignment); }
+	catch(const std::bad_alloc&) { return nullptr; }
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t& nothrow) noexcept { return operator new(size, nothrow); }
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t& nothrow) noexcept
+{
+	return operator new(size, alignment, nothrow);
+}
+
+void operator delete(void* pointer) noexcept
+{
+	count_deallocation(pointer);
+	std::free(pointer);
+}
+
+void operator delete(void* pointer, std::align_val_t) noexcept { operator delete(pointer); }
+void operator delete(void* pointer, std::size_t) noexcept { operator delete(pointer); }
+void operator delete(void* pointer, std::size_t, std::align_val_t) noexcept { operator delete(pointer); }
+void operator delete(void* pointer, const std::nothrow_t&) noexcept { operator delete(pointer); }
+void operator delete(void* pointer, std::align_val_t, const std::nothrow_t&) noexcept { operator delete(pointer); }
+
+void operator delete[](void* pointer) noexcept { operator delete(pointer); }
+void operator delete[](void* pointer, std::align_val_t) noexcept { operator delete(pointer); }
+void operator delete[](void* pointer, std::size_t) noexcept { operator delete(pointer); }
+void operator delete[](void* pointer, std::size_t, std::align_val_t) noexcept { operator delete(pointer); }
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept { operator delete(pointer); }
+void operator delete[](void* pointer, std::align_val_t, const std::nothrow_t&) noexcept { operator delete(pointer); }
@@ -0,0 +1,44 @@
+#ifndef ALLOCATION_COUNTER_HPP
+#define ALLOCATION_COUNTER_HPP
+
+#include <cstdint>
+
+namespace benchmarks::allocation_counter
+{
+
+/** Heap allocations made by one thread, counted by the global `operator new` and `operator delete` replaced in
+ * allocation_counter.cpp. Only counted in programs linking that file. */
+struct AllocationCounts
+{
+	uint64_t allocations{0};
+	/** Usable size of the allocated blocks, which may exceed the requested size */
+	uint64_t allocated_bytes{0};
+	/** Bytes allocated by this thread and not yet freed. Negative if it freed blocks allocated by other threads. */
+	int64_t live_bytes{0};
+	/** Highest `live_bytes` since the thread started, or since the innermost `AllocationScope` started */
+	int64_t peak_live_bytes{0};
+};
+
+/** Counts of the calling thread. Read before and after a unit of work to attribute the allocations in between to it. */
+AllocationCounts get_thread_counts();
+
+/** Counts the allocations of the calling thread from construction on, e.g. of one unit of work in a test or benchmark.
+ * Scopes can be nested, as long as the inner one ends first. */
+class AllocationScope
+{
+public:
+	AllocationScope();
+	~AllocationScope();
+
+	AllocationScope(const AllocationScope&) = delete;
+	AllocationScope& operator=(const AllocationScope&) = delete;
+
+	/** Counts since construction. The peak is the highest amount of memory in use above what was in use at construction. */
+	AllocationCounts get_counts() const;
+private:
+	AllocationCounts start;
+};
+
+}
+
+#endif // ALLOCATION_COUNTER_HPP
@@ -0,0 +1,318 @@
+#include "corpus_generator.hpp"
+
+#include <array>
+#include <string_view>
+
+using namespace benchmarks::corpus_generator;
+
+namespace
+{
+	constexpr std::string_view OPERATOR_PACKAGE = "gen::ops";
+	constexpr std::string_view FILE_PACKAGE_PREFIX = "gen::p";
+	constexpr std::string_view OPERATOR_MODULE_PREFIX = "ops";
+	constexpr std::string_view ENTRYPOINT_PREFIX = "start";
+
+	/** Chance that an expression below the maximum depth is a name or literal anyway */
+	constexpr double LEAF_CHANCE = 0.25;
+	/** Chance that an entrypoint uses an imported operator module the file does not use */
+	constexpr double BLOCK_USE_CHANCE = 0.3;
+	constexpr std::size_t MAX_ARGUMENTS = 3;
+	constexpr std::size_t MAX_IMPORTED_ENTRYPOINTS = 2;
+
+	// Names that are not keywords, e.g. `left` and `right` are
+	constexpr std::array<std::string_view, 12> NAMES
+	{
+		"x", "y", "width", "height", "count", "total", "offset", "scale", "index", "value", "limit", "step"
+	};
+	constexpr std::array<std::string_view, 7> FUNCTIONS
+	{
+		"compute", "clamp", "lookup", "app.run", "math.max", "items.get", "buffer.read"
+	};
+	constexpr std::array<std::string_view, 4> STRINGS
+	{
+		"\"a\"", "\"width\"", "\"neon\" \"code\"", "\"\\n\""
+	};
+
+	std::string to_module_name(std::size_t module)
+	{
+		return std::string{OPERATOR_MODULE_PREFIX} + std::to_string(module);
+	}
+}
+
+CorpusGenerator::CorpusGenerator(CorpusOptions init_options)
+	: options{init_options}, engine{init_options.seed}
+{
+	// Custom characters only, as `==`, `<` and `>` are taken by the language itself
+	operators = std::vector<OperatorSpec>
+	{
+		OperatorSpec{"+", false, 3, "left"},
+		OperatorSpec{"*", false, 2, "left"},
+		OperatorSpec{"-", true, 0, ""},
+		OperatorSpec{"!=", false, 6, ""},
+		OperatorSpec{"&&", false, 7, "left"},
+		OperatorSpec{"-", false, 3, "left"},
+		OperatorSpec{"/", false, 2, "left"},
+		OperatorSpec{"!", true, 0, ""},
+		OperatorSpec{"||", false, 8, "left"},
+		OperatorSpec{"^", false, 1, "right"},
+		OperatorSpec{"%", false, 2, "left"},
+		OperatorSpec{"~~", false, 6, ""},
+		OperatorSpec{"@", false, 4, "left"},
+		OperatorSpec{"#", false, 5, "left"}
+	};
+}
+
+std::vector<CorpusFile> CorpusGenerator::generate()
+{
+	std::vector<CorpusFile> files;
+	files.reserve(options.operator_module_count + options.file_count);
+
+	for(std::size_t module = 0; module < options.operator_module_count; ++module)
+	{
+		files.push_back(generate_operator_module_file(module));
+	}
+
+	for(std::size_t file = 0; file < options.file_count; ++file)
+	{
+		files.push_back(generate_file(file));
+	}
+
+	return files;
+}
+
+std::size_t CorpusGenerator::next_index(std::size_t count)
+{
+	return static_cast<std::size_t>(engine() % count);
+}
+
+bool CorpusGenerator::next_chance(double chance)
+{
+	// 53 random bits, as a double from 0 to 1
+	return static_cast<double>(engine() >> 11) * 0x1.0p-53 < chance;
+}
+
+CorpusFile CorpusGenerator::generate_operator_module_file(std::size_t module)
+{
+	std::string source = "pkg " + std::string{OPERATOR_PACKAGE} + ";\n\n"
+		"public operator_module " + to_module_name(module) + "\n{\n";
+
+	const std::vector<std::size_t> module_operators = get_module_operators(std::vector<std::size_t>{module});
+
+	for(const std::size_t index : module_operators)
+	{
+		const OperatorSpec& spec = operators[index];
+
+		source += spec.prefix ? "\toperator " + spec.symbol + " __\n" : "\toperator __ " + spec.symbol + " __\n";
+		source += "\t{\n\t\tsubordination " + std::to_string(spec.subordination) + ";\n";
+		if(!spec.associativity.empty())
+		{
+			source += "\t\tassociativity " + spec.associativity + ";\n";
+		}
+		source += "\t}\n\n";
+	}
+
+	for(const std::size_t index : module_operators)
+	{
+		const OperatorSpec& spec = operators[index];
+		if(spec.prefix) { continue; }
+
+		source += "\tint (int a) " + spec.symbol + " (int b)\n\t{\n\t\tret op" + std::to_string(index) + "(a, b);\n\t}\n\n";
+	}
+
+	source += "}\n";
+
+	return CorpusFile{"operators" + std::to_string(module) + ".neon", std::move(source)};
+}
+
+CorpusFile CorpusGenerator::generate_file(std::size_t file)
+{
+	std::string source = "pkg " + std::string{FILE_PACKAGE_PREFIX} + std::to_string(file) + ";\n\n";
+
+	for(std::size_t module = 0; module < options.operator_module_count; ++module)
+	{
+		source += "import " + std::string{OPERATOR_PACKAGE} + "::" + to_module_name(module) + ";\n";
+	}
+
+	if(file > 0 && options.members_per_file > 0)
+	{
+		const std::size_t imported_count = next_index(MAX_IMPORTED_ENTRYPOINTS + 1);
+		for(std::size_t i = 0; i < imported_count; ++i)
+		{
+			source += "import " + std::string{FILE_PACKAGE_PREFIX} + std::to_string(next_index(file)) + "::"
+				+ std::string{ENTRYPOINT_PREFIX} + std::to_string(next_index(options.members_per_file)) + ";\n";
+		}
+	}
+
+	source += "\n";
+
+	// At least one operator module is used by the whole file, the others maybe by single entrypoints
+	std::vector<std::size_t> used_modules;
+	for(std::size_t module = 0; module < options.operator_module_count; ++module)
+	{
+		if(next_chance(0.5)) { used_modules.push_back(module); }
+	}
+	if(used_modules.empty() && options.operator_module_count > 0)
+	{
+		used_modules.push_back(next_index(options.operator_module_count));
+	}
+
+	for(const std::size_t module : used_modules)
+	{
+		source += "use " + to_module_name(module) + ";\n";
+	}
+
+	for(std::size_t member = 0; member < options.members_per_file; ++member)
+	{
+		source += "\n";
+		append_entrypoint(source, member, used_modules);
+	}
+
+	return CorpusFile{"file" + std::to_string(file) + ".neon", std::move(source)};
+}
+
+void CorpusGenerator::append_entrypoint(std::string& source, std::size_t member, const std::vector<std::size_t>& used_modules)
+{
+	source += "public entrypoint " + std::string{ENTRYPOINT_PREFIX} + std::to_string(member) + "(borrow str arg)\n{\n";
+
+	std::vector<std::size_t> modules = used_modules;
+	for(std::size_t module = 0; module < options.operator_module_count; ++module)
+	{
+		bool used = false;
+		for(const std::size_t used_module : used_modules) { used = used || used_module == module; }
+
+		if(!used && next_chance(BLOCK_USE_CHANCE))
+		{
+			source += "\tuse " + to_module_name(module) + ";\n";
+			modules.push_back(module);
+		}
+	}
+
+	const std::vector<std::size_t> available_operators = get_module_operators(modules);
+
+	for(std::size_t statement = 0; statement + 1 < options.statements_per_member; ++statement)
+	{
+		append_statement(source, available_operators);
+	}
+
+	source += "\tret ";
+	append_expression(source, available_operators, 0, std::nullopt);
+	source += ";\n}\n";
+}
+
+void CorpusGenerator::append_statement(std::string& source, const std::vector<std::size_t>& available_operators)
+{
+	source += "\t";
+
+	if(next_chance(0.5))
+	{
+		source += "print(";
+		append_expression(source, available_operators, 0, std::nullopt);
+		source += ")";
+	}
+	else
+	{
+		append_function_call(source, available_operators, 0);
+	}
+
+	source += ";\n";
+}
+
+void CorpusGenerator::append_expression
+(
+	std::string& source,
+	const std::vector<std::size_t>& available_operators,
+	std::size_t depth,
+	std::optional<uint32_t> parent_subordination
+)
+{
+	if(depth + 1 >= options.max_nesting_depth || next_chance(LEAF_CHANCE))
+	{
+		append_leaf(source);
+	}
+	else if(!available_operators.empty() && next_chance(options.operator_density))
+	{
+		append_operator_call(source, available_operators, depth, parent_subordination);
+	}
+	else
+	{
+		append_function_call(source, available_operators, depth);
+	}
+}
+
+void CorpusGenerator::append_operator_call
+(
+	std::string& source,
+	const std::vector<std::size_t>& available_operators,
+	std::size_t depth,
+	std::optional<uint32_t> parent_subordination
+)
+{
+	const OperatorSpec& spec = operators[available_operators[next_index(available_operators.size())]];
+
+	// Without associativity or precedence to rely on, the operands would be ambiguous
+	const bool parenthesised = parent_subordination.has_value() && spec.subordination >= parent_subordination.value();
+
+	if(parenthesised) { source += "("; }
+
+	if(spec.prefix)
+	{
+		source += spec.symbol;
+	}
+	else
+	{
+		append_expression(source, available_operators, depth + 1, spec.subordination);
+		source += " " + spec.symbol + " ";
+	}
+	append_expression(source, available_operators, depth + 1, spec.subordination);
+
+	if(parenthesised) { source += ")"; }
+}
+
+void CorpusGenerator::append_function_call(std::string& source, const std::vector<std::size_t>& available_operators, std::size_t depth)
+{
+	source += FUNCTIONS[next_index(FUNCTIONS.size())];
+	source += "(";
+
+	const std::size_t argument_count = next_index(MAX_ARGUMENTS + 1);
+	for(std::size_t i = 0; i < argument_count; ++i)
+	{
+		if(i > 0) { source += ", "; }
+		append_expression(source, available_operators, depth + 1, std::nullopt);
+	}
+
+	source += ")";
+}
+
+void CorpusGenerator::append_leaf(std::string& source)
+{
+	switch(next_index(5))
+	{
+		case 0: { source += std::to_string(next_index(1000)); break; }
+		case 1: { source += "0x" + std::to_string(10 + next_index(90)) + "F"; break; }
+		case 2: { source += STRINGS[next_index(STRINGS.size())]; break; }
+		case 3:
+		{
+			source += NAMES[next_index(NAMES.size())];
+			source += ".";
+			source += NAMES[next_index(NAMES.size())];
+			break;
+		}
+		default: { source += NAMES[next_index(NAMES.size())]; }
+	}
+}
+
+std::vector<std::size_t> CorpusGenerator::get_module_operators(const std::vector<std::size_t>& modules) const
+{
+	// Operators are dealt out to the modules in turn
+	std::vector<std::size_t> module_operators;
+
+	for(std::size_t index = 0; index < operators.size(); ++index)
+	{
+		for(const std::size_t module : modules)
+		{
+			if(index % options.operator_module_count == module) { module_operators.push_back(index); }
+		}
+	}
+
+	return module_operators;
+}
@@ -0,0 +1,89 @@
+#ifndef CORPUS_GENERATOR_HPP
+#define CORPUS_GENERATOR_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace benchmarks::corpus_generator
+{
+
+struct CorpusOptions
+{
+	/** The same seed and options always give the same corpus */
+	uint64_t seed{1};
+	/** Number of files with entrypoints, besides the operator module files */
+	std::size_t file_count{100};
+	std::size_t operator_module_count{2};
+	std::size_t members_per_file{20};
+	std::size_t statements_per_member{4};
+	/** Maximum depth of nested expressions, e.g. 1 for only names and literals */
+	std::size_t max_nesting_depth{4};
+	/** Chance, from 0 to 1, that a nested expression is an operator call rather than a function call */
+	double operator_density{0.6};
+};
+
+struct CorpusFile
+{
+	std::string name;
+	std::string source;
+};
+
+/** Generates valid Neoncode: operator modules with custom operators, and files with imports, `use` statements,
+ * entrypoints and nested expressions using those operators. */
+class CorpusGenerator
+{
+public:
+	explicit CorpusGenerator(CorpusOptions init_options);
+
+	/** The operator module files come first, as files using an operator module must be parsed after it */
+	std::vector<CorpusFile> generate();
+private:
+	struct OperatorSpec
+	{
+		std::string symbol;
+		bool prefix;
+		uint32_t subordination;
+		/** Empty if not associative */
+		std::string associativity;
+	};
+
+	CorpusOptions options;
+	/** `std::mt19937_64` is specified exactly, unlike the standard distributions, so only its raw output is used */
+	std::mt19937_64 engine;
+	std::vector<OperatorSpec> operators;
+
+	std::size_t next_index(std::size_t count);
+	bool next_chance(double chance);
+
+	CorpusFile generate_operator_module_file(std::size_t module);
+	CorpusFile generate_file(std::size_t file);
+	void append_entrypoint(std::string& source, std::size_t member, const std::vector<std::size_t>& used_modules);
+	void append_statement(std::string& source, const std::vector<std::size_t>& available_operators);
+	/** `parent_subordination` is that of the operator call this is an operand of, if any.
+	 * Operator calls binding less tightly than it are put in parentheses. */
+	void append_expression
+	(
+		std::string& source,
+		const std::vector<std::size_t>& available_operators,
+		std::size_t depth,
+		std::optional<uint32_t> parent_subordination
+	);
+	void append_operator_call
+	(
+		std::string& source,
+		const std::vector<std::size_t>& available_operators,
+		std::size_t depth,
+		std::optional<uint32_t> parent_subordination
+	);
+	void append_function_call(std::string& source, const std::vector<std::size_t>& available_operators, std::size_t depth);
+	void append_leaf(std::string& source);
+	std::vector<std::size_t> get_module_operators(const std::vector<std::size_t>& modules) const;
+};
+
+}
+
+#endif // CORPUS_GENERATOR_HPP
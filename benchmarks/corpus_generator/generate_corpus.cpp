@@ -0,0 +1,74 @@
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "corpus_generator.hpp"
+
+using namespace benchmarks::corpus_generator;
+
+// Writes a generated corpus to a directory, e.g. for `make corpus CORPUS_ARGS="--files 500 --seed 7"`
+
+constexpr std::string_view OPTION_OUT = "--out";
+constexpr std::string_view OPTION_SEED = "--seed";
+constexpr std::string_view OPTION_FILES = "--files";
+constexpr std::string_view OPTION_OPERATOR_MODULES = "--operator-modules";
+constexpr std::string_view OPTION_MEMBERS = "--members";
+constexpr std::string_view OPTION_STATEMENTS = "--statements";
+constexpr std::string_view OPTION_DEPTH = "--depth";
+constexpr std::string_view OPTION_OPERATOR_DENSITY = "--operator-density";
+
+static void print_usage(const char* program)
+{
+	std::cerr << "Usage: " << program << " --out <directory> [--seed <n>] [--files <n>] [--operator-modules <n>]"
+		" [--members <n>] [--statements <n>] [--depth <n>] [--operator-density <0 to 1>]\n";
+}
+
+int main(int argc, char** argv)
+{
+	CorpusOptions options{};
+	std::filesystem::path out{};
+
+	for(int i = 1; i + 1 < argc; i += 2)
+	{
+		const std::string_view option{argv[i]};
+		const char* value = argv[i + 1];
+
+		if(option == OPTION_OUT) { out = value; }
+		else if(option == OPTION_SEED) { options.seed = std::strtoull(value, nullptr, 10); }
+		else if(option == OPTION_FILES) { options.file_count = std::strtoull(value, nullptr, 10); }
+		else if(option == OPTION_OPERATOR_MODULES) { options.operator_module_count = std::strtoull(value, nullptr, 10); }
+		else if(option == OPTION_MEMBERS) { options.members_per_file = std::strtoull(value, nullptr, 10); }
+		else if(option == OPTION_STATEMENTS) { options.statements_per_member = std::strtoull(value, nullptr, 10); }
+		else if(option == OPTION_DEPTH) { options.max_nesting_depth = std::strtoull(value, nullptr, 10); }
+		else if(option == OPTION_OPERATOR_DENSITY) { options.operator_density = std::strtod(value, nullptr); }
+		else
+		{
+			print_usage(argv[0]);
+			return 1;
+		}
+	}
+
+	if(out.empty() || argc % 2 == 0 || options.operator_module_count == 0)
+	{
+		print_usage(argv[0]);
+		return 1;
+	}
+
+	std::filesystem::create_directories(out);
+
+	std::size_t total_bytes = 0;
+	const std::vector<CorpusFile> files = CorpusGenerator{options}.generate();
+	for(const CorpusFile& file : files)
+	{
+		std::ofstream stream{out / file.name, std::ios::binary};
+		stream << file.source;
+		total_bytes += file.source.size();
+	}
+
+	std::cout << "Generated " << files.size() << " files (" << total_bytes << " bytes) in " << out.string() << "\n";
+
+	return 0;
+}
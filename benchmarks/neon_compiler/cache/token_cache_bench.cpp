@@ -0,0 +1,86 @@
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "../../../neon_compiler/token.hpp"
+#include "../../../neon_compiler/cache/content_hash.hpp"
+#include "../../../neon_compiler/cache/token_cache.hpp"
+#include "../../../neon_compiler/lexer/lexer.hpp"
+#include "../../../reading/char_reader.hpp"
+
+using namespace neon_compiler;
+using namespace neon_compiler::cache;
+using namespace neon_compiler::lexer;
+
+constexpr std::size_t FILE_COUNT = 200;
+constexpr std::size_t FUNCTIONS_PER_FILE = 50;
+
+static std::string make_source(std::size_t file)
+{
+	std::string source = "pkg main::generated" + std::to_string(file) + ";\n\n";
+
+	for(std::size_t i = 0; i < FUNCTIONS_PER_FILE; ++i)
+	{
+		source += "pub pure_function_set f" + std::to_string(i) + "\n{\n"
+			"\tpub int32 compute(int32 a, int32 b)\n\t{\n"
+			"\t\tvar int32 x = a * 0x1F + b;\n"
+			"\t\tif(x > 100) { return \"large\"; }\n"
+			"\t\treturn x - 'c';\n\t}\n}\n\n";
+	}
+
+	return source;
+}
+
+static double elapsed_ms(std::chrono::steady_clock::time_point start)
+{
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main()
+{
+	const std::filesystem::path directory = std::filesystem::temp_directory_path() / "neon_token_cache_bench";
+	std::filesystem::remove_all(directory);
+	TokenCache cache{directory};
+
+	std::vector<std::string> sources;
+	std::size_t total_bytes = 0;
+	for(std::size_t i = 0; i < FILE_COUNT; ++i)
+	{
+		sources.push_back(make_source(i));
+		total_bytes += sources.back().size();
+	}
+
+	std::size_t cold_tokens = 0;
+	const std::chrono::steady_clock::time_point cold_start = std::chrono::steady_clock::now();
+	for(const std::string& source : sources)
+	{
+		Lexer lexer{std::make_unique<reading::CharReader>(std::make_unique<std::istringstream>(source))};
+		lexer.run();
+		const std::vector<Token> tokens = lexer.take_tokens();
+		cold_tokens += tokens.size();
+		cache.store(hash_content(source), tokens, lexer.take_errors());
+	}
+	const double cold_ms = elapsed_ms(cold_start);
+
+	std::size_t warm_tokens = 0;
+	const std::chrono::steady_clock::time_point warm_start = std::chrono::steady_clock::now();
+	for(const std::string& source : sources)
+	{
+		const std::optional<CachedTokens> cached = cache.load(hash_content(source));
+		warm_tokens += cached.has_value() ? cached->tokens.size() : 0;
+	}
+	const double warm_ms = elapsed_ms(warm_start);
+
+	std::cout << "files: " << FILE_COUNT << " (" << total_bytes / 1024 << " KiB, " << cold_tokens << " tokens)\n"
+		<< "cold (lex + store): " << cold_ms << " ms\n"
+		<< "warm (hash + load): " << warm_ms << " ms (" << warm_tokens << " tokens)\n"
+		<< "speedup: " << cold_ms / warm_ms << "x\n";
+
+	std::filesystem::remove_all(directory);
+
+	return 0;
+}
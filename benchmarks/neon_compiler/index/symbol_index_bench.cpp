@@ -0,0 +1,119 @@
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include "../../../neon_compiler/index/symbol_interner.hpp"
+#include "../../../neon_compiler/index/symbol_index.hpp"
+
+using namespace neon_compiler::index;
+
+constexpr std::size_t SYMBOL_COUNT = 100'000;
+constexpr std::size_t SYMBOLS_PER_FILE = 20;
+constexpr std::size_t QUERY_COUNT = 2'000;
+constexpr std::size_t MAX_RESULTS = 50;
+constexpr unsigned SEED = 26;
+
+static const std::vector<std::string> WORDS
+{
+	"widget", "factory", "parser", "operator", "table", "reader", "writer", "buffer", "stream", "token",
+	"node", "visitor", "printer", "config", "manager", "server", "client", "request", "response", "cache",
+	"index", "symbol", "scope", "module", "package", "entry", "point", "vector", "matrix", "colour"
+};
+
+static std::string capitalise(std::string word)
+{
+	word[0] = static_cast<char>(word[0] - 'a' + 'A');
+	return word;
+}
+
+static std::string make_symbol(std::mt19937& rng, std::size_t i)
+{
+	std::uniform_int_distribution<std::size_t> word{0, WORDS.size() - 1};
+
+	return "main::" + WORDS[word(rng)] + "::" + WORDS[word(rng)] + "::" +
+		capitalise(WORDS[word(rng)]) + capitalise(WORDS[word(rng)]) + std::to_string(i % 97);
+}
+
+static std::string make_query(std::mt19937& rng, const std::vector<std::string>& symbols)
+{
+	const std::string& symbol = symbols[std::uniform_int_distribution<std::size_t>{0, symbols.size() - 1}(rng)];
+	std::string member = symbol.substr(symbol.rfind("::") + 2);
+
+	switch(std::uniform_int_distribution<int>{0, 2}(rng))
+	{
+		case 0: return member; // exact
+		case 1: return member.substr(0, std::min<std::size_t>(member.size(), 6)); // prefix
+		default: // typo: swap two adjacent characters
+		{
+			const std::size_t at = std::uniform_int_distribution<std::size_t>{0, member.size() - 2}(rng);
+			std::swap(member[at], member[at + 1]);
+			return member;
+		}
+	}
+}
+
+static double elapsed_us(std::chrono::steady_clock::time_point start)
+{
+	return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main()
+{
+	std::mt19937 rng{SEED};
+
+	std::vector<std::string> symbols;
+	symbols.reserve(SYMBOL_COUNT);
+	for(std::size_t i = 0; i < SYMBOL_COUNT; ++i)
+	{
+		symbols.push_back(make_symbol(rng, i));
+	}
+
+	std::shared_ptr<SymbolInterner> interner = std::make_shared<SymbolInterner>();
+	SymbolIndex index{interner};
+
+	const std::chrono::steady_clock::time_point build_start = std::chrono::steady_clock::now();
+	for(std::size_t i = 0; i < SYMBOL_COUNT; i += SYMBOLS_PER_FILE)
+	{
+		const std::vector<std::string> file_symbols{symbols.begin() + static_cast<std::ptrdiff_t>(i),
+			symbols.begin() + static_cast<std::ptrdiff_t>(std::min(i + SYMBOLS_PER_FILE, SYMBOL_COUNT))};
+		index.update_file("file_" + std::to_string(i / SYMBOLS_PER_FILE) + ".neon", file_symbols);
+	}
+	const double build_us = elapsed_us(build_start);
+
+	// Re-index a single file, as done after re-parsing it
+	const std::chrono::steady_clock::time_point update_start = std::chrono::steady_clock::now();
+	index.update_file("file_0.neon", std::vector<std::string>{symbols.begin(), symbols.begin() + SYMBOLS_PER_FILE});
+	const double update_us = elapsed_us(update_start);
+
+	std::vector<double> latencies;
+	latencies.reserve(QUERY_COUNT);
+	std::size_t total_results = 0;
+
+	for(std::size_t i = 0; i < QUERY_COUNT; ++i)
+	{
+		const std::string query = make_query(rng, symbols);
+
+		const std::chrono::steady_clock::time_point query_start = std::chrono::steady_clock::now();
+		total_results += index.search(query, MAX_RESULTS).size();
+		latencies.push_back(elapsed_us(query_start));
+	}
+
+	std::sort(latencies.begin(), latencies.end());
+
+	double sum = 0;
+	for(double latency : latencies) { sum += latency; }
+
+	std::cout << "symbols: " << index.get_live_symbol_count() << "\n"
+		<< "build: " << build_us / 1000.0 << " ms\n"
+		<< "single file update: " << update_us << " us\n"
+		<< "queries: " << QUERY_COUNT << " (avg. " << total_results / QUERY_COUNT << " results)\n"
+		<< "query latency mean: " << sum / static_cast<double>(QUERY_COUNT) << " us\n"
+		<< "query latency p50: " << latencies[QUERY_COUNT / 2] << " us\n"
+		<< "query latency p99: " << latencies[QUERY_COUNT * 99 / 100] << " us\n"
+		<< "query latency max: " << latencies.back() << " us\n";
+
+	return 0;
+}
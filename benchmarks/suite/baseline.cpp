@@ -0,0 +1,196 @@
+#include "baseline.hpp"
+
+#include <array>
+#include <cctype>
+#include <charconv>
+#include <iomanip>
+#include <iterator>
+#include <string_view>
+
+using namespace benchmarks::suite;
+
+namespace
+{
+	constexpr std::string_view THROUGHPUT_SUFFIX = "_per_s";
+	constexpr std::array<std::string_view, 3> LOWER_IS_BETTER_METRICS{"allocations", "allocated_bytes", "peak_heap_bytes"};
+
+	double per_second(uint64_t count, std::chrono::nanoseconds wall_time)
+	{
+		const double seconds = std::chrono::duration<double>{wall_time}.count();
+		return seconds > 0 ? static_cast<double>(count) / seconds : 0;
+	}
+
+	/** Reads the subset of JSON written by `write_baseline` */
+	class BaselineReader
+	{
+	public:
+		explicit BaselineReader(std::string_view init_json) : json{init_json} {}
+
+		std::optional<Baseline> read()
+		{
+			Baseline baseline{};
+
+			const bool valid = read_object([this, &baseline] (const std::string& benchmark)
+			{
+				std::map<std::string, double>& metrics = baseline[benchmark];
+
+				return read_object([this, &metrics] (const std::string& metric)
+				{
+					const std::optional<double> value = read_number();
+					if(value.has_value()) { metrics[metric] = value.value(); }
+					return value.has_value();
+				});
+			});
+
+			skip_space();
+			if(!valid || position != json.size()) { return std::nullopt; }
+
+			return baseline;
+		}
+	private:
+		std::string_view json;
+		std::size_t position{0};
+
+		void skip_space()
+		{
+			while(position < json.size() && std::isspace(static_cast<unsigned char>(json[position]))) { ++position; }
+		}
+
+		bool consume_if_next(char c)
+		{
+			skip_space();
+			if(position >= json.size() || json[position] != c) { return false; }
+
+			++position;
+			return true;
+		}
+
+		/** Calls `read_value` with each key, after which the value should be read. */
+		template<typename ReadValue>
+		bool read_object(ReadValue read_value)
+		{
+			if(!consume_if_next('{')) { return false; }
+			if(consume_if_next('}')) { return true; }
+
+			do
+			{
+				const std::optional<std::string> key = read_string();
+				if(!key.has_value() || !consume_if_next(':') || !read_value(key.value())) { return false; }
+			}
+			while(consume_if_next(','));
+
+			return consume_if_next('}');
+		}
+
+		/** Names are written without escapes, so none are read */
+		std::optional<std::string> read_string()
+		{
+			if(!consume_if_next('"')) { return std::nullopt; }
+
+			const std::size_t end = json.find('"', position);
+			if(end == std::string_view::npos) { return std::nullopt; }
+
+			std::string str{json.substr(position, end - position)};
+			position = end + 1;
+			return str;
+		}
+
+		std::optional<double> read_number()
+		{
+			skip_space();
+
+			double value{};
+			const std::from_chars_result result = std::from_chars(json.data() + position, json.data() + json.size(), value);
+			if(result.ec != std::errc{}) { return std::nullopt; }
+
+			position = static_cast<std::size_t>(result.ptr - json.data());
+			return value;
+		}
+	};
+}
+
+Baseline benchmarks::suite::to_baseline(const std::vector<BenchmarkResult>& results)
+{
+	Baseline baseline{};
+
+	for(const BenchmarkResult& result : results)
+	{
+		std::map<std::string, double>& metrics = baseline[result.name];
+
+		metrics["wall_ms"] = std::chrono::duration<double, std::milli>{result.wall_time}.count();
+		metrics["mb_per_s"] = per_second(result.bytes, result.wall_time) / 1'000'000.0;
+		metrics["tokens_per_s"] = per_second(result.tokens, result.wall_time);
+		if(result.ast_nodes > 0) { metrics["nodes_per_s"] = per_second(result.ast_nodes, result.wall_time); }
+		metrics["allocations"] = static_cast<double>(result.allocations);
+		metrics["allocated_bytes"] = static_cast<double>(result.allocated_bytes);
+		metrics["peak_heap_bytes"] = static_cast<double>(result.peak_heap_bytes);
+	}
+
+	return baseline;
+}
+
+void benchmarks::suite::write_baseline(std::ostream& out, const Baseline& baseline)
+{
+	out << "{\n";
+
+	for(Baseline::const_iterator it = baseline.begin(); it != baseline.end(); ++it)
+	{
+		out << "\t\"" << it->first << "\": {";
+
+		for(std::map<std::string, double>::const_iterator metric_it = it->second.begin(); metric_it != it->second.end(); ++metric_it)
+		{
+			if(metric_it != it->second.begin()) { out << ", "; }
+			out << "\"" << metric_it->first << "\": " << std::fixed << std::setprecision(3) << metric_it->second;
+		}
+
+		out << (std::next(it) == baseline.end() ? "}\n" : "},\n");
+	}
+
+	out << "}\n";
+}
+
+std::optional<Baseline> benchmarks::suite::read_baseline(std::istream& in)
+{
+	const std::string json{std::istreambuf_iterator<char>{in}, std::istreambuf_iterator<char>{}};
+
+	return BaselineReader{json}.read();
+}
+
+std::vector<Regression> benchmarks::suite::compare(const Baseline& baseline, const Baseline& current, double tolerance)
+{
+	std::vector<Regression> regressions;
+
+	for(const std::pair<const std::string, std::map<std::string, double>>& benchmark : current)
+	{
+		Baseline::const_iterator baseline_it = baseline.find(benchmark.first);
+		if(baseline_it == baseline.end()) { continue; }
+
+		for(const std::pair<const std::string, double>& metric : benchmark.second)
+		{
+			std::map<std::string, double>::const_iterator metric_it = baseline_it->second.find(metric.first);
+			if(metric_it == baseline_it->second.end()) { continue; }
+
+			const double baseline_value = metric_it->second;
+			bool regressed = false;
+
+			if(metric.first.ends_with(THROUGHPUT_SUFFIX))
+			{
+				regressed = metric.second < baseline_value * (1 - tolerance);
+			}
+			else
+			{
+				for(const std::string_view lower_is_better : LOWER_IS_BETTER_METRICS)
+				{
+					regressed = regressed || (metric.first == lower_is_better && metric.second > baseline_value * (1 + tolerance));
+				}
+			}
+
+			if(regressed)
+			{
+				regressions.push_back(Regression{benchmark.first, metric.first, baseline_value, metric.second});
+			}
+		}
+	}
+
+	return regressions;
+}
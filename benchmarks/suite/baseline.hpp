@@ -0,0 +1,53 @@
+#ifndef BASELINE_HPP
+#define BASELINE_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <istream>
+#include <map>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace benchmarks::suite
+{
+
+struct BenchmarkResult
+{
+	std::string name;
+	/** Of the fastest round */
+	std::chrono::nanoseconds wall_time{0};
+	uint64_t bytes{0};
+	uint64_t tokens{0};
+	uint64_t ast_nodes{0};
+	/** Of one round */
+	uint64_t allocations{0};
+	uint64_t allocated_bytes{0};
+	/** Highest amount of heap memory in use during a round, above what was in use before it */
+	uint64_t peak_heap_bytes{0};
+};
+
+/** Mapping from benchmark name to metric name to value, e.g. "lexer" -> "mb_per_s" -> 42.0 */
+using Baseline = std::map<std::string, std::map<std::string, double>>;
+
+/** A metric that got worse by more than the tolerance */
+struct Regression
+{
+	std::string benchmark;
+	std::string metric;
+	double baseline;
+	double current;
+};
+
+Baseline to_baseline(const std::vector<BenchmarkResult>& results);
+void write_baseline(std::ostream& out, const Baseline& baseline);
+/** Reads what `write_baseline` writes: an object of objects of numbers. Empty if it is not in that format. */
+std::optional<Baseline> read_baseline(std::istream& in);
+/** Compares throughput (`*_per_s`, higher is better), allocations and peak heap memory (lower is better).
+ * Changes smaller than `tolerance`, as a fraction of the baseline, are ignored, as are metrics missing on either side. */
+std::vector<Regression> compare(const Baseline& baseline, const Baseline& current, double tolerance);
+
+}
+
+#endif // BASELINE_HPP
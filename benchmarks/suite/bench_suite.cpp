@@ -0,0 +1,424 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <sstream>
+#include <streambuf>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "baseline.hpp"
+#include "../allocation_counter/allocation_counter.hpp"
+#include "../corpus_generator/corpus_generator.hpp"
+#include "../../logging/logger.hpp"
+#include "../../neon_compiler/compiler.hpp"
+#include "../../neon_compiler/token.hpp"
+#include "../../neon_compiler/analysis/analysis_reporter.hpp"
+#include "../../neon_compiler/ast/impl/ast_node_counter.hpp"
+#include "../../neon_compiler/ast/nodes/nodes.hpp"
+#include "../../neon_compiler/lexer/lexer.hpp"
+#include "../../neon_compiler/parser/parser.hpp"
+#include "../../reading/char_reader.hpp"
+
+using namespace benchmarks::allocation_counter;
+using namespace benchmarks::corpus_generator;
+using namespace benchmarks::suite;
+using namespace neon_compiler;
+using namespace neon_compiler::analysis;
+using namespace neon_compiler::ast::nodes;
+using namespace neon_compiler::parser;
+
+// Run with `make bench`. Throughput depends on the machine, so write the baseline again on the machine comparing with it.
+
+constexpr std::string_view OPTION_BASELINE = "--baseline";
+constexpr std::string_view OPTION_WRITE_BASELINE = "--write-baseline";
+constexpr std::string_view OPTION_TOLERANCE = "--tolerance";
+constexpr std::string_view OPTION_ROUNDS = "--rounds";
+
+constexpr std::size_t DEFAULT_ROUNDS = 5;
+constexpr double DEFAULT_TOLERANCE = 0.15;
+
+class IgnoringAnalysisReporter : public AnalysisReporter
+{
+public:
+	void report(const AnalysisEntry&) override {}
+};
+
+class DiscardingLogSink : public logging::LogSink
+{
+public:
+	void write(logging::LogLevel, std::string) override {}
+	void flush() override {}
+};
+
+/** Discards what is written to it, e.g. the AST printed by `analyse` */
+class DiscardingStreamBuffer : public std::streambuf
+{
+protected:
+	int overflow(int c) override { return c; }
+	std::streamsize xsputn(const char*, std::streamsize count) override { return count; }
+};
+
+struct Corpus
+{
+	std::vector<CorpusFile> files;
+	std::vector<std::vector<Token>> file_tokens;
+	uint64_t bytes{0};
+	uint64_t tokens{0};
+};
+
+/** One round of a benchmark */
+struct Round
+{
+	std::chrono::nanoseconds wall_time{0};
+	uint64_t allocations{0};
+	uint64_t allocated_bytes{0};
+	uint64_t peak_heap_bytes{0};
+};
+
+/** Measures wall time and the allocations of the calling thread from construction until `stop` */
+class RoundMeasurement
+{
+public:
+	Round stop() const
+	{
+		const std::chrono::steady_clock::time_point wall_end = std::chrono::steady_clock::now();
+		const AllocationCounts allocations = allocation_scope.get_counts();
+
+		return Round
+		{
+			std::chrono::duration_cast<std::chrono::nanoseconds>(wall_end - wall_start),
+			allocations.allocations,
+			allocations.allocated_bytes,
+			static_cast<uint64_t>(std::max<int64_t>(0, allocations.peak_live_bytes))
+		};
+	}
+private:
+	AllocationScope allocation_scope{};
+	std::chrono::steady_clock::time_point wall_start{std::chrono::steady_clock::now()};
+};
+
+/** State of parsing a corpus, created outside of the measured rounds */
+struct ParseState
+{
+	std::shared_ptr<Root> root_node = std::make_shared<Root>();
+	std::shared_ptr<OperatorMap> operator_map = std::make_shared<OperatorMap>();
+	std::shared_ptr<OperatorTable> operator_table = std::make_shared<OperatorTable>();
+	std::vector<Parser> parsers;
+};
+
+static std::shared_ptr<logging::Logger> create_logger(logging::LogLevel min_level = logging::LogLevel::WARNING)
+{
+	return std::make_shared<logging::Logger>(std::make_shared<DiscardingLogSink>(), min_level);
+}
+
+static std::vector<Token> lex(const std::string& source)
+{
+	lexer::Lexer lexer{std::make_unique<reading::CharReader>(std::make_unique<std::istringstream>(source))};
+	lexer.run();
+	return lexer.take_tokens();
+}
+
+static Corpus create_corpus(const CorpusOptions& options)
+{
+	Corpus corpus{};
+	corpus.files = CorpusGenerator{options}.generate();
+
+	for(const CorpusFile& file : corpus.files)
+	{
+		corpus.file_tokens.push_back(lex(file.source));
+		corpus.bytes += file.source.size();
+		corpus.tokens += corpus.file_tokens.back().size();
+	}
+
+	return corpus;
+}
+
+static void create_parsers(ParseState& state, const Corpus& corpus, const std::shared_ptr<logging::Logger>& logger)
+{
+	std::shared_ptr<AnalysisReporter> reporter = std::make_shared<IgnoringAnalysisReporter>();
+
+	state.parsers.reserve(corpus.files.size());
+	for(std::size_t i = 0; i < corpus.files.size(); ++i)
+	{
+		state.parsers.emplace_back(logger, corpus.file_tokens[i], reporter, state.root_node, corpus.files[i].name, state.operator_map);
+	}
+}
+
+static uint64_t count_ast_nodes(const Root& root_node)
+{
+	ast::impl::ASTNodeCounter counter{};
+	root_node.accept(counter);
+	return counter.get_count();
+}
+
+/** Keeps the fastest wall time and the allocations of the last round, which are the same every round */
+static BenchmarkResult summarise(std::string name, const Corpus& corpus, uint64_t ast_nodes, const std::vector<Round>& rounds)
+{
+	BenchmarkResult result{std::move(name), rounds.front().wall_time, corpus.bytes, corpus.tokens, ast_nodes};
+
+	for(const Round& round : rounds)
+	{
+		result.wall_time = std::min(result.wall_time, round.wall_time);
+	}
+
+	result.allocations = rounds.back().allocations;
+	result.allocated_bytes = rounds.back().allocated_bytes;
+	result.peak_heap_bytes = rounds.back().peak_heap_bytes;
+
+	return result;
+}
+
+static BenchmarkResult bench_lexer(const Corpus& corpus, std::size_t round_count)
+{
+	std::vector<Round> rounds;
+
+	for(std::size_t round = 0; round < round_count; ++round)
+	{
+		std::vector<std::unique_ptr<std::istringstream>> streams;
+		for(const CorpusFile& file : corpus.files)
+		{
+			streams.push_back(std::make_unique<std::istringstream>(file.source));
+		}
+
+		const RoundMeasurement measurement{};
+
+		for(std::unique_ptr<std::istringstream>& stream : streams)
+		{
+			lexer::Lexer lexer{std::make_unique<reading::CharReader>(std::move(stream))};
+			lexer.run();
+		}
+
+		rounds.push_back(measurement.stop());
+	}
+
+	return summarise("lexer", corpus, 0, rounds);
+}
+
+/** Measures both parsing phases, reported as the benchmarks `name_a` and `name_b`, or `name` if `combined`.
+ * Messages below `min_level` are not formatted, unless they are compiled out (see `NEON_MIN_LOG_LEVEL`). */
+static std::vector<BenchmarkResult> bench_parser
+(
+	const std::string& name,
+	const Corpus& corpus,
+	std::size_t round_count,
+	bool combined,
+	logging::LogLevel min_level = logging::LogLevel::WARNING
+)
+{
+	std::shared_ptr<logging::Logger> logger = create_logger(min_level);
+	std::vector<Round> rounds_a;
+	std::vector<Round> rounds_b;
+	std::vector<Round> rounds_combined;
+	uint64_t ast_nodes_a = 0;
+	uint64_t ast_nodes = 0;
+
+	for(std::size_t round = 0; round < round_count; ++round)
+	{
+		ParseState state{};
+		create_parsers(state, corpus, logger);
+
+		const RoundMeasurement measurement_a{};
+		for(Parser& parser : state.parsers) { parser.run_a(); }
+		rounds_a.push_back(measurement_a.stop());
+
+		ast_nodes_a = count_ast_nodes(*state.root_node);
+
+		const RoundMeasurement measurement_b{};
+		for(Parser& parser : state.parsers) { parser.run_b(state.operator_table); }
+		rounds_b.push_back(measurement_b.stop());
+
+		ast_nodes = count_ast_nodes(*state.root_node);
+
+		// Allocations of both phases; the peak may be underestimated, as each phase has its own
+		Round round_combined = rounds_b.back();
+		round_combined.wall_time += rounds_a.back().wall_time;
+		round_combined.allocations += rounds_a.back().allocations;
+		round_combined.allocated_bytes += rounds_a.back().allocated_bytes;
+		round_combined.peak_heap_bytes = std::max(round_combined.peak_heap_bytes, rounds_a.back().peak_heap_bytes);
+		rounds_combined.push_back(round_combined);
+	}
+
+	if(combined)
+	{
+		return std::vector<BenchmarkResult>{summarise(name, corpus, ast_nodes, rounds_combined)};
+	}
+
+	return std::vector<BenchmarkResult>
+	{
+		summarise(name + "_a", corpus, ast_nodes_a, rounds_a),
+		summarise(name + "_b", corpus, ast_nodes - ast_nodes_a, rounds_b)
+	};
+}
+
+static BenchmarkResult bench_analyse(const Corpus& corpus, uint64_t ast_nodes, std::size_t round_count)
+{
+	std::shared_ptr<logging::Logger> logger = create_logger();
+	std::vector<Round> rounds;
+
+	DiscardingStreamBuffer discarding_buffer{};
+	std::streambuf* const cout_buffer = std::cout.rdbuf(&discarding_buffer);
+
+	for(std::size_t round = 0; round < round_count; ++round)
+	{
+		std::vector<std::unique_ptr<std::istringstream>> streams;
+		for(const CorpusFile& file : corpus.files)
+		{
+			streams.push_back(std::make_unique<std::istringstream>(file.source));
+		}
+
+		Compiler compiler{logger};
+
+		const RoundMeasurement measurement{};
+
+		for(std::size_t i = 0; i < corpus.files.size(); ++i)
+		{
+			compiler.read_file(std::move(streams[i]), corpus.files[i].name);
+		}
+		compiler.generate_analysis();
+
+		rounds.push_back(measurement.stop());
+	}
+
+	std::cout.rdbuf(cout_buffer);
+
+	return summarise("analyse", corpus, ast_nodes, rounds);
+}
+
+static void print_results(const std::vector<BenchmarkResult>& results, const Baseline& current)
+{
+	constexpr int NAME_WIDTH = 14;
+	constexpr int COLUMN_WIDTH = 14;
+
+	std::cout << std::left << std::setw(NAME_WIDTH) << "benchmark" << std::right
+		<< std::setw(COLUMN_WIDTH) << "wall ms"
+		<< std::setw(COLUMN_WIDTH) << "MB/s"
+		<< std::setw(COLUMN_WIDTH) << "tokens/s"
+		<< std::setw(COLUMN_WIDTH) << "nodes/s"
+		<< std::setw(COLUMN_WIDTH) << "allocations"
+		<< std::setw(COLUMN_WIDTH) << "peak heap MiB" << "\n";
+
+	for(const BenchmarkResult& result : results)
+	{
+		const std::map<std::string, double>& metrics = current.at(result.name);
+		const std::map<std::string, double>::const_iterator nodes_it = metrics.find("nodes_per_s");
+
+		std::cout << std::fixed << std::setprecision(1)
+			<< std::left << std::setw(NAME_WIDTH) << result.name << std::right
+			<< std::setw(COLUMN_WIDTH) << metrics.at("wall_ms")
+			<< std::setw(COLUMN_WIDTH) << metrics.at("mb_per_s")
+			<< std::setw(COLUMN_WIDTH) << std::setprecision(0) << metrics.at("tokens_per_s")
+			<< std::setw(COLUMN_WIDTH) << (nodes_it == metrics.end() ? 0.0 : nodes_it->second)
+			<< std::setw(COLUMN_WIDTH) << result.allocations
+			<< std::setw(COLUMN_WIDTH) << std::setprecision(2) << static_cast<double>(result.peak_heap_bytes) / (1024.0 * 1024.0)
+			<< "\n";
+	}
+}
+
+static void print_usage(const char* program)
+{
+	std::cerr << "Usage: " << program
+		<< " [--baseline <file>] [--write-baseline <file>] [--tolerance <fraction, e.g. 0.15>] [--rounds <n>]\n";
+}
+
+int main(int argc, char** argv)
+{
+	const char* baseline_file{nullptr};
+	const char* write_baseline_file{nullptr};
+	double tolerance{DEFAULT_TOLERANCE};
+	std::size_t round_count{DEFAULT_ROUNDS};
+
+	for(int i = 1; i < argc; i += 2)
+	{
+		const std::string_view option{argv[i]};
+
+		if(i + 1 >= argc)
+		{
+			print_usage(argv[0]);
+			return 1;
+		}
+		else if(option == OPTION_BASELINE) { baseline_file = argv[i + 1]; }
+		else if(option == OPTION_WRITE_BASELINE) { write_baseline_file = argv[i + 1]; }
+		else if(option == OPTION_TOLERANCE) { tolerance = std::strtod(argv[i + 1], nullptr); }
+		else if(option == OPTION_ROUNDS) { round_count = std::max<std::size_t>(1, std::strtoull(argv[i + 1], nullptr, 10)); }
+		else
+		{
+			print_usage(argv[0]);
+			return 1;
+		}
+	}
+
+	const Corpus corpus = create_corpus(CorpusOptions{});
+
+	// Deeply nested expressions, mostly operator calls, to stress `ExpressionParser` and `OperatorTable`
+	CorpusOptions expression_options{};
+	expression_options.file_count = 20;
+	expression_options.operator_module_count = 3;
+	expression_options.members_per_file = 10;
+	expression_options.statements_per_member = 8;
+	expression_options.max_nesting_depth = 7;
+	expression_options.operator_density = 0.9;
+	const Corpus expression_corpus = create_corpus(expression_options);
+
+	std::cout << "corpus: " << corpus.files.size() << " files, " << corpus.bytes << " bytes, " << corpus.tokens << " tokens\n"
+		<< "expression corpus: " << expression_corpus.files.size() << " files, " << expression_corpus.bytes << " bytes, "
+		<< expression_corpus.tokens << " tokens\n"
+		<< "minimum log level compiled in: " << logging::log_level_to_string(logging::COMPILED_MIN_LOG_LEVEL) << "\n"
+		<< "rounds: " << round_count << "\n\n";
+
+	std::vector<BenchmarkResult> results;
+	results.push_back(bench_lexer(corpus, round_count));
+
+	for(BenchmarkResult& result : bench_parser("parse", corpus, round_count, false))
+	{
+		results.push_back(std::move(result));
+	}
+	const uint64_t ast_nodes = results[1].ast_nodes + results[2].ast_nodes;
+
+	results.push_back(bench_parser("expressions", expression_corpus, round_count, true).front());
+	// With every level enabled at runtime, so this only differs from `parse` by the debug and info messages compiled in
+	results.push_back(bench_parser("parse_logged", corpus, round_count, true, logging::LogLevel::DEBUG).front());
+	results.push_back(bench_analyse(corpus, ast_nodes, round_count));
+
+	const Baseline current = to_baseline(results);
+	print_results(results, current);
+
+	if(write_baseline_file != nullptr)
+	{
+		std::ofstream out{write_baseline_file};
+		write_baseline(out, current);
+		std::cout << "\nWrote baseline to " << write_baseline_file << "\n";
+	}
+
+	if(baseline_file == nullptr) { return 0; }
+
+	std::ifstream in{baseline_file};
+	const std::optional<Baseline> baseline = read_baseline(in);
+	if(!baseline.has_value())
+	{
+		std::cerr << "Could not read baseline \"" << baseline_file << "\"\n";
+		return 1;
+	}
+
+	const std::vector<Regression> regressions = compare(baseline.value(), current, tolerance);
+
+	std::cout << "\nCompared with " << baseline_file << " (tolerance " << std::setprecision(0) << tolerance * 100 << "%): ";
+	if(regressions.empty())
+	{
+		std::cout << "no regressions\n";
+		return 0;
+	}
+
+	std::cout << regressions.size() << " regression(s)\n";
+	for(const Regression& regression : regressions)
+	{
+		std::cout << std::setprecision(3) << "  " << regression.benchmark << " " << regression.metric << ": "
+			<< regression.baseline << " -> " << regression.current << "\n";
+	}
+
+	return 1;
+}
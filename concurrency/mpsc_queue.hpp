@@ -0,0 +1,78 @@
+#ifndef MPSC_QUEUE_HPP
+#define MPSC_QUEUE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <optional>
+#include <utility>
+
+namespace concurrency
+{
+
+/** Assumed size of a cache line, to keep data written by different threads apart */
+constexpr std::size_t CACHE_LINE_SIZE = 64;
+
+/** Unbounded lock-free queue for many producers and one consumer (Vyukov's intrusive MPSC queue).
+ * Pushing is one allocation and one atomic exchange, and never waits for other threads. */
+template<typename T>
+class MpscQueue
+{
+public:
+	MpscQueue() : head{new Node{}}, tail{head.load(std::memory_order_relaxed)} {}
+
+	~MpscQueue()
+	{
+		while(pop().has_value()) {}
+		delete tail;
+	}
+
+	MpscQueue(const MpscQueue&) = delete;
+	MpscQueue& operator=(const MpscQueue&) = delete;
+
+	/** May be called from any thread */
+	void push(T value)
+	{
+		Node* node = new Node{};
+		node->value.emplace(std::move(value));
+
+		Node* previous = head.exchange(node, std::memory_order_acq_rel);
+		previous->next.store(node, std::memory_order_release);
+	}
+
+	/** May only be called from the consumer thread. Empty if the queue is empty, but also while the next value
+	 * is being pushed; values pushed after it by other threads are only available once that push completes. */
+	std::optional<T> pop()
+	{
+		Node* next = tail->next.load(std::memory_order_acquire);
+
+		if(!next)
+		{
+			return std::nullopt;
+		}
+
+		std::optional<T> value{std::move(next->value)};
+		next->value.reset();
+
+		delete tail;
+		tail = next;
+
+		return value;
+	}
+
+private:
+	struct Node
+	{
+		std::atomic<Node*> next{nullptr};
+		/** Empty for the node `tail` points to */
+		std::optional<T> value;
+	};
+
+	/** Last pushed node, shared by the producers */
+	alignas(CACHE_LINE_SIZE) std::atomic<Node*> head;
+	/** Node before the next value, owned by the consumer */
+	alignas(CACHE_LINE_SIZE) Node* tail;
+};
+
+}
+
+#endif // MPSC_QUEUE_HPP
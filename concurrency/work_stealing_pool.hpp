@@ -0,0 +1,222 @@
+#ifndef WORK_STEALING_POOL_HPP
+#define WORK_STEALING_POOL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace concurrency
+{
+
+/** Number of threads to use by default: one per hardware thread */
+inline std::size_t get_default_thread_count()
+{
+	return std::max(1u, std::thread::hardware_concurrency());
+}
+
+/** Threads that run batches of indexed tasks, kept alive between batches.
+ * Every thread starts a batch with its own contiguous range of indices, taking them from the back of its queue.
+ * Once its queue is empty it steals from the front of the others, so uneven tasks are balanced
+ * without all threads contending on one shared counter. */
+class WorkStealingPool
+{
+public:
+	/** `init_thread_count` includes the thread calling `run` */
+	explicit WorkStealingPool(std::size_t init_thread_count)
+	{
+		const std::size_t thread_count = std::max<std::size_t>(init_thread_count, 1);
+
+		for(std::size_t i = 0; i < thread_count; ++i)
+		{
+			queues.push_back(std::make_unique<TaskQueue>());
+		}
+
+		for(std::size_t i = 1; i < thread_count; ++i)
+		{
+			threads.emplace_back([this, i] { run_worker(i); });
+		}
+	}
+
+	~WorkStealingPool()
+	{
+		{
+			const std::lock_guard<std::mutex> lock{mutex};
+			stopping = true;
+		}
+		batch_started.notify_all();
+
+		for(std::thread& thread : threads)
+		{
+			thread.join();
+		}
+	}
+
+	WorkStealingPool(const WorkStealingPool&) = delete;
+	WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+	std::size_t get_thread_count() const
+	{
+		return queues.size();
+	}
+
+	/** Calls `function(i)` for every `i` from 0 to `count` and returns when all calls have returned.
+	 * Must not be called from within `function`. If calls throw, the remaining tasks are skipped
+	 * and the first exception is rethrown. */
+	void run(std::size_t count, const std::function<void(std::size_t)>& function)
+	{
+		if(count == 0) { return; }
+
+		for(std::size_t q = 0; q < queues.size(); ++q)
+		{
+			const std::lock_guard<std::mutex> lock{queues[q]->mutex};
+
+			for(std::size_t i = count * q / queues.size(); i < count * (q + 1) / queues.size(); ++i)
+			{
+				queues[q]->tasks.push_back(i);
+			}
+		}
+
+		{
+			const std::lock_guard<std::mutex> lock{mutex};
+			current_function = &function;
+			cancelled = false;
+			busy_worker_count = threads.size();
+			++batch;
+		}
+		batch_started.notify_all();
+
+		work(0);
+
+		{
+			std::unique_lock<std::mutex> lock{mutex};
+			batch_finished.wait(lock, [this] { return busy_worker_count == 0; });
+			current_function = nullptr;
+		}
+
+		// Tasks skipped after an exception must not run in the next batch
+		for(const std::unique_ptr<TaskQueue>& queue : queues)
+		{
+			const std::lock_guard<std::mutex> lock{queue->mutex};
+			queue->tasks.clear();
+		}
+
+		if(exception)
+		{
+			std::exception_ptr thrown = exception;
+			exception = nullptr;
+			std::rethrow_exception(thrown);
+		}
+	}
+
+private:
+	struct TaskQueue
+	{
+		std::mutex mutex;
+		std::deque<std::size_t> tasks;
+	};
+
+	std::vector<std::unique_ptr<TaskQueue>> queues;
+	std::vector<std::thread> threads;
+
+	/** Guards the fields below, up to `exception` */
+	std::mutex mutex;
+	std::condition_variable batch_started;
+	std::condition_variable batch_finished;
+	const std::function<void(std::size_t)>* current_function{nullptr};
+	uint64_t batch{0};
+	std::size_t busy_worker_count{0};
+	bool stopping{false};
+
+	std::mutex exception_mutex;
+	std::exception_ptr exception{};
+	std::atomic<bool> cancelled{false};
+
+	void run_worker(std::size_t queue_index)
+	{
+		uint64_t last_batch{0};
+
+		while(true)
+		{
+			{
+				std::unique_lock<std::mutex> lock{mutex};
+				batch_started.wait(lock, [this, last_batch] { return stopping || batch != last_batch; });
+
+				if(stopping) { return; }
+
+				last_batch = batch;
+			}
+
+			work(queue_index);
+
+			{
+				const std::lock_guard<std::mutex> lock{mutex};
+				--busy_worker_count;
+			}
+			batch_finished.notify_one();
+		}
+	}
+
+	void work(std::size_t queue_index)
+	{
+		for(std::optional<std::size_t> task = take(queue_index); task.has_value(); task = take(queue_index))
+		{
+			try
+			{
+				(*current_function)(task.value());
+			}
+			catch(...)
+			{
+				const std::lock_guard<std::mutex> lock{exception_mutex};
+				if(!exception) { exception = std::current_exception(); }
+				cancelled = true;
+			}
+		}
+	}
+
+	/** Takes the last task of the own queue, or else the first one of another queue */
+	std::optional<std::size_t> take(std::size_t queue_index)
+	{
+		if(cancelled) { return std::nullopt; }
+
+		{
+			TaskQueue& queue = *queues[queue_index];
+			const std::lock_guard<std::mutex> lock{queue.mutex};
+
+			if(!queue.tasks.empty())
+			{
+				const std::size_t task = queue.tasks.back();
+				queue.tasks.pop_back();
+				return task;
+			}
+		}
+
+		for(std::size_t offset = 1; offset < queues.size(); ++offset)
+		{
+			TaskQueue& queue = *queues[(queue_index + offset) % queues.size()];
+			const std::lock_guard<std::mutex> lock{queue.mutex};
+
+			if(!queue.tasks.empty())
+			{
+				const std::size_t task = queue.tasks.front();
+				queue.tasks.pop_front();
+				return task;
+			}
+		}
+
+		return std::nullopt;
+	}
+};
+
+}
+
+#endif // WORK_STEALING_POOL_HPP
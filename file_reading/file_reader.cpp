@@ -18,8 +18,7 @@ bool FileReader::open_file(const char* file_name)
 
     if (!input_stream->is_open())
     {
-        logger->error("Failed to open file: " + string(file_name) +
-                      " - " + std::strerror(errno));
+        logger->error("Failed to open file: ", file_name, " - ", std::strerror(errno));
         return false;
     }
 
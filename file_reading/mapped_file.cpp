@@ -0,0 +1,60 @@
+#include "mapped_file.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace file_reading;
+
+MappedFile::~MappedFile()
+{
+	if(data)
+	{
+		munmap(data, size);
+	}
+}
+
+bool MappedFile::open_file(const std::string& file_name)
+{
+	const int fd = open(file_name.c_str(), O_RDONLY);
+
+	if(fd < 0)
+	{
+		return false;
+	}
+
+	struct stat file_stat;
+
+	if(fstat(fd, &file_stat) != 0 || file_stat.st_size <= 0)
+	{
+		close(fd);
+		return false;
+	}
+
+	const std::size_t file_size = static_cast<std::size_t>(file_stat.st_size);
+	void* mapping = mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+	// The mapping keeps its own reference to the file
+	close(fd);
+
+	if(mapping == MAP_FAILED)
+	{
+		return false;
+	}
+
+	if(data)
+	{
+		munmap(data, size);
+	}
+
+	data = mapping;
+	size = file_size;
+
+	return true;
+}
+
+std::string_view MappedFile::get_contents() const
+{
+	return std::string_view{static_cast<const char*>(data), size};
+}
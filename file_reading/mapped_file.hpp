@@ -0,0 +1,30 @@
+#ifndef MAPPED_FILE_HPP
+#define MAPPED_FILE_HPP
+
+#include <string>
+#include <string_view>
+
+namespace file_reading
+{
+
+/** A read-only memory mapping of a whole file. The contents stay valid until the object is destroyed. */
+class MappedFile
+{
+public:
+	MappedFile() = default;
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+	~MappedFile();
+
+	/** Maps `file_name`. Returns false if the file could not be opened or mapped. */
+	bool open_file(const std::string& file_name);
+	std::string_view get_contents() const;
+
+private:
+	void* data{nullptr};
+	std::size_t size{0};
+};
+
+}
+
+#endif // MAPPED_FILE_HPP
@@ -0,0 +1,162 @@
+#include "fuzz_targets.hpp"
+
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <vector>
+#include "../benchmarks/allocation_counter/allocation_counter.hpp"
+#include "../benchmarks/corpus_generator/corpus_generator.hpp"
+#include "../logging/logger.hpp"
+#include "../logging/log_sink.hpp"
+#include "../neon_compiler/token.hpp"
+#include "../neon_compiler/analysis/analysis_reporter.hpp"
+#include "../neon_compiler/ast/nodes/nodes.hpp"
+#include "../neon_compiler/lexer/lexer.hpp"
+#include "../neon_compiler/parser/parser.hpp"
+#include "../reading/char_reader.hpp"
+
+using namespace benchmarks::allocation_counter;
+using namespace benchmarks::corpus_generator;
+using namespace fuzz;
+using namespace neon_compiler;
+using namespace neon_compiler::analysis;
+using namespace neon_compiler::ast::nodes;
+using namespace neon_compiler::parser;
+
+namespace
+{
+	constexpr std::size_t OPERATOR_MODULE_COUNT = 2;
+
+	class IgnoringAnalysisReporter : public AnalysisReporter
+	{
+	public:
+		void report(const AnalysisEntry&) override {}
+	};
+
+	class DiscardingLogSink : public logging::LogSink
+	{
+	public:
+		void write(logging::LogLevel, std::string) override {}
+		void flush() override {}
+	};
+
+	/** Measures wall time and peak heap memory of the calling thread from construction until `stop` */
+	class RunMeasurement
+	{
+	public:
+		RunResult stop() const
+		{
+			const std::chrono::steady_clock::time_point wall_end = std::chrono::steady_clock::now();
+
+			return RunResult
+			{
+				std::chrono::duration_cast<std::chrono::nanoseconds>(wall_end - wall_start),
+				static_cast<uint64_t>(std::max<int64_t>(0, allocation_scope.get_counts().peak_live_bytes))
+			};
+		}
+	private:
+		AllocationScope allocation_scope{};
+		std::chrono::steady_clock::time_point wall_start{std::chrono::steady_clock::now()};
+	};
+
+	std::vector<Token> lex(std::string_view input)
+	{
+		lexer::Lexer lexer{std::make_unique<reading::CharReader>(std::make_unique<std::istringstream>(std::string{input}))};
+		lexer.run();
+		return lexer.take_tokens();
+	}
+
+	const std::vector<std::vector<Token>>& get_operator_module_tokens()
+	{
+		static const std::vector<std::vector<Token>> operator_module_tokens = []
+		{
+			CorpusOptions options{};
+			options.file_count = 0;
+			options.operator_module_count = OPERATOR_MODULE_COUNT;
+
+			std::vector<std::vector<Token>> file_tokens;
+			for(const CorpusFile& file : CorpusGenerator{options}.generate())
+			{
+				file_tokens.push_back(lex(file.source));
+			}
+			return file_tokens;
+		}();
+
+		return operator_module_tokens;
+	}
+}
+
+RunResult fuzz::run_lexer(std::string_view input)
+{
+	std::unique_ptr<std::istringstream> stream = std::make_unique<std::istringstream>(std::string{input});
+
+	const RunMeasurement measurement{};
+
+	lexer::Lexer lexer{std::make_unique<reading::CharReader>(std::move(stream))};
+	lexer.run();
+
+	return measurement.stop();
+}
+
+RunResult fuzz::run_parser(std::string_view input)
+{
+	std::shared_ptr<logging::Logger> logger = std::make_shared<logging::Logger>(std::make_shared<DiscardingLogSink>(), logging::LogLevel::DEBUG);
+	std::shared_ptr<AnalysisReporter> reporter = std::make_shared<IgnoringAnalysisReporter>();
+	std::shared_ptr<Root> root_node = std::make_shared<Root>();
+	std::shared_ptr<OperatorMap> operator_map = std::make_shared<OperatorMap>();
+	std::shared_ptr<OperatorTable> operator_table = std::make_shared<OperatorTable>();
+
+	std::vector<Parser> operator_module_parsers;
+	for(const std::vector<Token>& tokens : get_operator_module_tokens())
+	{
+		operator_module_parsers.emplace_back(logger, tokens, reporter, root_node, "operators.neon", operator_map);
+	}
+	for(Parser& parser : operator_module_parsers) { parser.run_a(); }
+	for(Parser& parser : operator_module_parsers) { parser.run_b(operator_table); }
+
+	std::unique_ptr<std::istringstream> stream = std::make_unique<std::istringstream>(std::string{input});
+
+	const RunMeasurement measurement{};
+
+	lexer::Lexer lexer{std::make_unique<reading::CharReader>(std::move(stream))};
+	lexer.run();
+	const std::vector<Token> tokens = lexer.take_tokens();
+
+	Parser parser{logger, tokens, reporter, root_node, "fuzz.neon", operator_map};
+	parser.run_a();
+	parser.run_b(operator_table);
+
+	return measurement.stop();
+}
+
+std::optional<std::string> fuzz::check_budget(const RunResult& result, std::size_t input_size, const Budget& budget)
+{
+	const std::chrono::nanoseconds time_limit = budget.base_time + budget.time_per_byte * input_size;
+	const uint64_t heap_limit = budget.base_heap_bytes + budget.heap_bytes_per_byte * input_size;
+
+	if(result.wall_time > time_limit)
+	{
+		return "took " + std::to_string(result.wall_time.count() / 1'000'000) + " ms for " + std::to_string(input_size)
+			+ " bytes, over the budget of " + std::to_string(time_limit.count() / 1'000'000) + " ms";
+	}
+
+	if(result.peak_heap_bytes > heap_limit)
+	{
+		return "used " + std::to_string(result.peak_heap_bytes) + " bytes of heap for " + std::to_string(input_size)
+			+ " bytes, over the budget of " + std::to_string(heap_limit) + " bytes";
+	}
+
+	return std::nullopt;
+}
+
+void fuzz::abort_if_over_budget(std::string_view target, const RunResult& result, std::size_t input_size)
+{
+	const std::optional<std::string> exceeded = check_budget(result, input_size);
+
+	if(exceeded.has_value())
+	{
+		std::cerr << "Fuzz target \"" << target << "\" " << exceeded.value() << "\n";
+		std::abort();
+	}
+}
@@ -0,0 +1,44 @@
+#ifndef FUZZ_TARGETS_HPP
+#define FUZZ_TARGETS_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace fuzz
+{
+
+/** Time and heap memory one input may take, growing linearly with its size. Generous enough for sanitizer builds,
+ * so only inputs taking super-linear time or memory exceed it. */
+struct Budget
+{
+	std::chrono::milliseconds base_time{100};
+	std::chrono::microseconds time_per_byte{20};
+	uint64_t base_heap_bytes{32 * 1024 * 1024};
+	uint64_t heap_bytes_per_byte{4 * 1024};
+};
+
+struct RunResult
+{
+	std::chrono::nanoseconds wall_time{0};
+	/** Highest amount of heap memory in use during the run */
+	uint64_t peak_heap_bytes{0};
+};
+
+/** Lexes `input` */
+RunResult run_lexer(std::string_view input);
+/** Lexes and parses `input` as a file, after operator modules `gen::ops::ops0` and `gen::ops::ops1`
+ * from the corpus generator, which `input` may import and use. */
+RunResult run_parser(std::string_view input);
+
+/** Empty if the run stayed within the budget for an input of `input_size` bytes, else what it exceeded */
+std::optional<std::string> check_budget(const RunResult& result, std::size_t input_size, const Budget& budget = Budget{});
+/** Prints what was exceeded and aborts, for the fuzzer to report the input, if the run exceeded the budget */
+void abort_if_over_budget(std::string_view target, const RunResult& result, std::size_t input_size);
+
+}
+
+#endif // FUZZ_TARGETS_HPP
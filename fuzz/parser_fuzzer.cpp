@@ -0,0 +1,15 @@
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include "fuzz_targets.hpp"
+
+// libFuzzer entry point, see the Makefile for building it
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, std::size_t size)
+{
+	const std::string_view input{reinterpret_cast<const char*>(data), size};
+
+	fuzz::abort_if_over_budget("parser", fuzz::run_parser(input), size);
+
+	return 0;
+}
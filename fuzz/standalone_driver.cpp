@@ -0,0 +1,57 @@
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+// Runs files through a fuzz target without libFuzzer, e.g. the regression cases: `./build-fuzz-parser fuzz/regressions`
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, std::size_t size);
+
+static void run_file(const std::filesystem::path& path)
+{
+	std::ifstream stream{path, std::ios::binary};
+	const std::string input{std::istreambuf_iterator<char>{stream}, std::istreambuf_iterator<char>{}};
+
+	const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	LLVMFuzzerTestOneInput(reinterpret_cast<const uint8_t*>(input.data()), input.size());
+	const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+	std::cout << path.string() << ": " << input.size() << " bytes, " << elapsed.count() << " ms\n";
+}
+
+int main(int argc, char** argv)
+{
+	if(argc < 2)
+	{
+		std::cerr << "Usage: " << argv[0] << " <file or directory>...\n";
+		return 1;
+	}
+
+	for(int i = 1; i < argc; ++i)
+	{
+		const std::filesystem::path path{argv[i]};
+
+		if(!std::filesystem::is_directory(path))
+		{
+			run_file(path);
+			continue;
+		}
+
+		std::vector<std::filesystem::path> files;
+		for(const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator{path})
+		{
+			if(entry.is_regular_file()) { files.push_back(entry.path()); }
+		}
+		std::sort(files.begin(), files.end());
+
+		for(const std::filesystem::path& file : files) { run_file(file); }
+	}
+
+	return 0;
+}
@@ -0,0 +1,90 @@
+#include "async_log_sink.hpp"
+
+using namespace logging;
+using namespace logging::impl;
+
+AsyncLogSink::AsyncLogSink(std::shared_ptr<LogSink> init_target)
+	: target{std::move(init_target)}, thread{&AsyncLogSink::run, this} {}
+
+AsyncLogSink::~AsyncLogSink()
+{
+	stopping.store(true, std::memory_order_release);
+	wake_ups.fetch_add(1, std::memory_order_release);
+	wake_ups.notify_one();
+
+	thread.join();
+}
+
+void AsyncLogSink::write(LogLevel level, std::string message)
+{
+	queue.push(Message{level, std::move(message)});
+
+	// Sequentially consistent with `run`, which sets `sleeping` before comparing the counts:
+	// either it sees this message, or this sees it sleeping
+	pushed_count.fetch_add(1, std::memory_order_seq_cst);
+
+	if(sleeping.load(std::memory_order_seq_cst))
+	{
+		wake_ups.fetch_add(1, std::memory_order_release);
+		wake_ups.notify_one();
+	}
+}
+
+void AsyncLogSink::flush()
+{
+	const uint64_t pushed = pushed_count.load(std::memory_order_acquire);
+	uint64_t written = written_count.load(std::memory_order_acquire);
+
+	while(written < pushed)
+	{
+		written_count.wait(written, std::memory_order_acquire);
+		written = written_count.load(std::memory_order_acquire);
+	}
+}
+
+void AsyncLogSink::run()
+{
+	while(true)
+	{
+		const uint64_t written = drain();
+
+		if(written > 0)
+		{
+			target->flush();
+			written_count.fetch_add(written, std::memory_order_release);
+			written_count.notify_all();
+		}
+
+		// Loaded before announcing sleep, so a wake-up after the check below changes it and the wait returns
+		const uint32_t wake_up = wake_ups.load(std::memory_order_acquire);
+		sleeping.store(true, std::memory_order_seq_cst);
+
+		const bool idle =
+			written_count.load(std::memory_order_seq_cst) == pushed_count.load(std::memory_order_seq_cst);
+
+		if(idle && stopping.load(std::memory_order_acquire))
+		{
+			return;
+		}
+
+		if(idle)
+		{
+			wake_ups.wait(wake_up, std::memory_order_acquire);
+		}
+
+		sleeping.store(false, std::memory_order_relaxed);
+	}
+}
+
+uint64_t AsyncLogSink::drain()
+{
+	uint64_t written = 0;
+
+	for(std::optional<Message> message = queue.pop(); message.has_value(); message = queue.pop())
+	{
+		target->write(message->level, std::move(message->message));
+		++written;
+	}
+
+	return written;
+}
@@ -0,0 +1,55 @@
+#ifndef ASYNC_LOG_SINK_HPP
+#define ASYNC_LOG_SINK_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include "../log_sink.hpp"
+#include "../../concurrency/mpsc_queue.hpp"
+
+namespace logging::impl
+{
+
+/** Hands messages to a background thread, which writes them to another sink, so writing never waits for I/O or a lock.
+ * Messages written by one thread keep their order. The destructor writes the remaining messages. */
+class AsyncLogSink : public logging::LogSink
+{
+public:
+	explicit AsyncLogSink(std::shared_ptr<logging::LogSink> init_target);
+	~AsyncLogSink() override;
+
+	AsyncLogSink(const AsyncLogSink&) = delete;
+	AsyncLogSink& operator=(const AsyncLogSink&) = delete;
+
+	void write(LogLevel level, std::string message) override;
+	/** Waits for the background thread to write and flush the messages written before */
+	void flush() override;
+private:
+	struct Message
+	{
+		LogLevel level;
+		std::string message;
+	};
+
+	std::shared_ptr<logging::LogSink> target;
+	concurrency::MpscQueue<Message> queue;
+	/** Number of messages pushed to the queue */
+	std::atomic<uint64_t> pushed_count{0};
+	/** Number of messages written to `target` and flushed */
+	std::atomic<uint64_t> written_count{0};
+	/** Changed to wake the background thread up while it is `sleeping`, and on stopping */
+	std::atomic<uint32_t> wake_ups{0};
+	/** Set by the background thread before it checks for messages and waits, so writing only notifies it when needed */
+	std::atomic<bool> sleeping{false};
+	std::atomic<bool> stopping{false};
+	std::thread thread;
+
+	void run();
+	/** Writes what is in the queue to `target`. Returns the number of messages written. */
+	uint64_t drain();
+};
+
+}
+
+#endif // ASYNC_LOG_SINK_HPP
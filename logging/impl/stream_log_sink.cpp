@@ -0,0 +1,48 @@
+#include "stream_log_sink.hpp"
+
+#include <string_view>
+
+using namespace logging;
+using namespace logging::impl;
+
+namespace
+{
+	constexpr std::string_view PREFIX_LOG = "[Log] ";
+
+	std::string_view get_level_label(LogLevel level)
+	{
+		switch(level)
+		{
+			case LogLevel::ERROR:   { return "\x1B[31mError\033[0m "; }
+			case LogLevel::WARNING: { return "\x1B[33mWarning\033[0m "; }
+			case LogLevel::INFO:    { return "\x1B[32mInfo\033[0m "; }
+			case LogLevel::DEBUG:   { return "\x1B[35mDebug\033[0m "; }
+			default: { return ""; }
+		}
+	}
+}
+
+StreamLogSink::StreamLogSink(std::ostream& init_out)
+	: out{init_out} {}
+
+void StreamLogSink::write(LogLevel level, std::string message)
+{
+	const std::string_view label = get_level_label(level);
+
+	// One write per line, as `std::cerr` flushes after every write
+	std::string line{};
+	line.reserve(PREFIX_LOG.size() + label.size() + message.size() + 1);
+	line += PREFIX_LOG;
+	line += label;
+	line += message;
+	line += '\n';
+
+	const std::lock_guard<std::mutex> lock{out_mutex};
+	out.write(line.data(), static_cast<std::streamsize>(line.size()));
+}
+
+void StreamLogSink::flush()
+{
+	const std::lock_guard<std::mutex> lock{out_mutex};
+	out.flush();
+}
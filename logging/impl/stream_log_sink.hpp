@@ -0,0 +1,27 @@
+#ifndef STREAM_LOG_SINK_HPP
+#define STREAM_LOG_SINK_HPP
+
+#include <mutex>
+#include <ostream>
+#include "../log_sink.hpp"
+
+namespace logging::impl
+{
+
+/** Writes each message as one line, with a coloured level, to a stream */
+class StreamLogSink : public logging::LogSink
+{
+public:
+	explicit StreamLogSink(std::ostream& init_out);
+
+	void write(LogLevel level, std::string message) override;
+	void flush() override;
+private:
+	std::ostream& out;
+	/** Keeps lines written from different threads apart */
+	std::mutex out_mutex;
+};
+
+}
+
+#endif // STREAM_LOG_SINK_HPP
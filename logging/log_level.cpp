@@ -0,0 +1,25 @@
+#include "log_level.hpp"
+
+using namespace logging;
+
+std::string_view logging::log_level_to_string(LogLevel level)
+{
+	switch(level)
+	{
+		case LogLevel::DEBUG:   { return "debug"; }
+		case LogLevel::INFO:    { return "info"; }
+		case LogLevel::WARNING: { return "warning"; }
+		case LogLevel::ERROR:   { return "error"; }
+		default: { return "unknown"; }
+	}
+}
+
+std::optional<LogLevel> logging::parse_log_level(std::string_view str)
+{
+	     if(str == "debug")   { return LogLevel::DEBUG; }
+	else if(str == "info")    { return LogLevel::INFO; }
+	else if(str == "warning") { return LogLevel::WARNING; }
+	else if(str == "error")   { return LogLevel::ERROR; }
+
+	return std::nullopt;
+}
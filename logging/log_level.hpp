@@ -0,0 +1,36 @@
+#ifndef LOG_LEVEL_HPP
+#define LOG_LEVEL_HPP
+
+#include <optional>
+#include <string_view>
+
+/** Minimum level of messages compiled in, as the index of a `LogLevel`, e.g. `-DNEON_MIN_LOG_LEVEL=2` for warnings and errors.
+ * Logging calls below it compile to nothing, regardless of the minimum level set at runtime. */
+#ifndef NEON_MIN_LOG_LEVEL
+#define NEON_MIN_LOG_LEVEL 0
+#endif
+
+namespace logging
+{
+
+/** Ordered from least to most severe */
+enum class LogLevel
+{
+	DEBUG,
+	INFO,
+	WARNING,
+	ERROR
+};
+
+/** See `NEON_MIN_LOG_LEVEL` */
+constexpr LogLevel COMPILED_MIN_LOG_LEVEL = static_cast<LogLevel>(NEON_MIN_LOG_LEVEL);
+
+static_assert(COMPILED_MIN_LOG_LEVEL >= LogLevel::DEBUG && COMPILED_MIN_LOG_LEVEL <= LogLevel::ERROR, "Invalid NEON_MIN_LOG_LEVEL");
+
+std::string_view log_level_to_string(LogLevel level);
+/** Inverse of `log_level_to_string`, e.g. "warning" */
+std::optional<LogLevel> parse_log_level(std::string_view str);
+
+}
+
+#endif // LOG_LEVEL_HPP
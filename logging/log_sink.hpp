@@ -0,0 +1,22 @@
+#ifndef LOG_SINK_HPP
+#define LOG_SINK_HPP
+
+#include <string>
+#include "log_level.hpp"
+
+namespace logging
+{
+
+/** Destination of formatted log messages. May be written to from several threads at once. */
+class LogSink
+{
+public:
+	virtual ~LogSink() = default;
+	virtual void write(LogLevel level, std::string message) = 0;
+	/** Returns once everything written before is visible at the destination */
+	virtual void flush() = 0;
+};
+
+}
+
+#endif // LOG_SINK_HPP
@@ -1,30 +1,22 @@
 #include "logger.hpp"
 
 #include <iostream>
-#include <string>
+#include "impl/stream_log_sink.hpp"
 
 using namespace logging;
 
-Logger::Logger() {}
+Logger::Logger()
+	: Logger{std::make_shared<impl::StreamLogSink>(std::cerr), LogLevel::DEBUG} {}
 
-constexpr const char* PREFIX_LOG = "[Log] ";
+Logger::Logger(std::shared_ptr<LogSink> init_sink, LogLevel init_min_level)
+	: sink{std::move(init_sink)}, min_level{init_min_level} {}
 
-void Logger::error(const std::string& message) const
+void Logger::set_min_level(LogLevel new_min_level)
 {
-	std::cerr << PREFIX_LOG << "\x1B[31mError\033[0m " << message << std::endl;
+	min_level.store(new_min_level, std::memory_order_relaxed);
 }
 
-void Logger::warning(const std::string& message) const
+void Logger::flush() const
 {
-	std::cerr << PREFIX_LOG << "\x1B[33mWarning\033[0m " << message << std::endl;
+	sink->flush();
 }
-
-void Logger::info(const std::string& message) const
-{
-	std::cerr << PREFIX_LOG << "\x1B[32mInfo\033[0m " << message << std::endl;
-}
-
-void Logger::debug(const std::string& message) const
-{
-	std::cerr << PREFIX_LOG << "\x1B[35mDebug\033[0m " << message << std::endl;
-}
\ No newline at end of file
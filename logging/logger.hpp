@@ -1,22 +1,62 @@
 #ifndef LOGGER_HPP
 #define LOGGER_HPP
 
+#include <atomic>
+#include <memory>
+#include <sstream>
 #include <string>
+#include "log_level.hpp"
+#include "log_sink.hpp"
 
 namespace logging
 {
 
+/** Messages are given as arguments, which are only formatted (with `operator<<`) if their level is enabled,
+ * e.g. `logger->debug("Appended to AST: ", identifier)`. */
 class Logger
 {
 public:
+	/** Writes messages of all levels to `std::cerr`, on the calling thread */
 	explicit Logger();
+	explicit Logger(std::shared_ptr<LogSink> init_sink, LogLevel init_min_level);
 
-	void error(const std::string& message) const;
-	void warning(const std::string& message) const;
-	void info(const std::string& message) const;
-	void debug(const std::string& message) const;
+	void set_min_level(LogLevel new_min_level);
+	/** Whether messages of `level` are written. Check before building a message in another way. */
+	bool is_enabled(LogLevel level) const
+	{
+		return level >= COMPILED_MIN_LOG_LEVEL && level >= min_level.load(std::memory_order_relaxed);
+	}
+	/** Returns once all messages logged before are written */
+	void flush() const;
+
+	/** Does nothing if `level` is below `COMPILED_MIN_LOG_LEVEL`. Arguments are still evaluated, so pass what
+	 * the message is made of rather than building it. */
+	template<LogLevel level, typename... Args>
+	void log(const Args&... args) const
+	{
+		if constexpr(level >= COMPILED_MIN_LOG_LEVEL)
+		{
+			if(!is_enabled(level)) { return; }
+
+			std::ostringstream stream{};
+			(stream << ... << args);
+			sink->write(level, std::move(stream).str());
+		}
+	}
+
+	template<typename... Args>
+	void error(const Args&... args) const { log<LogLevel::ERROR>(args...); }
+	template<typename... Args>
+	void warning(const Args&... args) const { log<LogLevel::WARNING>(args...); }
+	template<typename... Args>
+	void info(const Args&... args) const { log<LogLevel::INFO>(args...); }
+	template<typename... Args>
+	void debug(const Args&... args) const { log<LogLevel::DEBUG>(args...); }
+private:
+	std::shared_ptr<LogSink> sink;
+	std::atomic<LogLevel> min_level;
 };
 
 }
 
-#endif // LOGGER_HPP
\ No newline at end of file
+#endif // LOGGER_HPP
@@ -1,47 +1,154 @@
+#include <charconv>
+#include <fstream>
+#include <iostream>
 #include <memory>
+#include <optional>
 #include <vector>
 #include <string_view>
 #include <functional>
 
 #include "logging/logger.hpp"
+#include "logging/impl/async_log_sink.hpp"
+#include "logging/impl/stream_log_sink.hpp"
 #include "file_reading/file_reader.hpp"
 #include "neon_compiler/compiler.hpp"
+#include "neon_compiler/stats/operator_profiler.hpp"
+#include "neon_compiler/trace/trace.hpp"
 
 constexpr const char* TASK_BUILD = "build";
 constexpr const char* TASK_ANALYSE = "analyse";
 
+constexpr std::string_view OPTION_TOKEN_CACHE = "--token-cache";
+constexpr std::string_view OPTION_AST_CACHE = "--ast-cache";
+constexpr std::string_view OPTION_STATS = "--stats";
+constexpr std::string_view OPTION_TRACE = "--trace";
+constexpr std::string_view OPTION_OPERATOR_PROFILE = "--operator-profile";
+constexpr std::string_view OPTION_LOG_LEVEL = "--log-level";
+constexpr std::string_view OPTION_THREADS = "--threads";
+constexpr std::string_view OPTION_VERIFY_THREAD_LOCAL = "--verify-thread-local";
+constexpr std::string_view OPTION_VERIFY_IR = "--verify-ir";
+constexpr std::string_view OPTION_OUTPUT = "--output";
+constexpr std::string_view OPTION_ENTRYPOINT = "--entrypoint";
+
+constexpr std::string_view STATS_FORMAT_TABLE = "table";
+constexpr std::string_view STATS_FORMAT_JSON = "json";
+
+constexpr std::size_t OPERATOR_PROFILE_MAX_ENTRIES = 20;
+
+/** A positive number of threads, e.g. `4` */
+static std::optional<std::size_t> parse_thread_count(std::string_view str)
+{
+    std::size_t thread_count{0};
+    const std::from_chars_result result = std::from_chars(str.data(), str.data() + str.size(), thread_count);
+
+    if (result.ec != std::errc{} || result.ptr != str.data() + str.size() || thread_count == 0)
+    {
+        return std::nullopt;
+    }
+
+    return thread_count;
+}
+
 int main(int argc, char** argv)
 {
-    std::shared_ptr<logging::Logger> logger = std::make_shared<logging::Logger>();
+    std::shared_ptr<logging::Logger> logger = std::make_shared<logging::Logger>
+    (
+        std::make_shared<logging::impl::AsyncLogSink>(std::make_shared<logging::impl::StreamLogSink>(std::cerr)),
+        logging::LogLevel::DEBUG
+    );
 
     if (argc < 3)
     {
-        logger->error("Usage: " + std::string(argv[0]) + " <build|analyse> <source file(s)>\n");
+        logger->error("Usage: ", argv[0], " <build|analyse> [--token-cache <directory>] [--ast-cache <directory>] [--stats <table|json>] [--trace <file>] [--operator-profile] [--log-level <debug|info|warning|error>] [--threads <count>] [--verify-thread-local] [--verify-ir] [--output <directory>] [--entrypoint <identifier>] <source file(s)>\n");
         return 1;
     }
 
     neon_compiler::Compiler compiler{logger};
 
+    std::string_view stats_format{};
+    const char* trace_file{nullptr};
+    bool operator_profile{false};
+
+    int i = 2;
+    for (; i < argc && std::string_view{argv[i]}.starts_with("--"); ++i)
+    {
+        const std::string_view option{argv[i]};
+
+        if (option == OPTION_TOKEN_CACHE && i + 1 < argc)
+        {
+            compiler.enable_token_cache(argv[++i]);
+        }
+        else if (option == OPTION_AST_CACHE && i + 1 < argc)
+        {
+            compiler.enable_ast_cache(argv[++i]);
+        }
+        else if (option == OPTION_STATS && i + 1 < argc &&
+            (argv[i + 1] == STATS_FORMAT_TABLE || argv[i + 1] == STATS_FORMAT_JSON))
+        {
+            stats_format = argv[++i];
+            compiler.enable_stats();
+        }
+        else if (option == OPTION_TRACE && i + 1 < argc)
+        {
+            trace_file = argv[++i];
+            neon_compiler::trace::enable();
+        }
+        else if (option == OPTION_LOG_LEVEL && i + 1 < argc && logging::parse_log_level(argv[i + 1]).has_value())
+        {
+            logger->set_min_level(logging::parse_log_level(argv[++i]).value());
+        }
+        else if (option == OPTION_THREADS && i + 1 < argc && parse_thread_count(argv[i + 1]).has_value())
+        {
+            compiler.set_thread_count(parse_thread_count(argv[++i]).value());
+        }
+        else if (option == OPTION_VERIFY_THREAD_LOCAL)
+        {
+            compiler.enable_thread_local_verification();
+        }
+        else if (option == OPTION_VERIFY_IR)
+        {
+            compiler.enable_ir_verification();
+        }
+        else if (option == OPTION_OUTPUT && i + 1 < argc)
+        {
+            compiler.set_build_directory(argv[++i]);
+        }
+        else if (option == OPTION_ENTRYPOINT && i + 1 < argc)
+        {
+            compiler.set_build_entrypoint(argv[++i]);
+        }
+        else if (option == OPTION_OPERATOR_PROFILE)
+        {
+            operator_profile = true;
+            neon_compiler::stats::operator_profiler::enable();
+        }
+        else
+        {
+            logger->error("Invalid option: ", option);
+            return 1;
+        }
+    }
+
     const std::string_view task{argv[1]};
 
-    std::function<void(void)> task_runnable;
+    std::function<bool(void)> task_runnable;
     if(task == TASK_BUILD)
     {
-        task_runnable = std::bind(&neon_compiler::Compiler::build, &compiler);
+        task_runnable = [&compiler] { return compiler.build(); };
         logger->info("Building...");
     }
     else if(task == TASK_ANALYSE)
     {
-        task_runnable = std::bind(&neon_compiler::Compiler::generate_analysis, &compiler);
+        task_runnable = [&compiler] { compiler.generate_analysis(); return true; };
         logger->info("Analysing...");
     }
     else
     {
-        logger->error("No such task: " + std::string(task));
+        logger->error("No such task: ", task);
         return 1;
     }
 
-    for (int i = 2; i < argc; ++i)
+    for (; i < argc; ++i)
     {
         const char* file_name = argv[i];
 
@@ -55,7 +162,36 @@ int main(int argc, char** argv)
         compiler.read_file(file_reader->move_stream(), std::string_view{file_name});
     }
 
-    task_runnable();
+    const bool succeeded = task_runnable();
+
+    // Keep the log apart from the reports below
+    logger->flush();
+
+    if (stats_format == STATS_FORMAT_TABLE)
+    {
+        compiler.get_stats()->print_table(std::cerr);
+    }
+    else if (stats_format == STATS_FORMAT_JSON)
+    {
+        compiler.get_stats()->print_json(std::cerr);
+    }
+
+    if (operator_profile)
+    {
+        neon_compiler::stats::operator_profiler::print_report(std::cerr, compiler.get_operator_profile(), OPERATOR_PROFILE_MAX_ENTRIES);
+    }
+
+    if (trace_file)
+    {
+        std::ofstream trace_out{trace_file};
+        neon_compiler::trace::write_chrome_trace(trace_out);
+
+        if (!trace_out)
+        {
+            logger->error("Could not write trace to ", trace_file);
+            return 1;
+        }
+    }
 
-    return 0;
+    return succeeded ? 0 : 1;
 }
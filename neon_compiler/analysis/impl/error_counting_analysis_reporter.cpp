@@ -0,0 +1,19 @@
+#include "error_counting_analysis_reporter.hpp"
+
+using namespace neon_compiler::analysis;
+using namespace neon_compiler::analysis::impl;
+
+ErrorCountingAnalysisReporter::ErrorCountingAnalysisReporter(std::shared_ptr<AnalysisReporter> init_next)
+	: next{init_next} {}
+
+void ErrorCountingAnalysisReporter::report(const AnalysisEntry& entry)
+{
+	next->report(entry);
+
+	if(entry.severity == AnalysisSeverity::ERROR) { ++error_count; }
+}
+
+std::size_t ErrorCountingAnalysisReporter::get_error_count() const
+{
+	return error_count;
+}
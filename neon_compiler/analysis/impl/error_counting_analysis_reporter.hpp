@@ -0,0 +1,26 @@
+#ifndef ERROR_COUNTING_ANALYSIS_REPORTER_HPP
+#define ERROR_COUNTING_ANALYSIS_REPORTER_HPP
+
+#include <cstddef>
+#include <memory>
+#include "../analysis_reporter.hpp"
+
+namespace neon_compiler::analysis::impl
+{
+
+/** Forwards entries to another reporter, while counting those with `AnalysisSeverity::ERROR`. */
+class ErrorCountingAnalysisReporter : public neon_compiler::analysis::AnalysisReporter
+{
+public:
+	explicit ErrorCountingAnalysisReporter(std::shared_ptr<neon_compiler::analysis::AnalysisReporter> init_next);
+	void report(const AnalysisEntry& entry) override;
+
+	std::size_t get_error_count() const;
+private:
+	std::shared_ptr<neon_compiler::analysis::AnalysisReporter> next;
+	std::size_t error_count{0};
+};
+
+}
+
+#endif // ERROR_COUNTING_ANALYSIS_REPORTER_HPP
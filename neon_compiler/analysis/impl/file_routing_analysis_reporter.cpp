@@ -0,0 +1,26 @@
+#include "file_routing_analysis_reporter.hpp"
+
+#include <utility>
+
+using namespace neon_compiler::analysis;
+using namespace neon_compiler::analysis::impl;
+
+FileRoutingAnalysisReporter::FileRoutingAnalysisReporter(ReporterFactory init_create_reporter)
+	: create_reporter{std::move(init_create_reporter)} {}
+
+void FileRoutingAnalysisReporter::report(const AnalysisEntry& entry)
+{
+	std::unordered_map<std::string_view, std::shared_ptr<AnalysisReporter>>::iterator it = reporters.find(entry.file);
+
+	if(it == reporters.end())
+	{
+		it = reporters.emplace(entry.file, create_reporter(entry.file)).first;
+	}
+
+	it->second->report(entry);
+}
+
+void FileRoutingAnalysisReporter::add_file(std::string_view file, std::shared_ptr<AnalysisReporter> reporter)
+{
+	reporters[file] = std::move(reporter);
+}
@@ -0,0 +1,32 @@
+#ifndef FILE_ROUTING_ANALYSIS_REPORTER_HPP
+#define FILE_ROUTING_ANALYSIS_REPORTER_HPP
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include "../analysis_reporter.hpp"
+
+namespace neon_compiler::analysis::impl
+{
+
+/** Forwards each entry to the reporter of its file, so diagnostics of passes over the whole AST
+ * reach the same reporters as those of the parser. Reporters of files without one are created on their first entry. */
+class FileRoutingAnalysisReporter : public neon_compiler::analysis::AnalysisReporter
+{
+public:
+	using ReporterFactory = std::function<std::shared_ptr<neon_compiler::analysis::AnalysisReporter>(std::string_view file)>;
+
+	explicit FileRoutingAnalysisReporter(ReporterFactory init_create_reporter);
+	void report(const AnalysisEntry& entry) override;
+
+	void add_file(std::string_view file, std::shared_ptr<neon_compiler::analysis::AnalysisReporter> reporter);
+private:
+	ReporterFactory create_reporter;
+	std::unordered_map<std::string_view, std::shared_ptr<neon_compiler::analysis::AnalysisReporter>> reporters;
+};
+
+}
+
+#endif // FILE_ROUTING_ANALYSIS_REPORTER_HPP
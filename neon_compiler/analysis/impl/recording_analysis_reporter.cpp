@@ -0,0 +1,20 @@
+#include "recording_analysis_reporter.hpp"
+
+#include <utility>
+
+using namespace neon_compiler::analysis;
+using namespace neon_compiler::analysis::impl;
+
+RecordingAnalysisReporter::RecordingAnalysisReporter(std::shared_ptr<AnalysisReporter> init_next)
+	: next{init_next} {}
+
+void RecordingAnalysisReporter::report(const AnalysisEntry& entry)
+{
+	next->report(entry);
+	entries.push_back(entry);
+}
+
+std::vector<AnalysisEntry> RecordingAnalysisReporter::take_entries()
+{
+	return std::exchange(entries, std::vector<AnalysisEntry>{});
+}
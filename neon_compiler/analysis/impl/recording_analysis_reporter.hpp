@@ -0,0 +1,27 @@
+#ifndef RECORDING_ANALYSIS_REPORTER_HPP
+#define RECORDING_ANALYSIS_REPORTER_HPP
+
+#include <memory>
+#include <vector>
+#include "../analysis_reporter.hpp"
+
+namespace neon_compiler::analysis::impl
+{
+
+/** Forwards entries to another reporter, while keeping a copy, so they can be replayed without parsing again. */
+class RecordingAnalysisReporter : public neon_compiler::analysis::AnalysisReporter
+{
+public:
+	explicit RecordingAnalysisReporter(std::shared_ptr<neon_compiler::analysis::AnalysisReporter> init_next);
+	void report(const AnalysisEntry& entry) override;
+
+	/** Returns the entries reported since the last call. */
+	std::vector<AnalysisEntry> take_entries();
+private:
+	std::shared_ptr<neon_compiler::analysis::AnalysisReporter> next;
+	std::vector<AnalysisEntry> entries;
+};
+
+}
+
+#endif // RECORDING_ANALYSIS_REPORTER_HPP
@@ -0,0 +1,70 @@
+#include "reference_indexing_analysis_reporter.hpp"
+
+using namespace neon_compiler::analysis;
+using namespace neon_compiler::analysis::impl;
+using namespace neon_compiler::index;
+
+ReferenceIndexingAnalysisReporter::ReferenceIndexingAnalysisReporter
+(
+	std::shared_ptr<AnalysisReporter> init_next,
+	std::shared_ptr<ReferenceIndex> init_reference_index,
+	const std::string& init_file
+) :
+	next{init_next},
+	reference_index{init_reference_index},
+	file{init_file}
+{}
+
+void ReferenceIndexingAnalysisReporter::report(const AnalysisEntry& entry)
+{
+	next->report(entry);
+
+	// The info of errors at a reference (e.g. type errors) is their message, not a symbol
+	const bool is_symbol = (entry.type == AnalysisEntryType::DECLARATION || entry.type == AnalysisEntryType::REFERENCE)
+		&& entry.severity == AnalysisSeverity::INFO;
+
+	if(!is_symbol || !entry.info.has_value())
+	{
+		previous_collected = false;
+		return;
+	}
+
+	const bool declaration = entry.type == AnalysisEntryType::DECLARATION;
+
+	if(previous_collected)
+	{
+		std::pair<std::string, SymbolOccurrence>& previous = occurrences.back();
+
+		if(previous.first == entry.info.value() && previous.second.declaration == declaration)
+		{
+			previous.second.length = entry.source_position.offset_in_file + entry.length
+				- previous.second.source_position.offset_in_file;
+			return;
+		}
+	}
+
+	occurrences.emplace_back(entry.info.value(), SymbolOccurrence{entry.source_position, entry.length, declaration});
+	previous_collected = true;
+}
+
+void ReferenceIndexingAnalysisReporter::commit(const ResolveReference& resolve_reference)
+{
+	if(resolve_reference)
+	{
+		std::erase_if(occurrences, [&resolve_reference] (std::pair<std::string, SymbolOccurrence>& occurrence)
+		{
+			if(occurrence.second.declaration) { return false; }
+
+			std::optional<std::string> symbol = resolve_reference(occurrence.first, occurrence.second);
+
+			if(!symbol.has_value()) { return true; }
+
+			occurrence.first = std::move(symbol.value());
+			return false;
+		});
+	}
+
+	reference_index->replace_file(file, occurrences);
+	occurrences.clear();
+	previous_collected = false;
+}
@@ -0,0 +1,51 @@
+#ifndef REFERENCE_INDEXING_ANALYSIS_REPORTER_HPP
+#define REFERENCE_INDEXING_ANALYSIS_REPORTER_HPP
+
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+#include "../analysis_reporter.hpp"
+#include "../../index/reference_index.hpp"
+
+namespace neon_compiler::analysis::impl
+{
+
+/** Forwards entries to another reporter, while collecting the `INFO` `DECLARATION` and `REFERENCE` entries of one file
+ * for a `ReferenceIndex`. Consecutive entries for the parts of one identifier (`main`, `::`, `Widget`)
+ * become a single occurrence. */
+class ReferenceIndexingAnalysisReporter : public neon_compiler::analysis::AnalysisReporter
+{
+public:
+	/** Symbol of a reference, given the symbol reported for it. `std::nullopt` leaves the reference out of the index. */
+	using ResolveReference = std::function<std::optional<std::string>
+	(
+		const std::string& symbol,
+		const neon_compiler::index::SymbolOccurrence& occurrence
+	)>;
+
+	explicit ReferenceIndexingAnalysisReporter
+	(
+		std::shared_ptr<neon_compiler::analysis::AnalysisReporter> init_next,
+		std::shared_ptr<neon_compiler::index::ReferenceIndex> init_reference_index,
+		const std::string& init_file
+	);
+	void report(const AnalysisEntry& entry) override;
+
+	/** Replaces the file's entries in the reference index with what was reported since the last commit.
+	 * If given, `resolve_reference` decides the symbol of each reference, e.g. once names have been resolved. */
+	void commit(const ResolveReference& resolve_reference = nullptr);
+private:
+	std::shared_ptr<neon_compiler::analysis::AnalysisReporter> next;
+	std::shared_ptr<neon_compiler::index::ReferenceIndex> reference_index;
+	std::string file;
+	std::vector<std::pair<std::string, neon_compiler::index::SymbolOccurrence>> occurrences;
+	/** Whether the previous entry was collected, so the current one may continue the same identifier */
+	bool previous_collected{false};
+};
+
+}
+
+#endif // REFERENCE_INDEXING_ANALYSIS_REPORTER_HPP
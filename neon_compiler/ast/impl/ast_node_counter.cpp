@@ -0,0 +1,265 @@
+#include "ast_node_counter.hpp"
+
+#include "../nodes/statement_nodes.hpp"
+
+using namespace neon_compiler::ast::impl;
+using namespace neon_compiler::ast::nodes;
+
+ASTNodeCounter::ASTNodeCounter() {}
+
+void ASTNodeCounter::visit(const nodes::Root& node)
+{
+	++count;
+
+	for(const std::pair<const std::string, std::unique_ptr<nodes::PackageMember>>& pm : node.package_members)
+	{
+		accept_if_present(pm.second.get());
+	}
+}
+
+void ASTNodeCounter::visit(const nodes::Entrypoint& node)
+{
+	++count;
+	visit_parameters(node.parameters);
+	node.body.accept(*this);
+}
+
+void ASTNodeCounter::visit(const nodes::Type& node)
+{
+	++count;
+
+	for(const std::pair<const std::string, Field>& field : node.fields)
+	{
+		field.second.accept(*this);
+	}
+	for(const std::pair<const std::string, std::vector<Method>>& methods : node.methods)
+	{
+		for(const Method& method : methods.second) { method.accept(*this); }
+	}
+	for(const std::pair<const std::string, Constant>& constant : node.constants)
+	{
+		constant.second.accept(*this);
+	}
+	for(const std::pair<const std::string, std::vector<PureFunction>>& pure_functions : node.pure_functions)
+	{
+		for(const PureFunction& pure_function : pure_functions.second) { pure_function.accept(*this); }
+	}
+}
+
+void ASTNodeCounter::visit(const nodes::VariableDeclaration& node)
+{
+	++count;
+	node.reference_type.accept(*this);
+
+	accept_if_present(node.initialisation.get());
+}
+
+void ASTNodeCounter::visit(const nodes::Field& node)
+{
+	++count;
+	node.reference_type.accept(*this);
+}
+
+void ASTNodeCounter::visit(const nodes::Method& node)
+{
+	++count;
+
+	if(node.return_type.has_value()) { node.return_type->accept(*this); }
+	visit_parameters(node.parameters);
+	if(node.implementation.has_value()) { node.implementation->accept(*this); }
+}
+
+void ASTNodeCounter::visit(const nodes::Constant& node)
+{
+	++count;
+	node.type.accept(*this);
+}
+
+void ASTNodeCounter::visit(const nodes::ReferenceType&)
+{
+	++count;
+}
+
+void ASTNodeCounter::visit(const nodes::CodeBlock& node)
+{
+	++count;
+
+	for(const std::unique_ptr<Statement>& stmt : node.statements)
+	{
+		accept_if_present(stmt.get());
+	}
+}
+
+void ASTNodeCounter::visit(const nodes::DiscardExpression& node)
+{
+	++count;
+	accept_if_present(node.expression.get());
+}
+
+void ASTNodeCounter::visit(const nodes::LocalDeclaration& node)
+{
+	++count;
+	node.variable_declaration.accept(*this);
+}
+
+void ASTNodeCounter::visit(const nodes::AutoCall&)
+{
+	++count;
+}
+
+void ASTNodeCounter::visit(const nodes::Return& node)
+{
+	++count;
+
+	accept_if_present(node.value.get());
+}
+
+void ASTNodeCounter::visit(const nodes::Assignment& node)
+{
+	++count;
+	accept_if_present(node.target.get());
+	accept_if_present(node.value.get());
+}
+
+void ASTNodeCounter::visit(const nodes::ObjectFunctionCall& node)
+{
+	++count;
+	accept_if_present(node.object.get());
+	visit_expressions(node.arguments);
+}
+
+void ASTNodeCounter::visit(const nodes::ObjectRead& node)
+{
+	++count;
+	accept_if_present(node.object.get());
+}
+
+void ASTNodeCounter::visit(const nodes::FunctionCall& node)
+{
+	++count;
+	visit_expressions(node.arguments);
+}
+
+void ASTNodeCounter::visit(const nodes::SimpleRead&)
+{
+	++count;
+}
+
+void ASTNodeCounter::visit(const nodes::OptFunctionCall& node)
+{
+	++count;
+	visit_expressions(node.arguments);
+}
+
+void ASTNodeCounter::visit(const nodes::OptEmpty&)
+{
+	++count;
+}
+
+void ASTNodeCounter::visit(const nodes::PureFunctionSet& node)
+{
+	++count;
+
+	for(const std::pair<const std::string, std::vector<PureFunction>>& methods : node.methods)
+	{
+		for(const PureFunction& method : methods.second) { method.accept(*this); }
+	}
+}
+
+void ASTNodeCounter::visit(const nodes::PureFunction& node)
+{
+	++count;
+	node.return_type.accept(*this);
+	visit_parameters(node.parameters);
+
+	if(node.implementation.has_value()) { node.implementation->accept(*this); }
+}
+
+void ASTNodeCounter::visit(const nodes::OperatorModule& node)
+{
+	++count;
+
+	for(const OperatorDeclaration& od : node.operators)
+	{
+		od.accept(*this);
+	}
+	for(const OperatorFunction& of : node.functions)
+	{
+		of.accept(*this);
+	}
+}
+
+void ASTNodeCounter::visit(const nodes::OperatorDeclaration&)
+{
+	++count;
+}
+
+void ASTNodeCounter::visit(const nodes::OperatorFunction& node)
+{
+	++count;
+	node.return_type.accept(*this);
+
+	for(const OperatorFunctionPatternElement& elem : node.pattern)
+	{
+		if(std::holds_alternative<OperatorFunctionParameter>(elem))
+		{
+			std::get<OperatorFunctionParameter>(elem).parameter.accept(*this);
+		}
+	}
+
+	node.body.accept(*this);
+}
+
+void ASTNodeCounter::visit(const nodes::CompileFunction& node)
+{
+	++count;
+	node.body.accept(*this);
+}
+
+void ASTNodeCounter::visit(const nodes::LiteralNumberExpression&)
+{
+	++count;
+}
+
+void ASTNodeCounter::visit(const nodes::LiteralStringExpression&)
+{
+	++count;
+}
+
+void ASTNodeCounter::visit(const nodes::LiteralBooleanExpression&)
+{
+	++count;
+}
+
+void ASTNodeCounter::visit(const nodes::OperatorCallExpression& node)
+{
+	++count;
+	visit_expressions(node.arguments);
+}
+
+uint64_t ASTNodeCounter::get_count() const
+{
+	return count;
+}
+
+void ASTNodeCounter::accept_if_present(const ASTNode* node)
+{
+	// Nodes that failed to parse are left empty
+	if(node) { node->accept(*this); }
+}
+
+void ASTNodeCounter::visit_expressions(const std::vector<std::unique_ptr<Expression>>& expressions)
+{
+	for(const std::unique_ptr<Expression>& expression : expressions)
+	{
+		accept_if_present(expression.get());
+	}
+}
+
+void ASTNodeCounter::visit_parameters(const ParameterDeclarationList& parameters)
+{
+	for(const VariableDeclaration& parameter : parameters)
+	{
+		parameter.accept(*this);
+	}
+}
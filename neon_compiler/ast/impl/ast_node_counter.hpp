@@ -0,0 +1,57 @@
+#ifndef AST_NODE_COUNTER_HPP
+#define AST_NODE_COUNTER_HPP
+
+#include <cstdint>
+#include "../nodes/nodes.hpp"
+
+namespace neon_compiler::ast::impl
+{
+
+/** Counts the nodes of a tree, including the node it is first given. */
+class ASTNodeCounter : public ASTVisitor
+{
+public:
+	ASTNodeCounter();
+	void visit(const nodes::Root& node) override;
+	void visit(const nodes::Entrypoint& node) override;
+	void visit(const nodes::Type& node) override;
+	void visit(const nodes::VariableDeclaration& node) override;
+	void visit(const nodes::Field& node) override;
+	void visit(const nodes::Method& node) override;
+	void visit(const nodes::Constant& node) override;
+	void visit(const nodes::ReferenceType& node) override;
+	void visit(const nodes::CodeBlock& node) override;
+	void visit(const nodes::DiscardExpression& node) override;
+	void visit(const nodes::LocalDeclaration& node) override;
+	void visit(const nodes::AutoCall& node) override;
+	void visit(const nodes::Return& node) override;
+	void visit(const nodes::Assignment& node) override;
+	void visit(const nodes::ObjectFunctionCall& node) override;
+	void visit(const nodes::ObjectRead& node) override;
+	void visit(const nodes::FunctionCall& node) override;
+	void visit(const nodes::SimpleRead& node) override;
+	void visit(const nodes::OptFunctionCall& node) override;
+	void visit(const nodes::OptEmpty& node) override;
+	void visit(const nodes::PureFunctionSet& node) override;
+	void visit(const nodes::PureFunction& node) override;
+	void visit(const nodes::OperatorModule& node) override;
+	void visit(const nodes::OperatorDeclaration& node) override;
+	void visit(const nodes::OperatorFunction& node) override;
+	void visit(const nodes::CompileFunction& node) override;
+	void visit(const nodes::LiteralNumberExpression& node) override;
+	void visit(const nodes::LiteralStringExpression& node) override;
+	void visit(const nodes::LiteralBooleanExpression& node) override;
+	void visit(const nodes::OperatorCallExpression& node) override;
+
+	uint64_t get_count() const;
+private:
+	uint64_t count{0};
+
+	void accept_if_present(const ASTNode* node);
+	void visit_expressions(const std::vector<std::unique_ptr<nodes::Expression>>& expressions);
+	void visit_parameters(const nodes::ParameterDeclarationList& parameters);
+};
+
+}
+
+#endif // AST_NODE_COUNTER_HPP
@@ -1,6 +1,7 @@
 #ifndef NODES_HPP
 #define NODES_HPP
 
+#include <cstdint>
 #include <memory>
 #include <optional>
 #include <string>
@@ -22,11 +23,21 @@ namespace neon_compiler::parser
 namespace neon_compiler::ast::nodes
 {
 
+/** Index of a declaration in the name resolution of the AST, see `neon_compiler::resolution::Resolution` */
+using DeclarationId = uint32_t;
+
+/** Declaration of a reference that was not resolved (yet) */
+constexpr DeclarationId UNRESOLVED_DECLARATION = UINT32_MAX;
+
 struct PackageMember : ASTNode {};
 
 struct Statement : ASTNode {};
 
-struct Expression : ASTNode {};
+struct Expression : ASTNode
+{
+	/** Position of the first token of the expression */
+	reading::SourcePosition source_position{};
+};
 
 struct Root : ASTNode
 {
@@ -34,6 +45,8 @@ struct Root : ASTNode
 	std::unordered_map<std::string, std::unique_ptr<PackageMember>> package_members;
 	/** Mapping from file path to package member identifiers */
 	std::unordered_map<std::string, std::vector<std::string>> file_package_members;
+	/** Mapping from file path to the full identifiers of the package members it imports */
+	std::unordered_map<std::string, std::vector<std::string>> file_imports;
 
 	Root() = default;
 
@@ -97,6 +110,8 @@ struct GenericArgument
 	bool is_reference{false};
 	/** If `value` is a reference to a type, these are the generic arguments associated with it */
 	std::vector<GenericArgument> nested_generic_args{};
+	/** Declaration `value` refers to, if it is a reference and has been resolved */
+	DeclarationId declaration{UNRESOLVED_DECLARATION};
 };
 
 struct ReferenceType : ASTNode
@@ -113,6 +128,8 @@ struct ReferenceType : ASTNode
 	std::string inferred_name;
 	/** Generic arguments */
 	std::vector<GenericArgument> generic_arguments;
+	/** Declaration of the type, once resolved */
+	DeclarationId declaration{UNRESOLVED_DECLARATION};
 
 	ReferenceType
 	(
@@ -217,6 +234,9 @@ struct Field : ASTNode
 	/** The reference type of this field. */
 	ReferenceType reference_type;
 
+	Field(bool init_var, ReferenceType init_reference_type)
+	: var{init_var}, reference_type{std::move(init_reference_type)} {}
+
 	void accept(ASTVisitor& visitor) const override
 	{
 		visitor.visit(*this);
@@ -279,6 +299,19 @@ struct PureFunction : ASTNode
 	/** Pure function body. Empty means it's not implemented (an abstract pure function). */
 	std::optional<CodeBlock> implementation;
 
+	PureFunction
+	(
+		Access init_access,
+		ReferenceType init_return_type,
+		ParameterDeclarationList init_parameters,
+		std::optional<CodeBlock> init_implementation
+	) :
+		access{std::move(init_access)},
+		return_type{std::move(init_return_type)},
+		parameters{std::move(init_parameters)},
+		implementation{std::move(init_implementation)}
+	{}
+
 	void accept(ASTVisitor& visitor) const override
 	{
 		visitor.visit(*this);
@@ -335,18 +368,22 @@ struct OperatorDeclaration : ASTNode
 	OperatorAssociativity associativity;
 	/** The kind of built-in operator. NOT_BUILT_IN means it's not built-in. */
 	BuiltinOperatorKind builtin_operator_kind;
+	/** Position of the `operator` keyword; zero for built-in operators */
+	reading::SourcePosition source_position;
 
 	OperatorDeclaration
 	(
 		std::vector<OperatorSyntaxPatternElement> init_pattern,
 		uint init_subordination,
 		OperatorAssociativity init_associativity,
-		BuiltinOperatorKind init_builtin_operator_kind
+		BuiltinOperatorKind init_builtin_operator_kind,
+		reading::SourcePosition init_source_position = reading::SourcePosition{}
 	) :
 		pattern{std::move(init_pattern)},
 		subordination{init_subordination},
 		associativity{init_associativity},
-		builtin_operator_kind{init_builtin_operator_kind}
+		builtin_operator_kind{init_builtin_operator_kind},
+		source_position{init_source_position}
 	{}
 
 	void accept(ASTVisitor& visitor) const override
@@ -420,6 +457,9 @@ struct CompileFunction : PackageMember
 	/** Compile function body */
 	CodeBlock body;
 
+	CompileFunction(Access init_access, CompileFunctionScope init_scope, CodeBlock init_body)
+		: access{std::move(init_access)}, scope{init_scope}, body{std::move(init_body)} {}
+
 	void accept(ASTVisitor& visitor) const override
 	{
 		visitor.visit(*this);
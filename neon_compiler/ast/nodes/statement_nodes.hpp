@@ -31,6 +31,9 @@ struct LocalDeclaration : Statement
 	/** The variable declaration within this statement */
 	VariableDeclaration variable_declaration;
 
+	LocalDeclaration(VariableDeclaration init_variable_declaration)
+		: variable_declaration(std::move(init_variable_declaration)) {}
+
 	void accept(ASTVisitor& visitor) const override
 	{
 		visitor.visit(*this);
@@ -44,6 +47,8 @@ struct AutoCall : Statement
 	std::string function_name;
 	/** Tokens to pass. `,` separates arguments. */
 	std::vector<std::vector<neon_compiler::Token>> arguments;
+	/** Declaration of the compile function, once resolved */
+	DeclarationId declaration{UNRESOLVED_DECLARATION};
 
 	void accept(ASTVisitor& visitor) const override
 	{
@@ -152,6 +157,8 @@ struct FunctionCall : Expression
 	std::vector<GenericArgument> generic_arguments;
 	/** Arguments */
 	std::vector<std::unique_ptr<Expression>> arguments;
+	/** Declaration of the called function or type, once resolved */
+	DeclarationId declaration{UNRESOLVED_DECLARATION};
 
 	FunctionCall
 	(
@@ -175,6 +182,8 @@ struct SimpleRead : Expression
 {
 	/** Reference name */
 	std::string reference_name;
+	/** Declaration of the variable, constant or field read, once resolved */
+	DeclarationId declaration{UNRESOLVED_DECLARATION};
 
 	SimpleRead
 	(
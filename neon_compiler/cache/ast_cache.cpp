@@ -0,0 +1,308 @@
+#include "ast_cache.hpp"
+
+#include "ast_serializer.hpp"
+#include "binary_io.hpp"
+#include "content_hash.hpp"
+#include "entry_file.hpp"
+#include "../lexer/lexer.hpp"
+#include "../../file_reading/mapped_file.hpp"
+
+using namespace neon_compiler;
+using namespace neon_compiler::analysis;
+using namespace neon_compiler::ast;
+using namespace neon_compiler::ast::nodes;
+using namespace neon_compiler::cache;
+using namespace neon_compiler::parser;
+
+namespace
+{
+
+void write_entries(BinaryWriter& writer, const std::vector<AnalysisEntry>& entries)
+{
+	writer.write_u32(static_cast<uint32_t>(entries.size()));
+
+	for(const AnalysisEntry& entry : entries)
+	{
+		writer.write_u8(static_cast<uint8_t>(entry.type));
+		writer.write_u8(static_cast<uint8_t>(entry.severity));
+		writer.write_u32(entry.source_position.offset_in_file);
+		writer.write_u32(entry.source_position.newlines_count);
+		writer.write_u32(entry.source_position.offset_in_line);
+		writer.write_u32(entry.length);
+		writer.write_bool(entry.info.has_value());
+		if(entry.info.has_value())
+		{
+			writer.write_string(entry.info.value());
+		}
+	}
+}
+
+std::vector<CachedAnalysisEntry> read_entries(BinaryReader& reader)
+{
+	std::vector<CachedAnalysisEntry> entries;
+
+	const uint32_t count = reader.read_u32();
+	entries.reserve(count);
+
+	for(uint32_t i = 0; i < count; ++i)
+	{
+		const uint8_t type = reader.read_u8();
+		const uint8_t severity = reader.read_u8();
+
+		if(type > static_cast<uint8_t>(AnalysisEntryType::PACKAGE) || severity > static_cast<uint8_t>(AnalysisSeverity::ERROR))
+		{
+			throw CacheFormatException{"Invalid analysis entry"};
+		}
+
+		const reading::SourcePosition sp{reader.read_u32(), reader.read_u32(), reader.read_u32()};
+		const uint32_t length = reader.read_u32();
+
+		std::optional<std::string> info{std::nullopt};
+		if(reader.read_bool())
+		{
+			info = reader.read_string();
+		}
+
+		entries.push_back(CachedAnalysisEntry
+		{
+			static_cast<AnalysisEntryType>(type),
+			static_cast<AnalysisSeverity>(severity),
+			sp,
+			length,
+			std::move(info)
+		});
+	}
+
+	return entries;
+}
+
+}
+
+AnalysisEntry CachedAnalysisEntry::to_entry(std::string_view file) const
+{
+	return AnalysisEntry{file, type, severity, source_position, length, info};
+}
+
+AstCache::AstCache(std::filesystem::path init_directory)
+	: directory{std::move(init_directory)} {}
+
+std::optional<AstCacheEntry> AstCache::load(uint64_t content_hash) const
+{
+	file_reading::MappedFile mapped_file{};
+
+	if(!mapped_file.open_file(get_entry_path(directory, content_hash, ENTRY_EXTENSION).string()))
+	{
+		return std::nullopt;
+	}
+
+	try
+	{
+		BinaryReader reader{mapped_file.get_contents()};
+
+		if(reader.read_bytes(MAGIC.size()) != MAGIC ||
+			reader.read_u32() != FORMAT_VERSION ||
+			reader.read_u32() != lexer::LEXER_VERSION ||
+			reader.read_u32() != PARSER_VERSION ||
+			reader.read_u64() != content_hash)
+		{
+			return std::nullopt;
+		}
+
+		AstCacheEntry entry{};
+		ASTDeserializer deserializer{reader, nullptr};
+
+		entry.fragment_a.package = deserializer.read_identifier();
+
+		const uint32_t module_count = reader.read_u32();
+		for(uint32_t i = 0; i < module_count; ++i)
+		{
+			std::string identifier = reader.read_string();
+			Access access = deserializer.read_access();
+
+			std::vector<OperatorDeclaration> operators;
+			const uint32_t operator_count = reader.read_u32();
+			for(uint32_t j = 0; j < operator_count; ++j)
+			{
+				operators.push_back(deserializer.read_operator_declaration());
+			}
+
+			entry.fragment_a.operator_modules.emplace_back
+			(
+				std::move(identifier),
+				std::make_unique<OperatorModule>(std::move(access), std::move(operators), std::vector<OperatorFunction>{})
+			);
+		}
+
+		entry.fragment_a.entries = read_entries(reader);
+
+		const uint32_t used_count = reader.read_u32();
+		for(uint32_t i = 0; i < used_count; ++i)
+		{
+			std::string operator_module = reader.read_string();
+			entry.used_operator_modules.emplace_back(std::move(operator_module), reader.read_u64());
+		}
+
+		const uint32_t import_count = reader.read_u32();
+		for(uint32_t i = 0; i < import_count; ++i)
+		{
+			entry.imported_package_members.push_back(reader.read_string());
+		}
+
+		entry.fragment_b = reader.read_string();
+
+		if(!reader.end_reached())
+		{
+			return std::nullopt;
+		}
+
+		return entry;
+	}
+	catch(const CacheFormatException&)
+	{
+		return std::nullopt;
+	}
+}
+
+std::optional<AstFragmentB> AstCache::read_fragment_b(const AstCacheEntry& entry, const OperatorMap& operator_map) const
+{
+	try
+	{
+		BinaryReader reader{entry.fragment_b};
+		ASTDeserializer deserializer{reader, &operator_map};
+
+		AstFragmentB fragment{};
+
+		const uint32_t member_count = reader.read_u32();
+		for(uint32_t i = 0; i < member_count; ++i)
+		{
+			std::string identifier = reader.read_string();
+			fragment.package_members.emplace_back(std::move(identifier), deserializer.read_package_member());
+		}
+
+		const uint32_t module_count = reader.read_u32();
+		if(module_count != entry.fragment_a.operator_modules.size())
+		{
+			return std::nullopt;
+		}
+
+		for(uint32_t i = 0; i < module_count; ++i)
+		{
+			std::vector<OperatorFunction>& functions = fragment.operator_functions.emplace_back();
+
+			const uint32_t function_count = reader.read_u32();
+			for(uint32_t j = 0; j < function_count; ++j)
+			{
+				functions.push_back(deserializer.read_operator_function());
+			}
+		}
+
+		fragment.entries = read_entries(reader);
+
+		if(!reader.end_reached())
+		{
+			return std::nullopt;
+		}
+
+		return fragment;
+	}
+	catch(const CacheFormatException&)
+	{
+		return std::nullopt;
+	}
+}
+
+bool AstCache::store(uint64_t content_hash, const ParsedFile& parsed_file, const OperatorMap& operator_map) const
+{
+	const OperatorReferences operator_references = create_operator_references(operator_map);
+
+	BinaryWriter writer{};
+	BinaryWriter writer_b{};
+	ASTSerializer serializer{writer, operator_references};
+	ASTSerializer serializer_b{writer_b, operator_references};
+
+	try
+	{
+		writer.write_bytes(MAGIC);
+		writer.write_u32(FORMAT_VERSION);
+		writer.write_u32(lexer::LEXER_VERSION);
+		writer.write_u32(PARSER_VERSION);
+		writer.write_u64(content_hash);
+
+		serializer.write_identifier(parsed_file.package);
+
+		writer.write_u32(static_cast<uint32_t>(parsed_file.operator_modules.size()));
+		for(const std::pair<std::string, const OperatorModule*>& pair : parsed_file.operator_modules)
+		{
+			writer.write_string(pair.first);
+			serializer.write_access(pair.second->access);
+			writer.write_u32(static_cast<uint32_t>(pair.second->operators.size()));
+			for(const OperatorDeclaration& op : pair.second->operators)
+			{
+				serializer.write_operator_declaration(op);
+			}
+		}
+
+		write_entries(writer, parsed_file.entries_a);
+
+		writer.write_u32(static_cast<uint32_t>(parsed_file.used_operator_modules.size()));
+		for(const std::pair<std::string, uint64_t>& pair : parsed_file.used_operator_modules)
+		{
+			writer.write_string(pair.first);
+			writer.write_u64(pair.second);
+		}
+
+		writer.write_u32(static_cast<uint32_t>(parsed_file.imported_package_members.size()));
+		for(const std::string& imported_package_member : parsed_file.imported_package_members)
+		{
+			writer.write_string(imported_package_member);
+		}
+
+		writer_b.write_u32(static_cast<uint32_t>(parsed_file.package_members.size()));
+		for(const std::pair<std::string, const PackageMember*>& pair : parsed_file.package_members)
+		{
+			writer_b.write_string(pair.first);
+			serializer_b.write_package_member(*pair.second);
+		}
+
+		writer_b.write_u32(static_cast<uint32_t>(parsed_file.operator_modules.size()));
+		for(const std::pair<std::string, const OperatorModule*>& pair : parsed_file.operator_modules)
+		{
+			writer_b.write_u32(static_cast<uint32_t>(pair.second->functions.size()));
+			for(const OperatorFunction& function : pair.second->functions)
+			{
+				serializer_b.write_operator_function(function);
+			}
+		}
+
+		write_entries(writer_b, parsed_file.entries_b);
+
+		writer.write_string(writer_b.get_buffer());
+	}
+	catch(const CacheFormatException&)
+	{
+		return false;
+	}
+
+	return write_entry_file(get_entry_path(directory, content_hash, ENTRY_EXTENSION), writer.get_buffer());
+}
+
+uint64_t AstCache::fingerprint_operator_module(const OperatorMap& operator_map, const std::string& operator_module)
+{
+	OperatorMap::const_iterator it = operator_map.find(operator_module);
+
+	if(it == operator_map.end())
+	{
+		return 0;
+	}
+
+	const OperatorReferences no_references{};
+	BinaryWriter writer{};
+	ASTSerializer serializer{writer, no_references};
+
+	for(const std::shared_ptr<const Operator>& op : it->second)
+	{
+		serializer.write_operator_syntax(*op->get_declaration());
+	}
+
+	return hash_content(writer.get_buffer());
+}
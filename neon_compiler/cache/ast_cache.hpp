@@ -0,0 +1,116 @@
+#ifndef AST_CACHE_HPP
+#define AST_CACHE_HPP
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "../analysis/analysis_entry.hpp"
+#include "../ast/identifiers.hpp"
+#include "../ast/nodes/nodes.hpp"
+#include "../parser/parser.hpp"
+
+namespace neon_compiler::cache
+{
+
+/** An analysis entry without the file, which is only known when replaying */
+struct CachedAnalysisEntry
+{
+	neon_compiler::analysis::AnalysisEntryType type;
+	neon_compiler::analysis::AnalysisSeverity severity;
+	reading::SourcePosition source_position;
+	uint32_t length;
+	std::optional<std::string> info;
+
+	neon_compiler::analysis::AnalysisEntry to_entry(std::string_view file) const;
+};
+
+/** What `Parser::run_a` produces for a file. Only depends on the content of the file. */
+struct AstFragmentA
+{
+	neon_compiler::ast::Identifier package;
+	/** Operator modules declared in the file by full identifier, without their operator functions */
+	std::vector<std::pair<std::string, std::unique_ptr<neon_compiler::ast::nodes::OperatorModule>>> operator_modules;
+	std::vector<CachedAnalysisEntry> entries;
+};
+
+/** What `Parser::run_b` produces for a file. Also depends on the operator modules used by the file. */
+struct AstFragmentB
+{
+	/** Package members added by `run_b` by full identifier */
+	std::vector<std::pair<std::string, std::unique_ptr<neon_compiler::ast::nodes::PackageMember>>> package_members;
+	/** Operator functions of each operator module in `AstFragmentA::operator_modules`, in the same order */
+	std::vector<std::vector<neon_compiler::ast::nodes::OperatorFunction>> operator_functions;
+	std::vector<CachedAnalysisEntry> entries;
+};
+
+struct AstCacheEntry
+{
+	AstFragmentA fragment_a;
+	/** Operator modules used by the file and their fingerprints at the time it was parsed.
+	 * `fragment_b` may only be used if all fingerprints still match. */
+	std::vector<std::pair<std::string, uint64_t>> used_operator_modules;
+	/** Full identifiers of the package members imported by the file */
+	std::vector<std::string> imported_package_members;
+	/** Encoded `AstFragmentB`. Decoded with `AstCache::read_fragment_b` once the operator map is complete. */
+	std::string fragment_b;
+};
+
+/** The parse results of one file, to store in the cache. Non-owning. */
+struct ParsedFile
+{
+	const neon_compiler::ast::Identifier& package;
+	std::vector<std::pair<std::string, const neon_compiler::ast::nodes::OperatorModule*>> operator_modules;
+	const std::vector<neon_compiler::analysis::AnalysisEntry>& entries_a;
+	std::vector<std::pair<std::string, uint64_t>> used_operator_modules;
+	const std::vector<std::string>& imported_package_members;
+	std::vector<std::pair<std::string, const neon_compiler::ast::nodes::PackageMember*>> package_members;
+	const std::vector<neon_compiler::analysis::AnalysisEntry>& entries_b;
+};
+
+/** On-disk cache of per-file parse results, keyed by the content hash of the source file.
+ * A warm run restores unchanged files from here instead of parsing them, and only parses `run_b` again
+ * for unchanged files of which a used operator module changed. */
+class AstCache
+{
+public:
+	explicit AstCache(std::filesystem::path init_directory);
+
+	/** Returns the entry for content with `content_hash`, or nothing if absent, stale or corrupt. */
+	std::optional<AstCacheEntry> load(uint64_t content_hash) const;
+	/** Decodes `entry.fragment_b`, resolving operator calls through `operator_map`. Returns nothing if corrupt. */
+	std::optional<AstFragmentB> read_fragment_b
+	(
+		const AstCacheEntry& entry,
+		const neon_compiler::parser::OperatorMap& operator_map
+	) const;
+	/** Stores the parse results of a file. Returns false if they could not be encoded or written. */
+	bool store
+	(
+		uint64_t content_hash,
+		const ParsedFile& parsed_file,
+		const neon_compiler::parser::OperatorMap& operator_map
+	) const;
+
+	/** Hash of the operator declarations of `operator_module` without their source positions, or 0 if there is no such operator module */
+	static uint64_t fingerprint_operator_module
+	(
+		const neon_compiler::parser::OperatorMap& operator_map,
+		const std::string& operator_module
+	);
+
+private:
+	static constexpr std::string_view MAGIC = "NAST";
+	static constexpr uint32_t FORMAT_VERSION = 4;
+	static constexpr std::string_view ENTRY_EXTENSION = ".nast";
+
+	std::filesystem::path directory;
+};
+
+}
+
+#endif // AST_CACHE_HPP
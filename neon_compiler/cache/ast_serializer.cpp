@@ -0,0 +1,795 @@
+#include "ast_serializer.hpp"
+
+using namespace neon_compiler;
+using namespace neon_compiler::ast;
+using namespace neon_compiler::ast::nodes;
+using namespace neon_compiler::cache;
+using namespace neon_compiler::parser;
+
+namespace
+{
+
+enum class NodeTag : uint8_t
+{
+	NONE,
+	ENTRYPOINT,
+	OPERATOR_MODULE,
+	DISCARD_EXPRESSION,
+	RETURN,
+	ASSIGNMENT,
+	OBJECT_FUNCTION_CALL,
+	OBJECT_READ,
+	FUNCTION_CALL,
+	SIMPLE_READ,
+	OPT_FUNCTION_CALL,
+	OPT_EMPTY,
+	LITERAL_NUMBER,
+	LITERAL_STRING,
+	LITERAL_BOOLEAN,
+	OPERATOR_CALL
+};
+
+enum class OperatorSource : uint8_t
+{
+	BUILTIN,
+	OPERATOR_MODULE
+};
+
+enum class PatternElementTag : uint8_t
+{
+	PARAMETER,
+	TOKEN
+};
+
+void write_tag(BinaryWriter& writer, NodeTag tag)
+{
+	writer.write_u8(static_cast<uint8_t>(tag));
+}
+
+[[noreturn]] void throw_unsupported()
+{
+	throw CacheFormatException{std::string{ast_serializer_error_messages::UNSUPPORTED_NODE}};
+}
+
+[[noreturn]] void throw_invalid_tag()
+{
+	throw CacheFormatException{std::string{ast_serializer_error_messages::INVALID_TAG}};
+}
+
+}
+
+OperatorReferences neon_compiler::cache::create_operator_references(const OperatorMap& operator_map)
+{
+	OperatorReferences references;
+
+	for(const std::pair<const std::string, std::vector<std::shared_ptr<const Operator>>>& pair : operator_map)
+	{
+		for(uint32_t i = 0; i < pair.second.size(); ++i)
+		{
+			references.emplace(pair.second[i].get(), std::pair<std::string, uint32_t>{pair.first, i});
+		}
+	}
+
+	return references;
+}
+
+ASTSerializer::ASTSerializer(BinaryWriter& init_writer, const OperatorReferences& init_operator_references)
+	: writer{init_writer}, operator_references{init_operator_references} {}
+
+void ASTSerializer::write_package_member(const PackageMember& node)
+{
+	node.accept(*this);
+}
+
+void ASTSerializer::write_identifier(const Identifier& identifier)
+{
+	writer.write_u32(static_cast<uint32_t>(identifier.parts.size()));
+	for(const std::string& part : identifier.parts)
+	{
+		writer.write_string(part);
+	}
+}
+
+void ASTSerializer::write_access(const Access& access)
+{
+	writer.write_u8(static_cast<uint8_t>(access.type));
+	writer.write_u32(static_cast<uint32_t>(access.patterns.size()));
+
+	for(const PackageMemberPattern& pattern : access.patterns)
+	{
+		writer.write_u8(static_cast<uint8_t>(pattern.type));
+		write_optional_identifier(pattern.package_member_identifier);
+		write_optional_identifier(pattern.supertype);
+	}
+}
+
+void ASTSerializer::write_operator_declaration(const OperatorDeclaration& node)
+{
+	write_operator_syntax(node);
+	write_source_position(node.source_position);
+}
+
+void ASTSerializer::write_operator_syntax(const OperatorDeclaration& node)
+{
+	writer.write_u32(static_cast<uint32_t>(node.pattern.size()));
+
+	for(const OperatorSyntaxPatternElement& elem : node.pattern)
+	{
+		if(std::holds_alternative<OperatorSyntaxParameter>(elem))
+		{
+			writer.write_u8(static_cast<uint8_t>(PatternElementTag::PARAMETER));
+		}
+		else
+		{
+			writer.write_u8(static_cast<uint8_t>(PatternElementTag::TOKEN));
+			write_token_pattern(std::get<TokenPattern>(elem));
+		}
+	}
+
+	writer.write_u32(node.subordination);
+	writer.write_u8(static_cast<uint8_t>(node.associativity));
+	writer.write_u8(static_cast<uint8_t>(node.builtin_operator_kind));
+}
+
+void ASTSerializer::write_operator_function(const OperatorFunction& node)
+{
+	visit(node.return_type);
+
+	writer.write_u32(static_cast<uint32_t>(node.generic_parameters.size()));
+	for(const GenericParameter& generic_parameter : node.generic_parameters)
+	{
+		writer.write_string(generic_parameter.type);
+		writer.write_string(generic_parameter.reference_name);
+		writer.write_u32(static_cast<uint32_t>(generic_parameter.supertypes.size()));
+		for(const std::string& supertype : generic_parameter.supertypes)
+		{
+			writer.write_string(supertype);
+		}
+	}
+
+	writer.write_u32(static_cast<uint32_t>(node.pattern.size()));
+	for(const OperatorFunctionPatternElement& elem : node.pattern)
+	{
+		if(std::holds_alternative<OperatorFunctionParameter>(elem))
+		{
+			writer.write_u8(static_cast<uint8_t>(PatternElementTag::PARAMETER));
+			visit(std::get<OperatorFunctionParameter>(elem).parameter);
+		}
+		else
+		{
+			writer.write_u8(static_cast<uint8_t>(PatternElementTag::TOKEN));
+			write_token_pattern(std::get<TokenPattern>(elem));
+		}
+	}
+
+	visit(node.body);
+}
+
+void ASTSerializer::visit(const Root&) { throw_unsupported(); }
+
+void ASTSerializer::visit(const Entrypoint& node)
+{
+	write_tag(writer, NodeTag::ENTRYPOINT);
+	write_access(node.access);
+	write_parameters(node.parameters);
+	visit(node.body);
+}
+
+void ASTSerializer::visit(const Type&) { throw_unsupported(); }
+
+void ASTSerializer::visit(const VariableDeclaration& node)
+{
+	writer.write_bool(node.var);
+	visit(node.reference_type);
+	writer.write_string(node.reference_name);
+	write_expression(node.initialisation.get());
+}
+
+void ASTSerializer::visit(const Field&) { throw_unsupported(); }
+
+void ASTSerializer::visit(const Method&) { throw_unsupported(); }
+
+void ASTSerializer::visit(const Constant&) { throw_unsupported(); }
+
+void ASTSerializer::visit(const ReferenceType& node)
+{
+	writer.write_bool(node.opt);
+	writer.write_u8(static_cast<uint8_t>(node.mutability));
+	writer.write_bool(node.mut);
+	writer.write_string(node.type);
+	writer.write_string(node.inferred_name);
+	write_generic_arguments(node.generic_arguments);
+}
+
+void ASTSerializer::visit(const CodeBlock& node)
+{
+	writer.write_u32(static_cast<uint32_t>(node.statements.size()));
+	for(const std::unique_ptr<Statement>& statement : node.statements)
+	{
+		write_node(statement.get());
+	}
+}
+
+void ASTSerializer::visit(const DiscardExpression& node)
+{
+	write_tag(writer, NodeTag::DISCARD_EXPRESSION);
+	write_expression(node.expression.get());
+}
+
+void ASTSerializer::visit(const LocalDeclaration&) { throw_unsupported(); }
+
+void ASTSerializer::visit(const AutoCall&) { throw_unsupported(); }
+
+void ASTSerializer::visit(const Return& node)
+{
+	write_tag(writer, NodeTag::RETURN);
+	write_expression(node.value.get());
+}
+
+void ASTSerializer::visit(const Assignment& node)
+{
+	write_tag(writer, NodeTag::ASSIGNMENT);
+	write_expression(node.target.get());
+	write_expression(node.value.get());
+}
+
+void ASTSerializer::visit(const ObjectFunctionCall& node)
+{
+	write_tag(writer, NodeTag::OBJECT_FUNCTION_CALL);
+	write_expression(node.object.get());
+	writer.write_string(node.member_name);
+	write_generic_arguments(node.generic_arguments);
+	write_nodes(node.arguments);
+}
+
+void ASTSerializer::visit(const ObjectRead& node)
+{
+	write_tag(writer, NodeTag::OBJECT_READ);
+	write_expression(node.object.get());
+	writer.write_string(node.member_name);
+}
+
+void ASTSerializer::visit(const FunctionCall& node)
+{
+	write_tag(writer, NodeTag::FUNCTION_CALL);
+	writer.write_string(node.function_name);
+	write_generic_arguments(node.generic_arguments);
+	write_nodes(node.arguments);
+}
+
+void ASTSerializer::visit(const SimpleRead& node)
+{
+	write_tag(writer, NodeTag::SIMPLE_READ);
+	writer.write_string(node.reference_name);
+}
+
+void ASTSerializer::visit(const OptFunctionCall& node)
+{
+	write_tag(writer, NodeTag::OPT_FUNCTION_CALL);
+	writer.write_string(node.function_name);
+	write_nodes(node.arguments);
+}
+
+void ASTSerializer::visit(const OptEmpty&)
+{
+	write_tag(writer, NodeTag::OPT_EMPTY);
+}
+
+void ASTSerializer::visit(const PureFunctionSet&) { throw_unsupported(); }
+
+void ASTSerializer::visit(const PureFunction&) { throw_unsupported(); }
+
+void ASTSerializer::visit(const OperatorModule& node)
+{
+	write_tag(writer, NodeTag::OPERATOR_MODULE);
+	write_access(node.access);
+
+	writer.write_u32(static_cast<uint32_t>(node.operators.size()));
+	for(const OperatorDeclaration& op : node.operators)
+	{
+		write_operator_declaration(op);
+	}
+
+	writer.write_u32(static_cast<uint32_t>(node.functions.size()));
+	for(const OperatorFunction& function : node.functions)
+	{
+		write_operator_function(function);
+	}
+}
+
+void ASTSerializer::visit(const OperatorDeclaration& node)
+{
+	write_operator_declaration(node);
+}
+
+void ASTSerializer::visit(const OperatorFunction& node)
+{
+	write_operator_function(node);
+}
+
+void ASTSerializer::visit(const CompileFunction&) { throw_unsupported(); }
+
+void ASTSerializer::visit(const LiteralNumberExpression& node)
+{
+	write_tag(writer, NodeTag::LITERAL_NUMBER);
+	writer.write_string(node.value);
+}
+
+void ASTSerializer::visit(const LiteralStringExpression& node)
+{
+	write_tag(writer, NodeTag::LITERAL_STRING);
+	writer.write_string(node.value);
+}
+
+void ASTSerializer::visit(const LiteralBooleanExpression& node)
+{
+	write_tag(writer, NodeTag::LITERAL_BOOLEAN);
+	writer.write_bool(node.value);
+}
+
+void ASTSerializer::visit(const OperatorCallExpression& node)
+{
+	write_tag(writer, NodeTag::OPERATOR_CALL);
+
+	const std::vector<std::shared_ptr<const Operator>>& builtins = builtin_operators::LIST;
+
+	for(uint32_t i = 0; i < builtins.size(); ++i)
+	{
+		if(builtins[i] == node.op)
+		{
+			writer.write_u8(static_cast<uint8_t>(OperatorSource::BUILTIN));
+			writer.write_u32(i);
+			write_nodes(node.arguments);
+			return;
+		}
+	}
+
+	OperatorReferences::const_iterator it = operator_references.find(node.op.get());
+
+	if(it == operator_references.end())
+	{
+		throw CacheFormatException{std::string{ast_serializer_error_messages::UNKNOWN_OPERATOR}};
+	}
+
+	writer.write_u8(static_cast<uint8_t>(OperatorSource::OPERATOR_MODULE));
+	writer.write_string(it->second.first);
+	writer.write_u32(it->second.second);
+	write_nodes(node.arguments);
+}
+
+void ASTSerializer::write_node(const ASTNode* node)
+{
+	if(node)
+	{
+		node->accept(*this);
+	}
+	else
+	{
+		write_tag(writer, NodeTag::NONE);
+	}
+}
+
+void ASTSerializer::write_expression(const Expression* node)
+{
+	write_node(node);
+
+	if(node)
+	{
+		write_source_position(node->source_position);
+	}
+}
+
+void ASTSerializer::write_nodes(const std::vector<std::unique_ptr<Expression>>& nodes)
+{
+	writer.write_u32(static_cast<uint32_t>(nodes.size()));
+	for(const std::unique_ptr<Expression>& node : nodes)
+	{
+		write_expression(node.get());
+	}
+}
+
+void ASTSerializer::write_source_position(const reading::SourcePosition& source_position)
+{
+	writer.write_u32(source_position.offset_in_file);
+	writer.write_u32(source_position.newlines_count);
+	writer.write_u32(source_position.offset_in_line);
+}
+
+void ASTSerializer::write_optional_identifier(const std::optional<Identifier>& identifier)
+{
+	writer.write_bool(identifier.has_value());
+	if(identifier.has_value())
+	{
+		write_identifier(identifier.value());
+	}
+}
+
+void ASTSerializer::write_optional_string(const std::optional<std::string>& str)
+{
+	writer.write_bool(str.has_value());
+	if(str.has_value())
+	{
+		writer.write_string(str.value());
+	}
+}
+
+void ASTSerializer::write_generic_arguments(const std::vector<GenericArgument>& generic_arguments)
+{
+	writer.write_u32(static_cast<uint32_t>(generic_arguments.size()));
+	for(const GenericArgument& generic_argument : generic_arguments)
+	{
+		writer.write_string(generic_argument.value);
+		writer.write_bool(generic_argument.is_reference);
+		write_generic_arguments(generic_argument.nested_generic_args);
+	}
+}
+
+void ASTSerializer::write_parameters(const ParameterDeclarationList& parameters)
+{
+	writer.write_u32(static_cast<uint32_t>(parameters.size()));
+	for(const VariableDeclaration& parameter : parameters)
+	{
+		visit(parameter);
+	}
+}
+
+void ASTSerializer::write_token_pattern(const TokenPattern& token_pattern)
+{
+	writer.write_u8(static_cast<uint8_t>(token_pattern.token_type));
+	write_optional_string(token_pattern.lexeme);
+}
+
+ASTDeserializer::ASTDeserializer(BinaryReader& init_reader, const OperatorMap* init_operator_map)
+	: reader{init_reader}, operator_map{init_operator_map} {}
+
+template<typename Enum>
+Enum ASTDeserializer::read_enum(Enum max)
+{
+	const uint8_t value = reader.read_u8();
+
+	if(value > static_cast<uint8_t>(max))
+	{
+		throw_invalid_tag();
+	}
+
+	return static_cast<Enum>(value);
+}
+
+std::unique_ptr<PackageMember> ASTDeserializer::read_package_member()
+{
+	switch(read_enum(NodeTag::OPERATOR_CALL))
+	{
+		case NodeTag::ENTRYPOINT:
+		{
+			Access access = read_access();
+			ParameterDeclarationList parameters = read_parameters();
+			CodeBlock body = read_code_block();
+			return std::make_unique<Entrypoint>(std::move(access), std::move(parameters), std::move(body));
+		}
+		case NodeTag::OPERATOR_MODULE:
+		{
+			Access access = read_access();
+
+			std::vector<OperatorDeclaration> operators;
+			const uint32_t operator_count = reader.read_u32();
+			for(uint32_t i = 0; i < operator_count; ++i)
+			{
+				operators.push_back(read_operator_declaration());
+			}
+
+			std::vector<OperatorFunction> functions;
+			const uint32_t function_count = reader.read_u32();
+			for(uint32_t i = 0; i < function_count; ++i)
+			{
+				functions.push_back(read_operator_function());
+			}
+
+			return std::make_unique<OperatorModule>(std::move(access), std::move(operators), std::move(functions));
+		}
+		default: throw_invalid_tag();
+	}
+}
+
+Identifier ASTDeserializer::read_identifier()
+{
+	Identifier identifier{};
+
+	const uint32_t count = reader.read_u32();
+	for(uint32_t i = 0; i < count; ++i)
+	{
+		identifier.parts.push_back(reader.read_string());
+	}
+
+	return identifier;
+}
+
+Access ASTDeserializer::read_access()
+{
+	Access access{read_enum(AccessType::EXCLUSIVE)};
+
+	const uint32_t count = reader.read_u32();
+	for(uint32_t i = 0; i < count; ++i)
+	{
+		const PackageMemberPatternType type = read_enum(PackageMemberPatternType::PACKAGE_WITH_SUBPACKAGES);
+		std::optional<Identifier> package_member_identifier = read_optional_identifier();
+		std::optional<Identifier> supertype = read_optional_identifier();
+
+		access.patterns.push_back(PackageMemberPattern{type, std::move(package_member_identifier), std::move(supertype)});
+	}
+
+	return access;
+}
+
+OperatorDeclaration ASTDeserializer::read_operator_declaration()
+{
+	std::vector<OperatorSyntaxPatternElement> pattern;
+
+	const uint32_t count = reader.read_u32();
+	for(uint32_t i = 0; i < count; ++i)
+	{
+		if(read_enum(PatternElementTag::TOKEN) == PatternElementTag::PARAMETER)
+		{
+			pattern.push_back(OperatorSyntaxParameter{});
+		}
+		else
+		{
+			pattern.push_back(read_token_pattern());
+		}
+	}
+
+	const uint subordination = reader.read_u32();
+	const OperatorAssociativity associativity = read_enum(OperatorAssociativity::RIGHT);
+	const BuiltinOperatorKind builtin_operator_kind = read_enum(BuiltinOperatorKind::ASSIGNMENT);
+	const reading::SourcePosition source_position = read_source_position();
+
+	return OperatorDeclaration{std::move(pattern), subordination, associativity, builtin_operator_kind, source_position};
+}
+
+OperatorFunction ASTDeserializer::read_operator_function()
+{
+	ReferenceType return_type = read_reference_type();
+
+	std::vector<GenericParameter> generic_parameters;
+	const uint32_t generic_parameter_count = reader.read_u32();
+	for(uint32_t i = 0; i < generic_parameter_count; ++i)
+	{
+		std::string type = reader.read_string();
+		std::string reference_name = reader.read_string();
+
+		std::vector<std::string> supertypes;
+		const uint32_t supertype_count = reader.read_u32();
+		for(uint32_t j = 0; j < supertype_count; ++j)
+		{
+			supertypes.push_back(reader.read_string());
+		}
+
+		generic_parameters.push_back(GenericParameter{std::move(type), std::move(reference_name), std::move(supertypes)});
+	}
+
+	std::vector<OperatorFunctionPatternElement> pattern;
+	const uint32_t pattern_count = reader.read_u32();
+	for(uint32_t i = 0; i < pattern_count; ++i)
+	{
+		if(read_enum(PatternElementTag::TOKEN) == PatternElementTag::PARAMETER)
+		{
+			VariableDeclaration parameter = read_variable_declaration();
+			pattern.push_back(OperatorFunctionParameter{parameter});
+		}
+		else
+		{
+			pattern.push_back(read_token_pattern());
+		}
+	}
+
+	CodeBlock body = read_code_block();
+
+	return OperatorFunction{std::move(return_type), std::move(generic_parameters), std::move(pattern), std::move(body)};
+}
+
+std::unique_ptr<Statement> ASTDeserializer::read_statement()
+{
+	switch(read_enum(NodeTag::OPERATOR_CALL))
+	{
+		case NodeTag::NONE:               return nullptr;
+		case NodeTag::DISCARD_EXPRESSION: return std::make_unique<DiscardExpression>(read_expression());
+		case NodeTag::RETURN:             return std::make_unique<Return>(read_expression());
+		default:                          throw_invalid_tag();
+	}
+}
+
+std::unique_ptr<Expression> ASTDeserializer::read_expression()
+{
+	std::unique_ptr<Expression> expression = read_expression_node();
+
+	if(expression)
+	{
+		expression->source_position = read_source_position();
+	}
+
+	return expression;
+}
+
+std::unique_ptr<Expression> ASTDeserializer::read_expression_node()
+{
+	switch(read_enum(NodeTag::OPERATOR_CALL))
+	{
+		case NodeTag::NONE: return nullptr;
+		case NodeTag::ASSIGNMENT:
+		{
+			std::unique_ptr<Expression> target = read_expression();
+			std::unique_ptr<Expression> value = read_expression();
+			return std::make_unique<Assignment>(std::move(target), std::move(value));
+		}
+		case NodeTag::OBJECT_FUNCTION_CALL:
+		{
+			std::unique_ptr<Expression> object = read_expression();
+			std::string member_name = reader.read_string();
+			std::vector<GenericArgument> generic_arguments = read_generic_arguments();
+			return std::make_unique<ObjectFunctionCall>
+			(
+				std::move(object),
+				std::move(member_name),
+				std::move(generic_arguments),
+				read_expressions()
+			);
+		}
+		case NodeTag::OBJECT_READ:
+		{
+			std::unique_ptr<Expression> object = read_expression();
+			return std::make_unique<ObjectRead>(std::move(object), reader.read_string());
+		}
+		case NodeTag::FUNCTION_CALL:
+		{
+			std::string function_name = reader.read_string();
+			std::vector<GenericArgument> generic_arguments = read_generic_arguments();
+			return std::make_unique<FunctionCall>(std::move(function_name), std::move(generic_arguments), read_expressions());
+		}
+		case NodeTag::SIMPLE_READ: return std::make_unique<SimpleRead>(reader.read_string());
+		case NodeTag::OPT_FUNCTION_CALL:
+		{
+			std::unique_ptr<OptFunctionCall> call = std::make_unique<OptFunctionCall>();
+			call->function_name = reader.read_string();
+			call->arguments = read_expressions();
+			return call;
+		}
+		case NodeTag::OPT_EMPTY:       return std::make_unique<OptEmpty>();
+		case NodeTag::LITERAL_NUMBER:  return std::make_unique<LiteralNumberExpression>(reader.read_string());
+		case NodeTag::LITERAL_STRING:  return std::make_unique<LiteralStringExpression>(reader.read_string());
+		case NodeTag::LITERAL_BOOLEAN: return std::make_unique<LiteralBooleanExpression>(reader.read_bool());
+		case NodeTag::OPERATOR_CALL:
+		{
+			std::shared_ptr<const Operator> op = read_operator();
+			return std::make_unique<OperatorCallExpression>(read_expressions(), op);
+		}
+		default: throw_invalid_tag();
+	}
+}
+
+std::vector<std::unique_ptr<Expression>> ASTDeserializer::read_expressions()
+{
+	std::vector<std::unique_ptr<Expression>> expressions;
+
+	const uint32_t count = reader.read_u32();
+	for(uint32_t i = 0; i < count; ++i)
+	{
+		expressions.push_back(read_expression());
+	}
+
+	return expressions;
+}
+
+reading::SourcePosition ASTDeserializer::read_source_position()
+{
+	return reading::SourcePosition{reader.read_u32(), reader.read_u32(), reader.read_u32()};
+}
+
+std::optional<Identifier> ASTDeserializer::read_optional_identifier()
+{
+	if(!reader.read_bool()) { return std::nullopt; }
+	return read_identifier();
+}
+
+std::optional<std::string> ASTDeserializer::read_optional_string()
+{
+	if(!reader.read_bool()) { return std::nullopt; }
+	return reader.read_string();
+}
+
+ReferenceType ASTDeserializer::read_reference_type()
+{
+	const bool opt = reader.read_bool();
+	const MutabilityMode mutability = read_enum(MutabilityMode::BORROW);
+	const bool mut = reader.read_bool();
+	std::string type = reader.read_string();
+	std::string inferred_name = reader.read_string();
+
+	return ReferenceType{opt, mutability, mut, std::move(type), std::move(inferred_name), read_generic_arguments()};
+}
+
+VariableDeclaration ASTDeserializer::read_variable_declaration()
+{
+	const bool var = reader.read_bool();
+	ReferenceType reference_type = read_reference_type();
+	std::string reference_name = reader.read_string();
+
+	return VariableDeclaration{var, std::move(reference_type), std::move(reference_name), read_expression()};
+}
+
+ParameterDeclarationList ASTDeserializer::read_parameters()
+{
+	ParameterDeclarationList parameters;
+
+	const uint32_t count = reader.read_u32();
+	for(uint32_t i = 0; i < count; ++i)
+	{
+		parameters.push_back(read_variable_declaration());
+	}
+
+	return parameters;
+}
+
+std::vector<GenericArgument> ASTDeserializer::read_generic_arguments()
+{
+	std::vector<GenericArgument> generic_arguments;
+
+	const uint32_t count = reader.read_u32();
+	for(uint32_t i = 0; i < count; ++i)
+	{
+		std::string value = reader.read_string();
+		const bool is_reference = reader.read_bool();
+		generic_arguments.push_back(GenericArgument{std::move(value), is_reference, read_generic_arguments()});
+	}
+
+	return generic_arguments;
+}
+
+CodeBlock ASTDeserializer::read_code_block()
+{
+	std::vector<std::unique_ptr<Statement>> statements;
+
+	const uint32_t count = reader.read_u32();
+	for(uint32_t i = 0; i < count; ++i)
+	{
+		statements.push_back(read_statement());
+	}
+
+	return CodeBlock{std::move(statements)};
+}
+
+TokenPattern ASTDeserializer::read_token_pattern()
+{
+	const TokenType token_type = read_enum(TokenType::STMT_COPY);
+	return TokenPattern{token_type, read_optional_string()};
+}
+
+std::shared_ptr<const Operator> ASTDeserializer::read_operator()
+{
+	if(read_enum(OperatorSource::OPERATOR_MODULE) == OperatorSource::BUILTIN)
+	{
+		const uint32_t index = reader.read_u32();
+
+		if(index >= builtin_operators::LIST.size())
+		{
+			throw CacheFormatException{std::string{ast_serializer_error_messages::UNKNOWN_OPERATOR}};
+		}
+
+		return builtin_operators::LIST[index];
+	}
+
+	const std::string module = reader.read_string();
+	const uint32_t index = reader.read_u32();
+
+	if(!operator_map)
+	{
+		throw CacheFormatException{std::string{ast_serializer_error_messages::UNKNOWN_OPERATOR}};
+	}
+
+	OperatorMap::const_iterator it = operator_map->find(module);
+
+	if(it == operator_map->end() || index >= it->second.size())
+	{
+		throw CacheFormatException{std::string{ast_serializer_error_messages::UNKNOWN_OPERATOR}};
+	}
+
+	return it->second[index];
+}
@@ -0,0 +1,134 @@
+#ifndef AST_SERIALIZER_HPP
+#define AST_SERIALIZER_HPP
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "binary_io.hpp"
+#include "../ast/identifiers.hpp"
+#include "../ast/nodes/nodes.hpp"
+#include "../ast/nodes/statement_nodes.hpp"
+#include "../parser/parser.hpp"
+
+namespace neon_compiler::cache
+{
+
+namespace ast_serializer_error_messages
+{
+	constexpr std::string_view UNSUPPORTED_NODE =
+		"Node type is not supported by the AST cache";
+	constexpr std::string_view UNKNOWN_OPERATOR =
+		"Operator call refers to an operator outside of the operator map";
+	constexpr std::string_view INVALID_TAG =
+		"Invalid node tag";
+}
+
+/** Mapping from operator to the operator module identifier and the index in its `OperatorMap` list.
+ * Operator calls are stored as such a reference, since operators are owned by the operator map. */
+using OperatorReferences = std::unordered_map<const neon_compiler::parser::Operator*, std::pair<std::string, uint32_t>>;
+
+OperatorReferences create_operator_references(const neon_compiler::parser::OperatorMap& operator_map);
+
+/** Writes AST nodes produced by the parser. Throws `CacheFormatException` for nodes it does not support. */
+class ASTSerializer : public neon_compiler::ast::ASTVisitor
+{
+public:
+	explicit ASTSerializer(BinaryWriter& init_writer, const OperatorReferences& init_operator_references);
+
+	void write_package_member(const neon_compiler::ast::nodes::PackageMember& node);
+	void write_identifier(const neon_compiler::ast::Identifier& identifier);
+	void write_access(const neon_compiler::ast::nodes::Access& access);
+	void write_operator_declaration(const neon_compiler::ast::nodes::OperatorDeclaration& node);
+	/** Writes what determines how the operator is parsed, which excludes its source position */
+	void write_operator_syntax(const neon_compiler::ast::nodes::OperatorDeclaration& node);
+	void write_operator_function(const neon_compiler::ast::nodes::OperatorFunction& node);
+
+	void visit(const neon_compiler::ast::nodes::Root& node) override;
+	void visit(const neon_compiler::ast::nodes::Entrypoint& node) override;
+	void visit(const neon_compiler::ast::nodes::Type& node) override;
+	void visit(const neon_compiler::ast::nodes::VariableDeclaration& node) override;
+	void visit(const neon_compiler::ast::nodes::Field& node) override;
+	void visit(const neon_compiler::ast::nodes::Method& node) override;
+	void visit(const neon_compiler::ast::nodes::Constant& node) override;
+	void visit(const neon_compiler::ast::nodes::ReferenceType& node) override;
+	void visit(const neon_compiler::ast::nodes::CodeBlock& node) override;
+	void visit(const neon_compiler::ast::nodes::DiscardExpression& node) override;
+	void visit(const neon_compiler::ast::nodes::LocalDeclaration& node) override;
+	void visit(const neon_compiler::ast::nodes::AutoCall& node) override;
+	void visit(const neon_compiler::ast::nodes::Return& node) override;
+	void visit(const neon_compiler::ast::nodes::Assignment& node) override;
+	void visit(const neon_compiler::ast::nodes::ObjectFunctionCall& node) override;
+	void visit(const neon_compiler::ast::nodes::ObjectRead& node) override;
+	void visit(const neon_compiler::ast::nodes::FunctionCall& node) override;
+	void visit(const neon_compiler::ast::nodes::SimpleRead& node) override;
+	void visit(const neon_compiler::ast::nodes::OptFunctionCall& node) override;
+	void visit(const neon_compiler::ast::nodes::OptEmpty& node) override;
+	void visit(const neon_compiler::ast::nodes::PureFunctionSet& node) override;
+	void visit(const neon_compiler::ast::nodes::PureFunction& node) override;
+	void visit(const neon_compiler::ast::nodes::OperatorModule& node) override;
+	void visit(const neon_compiler::ast::nodes::OperatorDeclaration& node) override;
+	void visit(const neon_compiler::ast::nodes::OperatorFunction& node) override;
+	void visit(const neon_compiler::ast::nodes::CompileFunction& node) override;
+	void visit(const neon_compiler::ast::nodes::LiteralNumberExpression& node) override;
+	void visit(const neon_compiler::ast::nodes::LiteralStringExpression& node) override;
+	void visit(const neon_compiler::ast::nodes::LiteralBooleanExpression& node) override;
+	void visit(const neon_compiler::ast::nodes::OperatorCallExpression& node) override;
+
+private:
+	BinaryWriter& writer;
+	const OperatorReferences& operator_references;
+
+	void write_node(const neon_compiler::ast::ASTNode* node);
+	/** Writes the expression followed by its source position */
+	void write_expression(const neon_compiler::ast::nodes::Expression* node);
+	void write_nodes(const std::vector<std::unique_ptr<neon_compiler::ast::nodes::Expression>>& nodes);
+	void write_optional_identifier(const std::optional<neon_compiler::ast::Identifier>& identifier);
+	void write_optional_string(const std::optional<std::string>& str);
+	void write_generic_arguments(const std::vector<neon_compiler::ast::nodes::GenericArgument>& generic_arguments);
+	void write_parameters(const neon_compiler::ast::nodes::ParameterDeclarationList& parameters);
+	void write_token_pattern(const neon_compiler::ast::nodes::TokenPattern& token_pattern);
+	void write_source_position(const reading::SourcePosition& source_position);
+};
+
+/** Reads what `ASTSerializer` wrote. Operator calls are resolved against `operator_map`, if given. */
+class ASTDeserializer
+{
+public:
+	explicit ASTDeserializer(BinaryReader& init_reader, const neon_compiler::parser::OperatorMap* init_operator_map);
+
+	std::unique_ptr<neon_compiler::ast::nodes::PackageMember> read_package_member();
+	neon_compiler::ast::Identifier read_identifier();
+	neon_compiler::ast::nodes::Access read_access();
+	neon_compiler::ast::nodes::OperatorDeclaration read_operator_declaration();
+	neon_compiler::ast::nodes::OperatorFunction read_operator_function();
+
+private:
+	BinaryReader& reader;
+	const neon_compiler::parser::OperatorMap* operator_map;
+
+	std::unique_ptr<neon_compiler::ast::nodes::Statement> read_statement();
+	std::unique_ptr<neon_compiler::ast::nodes::Expression> read_expression();
+	/** Reads an expression without its source position */
+	std::unique_ptr<neon_compiler::ast::nodes::Expression> read_expression_node();
+	std::vector<std::unique_ptr<neon_compiler::ast::nodes::Expression>> read_expressions();
+	std::optional<neon_compiler::ast::Identifier> read_optional_identifier();
+	std::optional<std::string> read_optional_string();
+	neon_compiler::ast::nodes::ReferenceType read_reference_type();
+	neon_compiler::ast::nodes::VariableDeclaration read_variable_declaration();
+	neon_compiler::ast::nodes::ParameterDeclarationList read_parameters();
+	std::vector<neon_compiler::ast::nodes::GenericArgument> read_generic_arguments();
+	neon_compiler::ast::nodes::CodeBlock read_code_block();
+	neon_compiler::ast::nodes::TokenPattern read_token_pattern();
+	std::shared_ptr<const neon_compiler::parser::Operator> read_operator();
+	reading::SourcePosition read_source_position();
+
+	template<typename Enum>
+	Enum read_enum(Enum max);
+};
+
+}
+
+#endif // AST_SERIALIZER_HPP
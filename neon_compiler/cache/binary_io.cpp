@@ -0,0 +1,103 @@
+#include "binary_io.hpp"
+
+using namespace neon_compiler::cache;
+
+void BinaryWriter::write_u8(uint8_t value)
+{
+	buffer += static_cast<char>(value);
+}
+
+void BinaryWriter::write_u32(uint32_t value)
+{
+	for(int shift = 0; shift < 32; shift += 8)
+	{
+		buffer += static_cast<char>((value >> shift) & 0xFF);
+	}
+}
+
+void BinaryWriter::write_u64(uint64_t value)
+{
+	for(int shift = 0; shift < 64; shift += 8)
+	{
+		buffer += static_cast<char>((value >> shift) & 0xFF);
+	}
+}
+
+void BinaryWriter::write_bool(bool value)
+{
+	write_u8(value ? 1 : 0);
+}
+
+void BinaryWriter::write_string(std::string_view value)
+{
+	write_u32(static_cast<uint32_t>(value.size()));
+	buffer += value;
+}
+
+void BinaryWriter::write_bytes(std::string_view bytes)
+{
+	buffer += bytes;
+}
+
+const std::string& BinaryWriter::get_buffer() const
+{
+	return buffer;
+}
+
+BinaryReader::BinaryReader(std::string_view init_data)
+	: data{init_data} {}
+
+uint8_t BinaryReader::read_u8()
+{
+	return static_cast<uint8_t>(read_bytes(1)[0]);
+}
+
+uint32_t BinaryReader::read_u32()
+{
+	const std::string_view bytes = read_bytes(4);
+	uint32_t value = 0;
+	for(std::size_t i = 0; i < 4; ++i)
+	{
+		value |= static_cast<uint32_t>(static_cast<unsigned char>(bytes[i])) << (i * 8);
+	}
+	return value;
+}
+
+uint64_t BinaryReader::read_u64()
+{
+	const std::string_view bytes = read_bytes(8);
+	uint64_t value = 0;
+	for(std::size_t i = 0; i < 8; ++i)
+	{
+		value |= static_cast<uint64_t>(static_cast<unsigned char>(bytes[i])) << (i * 8);
+	}
+	return value;
+}
+
+bool BinaryReader::read_bool()
+{
+	return read_u8() != 0;
+}
+
+std::string BinaryReader::read_string()
+{
+	const uint32_t size = read_u32();
+	return std::string{read_bytes(size)};
+}
+
+std::string_view BinaryReader::read_bytes(std::size_t count)
+{
+	if(count > data.size() - position)
+	{
+		throw CacheFormatException{"Unexpected end of cache data"};
+	}
+
+	const std::string_view bytes = data.substr(position, count);
+	position += count;
+	return bytes;
+}
+
+bool BinaryReader::end_reached() const
+{
+	return position == data.size();
+}
@@ -0,0 +1,57 @@
+#ifndef BINARY_IO_HPP
+#define BINARY_IO_HPP
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace neon_compiler::cache
+{
+
+class CacheFormatException : public std::runtime_error
+{
+public:
+	explicit CacheFormatException(const std::string& msg)
+	: std::runtime_error{msg} {}
+};
+
+/** Appends fixed-width little-endian values and length-prefixed strings to a buffer */
+class BinaryWriter
+{
+public:
+	void write_u8(uint8_t value);
+	void write_u32(uint32_t value);
+	void write_u64(uint64_t value);
+	void write_bool(bool value);
+	void write_string(std::string_view value);
+	void write_bytes(std::string_view bytes);
+
+	const std::string& get_buffer() const;
+
+private:
+	std::string buffer;
+};
+
+/** Reads what `BinaryWriter` wrote. Throws `CacheFormatException` when reading past the end. */
+class BinaryReader
+{
+public:
+	explicit BinaryReader(std::string_view init_data);
+
+	uint8_t read_u8();
+	uint32_t read_u32();
+	uint64_t read_u64();
+	bool read_bool();
+	std::string read_string();
+	std::string_view read_bytes(std::size_t count);
+	bool end_reached() const;
+
+private:
+	std::string_view data;
+	std::size_t position{0};
+};
+
+}
+
+#endif // BINARY_IO_HPP
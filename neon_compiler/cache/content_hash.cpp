@@ -0,0 +1,113 @@
+#include "content_hash.hpp"
+
+#include <cstring>
+
+using namespace neon_compiler::cache;
+
+namespace
+{
+	constexpr uint64_t PRIME_1 = 0x9E3779B185EBCA87ULL;
+	constexpr uint64_t PRIME_2 = 0xC2B2AE3D27D4EB4FULL;
+	constexpr uint64_t PRIME_3 = 0x165667B19E3779F9ULL;
+	constexpr uint64_t PRIME_4 = 0x85EBCA77C2B2AE63ULL;
+	constexpr uint64_t PRIME_5 = 0x27D4EB2F165667C5ULL;
+
+	uint64_t rotate_left(uint64_t value, int bits)
+	{
+		return (value << bits) | (value >> (64 - bits));
+	}
+
+	// Reads little-endian, like the reference implementation on the platforms we target
+	uint64_t read_64(const char* p)
+	{
+		uint64_t value;
+		std::memcpy(&value, p, sizeof(value));
+		return value;
+	}
+
+	uint32_t read_32(const char* p)
+	{
+		uint32_t value;
+		std::memcpy(&value, p, sizeof(value));
+		return value;
+	}
+
+	uint64_t round(uint64_t accumulator, uint64_t input)
+	{
+		accumulator += input * PRIME_2;
+		accumulator = rotate_left(accumulator, 31);
+		return accumulator * PRIME_1;
+	}
+
+	uint64_t merge_round(uint64_t accumulator, uint64_t value)
+	{
+		accumulator ^= round(0, value);
+		return accumulator * PRIME_1 + PRIME_4;
+	}
+}
+
+uint64_t neon_compiler::cache::hash_content(std::string_view data, uint64_t seed)
+{
+	const char* p = data.data();
+	const char* const end = p + data.size();
+	uint64_t hash;
+
+	if(data.size() >= 32)
+	{
+		const char* const limit = end - 32;
+		uint64_t v1 = seed + PRIME_1 + PRIME_2;
+		uint64_t v2 = seed + PRIME_2;
+		uint64_t v3 = seed;
+		uint64_t v4 = seed - PRIME_1;
+
+		do
+		{
+			v1 = round(v1, read_64(p)); p += 8;
+			v2 = round(v2, read_64(p)); p += 8;
+			v3 = round(v3, read_64(p)); p += 8;
+			v4 = round(v4, read_64(p)); p += 8;
+		}
+		while(p <= limit);
+
+		hash = rotate_left(v1, 1) + rotate_left(v2, 7) + rotate_left(v3, 12) + rotate_left(v4, 18);
+		hash = merge_round(hash, v1);
+		hash = merge_round(hash, v2);
+		hash = merge_round(hash, v3);
+		hash = merge_round(hash, v4);
+	}
+	else
+	{
+		hash = seed + PRIME_5;
+	}
+
+	hash += static_cast<uint64_t>(data.size());
+
+	while(p + 8 <= end)
+	{
+		hash ^= round(0, read_64(p));
+		hash = rotate_left(hash, 27) * PRIME_1 + PRIME_4;
+		p += 8;
+	}
+
+	if(p + 4 <= end)
+	{
+		hash ^= static_cast<uint64_t>(read_32(p)) * PRIME_1;
+		hash = rotate_left(hash, 23) * PRIME_2 + PRIME_3;
+		p += 4;
+	}
+
+	while(p < end)
+	{
+		hash ^= static_cast<uint64_t>(static_cast<unsigned char>(*p)) * PRIME_5;
+		hash = rotate_left(hash, 11) * PRIME_1;
+		++p;
+	}
+
+	hash ^= hash >> 33;
+	hash *= PRIME_2;
+	hash ^= hash >> 29;
+	hash *= PRIME_3;
+	hash ^= hash >> 32;
+
+	return hash;
+}
@@ -0,0 +1,15 @@
+#ifndef CONTENT_HASH_HPP
+#define CONTENT_HASH_HPP
+
+#include <cstdint>
+#include <string_view>
+
+namespace neon_compiler::cache
+{
+
+/** XXH64 hash of `data`. Fast enough to hash every source file on startup to key caches by content. */
+uint64_t hash_content(std::string_view data, uint64_t seed = 0);
+
+}
+
+#endif // CONTENT_HASH_HPP
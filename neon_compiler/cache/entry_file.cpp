@@ -0,0 +1,46 @@
+#include "entry_file.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <system_error>
+
+std::filesystem::path neon_compiler::cache::get_entry_path
+(
+	const std::filesystem::path& directory,
+	uint64_t content_hash,
+	std::string_view extension
+)
+{
+	char name[17];
+	std::snprintf(name, sizeof(name), "%016llx", static_cast<unsigned long long>(content_hash));
+
+	std::filesystem::path path = directory / name;
+	path += extension;
+	return path;
+}
+
+bool neon_compiler::cache::write_entry_file(const std::filesystem::path& path, std::string_view data)
+{
+	std::error_code ec;
+	std::filesystem::create_directories(path.parent_path(), ec);
+	if(ec)
+	{
+		return false;
+	}
+
+	std::filesystem::path temporary_path = path;
+	temporary_path += ".tmp";
+
+	{
+		std::ofstream out{temporary_path, std::ios::binary | std::ios::trunc};
+		out.write(data.data(), static_cast<std::streamsize>(data.size()));
+		if(!out)
+		{
+			return false;
+		}
+	}
+
+	std::filesystem::rename(temporary_path, path, ec);
+
+	return !ec;
+}
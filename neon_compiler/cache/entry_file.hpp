@@ -0,0 +1,20 @@
+#ifndef ENTRY_FILE_HPP
+#define ENTRY_FILE_HPP
+
+#include <cstdint>
+#include <filesystem>
+#include <string_view>
+
+namespace neon_compiler::cache
+{
+
+/** Path of the cache entry for `content_hash`: `<directory>/<16 hex digits><extension>` */
+std::filesystem::path get_entry_path(const std::filesystem::path& directory, uint64_t content_hash, std::string_view extension);
+
+/** Writes `data` to a temporary file next to `path` and renames it into place,
+ * so concurrent runs never map a partially written entry. Returns false on failure. */
+bool write_entry_file(const std::filesystem::path& path, std::string_view data);
+
+}
+
+#endif // ENTRY_FILE_HPP
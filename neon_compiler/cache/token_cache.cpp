@@ -0,0 +1,143 @@
+#include "token_cache.hpp"
+
+#include "binary_io.hpp"
+#include "entry_file.hpp"
+#include "../lexer/lexer.hpp"
+#include "../../file_reading/mapped_file.hpp"
+
+using namespace neon_compiler;
+using namespace neon_compiler::cache;
+using namespace neon_compiler::lexer;
+
+TokenCache::TokenCache(std::filesystem::path init_directory)
+	: directory{std::move(init_directory)} {}
+
+std::optional<CachedTokens> TokenCache::load(uint64_t content_hash) const
+{
+	file_reading::MappedFile mapped_file{};
+
+	if(!mapped_file.open_file(get_entry_path(directory, content_hash, ENTRY_EXTENSION).string()))
+	{
+		return std::nullopt;
+	}
+
+	try
+	{
+		BinaryReader reader{mapped_file.get_contents()};
+
+		if(reader.read_bytes(MAGIC.size()) != MAGIC ||
+			reader.read_u32() != FORMAT_VERSION ||
+			reader.read_u32() != LEXER_VERSION ||
+			reader.read_u64() != content_hash)
+		{
+			return std::nullopt;
+		}
+
+		const uint32_t token_count = reader.read_u32();
+		const uint32_t error_count = reader.read_u32();
+
+		CachedTokens cached{};
+		cached.tokens.reserve(token_count);
+		cached.errors.reserve(error_count);
+
+		for(uint32_t i = 0; i < token_count; ++i)
+		{
+			const uint8_t type = reader.read_u8();
+			if(type > static_cast<uint8_t>(TokenType::STMT_COPY))
+			{
+				return std::nullopt;
+			}
+
+			const reading::SourcePosition sp{reader.read_u32(), reader.read_u32(), reader.read_u32()};
+			const uint32_t length = reader.read_u32();
+
+			std::optional<std::string> lexeme{std::nullopt};
+			if(reader.read_bool())
+			{
+				lexeme = reader.read_string();
+			}
+
+			cached.tokens.emplace_back(static_cast<TokenType>(type), sp, length, std::move(lexeme));
+		}
+
+		for(uint32_t i = 0; i < error_count; ++i)
+		{
+			const reading::SourcePosition sp{reader.read_u32(), reader.read_u32(), reader.read_u32()};
+			const uint32_t message_index = reader.read_u32();
+
+			if(message_index >= error_messages::ALL.size())
+			{
+				return std::nullopt;
+			}
+
+			cached.errors.push_back(TokenisationError{sp, error_messages::ALL[message_index]});
+		}
+
+		if(!reader.end_reached())
+		{
+			return std::nullopt;
+		}
+
+		return cached;
+	}
+	catch(const CacheFormatException&)
+	{
+		return std::nullopt;
+	}
+}
+
+bool TokenCache::store
+(
+	uint64_t content_hash,
+	const std::vector<Token>& tokens,
+	const std::vector<TokenisationError>& errors
+) const
+{
+	BinaryWriter writer{};
+
+	writer.write_bytes(MAGIC);
+	writer.write_u32(FORMAT_VERSION);
+	writer.write_u32(LEXER_VERSION);
+	writer.write_u64(content_hash);
+	writer.write_u32(static_cast<uint32_t>(tokens.size()));
+	writer.write_u32(static_cast<uint32_t>(errors.size()));
+
+	for(const Token& token : tokens)
+	{
+		const reading::SourcePosition sp = token.get_source_position();
+
+		writer.write_u8(static_cast<uint8_t>(token.get_type()));
+		writer.write_u32(sp.offset_in_file);
+		writer.write_u32(sp.newlines_count);
+		writer.write_u32(sp.offset_in_line);
+		writer.write_u32(token.get_length());
+
+		const std::optional<std::string_view> lexeme = token.get_lexeme();
+		writer.write_bool(lexeme.has_value());
+		if(lexeme.has_value())
+		{
+			writer.write_string(lexeme.value());
+		}
+	}
+
+	for(const TokenisationError& error : errors)
+	{
+		uint32_t message_index = 0;
+		while(message_index < error_messages::ALL.size() && error_messages::ALL[message_index] != error.message)
+		{
+			++message_index;
+		}
+
+		if(message_index == error_messages::ALL.size())
+		{
+			return false; // Not representable, so do not cache
+		}
+
+		writer.write_u32(error.source_position.offset_in_file);
+		writer.write_u32(error.source_position.newlines_count);
+		writer.write_u32(error.source_position.offset_in_line);
+		writer.write_u32(message_index);
+	}
+
+	return write_entry_file(get_entry_path(directory, content_hash, ENTRY_EXTENSION), writer.get_buffer());
+}
@@ -0,0 +1,49 @@
+#ifndef TOKEN_CACHE_HPP
+#define TOKEN_CACHE_HPP
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string_view>
+#include <vector>
+#include "../token.hpp"
+#include "../lexer/tokenisation_error.hpp"
+
+namespace neon_compiler::cache
+{
+
+struct CachedTokens
+{
+	std::vector<neon_compiler::Token> tokens;
+	std::vector<neon_compiler::lexer::TokenisationError> errors;
+};
+
+/** On-disk cache of lexer output, keyed by the content hash of the source file.
+ * Entries record the lexer version, so a changed lexer never uses stale token streams.
+ * One file per entry (named after the hash), loaded through a memory mapping. */
+class TokenCache
+{
+public:
+	explicit TokenCache(std::filesystem::path init_directory);
+
+	/** Returns the cached lexer output for content with `content_hash`, or nothing if absent, stale or corrupt. */
+	std::optional<CachedTokens> load(uint64_t content_hash) const;
+	/** Stores lexer output. Returns false if the entry could not be written. */
+	bool store
+	(
+		uint64_t content_hash,
+		const std::vector<neon_compiler::Token>& tokens,
+		const std::vector<neon_compiler::lexer::TokenisationError>& errors
+	) const;
+
+private:
+	static constexpr std::string_view MAGIC = "NTOK";
+	static constexpr uint32_t FORMAT_VERSION = 1;
+	static constexpr std::string_view ENTRY_EXTENSION = ".ntok";
+
+	std::filesystem::path directory;
+};
+
+}
+
+#endif // TOKEN_CACHE_HPP
@@ -0,0 +1,119 @@
+#include "c_builder.hpp"
+
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include "../reference_counting/refcount_runtime.hpp"
+#include "../trace/trace.hpp"
+
+using namespace neon_compiler::codegen;
+
+namespace
+{
+	constexpr std::string_view EXECUTABLE_NAME = "program";
+
+	/** Quotes `argument` for the POSIX shell that `std::system` runs */
+	std::string quote(const std::string& argument)
+	{
+		std::string quoted{"'"};
+
+		for(const char c : argument)
+		{
+			if(c == '\'') { quoted += "'\\''"; }
+			else { quoted += c; }
+		}
+
+		return quoted + "'";
+	}
+
+	bool write_file(const std::filesystem::path& path, const std::string& content)
+	{
+		std::ofstream out{path, std::ios::binary};
+		out << content;
+		return static_cast<bool>(out);
+	}
+}
+
+CBuilder::CBuilder(concurrency::WorkStealingPool& init_pool, CBuildOptions init_options)
+	: pool{init_pool}, options{std::move(init_options)} {}
+
+std::vector<std::string> CBuilder::build(const GeneratedProgram& program) const
+{
+	const trace::Span span{"CBuilder::build"};
+
+	std::error_code error_code;
+	std::filesystem::create_directories(options.directory, error_code);
+
+	if(!write_file(options.directory / program.header.file_name, program.header.source))
+	{
+		return {std::string{c_builder_error_messages::COULD_NOT_WRITE} + (options.directory / program.header.file_name).string()};
+	}
+
+	std::string compile_options = "-std=c11 -O2 -pthread";
+	if(options.verify_thread_local)
+	{
+		compile_options += " -D" + std::string{reference_counting::VERIFY_THREAD_LOCAL_MACRO};
+	}
+
+	std::mutex errors_mutex;
+	std::vector<std::string> errors;
+	std::vector<std::filesystem::path> object_files(program.units.size());
+
+	pool.run(program.units.size(), [&] (std::size_t i)
+	{
+		const TranslationUnit& unit = program.units[i];
+		const std::filesystem::path source = options.directory / unit.file_name;
+		object_files[i] = std::filesystem::path{source}.replace_extension(".o");
+
+		std::optional<std::string> error;
+		if(!write_file(source, unit.source))
+		{
+			error = std::string{c_builder_error_messages::COULD_NOT_WRITE} + source.string();
+		}
+		else if(std::optional<std::string> output = run_c_compiler
+		(
+			compile_options + " -c " + quote(source.string()) + " -o " + quote(object_files[i].string()),
+			std::filesystem::path{source}.replace_extension(".log")
+		))
+		{
+			error = std::string{c_builder_error_messages::COMPILATION_FAILED} + unit.file_name + ":\n" + output.value();
+		}
+
+		if(error.has_value())
+		{
+			const std::lock_guard<std::mutex> lock{errors_mutex};
+			errors.push_back(std::move(error.value()));
+		}
+	});
+
+	if(!errors.empty()) { return errors; }
+
+	std::string link_arguments = "-pthread -o " + quote(get_executable_path().string());
+	for(const std::filesystem::path& object_file : object_files)
+	{
+		link_arguments += " " + quote(object_file.string());
+	}
+
+	if(std::optional<std::string> output = run_c_compiler(link_arguments, options.directory / "link.log"))
+	{
+		errors.push_back(std::string{c_builder_error_messages::LINKING_FAILED} + get_executable_path().string() + ":\n" + output.value());
+	}
+
+	return errors;
+}
+
+std::filesystem::path CBuilder::get_executable_path() const
+{
+	return options.directory / EXECUTABLE_NAME;
+}
+
+std::optional<std::string> CBuilder::run_c_compiler(const std::string& arguments, const std::filesystem::path& log) const
+{
+	const std::string command = options.c_compiler + " " + arguments + " > " + quote(log.string()) + " 2>&1";
+
+	if(std::system(command.c_str()) == 0) { return std::nullopt; }
+
+	std::ifstream in{log};
+	return std::string{std::istreambuf_iterator<char>{in}, std::istreambuf_iterator<char>{}};
+}
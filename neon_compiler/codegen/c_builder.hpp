@@ -0,0 +1,57 @@
+#ifndef C_BUILDER_HPP
+#define C_BUILDER_HPP
+
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "c_generator.hpp"
+#include "../../concurrency/work_stealing_pool.hpp"
+
+namespace neon_compiler::codegen
+{
+
+namespace c_builder_error_messages
+{
+	constexpr std::string_view COULD_NOT_WRITE =
+		"Could not write ";
+	constexpr std::string_view COMPILATION_FAILED =
+		"The C compiler failed on ";
+	constexpr std::string_view LINKING_FAILED =
+		"The C compiler failed to link ";
+}
+
+struct CBuildOptions
+{
+	/** Where the C sources, object files and executable are written */
+	std::filesystem::path directory;
+	/** Command of the C compiler, which must take GCC-style options (e.g. `cc`, `gcc`, `clang`) */
+	std::string c_compiler{"cc"};
+	/** Whether the runtime checks thread-local allocations (see `reference_counting::VERIFY_THREAD_LOCAL_MACRO`) */
+	bool verify_thread_local{false};
+};
+
+/** Writes a generated program and compiles it with the system C compiler into an executable.
+ * Translation units are compiled in parallel, each by its own compiler process, then linked. */
+class CBuilder
+{
+public:
+	CBuilder(concurrency::WorkStealingPool& init_pool, CBuildOptions init_options);
+
+	/** Returns the errors, with the output of the C compiler. Empty if the executable was built. */
+	std::vector<std::string> build(const GeneratedProgram& program) const;
+
+	std::filesystem::path get_executable_path() const;
+
+private:
+	concurrency::WorkStealingPool& pool;
+	CBuildOptions options;
+
+	/** Runs the C compiler with `arguments`, writing its output to `log`. Empty if it succeeded, else the output. */
+	std::optional<std::string> run_c_compiler(const std::string& arguments, const std::filesystem::path& log) const;
+};
+
+}
+
+#endif // C_BUILDER_HPP
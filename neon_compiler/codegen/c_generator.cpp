@@ -0,0 +1,930 @@
+#include "c_generator.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <unordered_set>
+#include <variant>
+#include "c_runtime.hpp"
+#include "../parser/operator.hpp"
+#include "../reference_counting/bodies.hpp"
+#include "../reference_counting/refcount_runtime.hpp"
+#include "../trace/trace.hpp"
+
+using namespace neon_compiler;
+using namespace neon_compiler::ast;
+using namespace neon_compiler::ast::nodes;
+using namespace neon_compiler::codegen;
+using namespace neon_compiler::evaluation;
+using namespace neon_compiler::reference_counting;
+using namespace neon_compiler::resolution;
+
+namespace
+{
+	constexpr std::string_view HEADER_FILE_NAME = "program.h";
+	constexpr std::string_view MAIN_FILE_NAME = "main.c";
+
+	constexpr std::string_view SEPARATOR = "::";
+
+	/** e.g. `main::Point` to `main__Point`. Distinct identifiers get distinct names, as every `_` in the result starts
+	 * an escape: `::` becomes `__`, `_` becomes `_u`, and other characters not allowed in C names become `_x` and two hex digits.
+	 * `_` followed by a digit never occurs, so it can separate the overload index appended to a name. */
+	std::string mangle(std::string_view identifier)
+	{
+		std::string mangled;
+		mangled.reserve(identifier.size());
+
+		for(std::size_t i = 0; i < identifier.size(); ++i)
+		{
+			const char c = identifier[i];
+			const bool word_character = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9');
+
+			if(word_character)
+			{
+				mangled += c;
+			}
+			else if(c == '_')
+			{
+				mangled += "_u";
+			}
+			else if(identifier.substr(i, SEPARATOR.size()) == SEPARATOR)
+			{
+				mangled += "__";
+				i += SEPARATOR.size() - 1;
+			}
+			else
+			{
+				char escaped[5];
+				std::snprintf(escaped, sizeof escaped, "_x%02x", static_cast<unsigned int>(static_cast<unsigned char>(c)));
+				mangled += escaped;
+			}
+		}
+
+		return mangled;
+	}
+
+	std::string to_c_string_literal(std::string_view text)
+	{
+		std::string literal{"\""};
+
+		for(const char c : text)
+		{
+			const unsigned char byte = static_cast<unsigned char>(c);
+
+			if(c == '"' || c == '\\' || c == '?')
+			{
+				// `?` too, as it may start a trigraph
+				literal += '\\';
+				literal += c;
+			}
+			else if(byte < 0x20 || byte >= 0x7F)
+			{
+				char escaped[5];
+				std::snprintf(escaped, sizeof escaped, "\\%03o", static_cast<unsigned int>(byte));
+				literal += escaped;
+			}
+			else
+			{
+				literal += c;
+			}
+		}
+
+		return literal + "\"";
+	}
+
+	std::string get_parameter_name(std::size_t index, const VariableDeclaration& parameter)
+	{
+		return "p" + std::to_string(index) + "_" + mangle(parameter.reference_name);
+	}
+
+	template<typename Value>
+	std::vector<std::string> get_sorted_names(const std::unordered_map<std::string, Value>& map)
+	{
+		std::vector<std::string> names;
+		names.reserve(map.size());
+
+		for(const std::pair<const std::string, Value>& pair : map)
+		{
+			names.push_back(pair.first);
+		}
+
+		std::sort(names.begin(), names.end());
+		return names;
+	}
+
+	std::vector<const VariableDeclaration*> get_parameters(const ParameterDeclarationList& parameter_list)
+	{
+		std::vector<const VariableDeclaration*> parameters;
+		parameters.reserve(parameter_list.size());
+
+		for(const VariableDeclaration& parameter : parameter_list)
+		{
+			parameters.push_back(&parameter);
+		}
+
+		return parameters;
+	}
+}
+
+/** Lowers one body. Owned values (whose reference the holder has to release) and borrowed values are told apart by where they go:
+ * every `lower` call with `kept` set returns an owned value, and every other call a borrowed one.
+ * Call results are stored in temporaries, so that calls run in the order of the source;
+ * borrowed temporaries are released at the end of the statement. */
+class CGenerator::BodyEmitter
+{
+public:
+	BodyEmitter(const CGenerator& init_generator, const Function& init_function, std::vector<std::string>& init_errors)
+		: generator{init_generator}, function{init_function}, errors{init_errors} {}
+
+	std::string emit()
+	{
+		for(std::size_t i = 0; i < function.parameters.size(); ++i)
+		{
+			declare(*function.parameters[i], get_parameter_name(i, *function.parameters[i]));
+		}
+
+		bool returned{false};
+		for(const std::unique_ptr<Statement>& statement : function.body->statements)
+		{
+			if(!emit_statement(statement.get()))
+			{
+				returned = true;
+				break;
+			}
+		}
+
+		if(!returned)
+		{
+			release_variables();
+			add_line("return neon_empty();");
+		}
+
+		return std::move(out);
+	}
+
+private:
+	const CGenerator& generator;
+	const Function& function;
+	std::vector<std::string>& errors;
+	std::string out;
+	std::unordered_map<const VariableDeclaration*, std::string> variable_names;
+	/** Parameters and local variables, in order of declaration */
+	std::vector<const VariableDeclaration*> variables;
+	/** Whether each variable holds a reference that it has to release */
+	std::unordered_map<const VariableDeclaration*, bool> holding;
+	/** Temporaries to release at the end of the statement */
+	std::vector<std::string> releases;
+	std::size_t temporary_count{0};
+	std::size_t local_count{0};
+
+	void add_line(const std::string& line)
+	{
+		out += '\t';
+		out += line;
+		out += '\n';
+	}
+
+	void declare(const VariableDeclaration& variable, std::string name)
+	{
+		variable_names.emplace(&variable, std::move(name));
+		variables.push_back(&variable);
+		holding[&variable] = holds_reference(variable);
+	}
+
+	bool holds_reference(const VariableDeclaration& variable) const
+	{
+		if(variable.reference_type.mutability == MutabilityMode::BORROW) { return false; }
+
+		const std::unordered_map<const VariableDeclaration*, VariableRefcount>::const_iterator it = generator.refcounts.variables.find(&variable);
+		return it == generator.refcounts.variables.end() || it->second.counted;
+	}
+
+	void release_variables()
+	{
+		for(const VariableDeclaration* variable : variables)
+		{
+			if(holding.at(variable)) { add_line("neon_release_value(" + variable_names.at(variable) + ");"); }
+		}
+	}
+
+	void release_temporaries()
+	{
+		for(const std::string& temporary : releases)
+		{
+			add_line("neon_release_value(" + temporary + ");");
+		}
+		releases.clear();
+	}
+
+	/** Makes the program fail when it gets here */
+	std::string fail(std::string_view message, std::string_view detail = "")
+	{
+		add_line("neon_fail(" + to_c_string_literal(std::string{message} + std::string{detail}) + ");");
+		return "neon_empty()";
+	}
+
+	/** Reports an error in the program at `expression`, which is then not built */
+	std::string report(const Expression& expression, std::string_view message, std::string_view detail = "")
+	{
+		errors.push_back
+		(
+			"At line " + std::to_string(expression.source_position.newlines_count + 1)
+				+ ", column " + std::to_string(expression.source_position.offset_in_line + 1)
+				+ ", in file \"" + function.file + "\": " + std::string{message} + std::string{detail}
+		);
+		return "neon_empty()";
+	}
+
+	/** `value` is a new reference, e.g. the result of a call */
+	std::string take_owned(const std::string& value, bool kept)
+	{
+		const std::string temporary = "t" + std::to_string(temporary_count++);
+		add_line("neon_value " + temporary + " = " + value + ";");
+
+		if(!kept) { releases.push_back(temporary); }
+
+		return temporary;
+	}
+
+	/** `value` is held by something else, e.g. a variable or field */
+	static std::string take_borrowed(const std::string& value, bool kept)
+	{
+		return kept ? "neon_copy(" + value + ")" : value;
+	}
+
+	/** Returns whether the statements after it are reached */
+	bool emit_statement(const Statement* statement)
+	{
+		if(const DiscardExpression* discard = dynamic_cast<const DiscardExpression*>(statement))
+		{
+			lower(discard->expression.get(), false);
+		}
+		else if(const LocalDeclaration* local = dynamic_cast<const LocalDeclaration*>(statement))
+		{
+			const VariableDeclaration& variable = local->variable_declaration;
+			const std::string value = variable.initialisation
+				? lower(variable.initialisation.get(), variable.reference_type.mutability != MutabilityMode::BORROW)
+				: "neon_empty()";
+			const std::string name = "l" + std::to_string(local_count++) + "_" + mangle(variable.reference_name);
+
+			add_line("neon_value " + name + " = " + value + ";");
+			declare(variable, name);
+		}
+		else if(const Return* ret = dynamic_cast<const Return*>(statement))
+		{
+			add_line("neon_value result = " + lower(ret->value.get(), true) + ";");
+			release_temporaries();
+			release_variables();
+			add_line("return result;");
+			return false;
+		}
+		else if(const AutoCall* auto_call = dynamic_cast<const AutoCall*>(statement))
+		{
+			const Expansion* expansion = generator.interpreter ? generator.interpreter->find_expansion(*auto_call) : nullptr;
+
+			if(!expansion || !expansion->error.empty())
+			{
+				fail(c_generator_error_messages::EXPANSION_FAILED, expansion ? expansion->error : auto_call->function_name);
+			}
+			else if(expansion->value.has_value() && std::holds_alternative<AstHandle>(expansion->value.value()))
+			{
+				const ASTNode& node = generator.interpreter->get_node(std::get<AstHandle>(expansion->value.value()));
+
+				if(const Expression* expression = dynamic_cast<const Expression*>(&node))
+				{
+					lower(expression, false);
+				}
+				else if(const Statement* expanded = dynamic_cast<const Statement*>(&node))
+				{
+					return emit_statement(expanded);
+				}
+			}
+			// A constant on its own does nothing
+		}
+
+		release_temporaries();
+		return true;
+	}
+
+	std::string lower(const Expression* expression, bool kept)
+	{
+		if(!expression) { return "neon_empty()"; }
+
+		const FoldedCalls::const_iterator folded = generator.folded_calls.find(expression);
+		if(folded != generator.folded_calls.end()) { return lower_constant(folded->second); }
+
+		if(const LiteralNumberExpression* number = dynamic_cast<const LiteralNumberExpression*>(expression))
+		{
+			return lower_constant(make_number_value(number->value));
+		}
+		if(const LiteralStringExpression* string = dynamic_cast<const LiteralStringExpression*>(expression))
+		{
+			return lower_constant(string->value);
+		}
+		if(const LiteralBooleanExpression* boolean = dynamic_cast<const LiteralBooleanExpression*>(expression))
+		{
+			return lower_constant(boolean->value);
+		}
+		if(dynamic_cast<const OptEmpty*>(expression))
+		{
+			return "neon_empty()";
+		}
+		if(const SimpleRead* read = dynamic_cast<const SimpleRead*>(expression))
+		{
+			return lower_read(*read, kept);
+		}
+		if(const Assignment* assignment = dynamic_cast<const Assignment*>(expression))
+		{
+			return lower_assignment(*assignment, kept);
+		}
+		if(const FunctionCall* function_call = dynamic_cast<const FunctionCall*>(expression))
+		{
+			return lower_call(*function_call, kept);
+		}
+		if(const ObjectFunctionCall* object_call = dynamic_cast<const ObjectFunctionCall*>(expression))
+		{
+			return lower_member_call(*object_call, kept);
+		}
+		if(const ObjectRead* object_read = dynamic_cast<const ObjectRead*>(expression))
+		{
+			const std::string object = lower(object_read->object.get(), false);
+			const std::optional<std::size_t> field = find_field_index(object_read->object.get(), object_read->member_name);
+
+			if(!field.has_value()) { return fail(c_generator_error_messages::UNRESOLVED_MEMBER, object_read->member_name); }
+
+			return take_borrowed("neon_get_field(" + object + ", " + std::to_string(field.value()) + ")", kept);
+		}
+		if(const OperatorCallExpression* operator_call = dynamic_cast<const OperatorCallExpression*>(expression))
+		{
+			return lower_operator_call(*operator_call, kept);
+		}
+		if(const OptFunctionCall* opt_call = dynamic_cast<const OptFunctionCall*>(expression))
+		{
+			lower_arguments(opt_call->arguments, nullptr);
+			return fail(c_generator_error_messages::UNSUPPORTED, "opt:" + opt_call->function_name);
+		}
+
+		return fail(c_generator_error_messages::UNSUPPORTED, "expression");
+	}
+
+	/** Constants are not counted, so they are the same owned or borrowed */
+	std::string lower_constant(const ConstantValue& value)
+	{
+		if(const NumberValue* number = std::get_if<NumberValue>(&value))
+		{
+			const bool decimal = !number->literal.empty() && std::all_of(number->literal.begin(), number->literal.end(),
+				[] (char c) { return (c >= '0' && c <= '9') || c == '.'; });
+
+			if(!decimal) { return fail(c_generator_error_messages::UNSUPPORTED, "number " + number->literal); }
+
+			// A floating literal, as integer literals may be too long for any C integer type
+			const bool fraction = number->literal.find('.') != std::string::npos;
+			return "neon_number(" + number->literal + (fraction ? "" : ".0") + ")";
+		}
+		if(const std::string* string = std::get_if<std::string>(&value))
+		{
+			return "neon_string(" + to_c_string_literal(*string) + ")";
+		}
+
+		return std::get<bool>(value) ? "neon_boolean(1)" : "neon_boolean(0)";
+	}
+
+	std::string lower_read(const SimpleRead& read, bool kept)
+	{
+		if(const VariableDeclaration* variable = find_variable(generator.resolution, &read))
+		{
+			const std::unordered_map<const VariableDeclaration*, std::string>::const_iterator name = variable_names.find(variable);
+
+			// e.g. in the expansion of an `auto:` call
+			if(name == variable_names.end()) { return fail(c_generator_error_messages::UNSUPPORTED, "variable of another body " + read.reference_name); }
+			if(!kept) { return name->second; }
+
+			const std::unordered_map<const SimpleRead*, ReferenceTransfer>::const_iterator transfer = generator.refcounts.reads.find(&read);
+
+			if(transfer != generator.refcounts.reads.end() && transfer->second == ReferenceTransfer::BORROW)
+			{
+				return name->second;
+			}
+			if(transfer != generator.refcounts.reads.end() && transfer->second == ReferenceTransfer::MOVE)
+			{
+				holding[variable] = false;
+				return name->second;
+			}
+
+			return take_borrowed(name->second, true);
+		}
+
+		if(read.declaration == UNRESOLVED_DECLARATION) { return fail(c_generator_error_messages::UNRESOLVED_READ, read.reference_name); }
+
+		const Declaration& declaration = generator.resolution.get_declaration(read.declaration);
+
+		if(declaration.kind == DeclarationKind::FIELD && function.has_self)
+		{
+			const std::unordered_map<const Field*, std::size_t>::const_iterator field =
+				generator.field_indices.find(static_cast<const Field*>(declaration.nodes.front()));
+
+			if(field != generator.field_indices.end())
+			{
+				return take_borrowed("neon_get_field(self, " + std::to_string(field->second) + ")", kept);
+			}
+		}
+
+		return fail(c_generator_error_messages::UNSUPPORTED, read.reference_name);
+	}
+
+	std::string lower_assignment(const Assignment& assignment, bool kept)
+	{
+		if(const VariableDeclaration* target = find_variable(generator.resolution, assignment.target.get()))
+		{
+			const std::unordered_map<const VariableDeclaration*, std::string>::const_iterator name = variable_names.find(target);
+			if(name == variable_names.end()) { return report(assignment, c_generator_error_messages::NOT_ASSIGNABLE); }
+
+			// A `borrow` variable takes the value as it is, like in `RefcountAnalyser`
+			if(target->reference_type.mutability == MutabilityMode::BORROW)
+			{
+				add_line(name->second + " = " + lower(assignment.value.get(), kept) + ";");
+				return name->second;
+			}
+
+			const std::string value = lower(assignment.value.get(), true);
+
+			if(holding.at(target))
+			{
+				add_line("{ neon_value old = " + name->second + "; " + name->second + " = " + value + "; neon_release_value(old); }");
+			}
+			else
+			{
+				add_line(name->second + " = " + value + ";");
+			}
+			holding[target] = holds_reference(*target);
+
+			return take_borrowed(name->second, kept);
+		}
+
+		if(const ObjectRead* field_target = dynamic_cast<const ObjectRead*>(assignment.target.get()))
+		{
+			const std::string object = lower(field_target->object.get(), false);
+			const std::optional<std::size_t> field = find_field_index(field_target->object.get(), field_target->member_name);
+			const std::string value = lower(assignment.value.get(), true);
+
+			if(!field.has_value()) { return fail(c_generator_error_messages::UNRESOLVED_MEMBER, field_target->member_name); }
+
+			const std::string index = std::to_string(field.value());
+			add_line("neon_set_field(" + object + ", " + index + ", " + value + ");");
+
+			return take_borrowed("neon_get_field(" + object + ", " + index + ")", kept);
+		}
+
+		lower(assignment.value.get(), true);
+		return report(assignment, c_generator_error_messages::NOT_ASSIGNABLE);
+	}
+
+	/** `callee` is `nullptr` if not known, in which case all arguments are handed over */
+	std::vector<std::string> lower_arguments(const std::vector<std::unique_ptr<Expression>>& arguments, const Function* callee)
+	{
+		std::vector<std::string> lowered;
+		lowered.reserve(arguments.size());
+
+		for(std::size_t i = 0; i < arguments.size(); ++i)
+		{
+			const bool borrowed = callee && callee->parameters[i]->reference_type.mutability == MutabilityMode::BORROW;
+			lowered.push_back(lower(arguments[i].get(), !borrowed));
+		}
+
+		return lowered;
+	}
+
+	std::string call_function(const Function& callee, bool pass_self, const std::vector<std::string>& arguments, bool kept)
+	{
+		if(!callee.body) { return fail(c_generator_error_messages::NOT_IMPLEMENTED, callee.name); }
+
+		std::string call = callee.name + "(";
+		if(pass_self) { call += arguments.empty() ? "self" : "self, "; }
+
+		for(std::size_t i = 0; i < arguments.size(); ++i)
+		{
+			call += (i == 0 ? "" : ", ") + arguments[i];
+		}
+
+		return take_owned(call + ")", kept);
+	}
+
+	std::string lower_call(const FunctionCall& call, bool kept)
+	{
+		if(call.declaration == UNRESOLVED_DECLARATION)
+		{
+			const std::vector<std::string> arguments = lower_arguments(call.arguments, nullptr);
+
+			if(call.function_name == PRINT_FUNCTION && arguments.size() == 1)
+			{
+				return take_owned("neon_print(" + arguments.front() + ")", kept);
+			}
+
+			return fail(c_generator_error_messages::UNRESOLVED_CALL, call.function_name);
+		}
+
+		const Declaration& declaration = generator.resolution.get_declaration(call.declaration);
+
+		switch(declaration.kind)
+		{
+			case DeclarationKind::TYPE:
+			{
+				const std::vector<std::string> arguments = lower_arguments(call.arguments, nullptr);
+
+				const std::unordered_map<const FunctionCall*, AllocationSharing>::const_iterator sharing = generator.allocations.allocations.find(&call);
+				const bool single_thread = sharing != generator.allocations.allocations.end() && sharing->second == AllocationSharing::THREAD_LOCAL;
+				const std::string site = function.file + ":" + std::to_string(call.source_position.newlines_count + 1);
+
+				const std::string object = take_owned
+				(
+					"neon_new(" + std::to_string(generator.field_counts.at(static_cast<const Type*>(declaration.nodes.front()))) + ", "
+						+ (single_thread ? "1" : "0") + ", " + to_c_string_literal(site) + ")",
+					kept
+				);
+
+				// Constructors are not declared yet, so the arguments are not stored
+				for(const std::string& argument : arguments)
+				{
+					add_line("neon_release_value(" + argument + ");");
+				}
+
+				return object;
+			}
+			case DeclarationKind::ENTRYPOINT:
+			case DeclarationKind::METHOD:
+			case DeclarationKind::PURE_FUNCTION:
+			{
+				const Function* callee = find_function(call.declaration, call.arguments.size());
+				const std::vector<std::string> arguments = lower_arguments(call.arguments, callee);
+
+				if(!callee) { return report(call, c_generator_error_messages::NO_UNIQUE_OVERLOAD, declaration.name); }
+				if(callee->has_self && !function.has_self) { return report(call, c_generator_error_messages::NOT_CALLABLE, declaration.name); }
+
+				return call_function(*callee, callee->has_self, arguments, kept);
+			}
+			default:
+			{
+				lower_arguments(call.arguments, nullptr);
+				return report(call, c_generator_error_messages::NOT_CALLABLE, declaration.name);
+			}
+		}
+	}
+
+	std::string lower_member_call(const ObjectFunctionCall& call, bool kept)
+	{
+		const bool on_variable = find_variable(generator.resolution, call.object.get()) != nullptr;
+		const DeclarationId member = find_member(generator.resolution, call);
+		const std::string object = lower(call.object.get(), false);
+
+		if(member == UNRESOLVED_DECLARATION)
+		{
+			lower_arguments(call.arguments, nullptr);
+			return fail(c_generator_error_messages::UNRESOLVED_MEMBER, call.member_name);
+		}
+
+		const Declaration& declaration = generator.resolution.get_declaration(member);
+		const Function* callee = find_function(member, call.arguments.size());
+		const std::vector<std::string> arguments = lower_arguments(call.arguments, callee);
+
+		if(!callee) { return report(call, c_generator_error_messages::NO_UNIQUE_OVERLOAD, declaration.name); }
+		if(!callee->has_self) { return call_function(*callee, false, arguments, kept); }
+		if(!on_variable) { return report(call, c_generator_error_messages::NOT_CALLABLE, declaration.name); }
+
+		std::vector<std::string> with_object{object};
+		with_object.insert(with_object.end(), arguments.begin(), arguments.end());
+
+		return call_function(*callee, false, with_object, kept);
+	}
+
+	std::string lower_operator_call(const OperatorCallExpression& call, bool kept)
+	{
+		const std::vector<std::string> arguments = lower_arguments(call.arguments, nullptr);
+		const OperatorFunction* operator_function = find_operator_function(generator.operator_functions, call);
+
+		if(!operator_function && is_builtin_operator(call)) { return fail(c_generator_error_messages::UNSUPPORTED, "built-in operator"); }
+		if(!operator_function) { return report(call, c_generator_error_messages::NO_OPERATOR_FUNCTION); }
+
+		const Function& callee = generator.functions.at(operator_function);
+		const std::string result = call_function(callee, false, arguments, kept);
+
+		// Arguments of operator calls are always handed over (see `RefcountAnalyser`), so those the callee borrows are released here
+		for(std::size_t i = 0; i < arguments.size() && i < callee.parameters.size(); ++i)
+		{
+			if(callee.parameters[i]->reference_type.mutability == MutabilityMode::BORROW)
+			{
+				add_line("neon_release_value(" + arguments[i] + ");");
+			}
+		}
+
+		return result;
+	}
+
+	/** The only overload of `callee` taking `argument_count` arguments */
+	const Function* find_function(DeclarationId callee, std::size_t argument_count) const
+	{
+		const Function* found{nullptr};
+
+		for(const ASTNode* node : generator.resolution.get_declaration(callee).nodes)
+		{
+			const std::unordered_map<const ASTNode*, Function>::const_iterator it = generator.functions.find(node);
+
+			if(it == generator.functions.end() || it->second.parameters.size() != argument_count) { continue; }
+			if(found) { return nullptr; }
+
+			found = &it->second;
+		}
+
+		return found;
+	}
+
+	/** Index of the field `member` of the variable `object` */
+	std::optional<std::size_t> find_field_index(const Expression* object, const std::string& member) const
+	{
+		const VariableDeclaration* variable = find_variable(generator.resolution, object);
+		if(!variable || variable->reference_type.declaration == UNRESOLVED_DECLARATION) { return std::nullopt; }
+
+		const Scope* member_scope = generator.resolution.get_member_scope(generator.resolution.get_declaration(variable->reference_type.declaration).name);
+		if(!member_scope) { return std::nullopt; }
+
+		const std::optional<DeclarationId> field = member_scope->find(member);
+		if(!field.has_value()) { return std::nullopt; }
+
+		const Declaration& declaration = generator.resolution.get_declaration(field.value());
+		if(declaration.kind != DeclarationKind::FIELD) { return std::nullopt; }
+
+		const std::unordered_map<const Field*, std::size_t>::const_iterator it =
+			generator.field_indices.find(static_cast<const Field*>(declaration.nodes.front()));
+
+		if(it == generator.field_indices.end()) { return std::nullopt; }
+
+		return it->second;
+	}
+
+	static bool is_builtin_operator(const OperatorCallExpression& operator_call)
+	{
+		const OperatorDeclaration* operator_declaration = operator_call.op ? operator_call.op->get_declaration() : nullptr;
+		return operator_declaration && operator_declaration->builtin_operator_kind != BuiltinOperatorKind::NOT_BUILT_IN;
+	}
+};
+
+CGenerator::CGenerator
+(
+	const Root& init_root,
+	const Resolution& init_resolution,
+	const RefcountAnnotations& init_refcounts,
+	const AllocationAnnotations& init_allocations,
+	const FoldedCalls& init_folded_calls,
+	const CompileFunctionInterpreter* init_interpreter,
+	concurrency::WorkStealingPool& init_pool
+) :
+	root{init_root},
+	resolution{init_resolution},
+	refcounts{init_refcounts},
+	allocations{init_allocations},
+	folded_calls{init_folded_calls},
+	interpreter{init_interpreter},
+	pool{init_pool}
+{}
+
+std::optional<GeneratedProgram> CGenerator::generate(const std::string& entrypoint)
+{
+	const trace::Span span{"CGenerator::generate"};
+
+	const std::unordered_map<std::string, std::unique_ptr<PackageMember>>::const_iterator entrypoint_it = root.package_members.find(entrypoint);
+	if(entrypoint_it == root.package_members.end() || !dynamic_cast<const Entrypoint*>(entrypoint_it->second.get()))
+	{
+		return std::nullopt;
+	}
+
+	collect_functions();
+	operator_functions = PureEvaluator::find_operator_functions(resolution);
+
+	GeneratedProgram program;
+	program.header = generate_header();
+	program.units.resize(unit_functions.size());
+	std::vector<std::vector<std::string>> unit_errors(unit_functions.size());
+
+	pool.run(unit_functions.size(), [&] (std::size_t i)
+	{
+		program.units[i] = generate_unit(i, unit_errors[i]);
+	});
+
+	// In the order of the units, so that it does not depend on the scheduling
+	for(const std::vector<std::string>& errors : unit_errors)
+	{
+		program.errors.insert(program.errors.end(), errors.begin(), errors.end());
+	}
+
+	program.units.push_back(generate_main(static_cast<const Entrypoint&>(*entrypoint_it->second)));
+
+	return program;
+}
+
+void CGenerator::collect_functions()
+{
+	functions.clear();
+	unit_functions.clear();
+	field_indices.clear();
+	field_counts.clear();
+
+	std::unordered_set<std::string> collected;
+
+	for(const std::string& file : get_sorted_names(root.file_package_members))
+	{
+		std::vector<const Function*>& unit = unit_functions.emplace_back();
+
+		for(const std::string& identifier : root.file_package_members.at(file))
+		{
+			const std::unordered_map<std::string, std::unique_ptr<PackageMember>>::const_iterator it = root.package_members.find(identifier);
+			if(it == root.package_members.end() || !collected.insert(identifier).second) { continue; }
+
+			collect_package_member(identifier, *it->second, file, unit);
+		}
+	}
+
+	// Package members that no file declares, e.g. made by tools
+	std::vector<const Function*> unlisted;
+	for(const std::string& identifier : get_sorted_names(root.package_members))
+	{
+		if(collected.contains(identifier)) { continue; }
+
+		collect_package_member(identifier, *root.package_members.at(identifier), "", unlisted);
+	}
+	if(!unlisted.empty()) { unit_functions.push_back(std::move(unlisted)); }
+}
+
+void CGenerator::collect_package_member
+(
+	const std::string& identifier,
+	const PackageMember& package_member,
+	const std::string& file,
+	std::vector<const Function*>& unit
+)
+{
+	const std::string prefix = "neon_" + mangle(identifier);
+
+	if(const Entrypoint* entrypoint = dynamic_cast<const Entrypoint*>(&package_member))
+	{
+		add_function(*entrypoint, prefix, get_parameters(entrypoint->parameters), &entrypoint->body, false, file, unit);
+	}
+	else if(const Type* type = dynamic_cast<const Type*>(&package_member))
+	{
+		const std::vector<std::string> field_names = get_sorted_names(type->fields);
+		for(std::size_t i = 0; i < field_names.size(); ++i)
+		{
+			field_indices.emplace(&type->fields.at(field_names[i]), i);
+		}
+		field_counts.emplace(type, field_names.size());
+
+		for(const std::string& name : get_sorted_names(type->methods))
+		{
+			const std::vector<Method>& overloads = type->methods.at(name);
+
+			for(std::size_t i = 0; i < overloads.size(); ++i)
+			{
+				const Method& method = overloads[i];
+				add_function(method, prefix + "__" + mangle(name) + "_" + std::to_string(i), get_parameters(method.parameters),
+					method.implementation.has_value() ? &method.implementation.value() : nullptr, true, file, unit);
+			}
+		}
+
+		collect_pure_functions(type->pure_functions, prefix, file, unit);
+	}
+	else if(const PureFunctionSet* pure_function_set = dynamic_cast<const PureFunctionSet*>(&package_member))
+	{
+		collect_pure_functions(pure_function_set->methods, prefix, file, unit);
+	}
+	else if(const OperatorModule* operator_module = dynamic_cast<const OperatorModule*>(&package_member))
+	{
+		for(std::size_t i = 0; i < operator_module->functions.size(); ++i)
+		{
+			const OperatorFunction& operator_function = operator_module->functions[i];
+
+			std::vector<const VariableDeclaration*> parameters;
+			for(const OperatorFunctionPatternElement& element : operator_function.pattern)
+			{
+				if(const OperatorFunctionParameter* parameter = std::get_if<OperatorFunctionParameter>(&element))
+				{
+					parameters.push_back(&parameter->parameter);
+				}
+			}
+
+			add_function(operator_function, prefix + "__operator_" + std::to_string(i), parameters, &operator_function.body, false, file, unit);
+		}
+	}
+	// Compile functions run in the compiler, so they are not generated
+}
+
+void CGenerator::collect_pure_functions
+(
+	const std::unordered_map<std::string, std::vector<PureFunction>>& pure_functions,
+	const std::string& prefix,
+	const std::string& file,
+	std::vector<const Function*>& unit
+)
+{
+	for(const std::string& name : get_sorted_names(pure_functions))
+	{
+		const std::vector<PureFunction>& overloads = pure_functions.at(name);
+
+		for(std::size_t i = 0; i < overloads.size(); ++i)
+		{
+			const PureFunction& pure_function = overloads[i];
+			add_function(pure_function, prefix + "__" + mangle(name) + "_" + std::to_string(i), get_parameters(pure_function.parameters),
+				pure_function.implementation.has_value() ? &pure_function.implementation.value() : nullptr, false, file, unit);
+		}
+	}
+}
+
+void CGenerator::add_function
+(
+	const ASTNode& node,
+	std::string name,
+	std::vector<const VariableDeclaration*> parameters,
+	const CodeBlock* body,
+	bool has_self,
+	const std::string& file,
+	std::vector<const Function*>& unit
+)
+{
+	const Function& function = functions.emplace(&node, Function{std::move(name), std::move(parameters), body, has_self, file}).first->second;
+
+	if(body) { unit.push_back(&function); }
+}
+
+TranslationUnit CGenerator::generate_header() const
+{
+	std::vector<std::string> declarations;
+	for(const std::vector<const Function*>& unit : unit_functions)
+	{
+		for(const Function* function : unit)
+		{
+			declarations.push_back(generate_signature(*function) + ";\n");
+		}
+	}
+	std::sort(declarations.begin(), declarations.end());
+
+	std::string source = "#ifndef NEON_PROGRAM_H\n#define NEON_PROGRAM_H\n\n";
+	source += REFCOUNT_RUNTIME_SOURCE;
+	source += "\n";
+	source += VALUE_RUNTIME_SOURCE;
+	source += "\n";
+	for(const std::string& declaration : declarations)
+	{
+		source += declaration;
+	}
+	source += "\n#endif\n";
+
+	return TranslationUnit{std::string{HEADER_FILE_NAME}, std::move(source)};
+}
+
+TranslationUnit CGenerator::generate_unit(std::size_t index, std::vector<std::string>& errors) const
+{
+	std::string source = "#include \"" + std::string{HEADER_FILE_NAME} + "\"\n";
+
+	for(const Function* function : unit_functions[index])
+	{
+		source += "\n" + generate_signature(*function) + "\n{\n";
+		source += BodyEmitter{*this, *function, errors}.emit();
+		source += "}\n";
+	}
+
+	return TranslationUnit{"unit_" + std::to_string(index) + ".c", std::move(source)};
+}
+
+TranslationUnit CGenerator::generate_main(const Entrypoint& entrypoint) const
+{
+	const Function& function = functions.at(&entrypoint);
+
+	std::string call = function.name + "(";
+	for(std::size_t i = 0; i < function.parameters.size(); ++i)
+	{
+		const std::string argument = std::to_string(i + 1);
+		call += (i == 0 ? "" : ", ") + ("argc > " + argument + " ? neon_string(argv[" + argument + "]) : neon_string(\"\")");
+	}
+	call += ")";
+
+	std::string source = "#include \"" + std::string{HEADER_FILE_NAME} + "\"\n\n";
+	source += "int main(int argc, char** argv)\n{\n";
+	source += "\t(void)argc;\n\t(void)argv;\n";
+	source += "\treturn neon_exit_code(" + call + ");\n";
+	source += "}\n";
+
+	return TranslationUnit{std::string{MAIN_FILE_NAME}, std::move(source)};
+}
+
+std::string CGenerator::generate_signature(const Function& function)
+{
+	std::string signature = "neon_value " + function.name + "(";
+
+	if(function.has_self) { signature += "neon_value self"; }
+
+	for(std::size_t i = 0; i < function.parameters.size(); ++i)
+	{
+		signature += (i == 0 && !function.has_self ? "" : ", ") + ("neon_value " + get_parameter_name(i, *function.parameters[i]));
+	}
+
+	if(function.parameters.empty() && !function.has_self) { signature += "void"; }
+
+	return signature + ")";
+}
@@ -0,0 +1,164 @@
+#ifndef C_GENERATOR_HPP
+#define C_GENERATOR_HPP
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "../ast/nodes/nodes.hpp"
+#include "../ast/nodes/statement_nodes.hpp"
+#include "../evaluation/compile_function_interpreter.hpp"
+#include "../evaluation/pure_evaluator.hpp"
+#include "../reference_counting/refcount_analyser.hpp"
+#include "../reference_counting/thread_escape_analyser.hpp"
+#include "../resolution/resolution.hpp"
+#include "../../concurrency/work_stealing_pool.hpp"
+
+namespace neon_compiler::codegen
+{
+
+/** Messages of the errors in programs (e.g. operators without operator function), and of the failures that generated programs
+ * report at run time, for what cannot be lowered (e.g. unresolved names, which `type_checking::TypeChecker` reports beforehand) */
+namespace c_generator_error_messages
+{
+	constexpr std::string_view UNRESOLVED_CALL =
+		"Unresolved call: ";
+	constexpr std::string_view UNRESOLVED_READ =
+		"Unresolved read: ";
+	constexpr std::string_view UNRESOLVED_MEMBER =
+		"Unresolved member: ";
+	constexpr std::string_view NO_UNIQUE_OVERLOAD =
+		"No unique overload takes this number of arguments: ";
+	constexpr std::string_view NOT_IMPLEMENTED =
+		"Not implemented: ";
+	constexpr std::string_view NOT_CALLABLE =
+		"Not callable: ";
+	constexpr std::string_view NOT_ASSIGNABLE =
+		"Not assignable";
+	constexpr std::string_view NO_OPERATOR_FUNCTION =
+		"No unique operator function implements this operator";
+	constexpr std::string_view EXPANSION_FAILED =
+		"auto: call could not be expanded: ";
+	constexpr std::string_view UNSUPPORTED =
+		"Not supported by the C backend yet: ";
+}
+
+/** One source file of a generated program */
+struct TranslationUnit
+{
+	std::string file_name;
+	std::string source;
+};
+
+struct GeneratedProgram
+{
+	/** Runtime and declarations of all functions, included by every unit */
+	TranslationUnit header;
+	/** The functions of the package members, one unit per Neoncode file, followed by the unit defining `main` */
+	std::vector<TranslationUnit> units;
+	/** Errors in the program, e.g. calls that were not resolved. The program must not be built unless there are none. */
+	std::vector<std::string> errors;
+};
+
+/** Lowers the AST to portable C, to be compiled by the system C compiler until there is an LLVM backend.
+ *
+ * Every entrypoint, method, pure function and operator function becomes a C function taking and returning `neon_value`s
+ * (see `VALUE_RUNTIME_SOURCE`). Arguments for `borrow` parameters are borrowed, others are handed over to the callee,
+ * which releases its parameters and local variables at the end. Reference count traffic follows `RefcountAnnotations`,
+ * and allocations classified as thread-local by `ThreadEscapeAnalyser` get counters that are not atomic.
+ * Calls folded at compile time (see `evaluation::PureEvaluator`) and expanded `auto:` calls are replaced by their values.
+ * Errors in the program found while lowering (e.g. operators without operator function) are collected in `GeneratedProgram::errors`.
+ * Unresolved names, which the type checker reports, and what is valid but cannot be lowered yet (e.g. `opt:` calls,
+ * members of values of unknown type) fail when they are reached at run time, with a message from `c_generator_error_messages`,
+ * so that the rest of a program still runs.
+ *
+ * The package members of each Neoncode file make up one translation unit, and units are generated in parallel.
+ * Only reads the AST and the analyses, which must outlive the generator. */
+class CGenerator
+{
+public:
+	CGenerator
+	(
+		const neon_compiler::ast::nodes::Root& init_root,
+		const neon_compiler::resolution::Resolution& init_resolution,
+		const neon_compiler::reference_counting::RefcountAnnotations& init_refcounts,
+		const neon_compiler::reference_counting::AllocationAnnotations& init_allocations,
+		const neon_compiler::evaluation::FoldedCalls& init_folded_calls,
+		const neon_compiler::evaluation::CompileFunctionInterpreter* init_interpreter,
+		concurrency::WorkStealingPool& init_pool
+	);
+
+	/** Generates the program whose `main` runs the entrypoint with full identifier `entrypoint`,
+	 * passing the command line arguments as strings (empty ones for the missing).
+	 * Empty if there is no such entrypoint. */
+	std::optional<GeneratedProgram> generate(const std::string& entrypoint);
+
+private:
+	/** C function of a Neoncode function */
+	struct Function
+	{
+		std::string name;
+		std::vector<const neon_compiler::ast::nodes::VariableDeclaration*> parameters;
+		/** `nullptr` if not implemented */
+		const neon_compiler::ast::nodes::CodeBlock* body;
+		/** Whether it is a method, which gets its object as `self` */
+		bool has_self;
+		/** Neoncode file, for the allocation sites named at run time */
+		std::string file;
+	};
+
+	class BodyEmitter;
+
+	const neon_compiler::ast::nodes::Root& root;
+	const neon_compiler::resolution::Resolution& resolution;
+	const neon_compiler::reference_counting::RefcountAnnotations& refcounts;
+	const neon_compiler::reference_counting::AllocationAnnotations& allocations;
+	const neon_compiler::evaluation::FoldedCalls& folded_calls;
+	const neon_compiler::evaluation::CompileFunctionInterpreter* interpreter;
+	concurrency::WorkStealingPool& pool;
+
+	/** Every overload of every function, by node (e.g. `Method`) */
+	std::unordered_map<const neon_compiler::ast::ASTNode*, Function> functions;
+	/** Functions of each translation unit, with a body */
+	std::vector<std::vector<const Function*>> unit_functions;
+	std::unordered_map<const neon_compiler::ast::nodes::Field*, std::size_t> field_indices;
+	std::unordered_map<const neon_compiler::ast::nodes::Type*, std::size_t> field_counts;
+	neon_compiler::evaluation::OperatorFunctions operator_functions;
+
+	/** Fills the fields above, before the units are generated in parallel */
+	void collect_functions();
+	void collect_package_member
+	(
+		const std::string& identifier,
+		const neon_compiler::ast::nodes::PackageMember& package_member,
+		const std::string& file,
+		std::vector<const Function*>& unit
+	);
+	void collect_pure_functions
+	(
+		const std::unordered_map<std::string, std::vector<neon_compiler::ast::nodes::PureFunction>>& pure_functions,
+		const std::string& prefix,
+		const std::string& file,
+		std::vector<const Function*>& unit
+	);
+	void add_function
+	(
+		const neon_compiler::ast::ASTNode& node,
+		std::string name,
+		std::vector<const neon_compiler::ast::nodes::VariableDeclaration*> parameters,
+		const neon_compiler::ast::nodes::CodeBlock* body,
+		bool has_self,
+		const std::string& file,
+		std::vector<const Function*>& unit
+	);
+	TranslationUnit generate_header() const;
+	TranslationUnit generate_unit(std::size_t index, std::vector<std::string>& errors) const;
+	TranslationUnit generate_main(const neon_compiler::ast::nodes::Entrypoint& entrypoint) const;
+	static std::string generate_signature(const Function& function);
+};
+
+}
+
+#endif // C_GENERATOR_HPP
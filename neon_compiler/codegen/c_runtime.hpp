@@ -0,0 +1,154 @@
+#ifndef C_RUNTIME_HPP
+#define C_RUNTIME_HPP
+
+#include <string_view>
+
+namespace neon_compiler::codegen
+{
+
+/** C source of the values of generated programs, which follows `reference_counting::REFCOUNT_RUNTIME_SOURCE`.
+ * Types are not lowered to C types yet, so every value is a `neon_value` that knows its kind.
+ * Objects of Neoncode types are `neon_fields`, with their fields in the order of their names.
+ * Number, boolean and string values are not counted: strings are only literals so far. */
+constexpr std::string_view VALUE_RUNTIME_SOURCE = R"(#include <stdio.h>
+
+typedef enum neon_kind
+{
+	NEON_EMPTY,
+	NEON_NUMBER,
+	NEON_BOOLEAN,
+	NEON_STRING,
+	NEON_OBJECT
+} neon_kind;
+
+typedef struct neon_value
+{
+	neon_kind kind;
+	union
+	{
+		double number;
+		int boolean;
+		const char* string;
+		neon_object* object;
+	} as;
+} neon_value;
+
+typedef struct neon_fields
+{
+	neon_object header;
+	size_t count;
+	neon_value values[];
+} neon_fields;
+
+static inline neon_value neon_empty(void)
+{
+	neon_value value = {NEON_EMPTY, {.number = 0}};
+	return value;
+}
+
+static inline neon_value neon_number(double number)
+{
+	neon_value value = {NEON_NUMBER, {.number = number}};
+	return value;
+}
+
+static inline neon_value neon_boolean(int boolean)
+{
+	neon_value value = {NEON_BOOLEAN, {.boolean = boolean}};
+	return value;
+}
+
+static inline neon_value neon_string(const char* string)
+{
+	neon_value value = {NEON_STRING, {.string = string}};
+	return value;
+}
+
+_Noreturn static inline void neon_fail(const char* message)
+{
+	fprintf(stderr, "%s\n", message);
+	abort();
+}
+
+static inline void neon_retain_value(neon_value value)
+{
+	if(value.kind == NEON_OBJECT) { neon_retain(value.as.object); }
+}
+
+static inline void neon_release_value(neon_value value)
+{
+	if(value.kind == NEON_OBJECT) { neon_release(value.as.object); }
+}
+
+/* Another reference to a value that is kept */
+static inline neon_value neon_copy(neon_value value)
+{
+	neon_retain_value(value);
+	return value;
+}
+
+static inline void neon_destroy_fields(neon_object* object)
+{
+	neon_fields* fields = (neon_fields*)object;
+	for(size_t i = 0; i < fields->count; ++i) { neon_release_value(fields->values[i]); }
+}
+
+/* Fields start empty, as constructors are not declared yet */
+static inline neon_value neon_new(size_t field_count, int single_thread, const char* site)
+{
+	neon_fields* fields = neon_allocate(sizeof(neon_fields) + field_count * sizeof(neon_value), neon_destroy_fields, single_thread, site);
+	fields->count = field_count;
+
+	neon_value value = {NEON_OBJECT, {.object = &fields->header}};
+	return value;
+}
+
+static inline neon_value* neon_field(neon_value object, size_t index)
+{
+	if(object.kind != NEON_OBJECT || index >= ((neon_fields*)object.as.object)->count) { neon_fail("No such field"); }
+	return &((neon_fields*)object.as.object)->values[index];
+}
+
+/* Borrows the value of the field */
+static inline neon_value neon_get_field(neon_value object, size_t index)
+{
+	return *neon_field(object, index);
+}
+
+/* Takes over `value` */
+static inline void neon_set_field(neon_value object, size_t index, neon_value value)
+{
+	neon_value* field = neon_field(object, index);
+	neon_value old = *field;
+	*field = value;
+	neon_release_value(old);
+}
+
+/* Takes over `value` */
+static inline neon_value neon_print(neon_value value)
+{
+	switch(value.kind)
+	{
+		case NEON_EMPTY:   { puts("empty"); break; }
+		case NEON_NUMBER:  { printf("%.15g\n", value.as.number); break; }
+		case NEON_BOOLEAN: { puts(value.as.boolean ? "true" : "false"); break; }
+		case NEON_STRING:  { puts(value.as.string); break; }
+		case NEON_OBJECT:  { puts("object"); break; }
+	}
+
+	neon_release_value(value);
+	return neon_empty();
+}
+
+/* Takes over the value returned by the entrypoint */
+static inline int neon_exit_code(neon_value value)
+{
+	const int code = value.kind == NEON_NUMBER ? (int)value.as.number : 0;
+	neon_release_value(value);
+	return code;
+}
+)";
+
+}
+
+#endif // C_RUNTIME_HPP
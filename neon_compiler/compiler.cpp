@@ -1,14 +1,35 @@
 #include "compiler.hpp"
 
+#include <algorithm>
+#include <cstdlib>
 #include <iostream>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
 #include <span>
 #include "../reading/char_reader.hpp"
+#include "cache/content_hash.hpp"
 #include "lexer/lexer.hpp"
 #include "lexer/tokenisation_error.hpp"
 #include "analysis/analysis_reporter.hpp"
 #include "analysis/impl/console_analysis_reporter.hpp"
+#include "analysis/impl/file_routing_analysis_reporter.hpp"
+#include "analysis/impl/recording_analysis_reporter.hpp"
+#include "analysis/impl/reference_indexing_analysis_reporter.hpp"
 #include "ast/ast_visitor.hpp"
+#include "ast/impl/ast_node_counter.hpp"
 #include "ast/impl/ast_printer.hpp"
+#include "codegen/c_builder.hpp"
+#include "codegen/c_generator.hpp"
+#include "ir/dead_value_elimination.hpp"
+#include "ir/ir.hpp"
+#include "ir/ir_lowerer.hpp"
+#include "ir/pass_manager.hpp"
+#include "reference_counting/refcount_analyser.hpp"
+#include "reference_counting/thread_escape_analyser.hpp"
+#include "resolution/name_resolver.hpp"
+#include "type_checking/type_checker.hpp"
+#include "trace/trace.hpp"
 
 using namespace logging;
 using namespace reading;
@@ -17,79 +38,963 @@ using namespace neon_compiler::analysis;
 using namespace neon_compiler::analysis::impl;
 using namespace neon_compiler::ast::impl;
 using namespace neon_compiler::ast::nodes;
+using namespace neon_compiler::cache;
+using namespace neon_compiler::codegen;
+using namespace neon_compiler::evaluation;
+using namespace neon_compiler::index;
+using namespace neon_compiler::ir;
 using namespace neon_compiler::lexer;
 using namespace neon_compiler::parser;
+using namespace neon_compiler::reference_counting;
+using namespace neon_compiler::resolution;
+using namespace neon_compiler::stats;
+using namespace neon_compiler::type_checking;
+
+namespace
+{
+	std::string_view token_pattern_to_string(const TokenPattern& token_pattern)
+	{
+		if(token_pattern.lexeme.has_value())
+		{
+			return token_pattern.lexeme.value();
+		}
+
+		switch(token_pattern.token_type)
+		{
+			case TokenType::BRACKET_ROUND_OPEN:  { return "("; }
+			case TokenType::BRACKET_ROUND_CLOSE: { return ")"; }
+			case TokenType::SMALLER_THAN:        { return "<"; }
+			case TokenType::GREATER_THAN:        { return ">"; }
+			case TokenType::COMMA:               { return ","; }
+			case TokenType::COLON:               { return ":"; }
+			case TokenType::MEMBER_ACCESS_DOT:   { return "."; }
+			case TokenType::EQUALS_OR_ASSIGN:    { return "="; }
+			default: { return "?"; }
+		}
+	}
+
+	/** e.g. `__ + __` */
+	std::string operator_pattern_to_string(const OperatorDeclaration& declaration)
+	{
+		std::string str{};
+
+		for(const OperatorSyntaxPatternElement& elem : declaration.pattern)
+		{
+			if(!str.empty()) { str += ' '; }
+
+			if(std::holds_alternative<OperatorSyntaxParameter>(elem))
+			{
+				str += "__";
+			}
+			else
+			{
+				str += token_pattern_to_string(std::get<TokenPattern>(elem));
+			}
+		}
+
+		return str;
+	}
+}
 
 Compiler::Compiler(std::shared_ptr<Logger> init_logger)
-	: logger{init_logger}
+	: logger{init_logger}, resolution{std::make_shared<Resolution>()}, thread_count{concurrency::get_default_thread_count()}
 {
 	root_node = std::make_shared<Root>();
 	operator_map = std::make_shared<OperatorMap>();
+	symbol_interner = std::make_shared<SymbolInterner>();
+	symbol_index = std::make_shared<SymbolIndex>(symbol_interner);
+	reference_index = std::make_shared<ReferenceIndex>(symbol_interner);
+	dependency_graph = std::make_shared<DependencyGraph>();
+}
+
+void Compiler::enable_token_cache(const std::filesystem::path& directory)
+{
+	token_cache = std::make_shared<TokenCache>(directory);
+}
+
+void Compiler::enable_ast_cache(const std::filesystem::path& directory)
+{
+	ast_cache = std::make_shared<AstCache>(directory);
+}
+
+void Compiler::enable_stats()
+{
+	compilation_stats = std::make_shared<CompilationStats>();
+}
+
+void Compiler::set_thread_count(std::size_t new_thread_count)
+{
+	thread_count = new_thread_count;
+	pool.reset();
+}
+
+void Compiler::enable_thread_local_verification()
+{
+	verify_thread_local = true;
+}
+
+void Compiler::enable_ir_verification()
+{
+	verify_ir = true;
+}
+
+void Compiler::set_build_directory(const std::filesystem::path& directory)
+{
+	build_directory = directory;
+}
+
+void Compiler::set_build_entrypoint(std::string entrypoint)
+{
+	build_entrypoint = std::move(entrypoint);
 }
 
 void Compiler::read_file(std::unique_ptr<std::istream> stream, std::string_view file_name)
 {
+	trace::Span span{"Compiler::read_file"};
+	if(span.is_recording()) { span.set_detail(std::string{file_name}); }
+
+	const Measurement measurement{};
 	std::vector<lexer::TokenisationError> lexer_errors;
 	try
 	{
+		uint64_t content_hash{0};
+
+		if(token_cache || ast_cache)
+		{
+			const std::string contents{std::istreambuf_iterator<char>{*stream}, std::istreambuf_iterator<char>{}};
+			if(stream->bad())
+			{
+				throw ReadException("Failed to read from stream");
+			}
+
+			content_hash = hash_content(contents);
+			file_content_hashes[std::string{file_name}] = content_hash;
+
+			std::optional<CachedTokens> cached = token_cache ? token_cache->load(content_hash) : std::nullopt;
+
+			if(cached.has_value())
+			{
+				logger->debug("Token cache hit for \"", file_name, "\"");
+				record_file_stats(Phase::LEX, file_name, measurement, cached->tokens.size(), 0);
+				file_tokens.insert_or_assign(std::string{file_name}, std::move(cached->tokens));
+				file_lexer_error_counts.insert_or_assign(std::string{file_name}, cached->errors.size());
+				log_lexer_errors(cached->errors, file_name);
+				return;
+			}
+
+			stream = std::make_unique<std::istringstream>(contents);
+		}
+
 		std::unique_ptr<CharReader> reader = std::make_unique<CharReader>(std::move(stream));
 		Lexer lexer(std::move(reader));
 
 		lexer.run();
 
-		file_tokens.emplace(std::string{file_name}, lexer.take_tokens());
+		std::vector<Token> tokens = lexer.take_tokens();
 		lexer_errors = lexer.take_errors();
+
+		if(token_cache && !token_cache->store(content_hash, tokens, lexer_errors))
+		{
+			logger->warning("Could not write token cache entry for \"", file_name, "\"");
+		}
+
+		record_file_stats(Phase::LEX, file_name, measurement, tokens.size(), 0);
+		file_tokens.insert_or_assign(std::string{file_name}, std::move(tokens));
+		file_lexer_error_counts.insert_or_assign(std::string{file_name}, lexer_errors.size());
 	}
 	catch (const ReadException& e)
 	{
-		logger->error("Reading failed: " + std::string(e.what()));
+		logger->error("Reading failed: ", e.what());
 		return;
 	}
 
-	for(const TokenisationError& error : lexer_errors)
+	log_lexer_errors(lexer_errors, file_name);
+}
+
+void Compiler::update_file(std::unique_ptr<std::istream> stream, std::string_view file_name)
+{
+	read_file(std::move(stream), file_name);
+	changed_files.insert(std::string{file_name});
+}
+
+bool Compiler::build()
+{
+	logger->debug("Building...");
+
+	parse_all_files();
+
+	if(error_count > 0)
 	{
-		logger->error
+		logger->error("Not building, as ", error_count, " errors were found");
+		return false;
+	}
+
+	if(verify_ir)
+	{
+		const Measurement measurement_lower{CpuClock::PROCESS};
+		ir::Module module = IrLowerer{*resolution, *folded_calls, compile_function_interpreter.get(), *pool}.run(*root_node);
+
+		PassManager pass_manager{*pool};
+		pass_manager.add_pass(std::make_unique<DeadValueElimination>());
+		pass_manager.run(module);
+		record_phase_stats(Phase::LOWER_IR, measurement_lower);
+
+		bool valid_ir{true};
+		for(const ir::Function& function : module.functions)
+		{
+			for(const std::string& error : ir::verify(function))
+			{
+				logger->error("Invalid IR of ", function.name, ": ", error);
+				valid_ir = false;
+			}
+
+			if(logger->is_enabled(LogLevel::DEBUG)) { logger->debug("IR of ", ir::to_string(function)); }
+		}
+		if(!valid_ir) { return false; }
+	}
+
+	const Measurement measurement_generate{CpuClock::PROCESS};
+	const RefcountAnnotations refcounts = RefcountAnalyser{*pool}.run(*root_node, *resolution);
+	const AllocationAnnotations allocations = ThreadEscapeAnalyser{*pool}.run(*root_node, *resolution);
+	const std::optional<GeneratedProgram> program = CGenerator
+	{
+		*root_node,
+		*resolution,
+		refcounts,
+		allocations,
+		*folded_calls,
+		compile_function_interpreter.get(),
+		*pool
+	}.generate(build_entrypoint);
+	record_phase_stats(Phase::GENERATE, measurement_generate);
+
+	if(!program.has_value())
+	{
+		logger->error("No entrypoint ", build_entrypoint, " to build");
+		return false;
+	}
+	for(const std::string& error : program->errors)
+	{
+		logger->error(error);
+	}
+	if(!program->errors.empty()) { return false; }
+
+	// Process CPU time does not include the C compiler processes, so this is mostly the time spent writing the sources
+	const Measurement measurement_compile{CpuClock::PROCESS};
+	CBuildOptions options{build_directory};
+	if(const char* c_compiler = std::getenv("CC"))
+	{
+		options.c_compiler = c_compiler;
+	}
+	options.verify_thread_local = verify_thread_local;
+
+	const CBuilder builder{*pool, std::move(options)};
+	const std::vector<std::string> errors = builder.build(program.value());
+	record_phase_stats(Phase::COMPILE_C, measurement_compile);
+
+	for(const std::string& error : errors)
+	{
+		logger->error(error);
+	}
+	if(!errors.empty()) { return false; }
+
+	logger->info("Built ", builder.get_executable_path().string());
+	return true;
+}
+
+void Compiler::generate_analysis()
+{
+	logger->debug("Generating analysis...");
+
+	parse_all_files();
+
+	const Measurement measurement{CpuClock::PROCESS};
+
+	ASTPrinter printer{};
+	printer.visit(*root_node);
+
+	record_phase_stats(Phase::PRINT, measurement);
+}
+
+std::vector<std::string> Compiler::update_analysis()
+{
+	logger->debug("Updating analysis...");
+
+	std::vector<std::string_view> files;
+
+	for(const std::string& file : changed_files)
+	{
+		std::unordered_map<std::string, std::vector<Token>>::const_iterator it = file_tokens.find(file);
+
+		if(it != file_tokens.end())
+		{
+			files.push_back(it->first);
+		}
+	}
+
+	changed_files.clear();
+
+	return parse_files(files);
+}
+
+void Compiler::parse_all_files()
+{
+	std::vector<std::string_view> files;
+	files.reserve(file_tokens.size());
+
+	for(const std::pair<const std::string, std::vector<Token>>& pair : file_tokens)
+	{
+		files.push_back(pair.first);
+	}
+
+	changed_files.clear();
+	parse_files(files);
+}
+
+std::vector<std::string> Compiler::parse_files(const std::vector<std::string_view>& changed)
+{
+	std::unordered_set<std::string_view> parsed_files{changed.begin(), changed.end()};
+	// Package members declared by the changed files, both before and after the change
+	std::vector<std::string> changed_declarations;
+
+	std::vector<FileAnalysis> files;
+	files.reserve(file_tokens.size());
+
+	for(std::string_view file : changed)
+	{
+		const std::vector<std::string>& declarations = dependency_graph->get_declarations(std::string{file});
+		changed_declarations.insert(changed_declarations.end(), declarations.begin(), declarations.end());
+
+		remove_package_members(file, 0);
+
+		FileAnalysis& file_analysis = add_file_analysis(files, file);
+
+		if(ast_cache)
+		{
+			file_analysis.cache_entry = ast_cache->load(file_content_hashes.at(std::string{file}));
+		}
+
+		if(!file_analysis.cache_entry.has_value())
+		{
+			create_parser(file_analysis);
+		}
+	}
+
+	const Measurement measurement_a{CpuClock::PROCESS};
+
+	for(FileAnalysis& file_analysis : files)
+	{
+		const Measurement measurement{};
+		FileParseState& parse_state = *file_analysis.parse_state;
+
+		if(file_analysis.cache_entry.has_value())
+		{
+			restore_fragment_a(file_analysis);
+			parse_state.package = file_analysis.cache_entry->fragment_a.package;
+		}
+		else
+		{
+			file_analysis.parser->run_a();
+			parse_state.package = file_analysis.parser->get_package();
+		}
+
+		const std::vector<std::string>& members = root_node->file_package_members[std::string{file_analysis.file}];
+		parse_state.operator_module_count = members.size();
+		parse_state.entries_a = file_analysis.recording_reporter->take_entries();
+
+		changed_declarations.insert(changed_declarations.end(), members.begin(), members.end());
+
+		record_file_stats(Phase::PARSE_A, file_analysis.file, measurement, 0, 0);
+	}
+
+	record_phase_stats(Phase::PARSE_A, measurement_a);
+
+	// Operators are resolved while parsing, so files using a changed operator module have to be parsed again
+	for(const std::string& declaration : changed_declarations)
+	{
+		for(const std::string& dependent : dependency_graph->get_dependents_of(declaration, DependencyKind::USE))
+		{
+			std::unordered_map<std::string, std::vector<Token>>::const_iterator it = file_tokens.find(dependent);
+
+			if(it == file_tokens.end() || parsed_files.contains(it->first)) { continue; }
+
+			parsed_files.insert(it->first);
+
+			FileAnalysis& file_analysis = add_file_analysis(files, it->first);
+
+			remove_package_members(file_analysis.file, file_analysis.parse_state->operator_module_count);
+
+			if(ast_cache)
+			{
+				file_analysis.cache_entry = ast_cache->load(file_content_hashes.at(dependent));
+			}
+
+			for(const AnalysisEntry& entry : file_analysis.parse_state->entries_a)
+			{
+				file_analysis.indexing_reporter->report(entry);
+			}
+		}
+	}
+
+	const Measurement measurement_b{CpuClock::PROCESS};
+	std::shared_ptr<OperatorTable> operator_table = std::make_shared<OperatorTable>();
+	std::unordered_map<std::string, uint64_t> fingerprints;
+
+	for(FileAnalysis& file_analysis : files)
+	{
+		const uint64_t ast_nodes_a = compilation_stats ? count_ast_nodes(file_analysis.file) : 0;
+		const Measurement measurement{};
+
+		if(file_analysis.cache_entry.has_value())
+		{
+			if(restore_fragment_b(file_analysis, fingerprints))
+			{
+				logger->debug("AST cache hit for \"", file_analysis.file, "\"");
+
+				std::vector<std::string> used_operator_modules;
+				for(const std::pair<std::string, uint64_t>& used : file_analysis.cache_entry->used_operator_modules)
+				{
+					used_operator_modules.push_back(used.first);
+				}
+
+				update_dependency_graph(file_analysis.file, used_operator_modules, file_analysis.cache_entry->imported_package_members);
+
+				record_file_stats(Phase::PARSE_B, file_analysis.file, measurement, 0, ast_nodes_a);
+				continue;
+			}
+		}
+
+		if(!file_analysis.parser.has_value())
+		{
+			create_parser(file_analysis);
+			file_analysis.parser->restore_a(file_analysis.parse_state->package);
+		}
+
+		file_analysis.parser->run_b(operator_table);
+
+		update_dependency_graph
 		(
-			"At line " + std::to_string(error.source_position.newlines_count + 1) +
-			", column " + std::to_string(error.source_position.offset_in_line + 1) + // TODO: Take into account '\t'
-			", in file \"" + std::string(file_name) +
-			"\": " + std::string(error.message)
+			file_analysis.file,
+			file_analysis.parser->get_used_operator_modules(),
+			file_analysis.parser->get_imported_package_members()
 		);
+
+		if(ast_cache)
+		{
+			store_ast_cache_entry(file_analysis, fingerprints);
+		}
+		else
+		{
+			file_analysis.recording_reporter->take_entries();
+		}
+
+		record_file_stats(Phase::PARSE_B, file_analysis.file, measurement, 0, ast_nodes_a);
 	}
+
+	record_phase_stats(Phase::PARSE_B, measurement_b);
+
+	// Resolved again as a whole: a changed declaration can change what references in unchanged files resolve to
+	if(!pool) { pool = std::make_unique<concurrency::WorkStealingPool>(thread_count); }
+
+	const Measurement measurement_resolve{CpuClock::PROCESS};
+	resolution = NameResolver{*pool}.run(*root_node);
+	record_phase_stats(Phase::RESOLVE, measurement_resolve);
+
+	const Measurement measurement_type_check{CpuClock::PROCESS};
+	// Files that were not parsed again get a reporter for their type errors, which can change with other files
+	FileRoutingAnalysisReporter type_check_reporter{[] (std::string_view file)
+	{
+		return std::make_shared<ConsoleAnalysisReporter>(std::string{file});
+	}};
+	for(const FileAnalysis& file_analysis : files)
+	{
+		type_check_reporter.add_file(file_analysis.file, file_analysis.indexing_reporter);
+	}
+	error_count = 0;
+	for(const FileAnalysis& file_analysis : files)
+	{
+		error_count += file_lexer_error_counts[std::string{file_analysis.file}];
+		error_count += file_analysis.error_counting_reporter->get_error_count();
+	}
+	error_count += TypeChecker{*pool}.run(*root_node, *resolution, type_check_reporter);
+	record_phase_stats(Phase::TYPE_CHECK, measurement_type_check);
+
+	const Measurement measurement_evaluate{CpuClock::PROCESS};
+	folded_calls = std::make_shared<const FoldedCalls>(PureEvaluator{*resolution}.fold_calls(*root_node));
+
+	std::shared_ptr<CompileFunctionInterpreter> interpreter = std::make_shared<CompileFunctionInterpreter>(*root_node, *resolution);
+	const std::size_t failed_expansion_count = interpreter->expand_all();
+	if(failed_expansion_count > 0)
+	{
+		logger->warning(failed_expansion_count, " auto: calls could not be expanded");
+	}
+	compile_function_interpreter = std::move(interpreter);
+	record_phase_stats(Phase::EVALUATE, measurement_evaluate, folded_calls->size());
+
+	const Measurement measurement_index{CpuClock::PROCESS};
+	std::vector<std::string> parsed;
+	parsed.reserve(files.size());
+
+	for(const FileAnalysis& file_analysis : files)
+	{
+		file_analysis.indexing_reporter->commit(create_reference_resolver(file_analysis.file));
+		parsed.emplace_back(file_analysis.file);
+	}
+
+	update_symbol_index();
+
+	record_phase_stats(Phase::INDEX, measurement_index);
+
+	return parsed;
 }
 
-void Compiler::build() const
+std::shared_ptr<const SymbolIndex> Compiler::get_symbol_index() const
 {
-	logger->debug("Building...");
+	return symbol_index;
 }
 
-void Compiler::generate_analysis() const
+std::shared_ptr<const ReferenceIndex> Compiler::get_reference_index() const
 {
-	logger->debug("Generating analysis...");
+	return reference_index;
+}
+
+std::shared_ptr<const DependencyGraph> Compiler::get_dependency_graph() const
+{
+	return dependency_graph;
+}
 
-	std::vector<Parser> parsers;
+std::shared_ptr<const Resolution> Compiler::get_resolution() const
+{
+	return resolution;
+}
+
+std::shared_ptr<const FoldedCalls> Compiler::get_folded_calls() const
+{
+	return folded_calls;
+}
+
+std::shared_ptr<const CompileFunctionInterpreter> Compiler::get_compile_function_interpreter() const
+{
+	return compile_function_interpreter;
+}
+
+std::shared_ptr<const CompilationStats> Compiler::get_stats() const
+{
+	return compilation_stats;
+}
+
+std::vector<OperatorProfileEntry> Compiler::get_operator_profile() const
+{
+	const std::unordered_map<const OperatorDeclaration*, OperatorProfile> profiles = operator_profiler::collect();
+
+	std::vector<OperatorProfileEntry> entries;
+
+	for(const std::shared_ptr<const Operator>& op : builtin_operators::LIST)
+	{
+		std::unordered_map<const OperatorDeclaration*, OperatorProfile>::const_iterator it = profiles.find(op->get_declaration());
+
+		if(it != profiles.end())
+		{
+			entries.push_back(OperatorProfileEntry{operator_pattern_to_string(*op->get_declaration()), "", "", it->second});
+		}
+	}
+
+	for(const std::pair<const std::string, std::vector<std::string>>& pair : root_node->file_package_members)
+	{
+		for(const std::string& identifier : pair.second)
+		{
+			std::unordered_map<std::string, std::unique_ptr<PackageMember>>::const_iterator member_it =
+				root_node->package_members.find(identifier);
+
+			if(member_it == root_node->package_members.end()) { continue; }
+
+			const OperatorModule* operator_module = dynamic_cast<const OperatorModule*>(member_it->second.get());
+
+			if(!operator_module) { continue; }
+
+			for(const OperatorDeclaration& op_decl : operator_module->operators)
+			{
+				std::unordered_map<const OperatorDeclaration*, OperatorProfile>::const_iterator it = profiles.find(&op_decl);
+
+				if(it == profiles.end()) { continue; }
+
+				const std::string location = pair.first + ":" +
+					std::to_string(op_decl.source_position.newlines_count + 1) + ":" +
+					std::to_string(op_decl.source_position.offset_in_line + 1);
+
+				entries.push_back(OperatorProfileEntry{operator_pattern_to_string(op_decl), identifier, location, it->second});
+			}
+		}
+	}
+
+	return entries;
+}
+
+Compiler::FileAnalysis& Compiler::add_file_analysis(std::vector<FileAnalysis>& files, std::string_view file)
+{
+	FileAnalysis& file_analysis = files.emplace_back();
+	file_analysis.file = file;
+	file_analysis.parse_state = &file_parse_states[std::string{file}];
+	file_analysis.error_counting_reporter = std::make_shared<ErrorCountingAnalysisReporter>
+	(
+		std::make_shared<ConsoleAnalysisReporter>(std::string{file})
+	);
+	file_analysis.indexing_reporter = std::make_shared<ReferenceIndexingAnalysisReporter>
+	(
+		file_analysis.error_counting_reporter,
+		reference_index,
+		std::string{file}
+	);
+	file_analysis.recording_reporter = std::make_shared<RecordingAnalysisReporter>(file_analysis.indexing_reporter);
+
+	return file_analysis;
+}
+
+void Compiler::remove_package_members(std::string_view file, std::size_t first) const
+{
+	std::unordered_map<std::string, std::vector<std::string>>::iterator it =
+		root_node->file_package_members.find(std::string{file});
+
+	if(it == root_node->file_package_members.end())
+	{
+		return;
+	}
+
+	std::vector<std::string>& members = it->second;
+
+	for(std::size_t i = first; i < members.size(); ++i)
+	{
+		// Only operator modules are in the operator map
+		operator_map->erase(members[i]);
+		root_node->package_members.erase(members[i]);
+	}
 
+	members.resize(std::min(first, members.size()));
+}
+
+void Compiler::update_dependency_graph
+(
+	std::string_view file,
+	const std::vector<std::string>& used_operator_modules,
+	const std::vector<std::string>& imported_package_members
+) const
+{
+	std::vector<Dependency> dependencies;
+	dependencies.reserve(used_operator_modules.size() + imported_package_members.size());
+
+	for(const std::string& operator_module : used_operator_modules)
+	{
+		dependencies.push_back(Dependency{operator_module, DependencyKind::USE});
+	}
+
+	for(const std::string& package_member : imported_package_members)
+	{
+		dependencies.push_back(Dependency{package_member, DependencyKind::IMPORT});
+	}
+
+	const std::string file_str{file};
+
+	root_node->file_imports[file_str] = imported_package_members;
+	dependency_graph->update_file(file_str, root_node->file_package_members[file_str], dependencies);
+}
+
+void Compiler::update_symbol_index() const
+{
 	for(const std::pair<const std::string, std::vector<Token>>& pair : file_tokens)
 	{
-		const std::span<const Token> tokens_view{pair.second};
+		std::unordered_map<std::string, std::vector<std::string>>::const_iterator it =
+			root_node->file_package_members.find(pair.first);
 
-		std::shared_ptr<AnalysisReporter> reporter = std::make_shared<ConsoleAnalysisReporter>(pair.first);
+		if(it == root_node->file_package_members.end())
+		{
+			symbol_index->update_file(pair.first, std::vector<std::string>{});
+		}
+		else
+		{
+			symbol_index->update_file(pair.first, it->second);
+		}
+	}
+}
 
-		parsers.emplace_back(logger, tokens_view, reporter, root_node, pair.first, operator_map);
+ReferenceIndexingAnalysisReporter::ResolveReference Compiler::create_reference_resolver(std::string_view file) const
+{
+	// By offset in the file. Empty for the declarations that are not indexed.
+	std::unordered_map<uint32_t, std::optional<std::string>> body_symbols;
+
+	std::unordered_map<std::string, std::vector<std::string>>::const_iterator it = root_node->file_package_members.find(std::string{file});
+
+	if(it != root_node->file_package_members.end())
+	{
+		for(const std::string& package_member : it->second)
+		{
+			for(const BodyReference& body_reference : resolution->get_body_references(package_member))
+			{
+				const Declaration& declaration = resolution->get_declaration(body_reference.declaration);
+				const bool local = declaration.kind == DeclarationKind::PARAMETER || declaration.kind == DeclarationKind::LOCAL
+					|| declaration.kind == DeclarationKind::GENERIC_PARAMETER;
+
+				body_symbols[body_reference.source_position.offset_in_file] = local ? std::nullopt : std::optional<std::string>{declaration.name};
+			}
+		}
 	}
 
-	for(Parser& parser : parsers)
+	return [resolution = resolution, file_scope = resolution->get_file_scope(file), body_symbols = std::move(body_symbols)]
+		(const std::string& symbol, const SymbolOccurrence& occurrence) -> std::optional<std::string>
 	{
-		parser.run_a();
+		std::unordered_map<uint32_t, std::optional<std::string>>::const_iterator body_it = body_symbols.find(occurrence.source_position.offset_in_file);
+
+		if(body_it != body_symbols.end()) { return body_it->second; }
+
+		// Full identifiers, e.g. resolved imports
+		if(symbol.find("::") != std::string::npos) { return symbol; }
+
+		const std::optional<DeclarationId> declaration = file_scope ? file_scope->lookup(symbol) : std::nullopt;
+
+		if(!declaration.has_value()) { return std::nullopt; }
+
+		return resolution->get_declaration(declaration.value()).name;
+	};
+}
+
+void Compiler::record_file_stats
+(
+	Phase phase,
+	std::string_view file,
+	const Measurement& measurement,
+	uint64_t tokens,
+	uint64_t ast_nodes_before
+) const
+{
+	if(!compilation_stats) { return; }
+
+	PhaseStats stats = measurement.stop();
+	stats.tokens = tokens;
+
+	if(phase != Phase::LEX)
+	{
+		// Counted after stopping the measurement, so counting is not measured as part of the phase
+		stats.ast_nodes = count_ast_nodes(file) - ast_nodes_before;
 	}
 
-	std::shared_ptr<OperatorTable> operator_table = std::make_shared<OperatorTable>();
+	compilation_stats->add_file(phase, std::string{file}, stats);
 
-	for(Parser& parser : parsers)
+	if(phase == Phase::LEX)
 	{
-		parser.run_b(operator_table);
+		// Files are lexed one by one as they are read, so there is no separate measurement of the phase
+		compilation_stats->add_phase(phase, stats);
 	}
+}
 
-	ASTPrinter printer{};
-	printer.visit(*root_node);
+void Compiler::record_phase_stats(Phase phase, const Measurement& measurement, uint64_t folded_call_count) const
+{
+	if(compilation_stats)
+	{
+		PhaseStats stats = measurement.stop();
+		stats.folded_calls = folded_call_count;
+
+		compilation_stats->add_phase(phase, stats);
+	}
+}
+
+uint64_t Compiler::count_ast_nodes(std::string_view file) const
+{
+	std::unordered_map<std::string, std::vector<std::string>>::const_iterator it =
+		root_node->file_package_members.find(std::string{file});
+
+	if(it == root_node->file_package_members.end())
+	{
+		return 0;
+	}
+
+	ASTNodeCounter counter{};
+
+	for(const std::string& identifier : it->second)
+	{
+		std::unordered_map<std::string, std::unique_ptr<PackageMember>>::const_iterator member_it =
+			root_node->package_members.find(identifier);
+
+		if(member_it != root_node->package_members.end())
+		{
+			member_it->second->accept(counter);
+		}
+	}
+
+	return counter.get_count();
+}
+
+void Compiler::log_lexer_errors(const std::vector<TokenisationError>& errors, std::string_view file_name) const
+{
+	for(const TokenisationError& error : errors)
+	{
+		logger->error
+		(
+			"At line ", error.source_position.newlines_count + 1,
+			", column ", error.source_position.offset_in_line + 1, // TODO: Take into account '\t'
+			", in file \"", file_name,
+			"\": ", error.message
+		);
+	}
+}
+
+void Compiler::create_parser(FileAnalysis& file_analysis) const
+{
+	std::shared_ptr<AnalysisReporter> reporter = file_analysis.indexing_reporter;
+
+	if(file_analysis.recording_reporter)
+	{
+		reporter = file_analysis.recording_reporter;
+	}
+
+	const std::unordered_map<std::string, std::vector<Token>>::const_iterator it =
+		file_tokens.find(std::string{file_analysis.file});
+
+	file_analysis.parser.emplace(logger, std::span<const Token>{it->second}, reporter, root_node, it->first, operator_map);
+}
+
+void Compiler::append_cached_package_member
+(
+	std::string_view file,
+	const std::string& identifier,
+	std::unique_ptr<PackageMember> package_member
+) const
+{
+	root_node->file_package_members[std::string{file}].push_back(identifier);
+	root_node->package_members[identifier] = std::move(package_member);
+}
+
+void Compiler::restore_fragment_a(FileAnalysis& file_analysis) const
+{
+	AstFragmentA& fragment = file_analysis.cache_entry->fragment_a;
+
+	for(std::pair<std::string, std::unique_ptr<OperatorModule>>& pair : fragment.operator_modules)
+	{
+		OperatorModule* operator_module = pair.second.get();
+
+		append_cached_package_member(file_analysis.file, pair.first, std::move(pair.second));
+
+		// Same as registering a parsed operator module
+		std::vector<std::shared_ptr<const Operator>>& operator_list = (*operator_map)[pair.first];
+
+		for(const OperatorDeclaration& op_decl : operator_module->operators)
+		{
+			try
+			{
+				operator_list.push_back(std::make_shared<Operator>(&op_decl));
+			}
+			catch(const std::invalid_argument& e)
+			{
+				logger->info("Invalid operator: ", e.what());
+			}
+		}
+	}
+
+	for(const CachedAnalysisEntry& entry : fragment.entries)
+	{
+		file_analysis.recording_reporter->report(entry.to_entry(file_analysis.file));
+	}
+}
+
+bool Compiler::restore_fragment_b(FileAnalysis& file_analysis, std::unordered_map<std::string, uint64_t>& fingerprints) const
+{
+	const AstCacheEntry& entry = file_analysis.cache_entry.value();
+
+	for(const std::pair<std::string, uint64_t>& used : entry.used_operator_modules)
+	{
+		if(get_operator_module_fingerprint(used.first, fingerprints) != used.second)
+		{
+			return false;
+		}
+	}
+
+	std::optional<AstFragmentB> fragment = ast_cache->read_fragment_b(entry, *operator_map);
+
+	if(!fragment.has_value())
+	{
+		return false;
+	}
+
+	const std::vector<std::string>& members = root_node->file_package_members[std::string{file_analysis.file}];
+
+	for(std::size_t i = 0; i < fragment->operator_functions.size(); ++i)
+	{
+		OperatorModule* operator_module = dynamic_cast<OperatorModule*>(root_node->package_members[members[i]].get());
+
+		if(operator_module)
+		{
+			operator_module->functions = std::move(fragment->operator_functions[i]);
+		}
+	}
+
+	for(std::pair<std::string, std::unique_ptr<PackageMember>>& pair : fragment->package_members)
+	{
+		append_cached_package_member(file_analysis.file, pair.first, std::move(pair.second));
+	}
+
+	for(const CachedAnalysisEntry& cached_entry : fragment->entries)
+	{
+		file_analysis.indexing_reporter->report(cached_entry.to_entry(file_analysis.file));
+	}
+
+	return true;
+}
+
+void Compiler::store_ast_cache_entry(FileAnalysis& file_analysis, std::unordered_map<std::string, uint64_t>& fingerprints) const
+{
+	const std::vector<std::string>& members = root_node->file_package_members[std::string{file_analysis.file}];
+	const std::vector<AnalysisEntry> entries_b = file_analysis.recording_reporter->take_entries();
+
+	ParsedFile parsed_file
+	{
+		file_analysis.parser->get_package(),
+		{},
+		file_analysis.parse_state->entries_a,
+		{},
+		file_analysis.parser->get_imported_package_members(),
+		{},
+		entries_b
+	};
+
+	for(const std::string& operator_module : file_analysis.parser->get_used_operator_modules())
+	{
+		parsed_file.used_operator_modules.emplace_back(operator_module, get_operator_module_fingerprint(operator_module, fingerprints));
+	}
+
+	for(std::size_t i = 0; i < members.size(); ++i)
+	{
+		const PackageMember* package_member = root_node->package_members.at(members[i]).get();
+
+		if(i < file_analysis.parse_state->operator_module_count)
+		{
+			const OperatorModule* operator_module = dynamic_cast<const OperatorModule*>(package_member);
+
+			if(!operator_module) { return; }
+
+			parsed_file.operator_modules.emplace_back(members[i], operator_module);
+		}
+		else
+		{
+			parsed_file.package_members.emplace_back(members[i], package_member);
+		}
+	}
+
+	if(!ast_cache->store(file_content_hashes.at(std::string{file_analysis.file}), parsed_file, *operator_map))
+	{
+		logger->debug("Not caching the AST of \"", file_analysis.file, "\"");
+	}
+}
+
+uint64_t Compiler::get_operator_module_fingerprint
+(
+	const std::string& operator_module,
+	std::unordered_map<std::string, uint64_t>& fingerprints
+) const
+{
+	std::unordered_map<std::string, uint64_t>::const_iterator it = fingerprints.find(operator_module);
+
+	if(it == fingerprints.end())
+	{
+		it = fingerprints.emplace(operator_module, AstCache::fingerprint_operator_module(*operator_map, operator_module)).first;
+	}
+
+	return it->second;
 }
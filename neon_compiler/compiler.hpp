@@ -1,13 +1,32 @@
 #ifndef COMPILER_HPP
 #define COMPILER_HPP
 
+#include <filesystem>
 #include <memory>
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 #include <string>
 #include "../logging/logger.hpp"
+#include "analysis/analysis_entry.hpp"
+#include "analysis/impl/error_counting_analysis_reporter.hpp"
+#include "analysis/impl/recording_analysis_reporter.hpp"
+#include "analysis/impl/reference_indexing_analysis_reporter.hpp"
 #include "ast/nodes/nodes.hpp"
+#include "cache/ast_cache.hpp"
+#include "cache/token_cache.hpp"
+#include "evaluation/compile_function_interpreter.hpp"
+#include "evaluation/pure_evaluator.hpp"
+#include "index/dependency_graph.hpp"
+#include "index/reference_index.hpp"
+#include "index/symbol_index.hpp"
 #include "parser/parser.hpp"
+#include "resolution/resolution.hpp"
+#include "stats/compilation_stats.hpp"
+#include "stats/operator_profiler.hpp"
 #include "token.hpp"
+#include "../concurrency/work_stealing_pool.hpp"
 
 namespace neon_compiler
 {
@@ -17,15 +36,158 @@ class Compiler
 public:
 	explicit Compiler(std::shared_ptr<logging::Logger> init_logger);
 
+	/** Enables reusing lexer output across runs, stored in `directory` keyed by source content. */
+	void enable_token_cache(const std::filesystem::path& directory);
+	/** Enables reusing parse results across runs, stored in `directory` keyed by source content. */
+	void enable_ast_cache(const std::filesystem::path& directory);
+	/** Enables recording time and counters per phase and per file, see `get_stats`. */
+	void enable_stats();
+	/** Sets the number of threads used by the passes after parsing. Defaults to one per hardware thread. */
+	void set_thread_count(std::size_t new_thread_count);
+	/** Makes `build` generate code that checks at run time, in debug builds, that objects classified as thread-local
+	 * by `reference_counting::ThreadEscapeAnalyser` are only used on their own thread. */
+	void enable_thread_local_verification();
+	/** Makes `build` lower the AST to the IR (see `ir::IrLowerer`), run the pass pipeline on it and verify it, before generating C.
+	 * The C generator does not read the IR yet, so this only checks the lowering; the IR is logged at the debug level. */
+	void enable_ir_verification();
+	/** Sets where `build` writes the generated C sources and the executable. Defaults to `neon_build`. */
+	void set_build_directory(const std::filesystem::path& directory);
+	/** Sets the full identifier of the entrypoint that the executable built by `build` runs. Defaults to `main::start`. */
+	void set_build_entrypoint(std::string entrypoint);
 	void read_file(std::unique_ptr<std::istream> stream, std::string_view file_name);
-	void build() const;
-	void generate_analysis() const;
+	/** Reads a new version of a file. `update_analysis` parses it again, together with the files depending on it. */
+	void update_file(std::unique_ptr<std::istream> stream, std::string_view file_name);
+	/** Parses all files, generates C (see `codegen::CGenerator`) and compiles it with the system C compiler,
+	 * or the one named by the environment variable `CC`. Stops before generating C if the lexer, the parser
+	 * or the type checker reported errors, and before compiling it if the generator did. Returns whether the executable was built.
+	 *
+	 * With `enable_ir_verification`, stops before generating C if the IR is invalid. */
+	bool build();
+	void generate_analysis();
+	/** Parses the files changed by `update_file`, and the files that `use` an operator module declared in one of them.
+	 * Other files keep their parse results. Returns the files that were parsed. */
+	std::vector<std::string> update_analysis();
+
+	std::shared_ptr<const neon_compiler::index::SymbolIndex> get_symbol_index() const;
+	std::shared_ptr<const neon_compiler::index::ReferenceIndex> get_reference_index() const;
+	std::shared_ptr<const neon_compiler::index::DependencyGraph> get_dependency_graph() const;
+	/** Name resolution of the AST as of the last analysis */
+	std::shared_ptr<const neon_compiler::resolution::Resolution> get_resolution() const;
+	/** Values of the pure function calls evaluated at compile time, as of the last analysis */
+	std::shared_ptr<const neon_compiler::evaluation::FoldedCalls> get_folded_calls() const;
+	/** Expansions of the `auto:` calls, as of the last analysis */
+	std::shared_ptr<const neon_compiler::evaluation::CompileFunctionInterpreter> get_compile_function_interpreter() const;
+	/** Empty unless stats are enabled */
+	std::shared_ptr<const neon_compiler::stats::CompilationStats> get_stats() const;
+	/** Profiles of the operators tried while parsing. Empty unless `stats::operator_profiler` is enabled. */
+	std::vector<neon_compiler::stats::OperatorProfileEntry> get_operator_profile() const;
 
 private:
+	/** What is kept of a parsed file, so its second parsing phase can be repeated without the first */
+	struct FileParseState
+	{
+		neon_compiler::ast::Identifier package;
+		std::vector<neon_compiler::analysis::AnalysisEntry> entries_a;
+		/** Number of package members added in the first parsing phase, which are all operator modules */
+		std::size_t operator_module_count{0};
+	};
+
+	/** State of one file during `generate_analysis` */
+	struct FileAnalysis
+	{
+		std::string_view file;
+		std::shared_ptr<neon_compiler::analysis::impl::ReferenceIndexingAnalysisReporter> indexing_reporter;
+		/** Counts the errors forwarded by `indexing_reporter` */
+		std::shared_ptr<neon_compiler::analysis::impl::ErrorCountingAnalysisReporter> error_counting_reporter;
+		/** Records entries for `FileParseState::entries_a` and the AST cache */
+		std::shared_ptr<neon_compiler::analysis::impl::RecordingAnalysisReporter> recording_reporter;
+		/** Empty while the file is restored from the AST cache */
+		std::optional<neon_compiler::parser::Parser> parser;
+		std::optional<neon_compiler::cache::AstCacheEntry> cache_entry;
+		FileParseState* parse_state;
+	};
+
 	std::shared_ptr<logging::Logger> logger;
 	std::unordered_map<std::string, std::vector<neon_compiler::Token>> file_tokens;
 	std::shared_ptr<neon_compiler::ast::nodes::Root> root_node;
 	std::shared_ptr<neon_compiler::parser::OperatorMap> operator_map;
+	std::shared_ptr<neon_compiler::index::SymbolInterner> symbol_interner;
+	std::shared_ptr<neon_compiler::index::SymbolIndex> symbol_index;
+	std::shared_ptr<neon_compiler::index::ReferenceIndex> reference_index;
+	std::shared_ptr<neon_compiler::index::DependencyGraph> dependency_graph;
+	std::shared_ptr<neon_compiler::cache::TokenCache> token_cache;
+	std::shared_ptr<neon_compiler::cache::AstCache> ast_cache;
+	std::shared_ptr<neon_compiler::stats::CompilationStats> compilation_stats;
+	std::shared_ptr<const neon_compiler::resolution::Resolution> resolution;
+	std::shared_ptr<const neon_compiler::evaluation::FoldedCalls> folded_calls;
+	std::shared_ptr<const neon_compiler::evaluation::CompileFunctionInterpreter> compile_function_interpreter;
+	std::size_t thread_count;
+	bool verify_thread_local{false};
+	bool verify_ir{false};
+	std::filesystem::path build_directory{"neon_build"};
+	std::string build_entrypoint{"main::start"};
+	/** Runs the passes after parsing. Created on first use, with `thread_count` threads. */
+	std::unique_ptr<concurrency::WorkStealingPool> pool;
+	/** Mapping from file path to content hash. Only filled if a cache is enabled. */
+	std::unordered_map<std::string, uint64_t> file_content_hashes;
+	std::unordered_map<std::string, FileParseState> file_parse_states;
+	/** Files read by `update_file` since the last analysis */
+	std::unordered_set<std::string> changed_files;
+	std::unordered_map<std::string, std::size_t> file_lexer_error_counts;
+	/** Errors of the lexer, the parser and the type checker in the files parsed by the last analysis */
+	std::size_t error_count{0};
+
+	/** Parses all files read so far */
+	void parse_all_files();
+	/** Parses `changed` and the files depending on them through `use` statements. Returns the files that were parsed. */
+	std::vector<std::string> parse_files(const std::vector<std::string_view>& changed);
+	FileAnalysis& add_file_analysis(std::vector<FileAnalysis>& files, std::string_view file);
+	/** Removes the package members of `file` from the AST, starting at the `first`-th one */
+	void remove_package_members(std::string_view file, std::size_t first) const;
+	void update_dependency_graph
+	(
+		std::string_view file,
+		const std::vector<std::string>& used_operator_modules,
+		const std::vector<std::string>& imported_package_members
+	) const;
+	void update_symbol_index() const;
+	/** Decides the symbols of the references reported for `file` by the name resolution. References in bodies get the declaration
+	 * they were resolved to; others are looked up in the scope of the file. Local variables, parameters, generic parameters
+	 * and names that are not declared (e.g. `int`) are left out of the reference index. */
+	neon_compiler::analysis::impl::ReferenceIndexingAnalysisReporter::ResolveReference create_reference_resolver(std::string_view file) const;
+	/** Records the stats of one file. AST nodes are counted as those added to the file since `ast_nodes_before`. */
+	void record_file_stats
+	(
+		neon_compiler::stats::Phase phase,
+		std::string_view file,
+		const neon_compiler::stats::Measurement& measurement,
+		uint64_t tokens,
+		uint64_t ast_nodes_before
+	) const;
+	void record_phase_stats
+	(
+		neon_compiler::stats::Phase phase,
+		const neon_compiler::stats::Measurement& measurement,
+		uint64_t folded_call_count = 0
+	) const;
+	uint64_t count_ast_nodes(std::string_view file) const;
+	void create_parser(FileAnalysis& file_analysis) const;
+	void append_cached_package_member
+	(
+		std::string_view file,
+		const std::string& identifier,
+		std::unique_ptr<neon_compiler::ast::nodes::PackageMember> package_member
+	) const;
+	void restore_fragment_a(FileAnalysis& file_analysis) const;
+	/** Restores the second parsing phase of a file, unless an operator module it uses changed. */
+	bool restore_fragment_b(FileAnalysis& file_analysis, std::unordered_map<std::string, uint64_t>& fingerprints) const;
+	void store_ast_cache_entry(FileAnalysis& file_analysis, std::unordered_map<std::string, uint64_t>& fingerprints) const;
+	uint64_t get_operator_module_fingerprint
+	(
+		const std::string& operator_module,
+		std::unordered_map<std::string, uint64_t>& fingerprints
+	) const;
+	void log_lexer_errors(const std::vector<neon_compiler::lexer::TokenisationError>& errors, std::string_view file_name) const;
 };
 
 }
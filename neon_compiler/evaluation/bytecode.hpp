@@ -0,0 +1,93 @@
+#ifndef BYTECODE_HPP
+#define BYTECODE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <variant>
+#include <vector>
+#include "constant_value.hpp"
+
+namespace neon_compiler::evaluation
+{
+
+/** Stable reference to a node of the AST, handed to compile functions instead of a copy of the node.
+ * Stays valid, and refers to the same node, for as long as the interpreter that handed it out. */
+struct AstHandle
+{
+	uint32_t index;
+
+	bool operator==(const AstHandle&) const = default;
+};
+
+/** Value in a register of a running compile function */
+using Value = std::variant<NumberValue, std::string, bool, AstHandle>;
+
+/** Functions that compile functions call to read their arguments and the AST */
+enum class Intrinsic : uint32_t
+{
+	/** `argument_count()`: number of arguments of the `auto:` call */
+	ARGUMENT_COUNT,
+	/** `argument(index)`: the name or literal passed as argument, as a string */
+	ARGUMENT,
+	/** `package_member(identifier)`: handle to the package member with this full identifier */
+	PACKAGE_MEMBER,
+	/** `kind(handle)`: kind of the node, e.g. `entrypoint` */
+	KIND,
+	/** `concat(a, b)`: `a` and `b` as one string */
+	CONCAT
+};
+
+struct IntrinsicInfo
+{
+	std::string_view name;
+	std::size_t parameter_count;
+};
+
+constexpr IntrinsicInfo INTRINSICS[]
+{
+	{"argument_count", 0},
+	{"argument", 1},
+	{"package_member", 1},
+	{"kind", 1},
+	{"concat", 2}
+};
+
+enum class OpCode : uint8_t
+{
+	/** `destination = constants[operand]` */
+	LOAD_CONSTANT,
+	/** `destination = first` */
+	MOVE,
+	/** `destination =` pure function with declaration `operand`, called with registers `first` to `first + count` */
+	CALL_PURE,
+	/** `destination =` intrinsic `operand`, called with registers `first` to `first + count` */
+	CALL_INTRINSIC,
+	/** Returns register `first` */
+	RETURN,
+	/** Returns without a value */
+	RETURN_VOID
+};
+
+/** One instruction. Operands are register indices, apart from `operand`, whose meaning depends on the op code. */
+struct Instruction
+{
+	OpCode op_code;
+	uint16_t destination;
+	uint16_t first;
+	uint16_t count;
+	uint32_t operand;
+};
+
+/** Bytecode of a compile function body. Registers hold its local variables, followed by temporary values. */
+struct Chunk
+{
+	std::vector<Instruction> instructions;
+	std::vector<ConstantValue> constants;
+	std::size_t register_count{0};
+};
+
+}
+
+#endif // BYTECODE_HPP
@@ -0,0 +1,235 @@
+#include "bytecode_compiler.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <string>
+#include "pure_evaluator.hpp"
+
+using namespace neon_compiler::ast::nodes;
+using namespace neon_compiler::evaluation;
+using namespace neon_compiler::resolution;
+
+namespace
+{
+	/** Thrown to stop compiling at the first error */
+	struct BytecodeCompilationError
+	{
+		std::string message;
+	};
+
+	std::optional<Intrinsic> find_intrinsic(std::string_view name)
+	{
+		for(std::size_t i = 0; i < std::size(INTRINSICS); ++i)
+		{
+			if(INTRINSICS[i].name == name) { return static_cast<Intrinsic>(i); }
+		}
+
+		return std::nullopt;
+	}
+}
+
+BytecodeCompiler::BytecodeCompiler(const Resolution& init_resolution)
+	: resolution{init_resolution} {}
+
+CompiledFunction BytecodeCompiler::compile(const CodeBlock& body)
+{
+	chunk = Chunk{};
+	local_registers.clear();
+	next_register = 0;
+
+	try
+	{
+		for(const std::unique_ptr<Statement>& statement : body.statements)
+		{
+			compile_statement(statement.get());
+		}
+		emit(OpCode::RETURN_VOID, 0, 0, 0, 0);
+	}
+	catch(const BytecodeCompilationError& error)
+	{
+		return CompiledFunction{std::nullopt, error.message};
+	}
+
+	return CompiledFunction{std::move(chunk), std::string{}};
+}
+
+void BytecodeCompiler::compile_statement(const Statement* statement)
+{
+	if(!statement)
+	{
+		throw BytecodeCompilationError{std::string{bytecode_compiler_error_messages::SYNTAX_ERROR}};
+	}
+
+	// Temporary values of a statement are not needed by the next one
+	const uint32_t first_temporary_register = next_register;
+
+	if(const DiscardExpression* discard = dynamic_cast<const DiscardExpression*>(statement))
+	{
+		compile_expression(discard->expression.get(), allocate_register());
+	}
+	else if(const LocalDeclaration* local = dynamic_cast<const LocalDeclaration*>(statement))
+	{
+		const uint16_t local_register = allocate_register();
+		local_registers.emplace(&local->variable_declaration, local_register);
+
+		if(local->variable_declaration.initialisation)
+		{
+			compile_expression(local->variable_declaration.initialisation.get(), local_register);
+		}
+		return;
+	}
+	else if(const Return* ret = dynamic_cast<const Return*>(statement))
+	{
+		if(ret->value)
+		{
+			const uint16_t value_register = allocate_register();
+			compile_expression(ret->value.get(), value_register);
+			emit(OpCode::RETURN, 0, value_register, 1, 0);
+		}
+		else
+		{
+			emit(OpCode::RETURN_VOID, 0, 0, 0, 0);
+		}
+	}
+	else
+	{
+		throw BytecodeCompilationError{std::string{bytecode_compiler_error_messages::UNSUPPORTED_STATEMENT}};
+	}
+
+	next_register = first_temporary_register;
+}
+
+void BytecodeCompiler::compile_expression(const Expression* expression, uint16_t destination)
+{
+	if(!expression)
+	{
+		throw BytecodeCompilationError{std::string{bytecode_compiler_error_messages::SYNTAX_ERROR}};
+	}
+
+	if(const LiteralNumberExpression* number = dynamic_cast<const LiteralNumberExpression*>(expression))
+	{
+		chunk.constants.emplace_back(make_number_value(number->value));
+		emit(OpCode::LOAD_CONSTANT, destination, 0, 0, static_cast<uint32_t>(chunk.constants.size() - 1));
+	}
+	else if(const LiteralStringExpression* string = dynamic_cast<const LiteralStringExpression*>(expression))
+	{
+		chunk.constants.emplace_back(string->value);
+		emit(OpCode::LOAD_CONSTANT, destination, 0, 0, static_cast<uint32_t>(chunk.constants.size() - 1));
+	}
+	else if(const LiteralBooleanExpression* boolean = dynamic_cast<const LiteralBooleanExpression*>(expression))
+	{
+		chunk.constants.emplace_back(boolean->value);
+		emit(OpCode::LOAD_CONSTANT, destination, 0, 0, static_cast<uint32_t>(chunk.constants.size() - 1));
+	}
+	else if(dynamic_cast<const SimpleRead*>(expression))
+	{
+		emit(OpCode::MOVE, destination, get_local_register(expression), 1, 0);
+	}
+	else if(const Assignment* assignment = dynamic_cast<const Assignment*>(expression))
+	{
+		const uint16_t local_register = get_local_register(assignment->target.get());
+
+		compile_expression(assignment->value.get(), local_register);
+		emit(OpCode::MOVE, destination, local_register, 1, 0);
+	}
+	else if(const DeclarationId pure_function = PureEvaluator::find_called_function(resolution, *expression);
+		pure_function != UNRESOLVED_DECLARATION)
+	{
+		const FunctionCall* function_call = dynamic_cast<const FunctionCall*>(expression);
+		const std::vector<std::unique_ptr<Expression>>& arguments = function_call
+			? function_call->arguments
+			: static_cast<const ObjectFunctionCall*>(expression)->arguments;
+
+		compile_call(OpCode::CALL_PURE, pure_function, arguments, destination);
+	}
+	// Intrinsics are not declared, so their names are not resolved
+	else if(const FunctionCall* call = dynamic_cast<const FunctionCall*>(expression);
+		call && call->declaration == UNRESOLVED_DECLARATION)
+	{
+		const std::optional<Intrinsic> intrinsic = find_intrinsic(call->function_name);
+
+		if(!intrinsic.has_value())
+		{
+			throw BytecodeCompilationError{std::string{bytecode_compiler_error_messages::UNKNOWN_FUNCTION} + call->function_name};
+		}
+		if(call->arguments.size() != INTRINSICS[static_cast<std::size_t>(intrinsic.value())].parameter_count)
+		{
+			throw BytecodeCompilationError{std::string{bytecode_compiler_error_messages::WRONG_ARGUMENT_COUNT} + call->function_name};
+		}
+
+		compile_call(OpCode::CALL_INTRINSIC, static_cast<uint32_t>(intrinsic.value()), call->arguments, destination);
+	}
+	else
+	{
+		throw BytecodeCompilationError{std::string{bytecode_compiler_error_messages::UNSUPPORTED_EXPRESSION}};
+	}
+}
+
+void BytecodeCompiler::compile_call
+(
+	OpCode op_code,
+	uint32_t operand,
+	const std::vector<std::unique_ptr<Expression>>& arguments,
+	uint16_t destination
+)
+{
+	const uint32_t first_argument_register = next_register;
+
+	// All argument registers are allocated first, as computing an argument may need further registers
+	for(std::size_t i = 0; i < arguments.size(); ++i)
+	{
+		allocate_register();
+	}
+	for(std::size_t i = 0; i < arguments.size(); ++i)
+	{
+		compile_expression(arguments[i].get(), static_cast<uint16_t>(first_argument_register + i));
+	}
+
+	emit
+	(
+		op_code,
+		destination,
+		static_cast<uint16_t>(first_argument_register),
+		static_cast<uint16_t>(arguments.size()),
+		operand
+	);
+	next_register = first_argument_register;
+}
+
+uint16_t BytecodeCompiler::get_local_register(const Expression* expression) const
+{
+	const SimpleRead* read = dynamic_cast<const SimpleRead*>(expression);
+
+	if(!read)
+	{
+		throw BytecodeCompilationError{std::string{bytecode_compiler_error_messages::UNSUPPORTED_EXPRESSION}};
+	}
+
+	if(read->declaration != UNRESOLVED_DECLARATION)
+	{
+		const Declaration& declaration = resolution.get_declaration(read->declaration);
+		const std::unordered_map<const VariableDeclaration*, uint16_t>::const_iterator it =
+			local_registers.find(static_cast<const VariableDeclaration*>(declaration.nodes.empty() ? nullptr : declaration.nodes.front()));
+
+		if(declaration.kind == DeclarationKind::LOCAL && it != local_registers.end()) { return it->second; }
+	}
+
+	throw BytecodeCompilationError{std::string{bytecode_compiler_error_messages::NOT_A_LOCAL_VARIABLE} + read->reference_name};
+}
+
+uint16_t BytecodeCompiler::allocate_register()
+{
+	if(next_register > std::numeric_limits<uint16_t>::max())
+	{
+		throw BytecodeCompilationError{std::string{bytecode_compiler_error_messages::TOO_MANY_REGISTERS}};
+	}
+
+	chunk.register_count = std::max<std::size_t>(chunk.register_count, next_register + 1);
+	return static_cast<uint16_t>(next_register++);
+}
+
+void BytecodeCompiler::emit(OpCode op_code, uint16_t destination, uint16_t first, uint16_t count, uint32_t operand)
+{
+	chunk.instructions.push_back(Instruction{op_code, destination, first, count, operand});
+}
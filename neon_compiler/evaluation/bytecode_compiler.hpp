@@ -0,0 +1,78 @@
+#ifndef BYTECODE_COMPILER_HPP
+#define BYTECODE_COMPILER_HPP
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include "bytecode.hpp"
+#include "../ast/nodes/nodes.hpp"
+#include "../ast/nodes/statement_nodes.hpp"
+#include "../resolution/resolution.hpp"
+
+namespace neon_compiler::evaluation
+{
+
+namespace bytecode_compiler_error_messages
+{
+	constexpr std::string_view SYNTAX_ERROR =
+		"Compile function has syntax errors";
+	constexpr std::string_view UNSUPPORTED_STATEMENT =
+		"Statement not supported in compile functions";
+	constexpr std::string_view UNSUPPORTED_EXPRESSION =
+		"Expression not supported in compile functions";
+	constexpr std::string_view NOT_A_LOCAL_VARIABLE =
+		"Not a local variable of the compile function: ";
+	constexpr std::string_view UNKNOWN_FUNCTION =
+		"Unknown function: ";
+	constexpr std::string_view WRONG_ARGUMENT_COUNT =
+		"Wrong number of arguments: ";
+	constexpr std::string_view TOO_MANY_REGISTERS =
+		"Compile function needs too many registers";
+}
+
+/** Bytecode of a compile function, or why it could not be compiled */
+struct CompiledFunction
+{
+	/** Empty if the body could not be compiled */
+	std::optional<Chunk> chunk;
+	std::string error;
+};
+
+/** Compiles compile function bodies to bytecode for the register machine of `CompileFunctionInterpreter`.
+ * Local variables get a register each, and each expression is computed into a register given by its parent,
+ * so values are not copied through a stack. Arguments of a call are computed into consecutive registers. */
+class BytecodeCompiler
+{
+public:
+	explicit BytecodeCompiler(const neon_compiler::resolution::Resolution& init_resolution);
+
+	CompiledFunction compile(const neon_compiler::ast::nodes::CodeBlock& body);
+
+private:
+	const neon_compiler::resolution::Resolution& resolution;
+
+	Chunk chunk;
+	std::unordered_map<const neon_compiler::ast::nodes::VariableDeclaration*, uint16_t> local_registers;
+	/** Registers from here on are free */
+	uint32_t next_register{0};
+
+	void compile_statement(const neon_compiler::ast::nodes::Statement* statement);
+	void compile_expression(const neon_compiler::ast::nodes::Expression* expression, uint16_t destination);
+	void compile_call
+	(
+		OpCode op_code,
+		uint32_t operand,
+		const std::vector<std::unique_ptr<neon_compiler::ast::nodes::Expression>>& arguments,
+		uint16_t destination
+	);
+	/** Register of the local variable `expression` reads */
+	uint16_t get_local_register(const neon_compiler::ast::nodes::Expression* expression) const;
+	uint16_t allocate_register();
+	void emit(OpCode op_code, uint16_t destination, uint16_t first, uint16_t count, uint32_t operand);
+};
+
+}
+
+#endif // BYTECODE_COMPILER_HPP
@@ -0,0 +1,423 @@
+#include "compile_function_interpreter.hpp"
+
+#include <charconv>
+#include <functional>
+#include "../trace/trace.hpp"
+
+using namespace neon_compiler;
+using namespace neon_compiler::ast;
+using namespace neon_compiler::ast::nodes;
+using namespace neon_compiler::evaluation;
+using namespace neon_compiler::resolution;
+
+namespace
+{
+	std::size_t combine(std::size_t seed, std::size_t value)
+	{
+		return seed ^ (value + 0x9e3779b97f4a7c15 + (seed << 6) + (seed >> 2));
+	}
+
+	Value to_value(const ConstantValue& constant)
+	{
+		return std::visit([] (const auto& value) { return Value{value}; }, constant);
+	}
+
+	/** Empty for AST handles, which only compile functions can have */
+	std::optional<ConstantValue> to_constant(const Value& value)
+	{
+		if(const NumberValue* number = std::get_if<NumberValue>(&value)) { return *number; }
+		if(const std::string* string = std::get_if<std::string>(&value)) { return *string; }
+		if(const bool* boolean = std::get_if<bool>(&value)) { return *boolean; }
+		return std::nullopt;
+	}
+
+	std::string_view get_kind(const ASTNode& node)
+	{
+		if(dynamic_cast<const Entrypoint*>(&node))      { return "entrypoint"; }
+		if(dynamic_cast<const Type*>(&node))            { return "type"; }
+		if(dynamic_cast<const PureFunctionSet*>(&node)) { return "pure_function_set"; }
+		if(dynamic_cast<const OperatorModule*>(&node))  { return "operator_module"; }
+		if(dynamic_cast<const CompileFunction*>(&node)) { return "compile_function"; }
+		return "node";
+	}
+
+	std::string_view get_intrinsic_name(Intrinsic intrinsic)
+	{
+		return INTRINSICS[static_cast<std::size_t>(intrinsic)].name;
+	}
+}
+
+CompileFunctionInterpreter::CompileFunctionInterpreter(const Root& init_root, const Resolution& init_resolution) :
+	root{init_root},
+	resolution{init_resolution},
+	bytecode_compiler{init_resolution},
+	pure_evaluator{init_resolution}
+{}
+
+const Expansion& CompileFunctionInterpreter::expand(const AutoCall& auto_call)
+{
+	const std::unordered_map<const AutoCall*, const Expansion*>::const_iterator expanded_it = call_expansions.find(&auto_call);
+	if(expanded_it != call_expansions.end()) { return *expanded_it->second; }
+
+	if(auto_call.declaration == UNRESOLVED_DECLARATION
+		|| resolution.get_declaration(auto_call.declaration).kind != DeclarationKind::COMPILE_FUNCTION)
+	{
+		const Expansion& failed = failed_expansions.emplace_back
+		(
+			Expansion{std::nullopt, std::string{compile_function_interpreter_error_messages::NOT_A_COMPILE_FUNCTION} + auto_call.function_name}
+		);
+		call_expansions.emplace(&auto_call, &failed);
+		return failed;
+	}
+
+	ExpansionKey key{auto_call.declaration, {}};
+	key.arguments.reserve(auto_call.arguments.size());
+	for(const std::vector<Token>& argument : auto_call.arguments)
+	{
+		std::vector<TokenKey>& tokens = key.arguments.emplace_back();
+		tokens.reserve(argument.size());
+
+		for(const Token& token : argument)
+		{
+			const std::optional<std::string_view> lexeme = token.get_lexeme();
+			tokens.push_back(TokenKey{token.get_type(), lexeme.has_value() ? std::optional<std::string>{lexeme.value()} : std::nullopt});
+		}
+	}
+
+	const std::unordered_map<ExpansionKey, Expansion, ExpansionKeyHash>::const_iterator it = expansions.find(key);
+	if(it != expansions.end())
+	{
+		++expansion_cache_hit_count;
+		call_expansions.emplace(&auto_call, &it->second);
+		return it->second;
+	}
+
+	++expansion_cache_miss_count;
+
+	std::unordered_map<DeclarationId, CompiledFunction>::iterator compiled_it = compiled_functions.find(auto_call.declaration);
+
+	if(compiled_it == compiled_functions.end())
+	{
+		const CompileFunction& compile_function =
+			*static_cast<const CompileFunction*>(resolution.get_declaration(auto_call.declaration).nodes.front());
+		compiled_it = compiled_functions.emplace(auto_call.declaration, bytecode_compiler.compile(compile_function.body)).first;
+	}
+
+	const CompiledFunction& compiled_function = compiled_it->second;
+	Expansion expansion = compiled_function.chunk.has_value()
+		? run(compiled_function.chunk.value(), auto_call)
+		: Expansion{std::nullopt, compiled_function.error};
+
+	const Expansion& stored = expansions.emplace(std::move(key), std::move(expansion)).first->second;
+	call_expansions.emplace(&auto_call, &stored);
+	return stored;
+}
+
+std::size_t CompileFunctionInterpreter::expand_all()
+{
+	const trace::Span span{"CompileFunctionInterpreter::expand_all"};
+
+	std::size_t failed_count{0};
+
+	for(const std::pair<const std::string, std::unique_ptr<PackageMember>>& pair : root.package_members)
+	{
+		const PackageMember* package_member = pair.second.get();
+
+		if(const Entrypoint* entrypoint = dynamic_cast<const Entrypoint*>(package_member))
+		{
+			failed_count += expand_code_block(entrypoint->body);
+		}
+		else if(const Type* type = dynamic_cast<const Type*>(package_member))
+		{
+			for(const std::pair<const std::string, std::vector<Method>>& overloads : type->methods)
+			{
+				for(const Method& method : overloads.second)
+				{
+					if(method.implementation.has_value()) { failed_count += expand_code_block(method.implementation.value()); }
+				}
+			}
+			for(const std::pair<const std::string, std::vector<PureFunction>>& overloads : type->pure_functions)
+			{
+				for(const PureFunction& pure_function : overloads.second)
+				{
+					if(pure_function.implementation.has_value()) { failed_count += expand_code_block(pure_function.implementation.value()); }
+				}
+			}
+		}
+		else if(const PureFunctionSet* pure_function_set = dynamic_cast<const PureFunctionSet*>(package_member))
+		{
+			for(const std::pair<const std::string, std::vector<PureFunction>>& overloads : pure_function_set->methods)
+			{
+				for(const PureFunction& pure_function : overloads.second)
+				{
+					if(pure_function.implementation.has_value()) { failed_count += expand_code_block(pure_function.implementation.value()); }
+				}
+			}
+		}
+		else if(const OperatorModule* operator_module = dynamic_cast<const OperatorModule*>(package_member))
+		{
+			for(const OperatorFunction& operator_function : operator_module->functions)
+			{
+				failed_count += expand_code_block(operator_function.body);
+			}
+		}
+		else if(const CompileFunction* compile_function = dynamic_cast<const CompileFunction*>(package_member))
+		{
+			failed_count += expand_code_block(compile_function->body);
+		}
+	}
+
+	return failed_count;
+}
+
+const Expansion* CompileFunctionInterpreter::find_expansion(const AutoCall& auto_call) const
+{
+	const std::unordered_map<const AutoCall*, const Expansion*>::const_iterator it = call_expansions.find(&auto_call);
+	return it == call_expansions.end() ? nullptr : it->second;
+}
+
+const ASTNode& CompileFunctionInterpreter::get_node(AstHandle handle) const
+{
+	return *handle_nodes.at(handle.index);
+}
+
+std::size_t CompileFunctionInterpreter::get_compiled_count() const
+{
+	return compiled_functions.size();
+}
+
+uint64_t CompileFunctionInterpreter::get_expansion_cache_hit_count() const
+{
+	return expansion_cache_hit_count;
+}
+
+uint64_t CompileFunctionInterpreter::get_expansion_cache_miss_count() const
+{
+	return expansion_cache_miss_count;
+}
+
+std::size_t CompileFunctionInterpreter::ExpansionKeyHash::operator()(const ExpansionKey& key) const
+{
+	std::size_t seed = std::hash<DeclarationId>{}(key.function);
+
+	for(const std::vector<TokenKey>& argument : key.arguments)
+	{
+		seed = combine(seed, argument.size());
+
+		for(const TokenKey& token : argument)
+		{
+			seed = combine(seed, static_cast<std::size_t>(token.type));
+			if(token.lexeme.has_value()) { seed = combine(seed, std::hash<std::string>{}(token.lexeme.value())); }
+		}
+	}
+
+	return seed;
+}
+
+Expansion CompileFunctionInterpreter::run(const Chunk& chunk, const AutoCall& auto_call)
+{
+	std::vector<std::optional<Value>> registers(chunk.register_count);
+	std::vector<Value> arguments;
+
+	for(const Instruction& instruction : chunk.instructions)
+	{
+		switch(instruction.op_code)
+		{
+			case OpCode::LOAD_CONSTANT:
+			{
+				registers[instruction.destination] = to_value(chunk.constants[instruction.operand]);
+				break;
+			}
+			case OpCode::MOVE:
+			{
+				if(!registers[instruction.first].has_value())
+				{
+					return Expansion{std::nullopt, std::string{compile_function_interpreter_error_messages::UNASSIGNED_REGISTER}};
+				}
+
+				registers[instruction.destination] = registers[instruction.first];
+				break;
+			}
+			case OpCode::CALL_PURE:
+			case OpCode::CALL_INTRINSIC:
+			{
+				arguments.clear();
+				for(uint16_t i = 0; i < instruction.count; ++i)
+				{
+					const std::optional<Value>& argument = registers[instruction.first + i];
+					if(!argument.has_value())
+					{
+						return Expansion{std::nullopt, std::string{compile_function_interpreter_error_messages::UNASSIGNED_REGISTER}};
+					}
+
+					arguments.push_back(argument.value());
+				}
+
+				if(instruction.op_code == OpCode::CALL_INTRINSIC)
+				{
+					Value result{false};
+					const std::string error = call_intrinsic(static_cast<Intrinsic>(instruction.operand), arguments, auto_call, result);
+					if(!error.empty()) { return Expansion{std::nullopt, error}; }
+
+					registers[instruction.destination] = std::move(result);
+					break;
+				}
+
+				const std::string& function_name = resolution.get_declaration(instruction.operand).name;
+				std::vector<ConstantValue> constants;
+				constants.reserve(arguments.size());
+
+				for(const Value& argument : arguments)
+				{
+					std::optional<ConstantValue> constant = to_constant(argument);
+					if(!constant.has_value())
+					{
+						return Expansion{std::nullopt, std::string{compile_function_interpreter_error_messages::WRONG_ARGUMENT_TYPE} + function_name};
+					}
+
+					constants.push_back(std::move(constant.value()));
+				}
+
+				const std::optional<ConstantValue> result = pure_evaluator.call_function(instruction.operand, std::move(constants));
+				if(!result.has_value())
+				{
+					return Expansion
+					{
+						std::nullopt,
+						std::string{compile_function_interpreter_error_messages::PURE_FUNCTION_NOT_EVALUATED} + function_name
+					};
+				}
+
+				registers[instruction.destination] = to_value(result.value());
+				break;
+			}
+			case OpCode::RETURN:
+			{
+				if(!registers[instruction.first].has_value())
+				{
+					return Expansion{std::nullopt, std::string{compile_function_interpreter_error_messages::UNASSIGNED_REGISTER}};
+				}
+
+				return Expansion{registers[instruction.first], std::string{}};
+			}
+			case OpCode::RETURN_VOID:
+			{
+				return Expansion{};
+			}
+		}
+	}
+
+	return Expansion{};
+}
+
+std::string CompileFunctionInterpreter::call_intrinsic
+(
+	Intrinsic intrinsic,
+	const std::vector<Value>& arguments,
+	const AutoCall& auto_call,
+	Value& result
+)
+{
+	const std::string wrong_argument_type = std::string{compile_function_interpreter_error_messages::WRONG_ARGUMENT_TYPE}
+		+ std::string{get_intrinsic_name(intrinsic)};
+
+	switch(intrinsic)
+	{
+		case Intrinsic::ARGUMENT_COUNT:
+		{
+			result = NumberValue{std::to_string(auto_call.arguments.size())};
+			return std::string{};
+		}
+		case Intrinsic::ARGUMENT:
+		{
+			const NumberValue* index_value = std::get_if<NumberValue>(&arguments[0]);
+			std::size_t index{0};
+
+			if(!index_value) { return wrong_argument_type; }
+
+			const std::string& literal = index_value->literal;
+			const std::from_chars_result parsed = std::from_chars(literal.data(), literal.data() + literal.size(), index);
+
+			if(parsed.ec != std::errc{} || parsed.ptr != literal.data() + literal.size()) { return wrong_argument_type; }
+			if(index >= auto_call.arguments.size())
+			{
+				return std::string{compile_function_interpreter_error_messages::ARGUMENT_OUT_OF_RANGE} + literal;
+			}
+
+			const std::vector<Token>& tokens = auto_call.arguments[index];
+			if(tokens.size() != 1 || !tokens.front().get_lexeme().has_value())
+			{
+				return std::string{compile_function_interpreter_error_messages::ARGUMENT_NOT_A_NAME_OR_LITERAL} + literal;
+			}
+
+			result = std::string{tokens.front().get_lexeme().value()};
+			return std::string{};
+		}
+		case Intrinsic::PACKAGE_MEMBER:
+		{
+			const std::string* identifier = std::get_if<std::string>(&arguments[0]);
+			if(!identifier) { return wrong_argument_type; }
+
+			const std::unordered_map<std::string, std::unique_ptr<PackageMember>>::const_iterator it = root.package_members.find(*identifier);
+			if(it == root.package_members.end() || !it->second)
+			{
+				return std::string{compile_function_interpreter_error_messages::UNKNOWN_PACKAGE_MEMBER} + *identifier;
+			}
+
+			result = get_handle(*it->second);
+			return std::string{};
+		}
+		case Intrinsic::KIND:
+		{
+			const AstHandle* handle = std::get_if<AstHandle>(&arguments[0]);
+			if(!handle) { return wrong_argument_type; }
+
+			result = std::string{get_kind(get_node(*handle))};
+			return std::string{};
+		}
+		case Intrinsic::CONCAT:
+		{
+			std::string text;
+
+			for(const Value& argument : arguments)
+			{
+				if(const NumberValue* number = std::get_if<NumberValue>(&argument)) { text += number->literal; }
+				else if(const std::string* string = std::get_if<std::string>(&argument)) { text += *string; }
+				else if(const bool* boolean = std::get_if<bool>(&argument)) { text += *boolean ? "true" : "false"; }
+				else { return wrong_argument_type; }
+			}
+
+			result = std::move(text);
+			return std::string{};
+		}
+	}
+
+	return wrong_argument_type;
+}
+
+AstHandle CompileFunctionInterpreter::get_handle(const ASTNode& node)
+{
+	const std::unordered_map<const ASTNode*, AstHandle>::const_iterator it = node_handles.find(&node);
+	if(it != node_handles.end()) { return it->second; }
+
+	const AstHandle handle{static_cast<uint32_t>(handle_nodes.size())};
+	handle_nodes.push_back(&node);
+	node_handles.emplace(&node, handle);
+
+	return handle;
+}
+
+std::size_t CompileFunctionInterpreter::expand_code_block(const CodeBlock& code_block)
+{
+	std::size_t failed_count{0};
+
+	for(const std::unique_ptr<Statement>& statement : code_block.statements)
+	{
+		if(const AutoCall* auto_call = dynamic_cast<const AutoCall*>(statement.get()))
+		{
+			if(!expand(*auto_call).error.empty()) { ++failed_count; }
+		}
+	}
+
+	return failed_count;
+}
@@ -0,0 +1,137 @@
+#ifndef COMPILE_FUNCTION_INTERPRETER_HPP
+#define COMPILE_FUNCTION_INTERPRETER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "bytecode.hpp"
+#include "bytecode_compiler.hpp"
+#include "pure_evaluator.hpp"
+#include "../token.hpp"
+#include "../ast/nodes/nodes.hpp"
+#include "../ast/nodes/statement_nodes.hpp"
+#include "../resolution/resolution.hpp"
+
+namespace neon_compiler::evaluation
+{
+
+namespace compile_function_interpreter_error_messages
+{
+	constexpr std::string_view NOT_A_COMPILE_FUNCTION =
+		"Not a compile function: ";
+	constexpr std::string_view UNASSIGNED_REGISTER =
+		"Local variable read before it was assigned";
+	constexpr std::string_view WRONG_ARGUMENT_TYPE =
+		"Argument of the wrong type for ";
+	constexpr std::string_view ARGUMENT_OUT_OF_RANGE =
+		"No argument with index ";
+	constexpr std::string_view ARGUMENT_NOT_A_NAME_OR_LITERAL =
+		"Argument is not a single name or literal: ";
+	constexpr std::string_view UNKNOWN_PACKAGE_MEMBER =
+		"Unknown package member: ";
+	constexpr std::string_view PURE_FUNCTION_NOT_EVALUATED =
+		"Pure function call could not be evaluated at compile time: ";
+}
+
+/** Result of running the compile function of an `auto:` call */
+struct Expansion
+{
+	/** Returned value. Empty if nothing was returned or running failed. */
+	std::optional<Value> value;
+	/** Empty unless compiling or running failed */
+	std::string error;
+};
+
+/** Runs compile functions for their `auto:` calls.
+ * Each compile function is compiled to bytecode once, on its first call, and run on a register machine.
+ * Compile functions see the AST through `AstHandle`s, so nodes are not copied into their registers.
+ *
+ * The expansion of a call is cached by compile function and argument tokens (types and lexemes, not positions),
+ * so calls with the same arguments in many places run once.
+ * Refers to the AST and its resolution, so it is only valid as long as they are. */
+class CompileFunctionInterpreter
+{
+public:
+	CompileFunctionInterpreter
+	(
+		const neon_compiler::ast::nodes::Root& init_root,
+		const neon_compiler::resolution::Resolution& init_resolution
+	);
+
+	/** Runs the compile function called by `auto_call`, unless one of its calls with the same argument tokens ran before */
+	const Expansion& expand(const neon_compiler::ast::nodes::AutoCall& auto_call);
+	/** Expands all `auto:` calls in the bodies of the package members. Returns the number that failed. */
+	std::size_t expand_all();
+	/** Expansion of a call that was expanded; null otherwise */
+	const Expansion* find_expansion(const neon_compiler::ast::nodes::AutoCall& auto_call) const;
+
+	/** Node a handle given to a compile function refers to */
+	const neon_compiler::ast::ASTNode& get_node(AstHandle handle) const;
+
+	/** Number of compile functions compiled to bytecode */
+	std::size_t get_compiled_count() const;
+	/** Calls whose expansion was taken from the cache */
+	uint64_t get_expansion_cache_hit_count() const;
+	/** Calls that were run */
+	uint64_t get_expansion_cache_miss_count() const;
+
+private:
+	struct TokenKey
+	{
+		neon_compiler::TokenType type;
+		std::optional<std::string> lexeme;
+
+		bool operator==(const TokenKey&) const = default;
+	};
+
+	struct ExpansionKey
+	{
+		neon_compiler::ast::nodes::DeclarationId function;
+		std::vector<std::vector<TokenKey>> arguments;
+
+		bool operator==(const ExpansionKey&) const = default;
+	};
+
+	struct ExpansionKeyHash
+	{
+		std::size_t operator()(const ExpansionKey& key) const;
+	};
+
+	const neon_compiler::ast::nodes::Root& root;
+	const neon_compiler::resolution::Resolution& resolution;
+	BytecodeCompiler bytecode_compiler;
+	PureEvaluator pure_evaluator;
+
+	std::unordered_map<neon_compiler::ast::nodes::DeclarationId, CompiledFunction> compiled_functions;
+	std::unordered_map<ExpansionKey, Expansion, ExpansionKeyHash> expansions;
+	/** Expansions of calls of names that are not compile functions, which are not cached */
+	std::deque<Expansion> failed_expansions;
+	std::unordered_map<const neon_compiler::ast::nodes::AutoCall*, const Expansion*> call_expansions;
+	uint64_t expansion_cache_hit_count{0};
+	uint64_t expansion_cache_miss_count{0};
+
+	std::vector<const neon_compiler::ast::ASTNode*> handle_nodes;
+	std::unordered_map<const neon_compiler::ast::ASTNode*, AstHandle> node_handles;
+
+	Expansion run(const Chunk& chunk, const neon_compiler::ast::nodes::AutoCall& auto_call);
+	/** Sets `result` and returns an empty string, or returns an error message */
+	std::string call_intrinsic
+	(
+		Intrinsic intrinsic,
+		const std::vector<Value>& arguments,
+		const neon_compiler::ast::nodes::AutoCall& auto_call,
+		Value& result
+	);
+	AstHandle get_handle(const neon_compiler::ast::ASTNode& node);
+	/** Returns the number of calls that failed */
+	std::size_t expand_code_block(const neon_compiler::ast::nodes::CodeBlock& code_block);
+};
+
+}
+
+#endif // COMPILE_FUNCTION_INTERPRETER_HPP
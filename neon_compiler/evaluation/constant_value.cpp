@@ -0,0 +1,114 @@
+#include "constant_value.hpp"
+
+#include <algorithm>
+#include <optional>
+#include <vector>
+
+using namespace neon_compiler::evaluation;
+
+namespace
+{
+	std::optional<unsigned> get_digit_value(char c, unsigned base)
+	{
+		unsigned value{base};
+
+		if(c >= '0' && c <= '9') { value = static_cast<unsigned>(c - '0'); }
+		else if(c >= 'a' && c <= 'f') { value = static_cast<unsigned>(c - 'a') + 10; }
+		else if(c >= 'A' && c <= 'F') { value = static_cast<unsigned>(c - 'A') + 10; }
+
+		return value < base ? std::optional<unsigned>{value} : std::nullopt;
+	}
+
+	/** Converts the digits of a hexadecimal or binary literal to decimal.
+	 * Works on decimal digits stored least significant first, so literals of any length convert. */
+	std::optional<std::string> to_decimal(std::string_view digits, unsigned base)
+	{
+		if(digits.empty()) { return std::nullopt; }
+
+		std::vector<unsigned> decimal_digits{0};
+
+		for(char c : digits)
+		{
+			const std::optional<unsigned> digit_value = get_digit_value(c, base);
+			if(!digit_value.has_value()) { return std::nullopt; }
+
+			unsigned carry = digit_value.value();
+			for(unsigned& decimal_digit : decimal_digits)
+			{
+				const unsigned product = decimal_digit * base + carry;
+				decimal_digit = product % 10;
+				carry = product / 10;
+			}
+			for(; carry > 0; carry /= 10)
+			{
+				decimal_digits.push_back(carry % 10);
+			}
+		}
+
+		while(decimal_digits.size() > 1 && decimal_digits.back() == 0)
+		{
+			decimal_digits.pop_back();
+		}
+
+		std::string decimal;
+		decimal.reserve(decimal_digits.size());
+		for(std::vector<unsigned>::const_reverse_iterator it = decimal_digits.rbegin(); it != decimal_digits.rend(); ++it)
+		{
+			decimal += static_cast<char>('0' + *it);
+		}
+
+		return decimal;
+	}
+
+	std::optional<std::string> trim_decimal(std::string_view literal)
+	{
+		const std::size_t point = literal.find('.');
+		std::string_view integer_part = literal.substr(0, point);
+		std::string_view fraction_part = point == std::string_view::npos ? std::string_view{} : literal.substr(point + 1);
+
+		const auto is_decimal_digit = [](char c) { return c >= '0' && c <= '9'; };
+		if(integer_part.empty()
+			|| !std::all_of(integer_part.begin(), integer_part.end(), is_decimal_digit)
+			|| !std::all_of(fraction_part.begin(), fraction_part.end(), is_decimal_digit))
+		{
+			return std::nullopt;
+		}
+
+		while(integer_part.size() > 1 && integer_part.front() == '0') { integer_part.remove_prefix(1); }
+		while(!fraction_part.empty() && fraction_part.back() == '0') { fraction_part.remove_suffix(1); }
+
+		std::string decimal{integer_part};
+		if(!fraction_part.empty())
+		{
+			decimal += '.';
+			decimal += fraction_part;
+		}
+
+		return decimal;
+	}
+}
+
+std::string neon_compiler::evaluation::normalise_number_literal(std::string_view literal)
+{
+	std::optional<std::string> normalised{};
+
+	if(literal.starts_with("0x"))
+	{
+		normalised = to_decimal(literal.substr(2), 16);
+	}
+	else if(literal.starts_with("0b"))
+	{
+		normalised = to_decimal(literal.substr(2), 2);
+	}
+	else
+	{
+		normalised = trim_decimal(literal);
+	}
+
+	return normalised.value_or(std::string{literal});
+}
+
+NumberValue neon_compiler::evaluation::make_number_value(std::string_view literal)
+{
+	return NumberValue{normalise_number_literal(literal)};
+}
@@ -0,0 +1,33 @@
+#ifndef CONSTANT_VALUE_HPP
+#define CONSTANT_VALUE_HPP
+
+#include <string>
+#include <string_view>
+#include <variant>
+
+namespace neon_compiler::evaluation
+{
+
+/** A number in decimal notation (see `normalise_number_literal`), so that e.g. `0x1F` and `31` are the same value.
+ * Numbers are only passed around at compile time, not computed with. */
+struct NumberValue
+{
+	std::string literal;
+
+	bool operator==(const NumberValue&) const = default;
+};
+
+/** Value known at compile time */
+using ConstantValue = std::variant<NumberValue, std::string, bool>;
+
+/** Writes a number literal as read by the lexer (e.g. `0x1F`, `0b101`, `007.50`) in decimal notation
+ * without redundant zeros (e.g. `31`, `5`, `7.5`). Hexadecimal and binary literals may have any number of digits.
+ * Literals that are not valid numbers are returned unchanged. */
+std::string normalise_number_literal(std::string_view literal);
+
+/** The value of a number literal */
+NumberValue make_number_value(std::string_view literal);
+
+}
+
+#endif // CONSTANT_VALUE_HPP
@@ -0,0 +1,566 @@
+#include "pure_evaluator.hpp"
+
+#include <functional>
+#include <string>
+#include <variant>
+#include "../parser/operator.hpp"
+#include "../trace/trace.hpp"
+
+using namespace neon_compiler;
+using namespace neon_compiler::ast;
+using namespace neon_compiler::ast::nodes;
+using namespace neon_compiler::evaluation;
+using namespace neon_compiler::resolution;
+
+namespace
+{
+	std::size_t combine(std::size_t seed, std::size_t value)
+	{
+		return seed ^ (value + 0x9e3779b97f4a7c15 + (seed << 6) + (seed >> 2));
+	}
+
+	std::size_t hash_value(const ConstantValue& value)
+	{
+		std::size_t content_hash{0};
+
+		if(const NumberValue* number = std::get_if<NumberValue>(&value))
+		{
+			content_hash = std::hash<std::string>{}(number->literal);
+		}
+		else if(const std::string* string = std::get_if<std::string>(&value))
+		{
+			content_hash = std::hash<std::string>{}(*string);
+		}
+		else
+		{
+			content_hash = std::hash<bool>{}(std::get<bool>(value));
+		}
+
+		return combine(value.index(), content_hash);
+	}
+
+	/** The variable declaration a read or assignment target refers to, if it is a parameter or local variable */
+	const VariableDeclaration* find_variable(const Resolution& resolution, const Expression* expression)
+	{
+		const SimpleRead* read = dynamic_cast<const SimpleRead*>(expression);
+
+		if(!read || read->declaration == UNRESOLVED_DECLARATION) { return nullptr; }
+
+		const Declaration& declaration = resolution.get_declaration(read->declaration);
+
+		if(declaration.kind != DeclarationKind::PARAMETER && declaration.kind != DeclarationKind::LOCAL) { return nullptr; }
+
+		return static_cast<const VariableDeclaration*>(declaration.nodes.front());
+	}
+}
+
+PureEvaluator::PureEvaluator(const Resolution& init_resolution)
+	: resolution{init_resolution} {}
+
+std::optional<ConstantValue> PureEvaluator::evaluate(const Expression& expression)
+{
+	call_depth = 0;
+	steps_left = MAX_EVALUATION_STEPS;
+	out_of_budget = false;
+
+	return evaluate_expression(expression, nullptr);
+}
+
+std::optional<ConstantValue> PureEvaluator::call_function(DeclarationId function, std::vector<ConstantValue> arguments)
+{
+	call_depth = 0;
+	steps_left = MAX_EVALUATION_STEPS;
+	out_of_budget = false;
+
+	return call(function, std::move(arguments));
+}
+
+FoldedCalls PureEvaluator::fold_calls(const Root& root)
+{
+	const trace::Span span{"PureEvaluator::fold_calls"};
+
+	FoldedCalls folded_calls;
+
+	for(const std::pair<const std::string, std::unique_ptr<PackageMember>>& pair : root.package_members)
+	{
+		const PackageMember* package_member = pair.second.get();
+
+		if(const Entrypoint* entrypoint = dynamic_cast<const Entrypoint*>(package_member))
+		{
+			fold_code_block(entrypoint->body, folded_calls);
+		}
+		else if(const Type* type = dynamic_cast<const Type*>(package_member))
+		{
+			for(const std::pair<const std::string, std::vector<Method>>& overloads : type->methods)
+			{
+				for(const Method& method : overloads.second)
+				{
+					if(method.implementation.has_value()) { fold_code_block(method.implementation.value(), folded_calls); }
+				}
+			}
+			for(const std::pair<const std::string, std::vector<PureFunction>>& overloads : type->pure_functions)
+			{
+				for(const PureFunction& pure_function : overloads.second)
+				{
+					if(pure_function.implementation.has_value()) { fold_code_block(pure_function.implementation.value(), folded_calls); }
+				}
+			}
+		}
+		else if(const PureFunctionSet* pure_function_set = dynamic_cast<const PureFunctionSet*>(package_member))
+		{
+			for(const std::pair<const std::string, std::vector<PureFunction>>& overloads : pure_function_set->methods)
+			{
+				for(const PureFunction& pure_function : overloads.second)
+				{
+					if(pure_function.implementation.has_value()) { fold_code_block(pure_function.implementation.value(), folded_calls); }
+				}
+			}
+		}
+		else if(const OperatorModule* operator_module = dynamic_cast<const OperatorModule*>(package_member))
+		{
+			for(const OperatorFunction& operator_function : operator_module->functions)
+			{
+				fold_code_block(operator_function.body, folded_calls);
+			}
+		}
+		else if(const CompileFunction* compile_function = dynamic_cast<const CompileFunction*>(package_member))
+		{
+			fold_code_block(compile_function->body, folded_calls);
+		}
+	}
+
+	return folded_calls;
+}
+
+uint64_t PureEvaluator::get_memo_hit_count() const
+{
+	return memo_hit_count;
+}
+
+uint64_t PureEvaluator::get_memo_miss_count() const
+{
+	return memo_miss_count;
+}
+
+std::size_t PureEvaluator::CallKeyHash::operator()(const CallKey& key) const
+{
+	std::size_t seed = std::hash<const ASTNode*>{}(key.function);
+
+	for(const ConstantValue& argument : key.arguments)
+	{
+		seed = combine(seed, hash_value(argument));
+	}
+
+	return seed;
+}
+
+std::optional<ConstantValue> PureEvaluator::evaluate_expression(const Expression& expression, Frame* frame)
+{
+	if(!take_step()) { return std::nullopt; }
+
+	if(const LiteralNumberExpression* number = dynamic_cast<const LiteralNumberExpression*>(&expression))
+	{
+		return make_number_value(number->value);
+	}
+	if(const LiteralStringExpression* string = dynamic_cast<const LiteralStringExpression*>(&expression))
+	{
+		return string->value;
+	}
+	if(const LiteralBooleanExpression* boolean = dynamic_cast<const LiteralBooleanExpression*>(&expression))
+	{
+		return boolean->value;
+	}
+	if(const FunctionCall* function_call = dynamic_cast<const FunctionCall*>(&expression))
+	{
+		const DeclarationId function = find_called_function(resolution, expression);
+		if(function == UNRESOLVED_DECLARATION) { return std::nullopt; }
+
+		std::optional<std::vector<ConstantValue>> values = evaluate_arguments(function_call->arguments, frame);
+		if(!values.has_value()) { return std::nullopt; }
+
+		return call(function, std::move(values.value()));
+	}
+	if(const ObjectFunctionCall* object_call = dynamic_cast<const ObjectFunctionCall*>(&expression))
+	{
+		const DeclarationId function = find_called_function(resolution, expression);
+		if(function == UNRESOLVED_DECLARATION) { return std::nullopt; }
+
+		std::optional<std::vector<ConstantValue>> values = evaluate_arguments(object_call->arguments, frame);
+		if(!values.has_value()) { return std::nullopt; }
+
+		return call(function, std::move(values.value()));
+	}
+	if(const OperatorCallExpression* operator_call = dynamic_cast<const OperatorCallExpression*>(&expression))
+	{
+		const OperatorFunction* operator_function = find_operator_function(*operator_call);
+		if(!operator_function) { return std::nullopt; }
+
+		std::optional<std::vector<ConstantValue>> values = evaluate_arguments(operator_call->arguments, frame);
+		if(!values.has_value()) { return std::nullopt; }
+
+		return call_operator(*operator_function, std::move(values.value()));
+	}
+	if(const Assignment* assignment = dynamic_cast<const Assignment*>(&expression))
+	{
+		return assign(*assignment, frame);
+	}
+
+	// Parameters and local variables only have values within a call
+	const VariableDeclaration* variable = find_variable(resolution, &expression);
+	if(!frame || !variable) { return std::nullopt; }
+
+	const Frame::const_iterator it = frame->find(variable);
+	return it == frame->end() ? std::nullopt : std::optional<ConstantValue>{it->second};
+}
+
+std::optional<std::vector<ConstantValue>> PureEvaluator::evaluate_arguments
+(
+	const std::vector<std::unique_ptr<Expression>>& arguments,
+	Frame* frame
+)
+{
+	std::vector<ConstantValue> values;
+	values.reserve(arguments.size());
+
+	for(const std::unique_ptr<Expression>& argument : arguments)
+	{
+		std::optional<ConstantValue> value = argument ? evaluate_expression(*argument, frame) : std::nullopt;
+		if(!value.has_value()) { return std::nullopt; }
+
+		values.push_back(std::move(value.value()));
+	}
+
+	return values;
+}
+
+std::optional<ConstantValue> PureEvaluator::call(DeclarationId function, std::vector<ConstantValue> arguments)
+{
+	const PureFunction* overload{nullptr};
+	for(const ASTNode* node : resolution.get_declaration(function).nodes)
+	{
+		const PureFunction* pure_function = static_cast<const PureFunction*>(node);
+
+		if(pure_function->parameters.size() != arguments.size()) { continue; }
+
+		if(overload) { return std::nullopt; }
+		overload = pure_function;
+	}
+
+	if(!overload || !overload->implementation.has_value()) { return std::nullopt; }
+
+	std::vector<const VariableDeclaration*> parameters;
+	parameters.reserve(overload->parameters.size());
+	for(const VariableDeclaration& parameter : overload->parameters)
+	{
+		parameters.push_back(&parameter);
+	}
+
+	return run(*overload, overload->implementation.value(), parameters, std::move(arguments));
+}
+
+std::optional<ConstantValue> PureEvaluator::call_operator(const OperatorFunction& operator_function, std::vector<ConstantValue> arguments)
+{
+	std::vector<const VariableDeclaration*> parameters;
+	for(const OperatorFunctionPatternElement& element : operator_function.pattern)
+	{
+		if(const OperatorFunctionParameter* parameter = std::get_if<OperatorFunctionParameter>(&element))
+		{
+			parameters.push_back(&parameter->parameter);
+		}
+	}
+
+	if(parameters.size() != arguments.size()) { return std::nullopt; }
+
+	return run(operator_function, operator_function.body, parameters, std::move(arguments));
+}
+
+std::optional<ConstantValue> PureEvaluator::run
+(
+	const ASTNode& function,
+	const CodeBlock& body,
+	const std::vector<const VariableDeclaration*>& parameters,
+	std::vector<ConstantValue> arguments
+)
+{
+	CallKey key{&function, std::move(arguments)};
+
+	const std::unordered_map<CallKey, std::optional<ConstantValue>, CallKeyHash>::const_iterator it = memo.find(key);
+	if(it != memo.end())
+	{
+		++memo_hit_count;
+		return it->second;
+	}
+
+	++memo_miss_count;
+
+	if(call_depth >= MAX_CALL_DEPTH)
+	{
+		out_of_budget = true;
+		return std::nullopt;
+	}
+
+	++call_depth;
+	std::optional<ConstantValue> result = run_body(body, parameters, key.arguments);
+	--call_depth;
+
+	if(!out_of_budget) { memo.emplace(std::move(key), result); }
+
+	return result;
+}
+
+std::optional<ConstantValue> PureEvaluator::run_body
+(
+	const CodeBlock& body,
+	const std::vector<const VariableDeclaration*>& parameters,
+	const std::vector<ConstantValue>& arguments
+)
+{
+	Frame frame;
+	for(std::size_t i = 0; i < arguments.size(); ++i)
+	{
+		frame.emplace(parameters[i], arguments[i]);
+	}
+
+	for(const std::unique_ptr<Statement>& statement : body.statements)
+	{
+		if(!statement || !take_step()) { return std::nullopt; }
+
+		if(const LocalDeclaration* local = dynamic_cast<const LocalDeclaration*>(statement.get()))
+		{
+			const VariableDeclaration& variable = local->variable_declaration;
+			if(!variable.initialisation) { continue; }
+
+			std::optional<ConstantValue> value = evaluate_expression(*variable.initialisation, &frame);
+			if(!value.has_value()) { return std::nullopt; }
+
+			frame.insert_or_assign(&variable, std::move(value.value()));
+		}
+		else if(const DiscardExpression* discard = dynamic_cast<const DiscardExpression*>(statement.get()))
+		{
+			if(!discard->expression || !evaluate_expression(*discard->expression, &frame).has_value()) { return std::nullopt; }
+		}
+		else if(const Return* ret = dynamic_cast<const Return*>(statement.get()))
+		{
+			return ret->value ? evaluate_expression(*ret->value, &frame) : std::nullopt;
+		}
+		else
+		{
+			return std::nullopt;
+		}
+	}
+
+	// Pure functions and operator functions return a value, so one that ends without returning cannot be evaluated
+	return std::nullopt;
+}
+
+std::optional<ConstantValue> PureEvaluator::assign(const Assignment& assignment, Frame* frame)
+{
+	const VariableDeclaration* variable = find_variable(resolution, assignment.target.get());
+
+	if(!frame || !variable || !assignment.value) { return std::nullopt; }
+
+	std::optional<ConstantValue> value = evaluate_expression(*assignment.value, frame);
+	if(value.has_value()) { frame->insert_or_assign(variable, value.value()); }
+
+	return value;
+}
+
+DeclarationId PureEvaluator::find_called_function(const Resolution& ast_resolution, const Expression& call)
+{
+	DeclarationId function{UNRESOLVED_DECLARATION};
+
+	if(const FunctionCall* function_call = dynamic_cast<const FunctionCall*>(&call))
+	{
+		function = function_call->declaration;
+	}
+	// e.g. `Tables.square(4)`, calling a pure function of a pure function set or type
+	else if(const ObjectFunctionCall* object_call = dynamic_cast<const ObjectFunctionCall*>(&call))
+	{
+		const SimpleRead* object = dynamic_cast<const SimpleRead*>(object_call->object.get());
+		if(!object || object->declaration == UNRESOLVED_DECLARATION) { return UNRESOLVED_DECLARATION; }
+
+		const Scope* member_scope = ast_resolution.get_member_scope(ast_resolution.get_declaration(object->declaration).name);
+		if(!member_scope) { return UNRESOLVED_DECLARATION; }
+
+		function = member_scope->find(object_call->member_name).value_or(UNRESOLVED_DECLARATION);
+	}
+
+	if(function == UNRESOLVED_DECLARATION || ast_resolution.get_declaration(function).kind != DeclarationKind::PURE_FUNCTION)
+	{
+		return UNRESOLVED_DECLARATION;
+	}
+
+	return function;
+}
+
+bool PureEvaluator::take_step()
+{
+	if(steps_left == 0)
+	{
+		out_of_budget = true;
+		return false;
+	}
+
+	--steps_left;
+	return true;
+}
+
+const OperatorFunction* evaluation::find_operator_function(const OperatorFunctions& operator_functions, const OperatorCallExpression& operator_call)
+{
+	if(!operator_call.op) { return nullptr; }
+
+	const OperatorDeclaration* operator_declaration = operator_call.op->get_declaration();
+
+	// Member access and assignment are built into the language, without operator function
+	if(!operator_declaration || operator_declaration->builtin_operator_kind != BuiltinOperatorKind::NOT_BUILT_IN) { return nullptr; }
+
+	const OperatorFunctions::const_iterator it = operator_functions.find(operator_declaration);
+
+	return it == operator_functions.end() ? nullptr : it->second;
+}
+
+const OperatorFunction* PureEvaluator::find_operator_function(const OperatorCallExpression& operator_call)
+{
+	if(!operator_functions_found)
+	{
+		operator_functions = find_operator_functions(resolution);
+		operator_functions_found = true;
+	}
+
+	return evaluation::find_operator_function(operator_functions, operator_call);
+}
+
+OperatorFunctions PureEvaluator::find_operator_functions(const Resolution& ast_resolution)
+{
+	OperatorFunctions operator_functions;
+
+	std::vector<const OperatorModule*> operator_modules;
+	for(std::size_t id = 0; id < ast_resolution.get_declaration_count(); ++id)
+	{
+		const Declaration& declaration = ast_resolution.get_declaration(static_cast<DeclarationId>(id));
+
+		if(declaration.kind == DeclarationKind::OPERATOR_MODULE && !declaration.nodes.empty())
+		{
+			operator_modules.push_back(static_cast<const OperatorModule*>(declaration.nodes.front()));
+		}
+	}
+
+	for(const OperatorModule* declaring_module : operator_modules)
+	{
+		for(const OperatorDeclaration& operator_declaration : declaring_module->operators)
+		{
+			const OperatorFunction* found{nullptr};
+			bool ambiguous{false};
+
+			for(const OperatorModule* implementing_module : operator_modules)
+			{
+				for(const OperatorFunction& operator_function : implementing_module->functions)
+				{
+					if(!implements(operator_function, operator_declaration)) { continue; }
+
+					ambiguous = ambiguous || found;
+					found = &operator_function;
+				}
+			}
+
+			operator_functions.emplace(&operator_declaration, ambiguous ? nullptr : found);
+		}
+	}
+
+	return operator_functions;
+}
+
+bool PureEvaluator::implements(const OperatorFunction& operator_function, const OperatorDeclaration& operator_declaration)
+{
+	if(operator_function.pattern.size() != operator_declaration.pattern.size()) { return false; }
+
+	for(std::size_t i = 0; i < operator_function.pattern.size(); ++i)
+	{
+		const TokenPattern* function_token = std::get_if<TokenPattern>(&operator_function.pattern[i]);
+		const TokenPattern* declaration_token = std::get_if<TokenPattern>(&operator_declaration.pattern[i]);
+
+		if(!function_token != !declaration_token) { return false; }
+
+		if(function_token
+			&& (function_token->token_type != declaration_token->token_type || function_token->lexeme != declaration_token->lexeme))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void PureEvaluator::fold_code_block(const CodeBlock& code_block, FoldedCalls& folded_calls)
+{
+	for(const std::unique_ptr<Statement>& statement : code_block.statements)
+	{
+		if(const DiscardExpression* discard = dynamic_cast<const DiscardExpression*>(statement.get()))
+		{
+			fold_expression(discard->expression.get(), folded_calls);
+		}
+		else if(const LocalDeclaration* local = dynamic_cast<const LocalDeclaration*>(statement.get()))
+		{
+			fold_expression(local->variable_declaration.initialisation.get(), folded_calls);
+		}
+		else if(const Return* ret = dynamic_cast<const Return*>(statement.get()))
+		{
+			fold_expression(ret->value.get(), folded_calls);
+		}
+	}
+}
+
+void PureEvaluator::fold_expression(const Expression* expression, FoldedCalls& folded_calls)
+{
+	if(!expression) { return; }
+
+	const OperatorCallExpression* operator_call = dynamic_cast<const OperatorCallExpression*>(expression);
+
+	if(find_called_function(resolution, *expression) != UNRESOLVED_DECLARATION
+		|| (operator_call && find_operator_function(*operator_call)))
+	{
+		std::optional<ConstantValue> value = evaluate(*expression);
+
+		if(value.has_value())
+		{
+			folded_calls.emplace(expression, std::move(value.value()));
+			return;
+		}
+	}
+
+	// Not constant as a whole, but parts of it may be
+	if(const FunctionCall* function_call = dynamic_cast<const FunctionCall*>(expression))
+	{
+		fold_expressions(function_call->arguments, folded_calls);
+	}
+	else if(const ObjectFunctionCall* object_call = dynamic_cast<const ObjectFunctionCall*>(expression))
+	{
+		fold_expression(object_call->object.get(), folded_calls);
+		fold_expressions(object_call->arguments, folded_calls);
+	}
+	else if(const ObjectRead* object_read = dynamic_cast<const ObjectRead*>(expression))
+	{
+		fold_expression(object_read->object.get(), folded_calls);
+	}
+	else if(const Assignment* assignment = dynamic_cast<const Assignment*>(expression))
+	{
+		fold_expression(assignment->target.get(), folded_calls);
+		fold_expression(assignment->value.get(), folded_calls);
+	}
+	else if(operator_call)
+	{
+		fold_expressions(operator_call->arguments, folded_calls);
+	}
+	else if(const OptFunctionCall* opt_call = dynamic_cast<const OptFunctionCall*>(expression))
+	{
+		fold_expressions(opt_call->arguments, folded_calls);
+	}
+}
+
+void PureEvaluator::fold_expressions(const std::vector<std::unique_ptr<Expression>>& expressions, FoldedCalls& folded_calls)
+{
+	for(const std::unique_ptr<Expression>& expression : expressions)
+	{
+		fold_expression(expression.get(), folded_calls);
+	}
+}
@@ -0,0 +1,164 @@
+#ifndef PURE_EVALUATOR_HPP
+#define PURE_EVALUATOR_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+#include "constant_value.hpp"
+#include "../ast/nodes/nodes.hpp"
+#include "../ast/nodes/statement_nodes.hpp"
+#include "../resolution/resolution.hpp"
+
+namespace neon_compiler::evaluation
+{
+
+/** Maximum depth of nested calls, beyond which a call is left for run time */
+constexpr std::size_t MAX_CALL_DEPTH = 256;
+/** Maximum number of statements and expressions evaluated for one call, beyond which it is left for run time */
+constexpr uint64_t MAX_EVALUATION_STEPS = 1'000'000;
+
+/** Values of the calls evaluated at compile time, by call expression */
+using FoldedCalls = std::unordered_map<const neon_compiler::ast::nodes::Expression*, ConstantValue>;
+
+/** Operator function called by each operator, or `nullptr` if there is none or several */
+using OperatorFunctions = std::unordered_map<const neon_compiler::ast::nodes::OperatorDeclaration*, const neon_compiler::ast::nodes::OperatorFunction*>;
+
+/** Operator function called by `operator_call`, or `nullptr` if it is a built-in operator (e.g. member access) or there is no unique one.
+ * `operator_functions` is made by `PureEvaluator::find_operator_functions`. */
+const neon_compiler::ast::nodes::OperatorFunction* find_operator_function
+(
+	const OperatorFunctions& operator_functions,
+	const neon_compiler::ast::nodes::OperatorCallExpression& operator_call
+);
+
+/** Evaluates calls of pure functions and operator functions with constant arguments at compile time,
+ * by walking the AST of their bodies. Pure functions have no side effects, so a call has the same value wherever it is evaluated.
+ * Operator functions are treated alike: one whose body only uses what is evaluated here has no side effects either.
+ * Results are memoized by function and argument values, so tables of constants built from the same calls
+ * evaluate each distinct call once.
+ *
+ * Only literals, parameters, local variables and calls of pure functions and operator functions are evaluated.
+ * Calls needing anything else (e.g. methods or constructors) are left for run time,
+ * as are calls beyond `MAX_CALL_DEPTH` or `MAX_EVALUATION_STEPS` (e.g. endless recursion).
+ * Literals do not have a declared type yet, so the overload called is the only one taking that number of arguments,
+ * and the operator function called is the only one whose pattern has the shape of the operator.
+ * Number literals are normalised (see `normalise_number_literal`), so `0x1F`, `0b11111` and `31` are the same argument.
+ *
+ * Refers to the nodes of the AST through the resolution, so it is only valid as long as that is. */
+class PureEvaluator
+{
+public:
+	explicit PureEvaluator(const neon_compiler::resolution::Resolution& init_resolution);
+
+	/** Evaluates a literal, or a call of a pure function or operator function with constant arguments.
+	 * Empty if not known at compile time. */
+	std::optional<ConstantValue> evaluate(const neon_compiler::ast::nodes::Expression& expression);
+	/** Evaluates a call of the pure function with declaration `function`. Empty if not known at compile time. */
+	std::optional<ConstantValue> call_function(neon_compiler::ast::nodes::DeclarationId function, std::vector<ConstantValue> arguments);
+	/** Evaluates the outermost calls of pure functions and operator functions with constant arguments in all bodies in `root`.
+	 * The AST is left as it is, as unchanged files keep their nodes between analyses; code generation looks calls up instead. */
+	FoldedCalls fold_calls(const neon_compiler::ast::nodes::Root& root);
+
+	/** Declaration of the pure function called by `call`, or `UNRESOLVED_DECLARATION` if it does not call one */
+	static neon_compiler::ast::nodes::DeclarationId find_called_function
+	(
+		const neon_compiler::resolution::Resolution& ast_resolution,
+		const neon_compiler::ast::nodes::Expression& call
+	);
+
+	/** Matches the operators declared in all operator modules of `ast_resolution` with the operator functions implementing them.
+	 * An operator function may implement an operator declared in another operator module. */
+	static OperatorFunctions find_operator_functions(const neon_compiler::resolution::Resolution& ast_resolution);
+
+	/** Calls whose value was taken from the memo */
+	uint64_t get_memo_hit_count() const;
+	/** Calls that were evaluated */
+	uint64_t get_memo_miss_count() const;
+
+private:
+	struct CallKey
+	{
+		/** The overload of a pure function, or the operator function */
+		const neon_compiler::ast::ASTNode* function;
+		std::vector<ConstantValue> arguments;
+
+		bool operator==(const CallKey&) const = default;
+	};
+
+	struct CallKeyHash
+	{
+		std::size_t operator()(const CallKey& key) const;
+	};
+
+	/** Values of the parameters and local variables of a call */
+	using Frame = std::unordered_map<const neon_compiler::ast::nodes::VariableDeclaration*, ConstantValue>;
+
+	const neon_compiler::resolution::Resolution& resolution;
+	/** Found on first use */
+	OperatorFunctions operator_functions;
+	bool operator_functions_found{false};
+	/** Empty values are calls that cannot be evaluated at compile time */
+	std::unordered_map<CallKey, std::optional<ConstantValue>, CallKeyHash> memo;
+	uint64_t memo_hit_count{0};
+	uint64_t memo_miss_count{0};
+
+	std::size_t call_depth{0};
+	uint64_t steps_left{0};
+	/** Set once a limit is reached, after which nothing is memoized until the outermost call returns,
+	 * as failing calls might have been evaluated with more budget left */
+	bool out_of_budget{false};
+
+	std::optional<ConstantValue> evaluate_expression(const neon_compiler::ast::nodes::Expression& expression, Frame* frame);
+	std::optional<std::vector<ConstantValue>> evaluate_arguments
+	(
+		const std::vector<std::unique_ptr<neon_compiler::ast::nodes::Expression>>& arguments,
+		Frame* frame
+	);
+	std::optional<ConstantValue> call(neon_compiler::ast::nodes::DeclarationId function, std::vector<ConstantValue> arguments);
+	std::optional<ConstantValue> call_operator
+	(
+		const neon_compiler::ast::nodes::OperatorFunction& operator_function,
+		std::vector<ConstantValue> arguments
+	);
+	/** Runs `body` with `arguments` for `parameters`, or takes the value from the memo */
+	std::optional<ConstantValue> run
+	(
+		const neon_compiler::ast::ASTNode& function,
+		const neon_compiler::ast::nodes::CodeBlock& body,
+		const std::vector<const neon_compiler::ast::nodes::VariableDeclaration*>& parameters,
+		std::vector<ConstantValue> arguments
+	);
+	std::optional<ConstantValue> run_body
+	(
+		const neon_compiler::ast::nodes::CodeBlock& body,
+		const std::vector<const neon_compiler::ast::nodes::VariableDeclaration*>& parameters,
+		const std::vector<ConstantValue>& arguments
+	);
+	std::optional<ConstantValue> assign(const neon_compiler::ast::nodes::Assignment& assignment, Frame* frame);
+	bool take_step();
+
+	/** See `evaluation::find_operator_function`. Matches the operator functions on first use. */
+	const neon_compiler::ast::nodes::OperatorFunction* find_operator_function
+	(
+		const neon_compiler::ast::nodes::OperatorCallExpression& operator_call
+	);
+	static bool implements
+	(
+		const neon_compiler::ast::nodes::OperatorFunction& operator_function,
+		const neon_compiler::ast::nodes::OperatorDeclaration& operator_declaration
+	);
+
+	void fold_code_block(const neon_compiler::ast::nodes::CodeBlock& code_block, FoldedCalls& folded_calls);
+	void fold_expression(const neon_compiler::ast::nodes::Expression* expression, FoldedCalls& folded_calls);
+	void fold_expressions
+	(
+		const std::vector<std::unique_ptr<neon_compiler::ast::nodes::Expression>>& expressions,
+		FoldedCalls& folded_calls
+	);
+};
+
+}
+
+#endif // PURE_EVALUATOR_HPP
@@ -0,0 +1,171 @@
+#include "dependency_graph.hpp"
+
+#include <algorithm>
+
+using namespace neon_compiler::index;
+
+namespace
+{
+	const std::vector<std::string> NO_DECLARATIONS{};
+}
+
+void DependencyGraph::update_file(const std::string& file, const std::vector<std::string>& declarations, const std::vector<Dependency>& dependencies)
+{
+	clear_file(file);
+
+	for(const std::string& declaration : declarations)
+	{
+		declaring_files[declaration].push_back(file);
+	}
+
+	for(const Dependency& dependency : dependencies)
+	{
+		dependent_files[dependency.package_member].emplace_back(file, dependency.kind);
+	}
+
+	file_declarations[file] = declarations;
+	file_dependencies[file] = dependencies;
+}
+
+void DependencyGraph::remove_file(const std::string& file)
+{
+	clear_file(file);
+}
+
+const std::vector<std::string>& DependencyGraph::get_declarations(const std::string& file) const
+{
+	std::unordered_map<std::string, std::vector<std::string>>::const_iterator it = file_declarations.find(file);
+
+	return it == file_declarations.end() ? NO_DECLARATIONS : it->second;
+}
+
+std::vector<std::string> DependencyGraph::get_dependencies(const std::string& file) const
+{
+	std::vector<std::string> files;
+
+	std::unordered_map<std::string, std::vector<Dependency>>::const_iterator it = file_dependencies.find(file);
+
+	if(it == file_dependencies.end())
+	{
+		return files;
+	}
+
+	for(const Dependency& dependency : it->second)
+	{
+		std::unordered_map<std::string, std::vector<std::string>>::const_iterator declaring_it =
+			declaring_files.find(dependency.package_member);
+
+		if(declaring_it == declaring_files.end()) { continue; }
+
+		for(const std::string& declaring_file : declaring_it->second)
+		{
+			if(declaring_file != file)
+			{
+				files.push_back(declaring_file);
+			}
+		}
+	}
+
+	sort_unique(files);
+
+	return files;
+}
+
+std::vector<std::string> DependencyGraph::get_dependents(const std::string& file) const
+{
+	std::vector<std::string> files;
+
+	for(const std::string& declaration : get_declarations(file))
+	{
+		std::unordered_map<std::string, std::vector<DependentFile>>::const_iterator it = dependent_files.find(declaration);
+
+		if(it == dependent_files.end()) { continue; }
+
+		for(const DependentFile& dependent : it->second)
+		{
+			if(dependent.first != file)
+			{
+				files.push_back(dependent.first);
+			}
+		}
+	}
+
+	sort_unique(files);
+
+	return files;
+}
+
+std::vector<std::string> DependencyGraph::get_dependents_of(const std::string& package_member, DependencyKind kind) const
+{
+	std::vector<std::string> files;
+
+	std::unordered_map<std::string, std::vector<DependentFile>>::const_iterator it = dependent_files.find(package_member);
+
+	if(it == dependent_files.end())
+	{
+		return files;
+	}
+
+	for(const DependentFile& dependent : it->second)
+	{
+		if(dependent.second == kind)
+		{
+			files.push_back(dependent.first);
+		}
+	}
+
+	sort_unique(files);
+
+	return files;
+}
+
+void DependencyGraph::clear_file(const std::string& file)
+{
+	std::unordered_map<std::string, std::vector<std::string>>::iterator declarations_it = file_declarations.find(file);
+
+	if(declarations_it != file_declarations.end())
+	{
+		for(const std::string& declaration : declarations_it->second)
+		{
+			std::unordered_map<std::string, std::vector<std::string>>::iterator it = declaring_files.find(declaration);
+
+			if(it == declaring_files.end()) { continue; }
+
+			std::erase(it->second, file);
+
+			if(it->second.empty())
+			{
+				declaring_files.erase(it);
+			}
+		}
+
+		file_declarations.erase(declarations_it);
+	}
+
+	std::unordered_map<std::string, std::vector<Dependency>>::iterator dependencies_it = file_dependencies.find(file);
+
+	if(dependencies_it != file_dependencies.end())
+	{
+		for(const Dependency& dependency : dependencies_it->second)
+		{
+			std::unordered_map<std::string, std::vector<DependentFile>>::iterator it = dependent_files.find(dependency.package_member);
+
+			if(it == dependent_files.end()) { continue; }
+
+			std::erase_if(it->second, [&file](const DependentFile& dependent) { return dependent.first == file; });
+
+			if(it->second.empty())
+			{
+				dependent_files.erase(it);
+			}
+		}
+
+		file_dependencies.erase(dependencies_it);
+	}
+}
+
+void DependencyGraph::sort_unique(std::vector<std::string>& files)
+{
+	std::sort(files.begin(), files.end());
+	files.erase(std::unique(files.begin(), files.end()), files.end());
+}
@@ -0,0 +1,63 @@
+#ifndef DEPENDENCY_GRAPH_HPP
+#define DEPENDENCY_GRAPH_HPP
+
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace neon_compiler::index
+{
+
+enum class DependencyKind
+{
+	/** `import main::subpkg::Widget;` Only affects name resolution. */
+	IMPORT,
+	/** `use main::ops;` The operators of the operator module determine how the file is parsed. */
+	USE
+};
+
+struct Dependency
+{
+	/** Full identifier of the package member depended on */
+	std::string package_member;
+	DependencyKind kind;
+};
+
+/** File-level dependency graph, built from the imports and `use` statements found while parsing.
+ * Files depend on package members rather than on files, so a dependency on a package member
+ * that is not declared (yet) is kept and applies as soon as some file declares it. */
+class DependencyGraph
+{
+public:
+	/** Replaces the package members declared by `file` and the dependencies of `file`. */
+	void update_file(const std::string& file, const std::vector<std::string>& declarations, const std::vector<Dependency>& dependencies);
+	void remove_file(const std::string& file);
+
+	/** Package members declared by `file`, as of the last update */
+	const std::vector<std::string>& get_declarations(const std::string& file) const;
+	/** Files declaring a package member `file` depends on. Sorted, without `file` itself. */
+	std::vector<std::string> get_dependencies(const std::string& file) const;
+	/** Files depending on a package member declared by `file`. Sorted, without `file` itself. */
+	std::vector<std::string> get_dependents(const std::string& file) const;
+	/** Files with a dependency of `kind` on `package_member`. Sorted. */
+	std::vector<std::string> get_dependents_of(const std::string& package_member, DependencyKind kind) const;
+
+private:
+	using DependentFile = std::pair<std::string, DependencyKind>;
+
+	std::unordered_map<std::string, std::vector<std::string>> file_declarations;
+	std::unordered_map<std::string, std::vector<Dependency>> file_dependencies;
+	/** Mapping from package member identifier to the files declaring it */
+	std::unordered_map<std::string, std::vector<std::string>> declaring_files;
+	/** Mapping from package member identifier to the files depending on it */
+	std::unordered_map<std::string, std::vector<DependentFile>> dependent_files;
+
+	void clear_file(const std::string& file);
+
+	static void sort_unique(std::vector<std::string>& files);
+};
+
+}
+
+#endif // DEPENDENCY_GRAPH_HPP
@@ -0,0 +1,151 @@
+#include "reference_index.hpp"
+
+#include <algorithm>
+
+using namespace neon_compiler::index;
+
+ReferenceIndex::ReferenceIndex(std::shared_ptr<SymbolInterner> init_interner)
+	: interner{init_interner} {}
+
+template<typename Predicate>
+std::vector<SymbolLocation> ReferenceIndex::collect(SymbolId id, Predicate predicate) const
+{
+	std::vector<SymbolLocation> locations;
+
+	std::unordered_map<SymbolId, std::vector<FileId>>::const_iterator it = symbol_files.find(id);
+
+	if(it == symbol_files.end())
+	{
+		return locations;
+	}
+
+	for(FileId file_id : it->second)
+	{
+		const std::vector<SymbolOccurrence>& occurrences = file_occurrences[file_id].at(id);
+
+		for(const SymbolOccurrence& occurrence : occurrences)
+		{
+			if(predicate(occurrence))
+			{
+				locations.push_back(SymbolLocation{files[file_id], occurrence});
+			}
+		}
+	}
+
+	return locations;
+}
+
+void ReferenceIndex::replace_file(const std::string& file, const std::vector<std::pair<std::string, SymbolOccurrence>>& occurrences)
+{
+	const FileId file_id = get_file_id(file);
+
+	clear_file(file_id);
+
+	FileOccurrences& by_symbol = file_occurrences[file_id];
+
+	for(const std::pair<std::string, SymbolOccurrence>& pair : occurrences)
+	{
+		const SymbolId id = interner->intern(pair.first);
+
+		std::vector<SymbolOccurrence>& symbol_occurrences = by_symbol[id];
+		if(symbol_occurrences.empty())
+		{
+			symbol_files[id].push_back(file_id);
+		}
+		symbol_occurrences.push_back(pair.second);
+	}
+}
+
+void ReferenceIndex::remove_file(const std::string& file)
+{
+	std::unordered_map<std::string_view, FileId>::const_iterator it = file_ids.find(file);
+
+	if(it != file_ids.end())
+	{
+		clear_file(it->second);
+	}
+}
+
+std::vector<SymbolLocation> ReferenceIndex::find_references(SymbolId id) const
+{
+	return collect(id, [](const SymbolOccurrence&) { return true; });
+}
+
+std::vector<SymbolLocation> ReferenceIndex::find_declarations(SymbolId id) const
+{
+	return collect(id, [](const SymbolOccurrence& occurrence) { return occurrence.declaration; });
+}
+
+std::vector<SymbolLocation> ReferenceIndex::find_rename_locations(SymbolId id) const
+{
+	const std::string& name = interner->get_name(id);
+	const std::size_t separator = name.rfind("::");
+	const uint32_t member_name_length =
+		static_cast<uint32_t>(separator == std::string::npos ? name.size() : name.size() - separator - 2);
+
+	std::vector<SymbolLocation> locations = find_references(id);
+
+	for(SymbolLocation& location : locations)
+	{
+		SymbolOccurrence& occurrence = location.occurrence;
+
+		// Qualified references end with the member name; declarations and imported names are only the member name
+		const uint32_t skip = occurrence.length > member_name_length ? occurrence.length - member_name_length : 0;
+
+		occurrence.source_position.offset_in_file += skip;
+		occurrence.source_position.offset_in_line += skip;
+		occurrence.length -= skip;
+	}
+
+	return locations;
+}
+
+std::shared_ptr<SymbolInterner> ReferenceIndex::get_interner() const
+{
+	return interner;
+}
+
+ReferenceIndex::FileId ReferenceIndex::get_file_id(const std::string& file)
+{
+	std::unordered_map<std::string_view, FileId>::const_iterator it = file_ids.find(file);
+
+	if(it != file_ids.end())
+	{
+		return it->second;
+	}
+
+	const FileId file_id = static_cast<FileId>(files.size());
+	const std::string& stored = files.emplace_back(file);
+	file_ids.emplace(std::string_view{stored}, file_id);
+	file_occurrences.emplace_back();
+
+	return file_id;
+}
+
+void ReferenceIndex::clear_file(FileId file_id)
+{
+	FileOccurrences& by_symbol = file_occurrences[file_id];
+
+	for(const std::pair<const SymbolId, std::vector<SymbolOccurrence>>& pair : by_symbol)
+	{
+		std::unordered_map<SymbolId, std::vector<FileId>>::iterator it = symbol_files.find(pair.first);
+
+		if(it == symbol_files.end()) { continue; }
+
+		std::vector<FileId>& containing_files = it->second;
+		std::vector<FileId>::iterator file_it = std::find(containing_files.begin(), containing_files.end(), file_id);
+
+		if(file_it != containing_files.end())
+		{
+			*file_it = containing_files.back();
+			containing_files.pop_back();
+		}
+
+		if(containing_files.empty())
+		{
+			symbol_files.erase(it);
+		}
+	}
+
+	by_symbol.clear();
+}
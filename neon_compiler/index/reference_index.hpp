@@ -0,0 +1,76 @@
+#ifndef REFERENCE_INDEX_HPP
+#define REFERENCE_INDEX_HPP
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "symbol_interner.hpp"
+#include "../../reading/source_position.hpp"
+
+namespace neon_compiler::index
+{
+
+struct SymbolOccurrence
+{
+	/** Start of the (possibly multi-part) identifier */
+	reading::SourcePosition source_position;
+	/** Length of the identifier, including `::` separators */
+	uint32_t length;
+	/** Whether this is the declaration of the symbol rather than a reference to it */
+	bool declaration;
+};
+
+struct SymbolLocation
+{
+	/** Owned by the `ReferenceIndex`; valid as long as the index is */
+	std::string_view file;
+	SymbolOccurrence occurrence;
+};
+
+/** Cross-reference index from symbols to the places they are declared and referenced.
+ * Filled per file from `DECLARATION` and `REFERENCE` analysis entries.
+ * Queries cost O(results + files containing the symbol); updating a file only touches that file's entries. */
+class ReferenceIndex
+{
+public:
+	explicit ReferenceIndex(std::shared_ptr<SymbolInterner> init_interner);
+
+	/** Replaces everything recorded for `file` with `occurrences` (symbol string and its occurrence). */
+	void replace_file(const std::string& file, const std::vector<std::pair<std::string, SymbolOccurrence>>& occurrences);
+	void remove_file(const std::string& file);
+
+	/** All declarations of and references to `id` */
+	std::vector<SymbolLocation> find_references(SymbolId id) const;
+	std::vector<SymbolLocation> find_declarations(SymbolId id) const;
+	/** The ranges to replace when renaming `id`: the last identifier part (the member name) of every occurrence. */
+	std::vector<SymbolLocation> find_rename_locations(SymbolId id) const;
+
+	std::shared_ptr<SymbolInterner> get_interner() const;
+
+private:
+	using FileId = uint32_t;
+	using FileOccurrences = std::unordered_map<SymbolId, std::vector<SymbolOccurrence>>;
+
+	std::shared_ptr<SymbolInterner> interner;
+	/** File paths by `FileId`. A deque keeps the strings in place, so `SymbolLocation::file` stays valid. */
+	std::deque<std::string> files;
+	std::unordered_map<std::string_view, FileId> file_ids;
+	/** Occurrences per symbol, by `FileId` */
+	std::vector<FileOccurrences> file_occurrences;
+	/** Mapping from symbol to files containing at least one occurrence */
+	std::unordered_map<SymbolId, std::vector<FileId>> symbol_files;
+
+	FileId get_file_id(const std::string& file);
+	void clear_file(FileId file_id);
+	template<typename Predicate>
+	std::vector<SymbolLocation> collect(SymbolId id, Predicate predicate) const;
+};
+
+}
+
+#endif // REFERENCE_INDEX_HPP
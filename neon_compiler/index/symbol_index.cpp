@@ -0,0 +1,280 @@
+#include "symbol_index.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+
+using namespace neon_compiler::index;
+
+SymbolIndex::SymbolIndex(std::shared_ptr<SymbolInterner> init_interner)
+	: interner{init_interner} {}
+
+void SymbolIndex::update_file(const std::string& file, const std::vector<std::string>& qualified_identifiers)
+{
+	std::vector<SymbolId> symbols;
+	symbols.reserve(qualified_identifiers.size());
+
+	// Add before releasing, so symbols that stay defined by this file are never briefly dead
+	for(const std::string& qualified_identifier : qualified_identifiers)
+	{
+		const SymbolId id = interner->intern(qualified_identifier);
+		add_symbol(id);
+		symbols.push_back(id);
+	}
+
+	std::unordered_map<std::string, std::vector<SymbolId>>::iterator it = file_symbols.find(file);
+
+	if(it != file_symbols.end())
+	{
+		for(SymbolId id : it->second)
+		{
+			release_symbol(id);
+		}
+		it->second = std::move(symbols);
+	}
+	else
+	{
+		file_symbols.emplace(file, std::move(symbols));
+	}
+}
+
+void SymbolIndex::remove_file(const std::string& file)
+{
+	std::unordered_map<std::string, std::vector<SymbolId>>::iterator it = file_symbols.find(file);
+
+	if(it == file_symbols.end())
+	{
+		return;
+	}
+
+	for(SymbolId id : it->second)
+	{
+		release_symbol(id);
+	}
+
+	file_symbols.erase(it);
+}
+
+std::vector<SymbolMatch> SymbolIndex::search(std::string_view query, std::size_t max_results) const
+{
+	const std::string lower_query = to_lower(query);
+
+	if(lower_query.empty() || max_results == 0)
+	{
+		return {};
+	}
+
+	// A single character only forms the trigram for an exact one-character member name
+	if(lower_query.size() < 2)
+	{
+		return search_short(lower_query, max_results);
+	}
+
+	std::vector<Trigram> query_trigrams;
+	collect_trigrams(lower_query, query_trigrams);
+	std::sort(query_trigrams.begin(), query_trigrams.end());
+	query_trigrams.erase(std::unique(query_trigrams.begin(), query_trigrams.end()), query_trigrams.end());
+
+	// Keyed by candidate, so a query only touches the symbols sharing a trigram with it
+	std::unordered_map<SymbolId, uint32_t> shared_counts;
+	std::vector<SymbolId> candidates;
+
+	for(Trigram trigram : query_trigrams)
+	{
+		std::unordered_map<Trigram, std::vector<SymbolId>>::const_iterator it = postings.find(trigram);
+
+		if(it == postings.end()) { continue; }
+
+		for(SymbolId id : it->second)
+		{
+			if(shared_counts[id]++ == 0)
+			{
+				candidates.push_back(id);
+			}
+		}
+	}
+
+	const uint32_t min_shared = std::max<uint32_t>
+	(
+		1,
+		static_cast<uint32_t>(std::ceil(static_cast<double>(query_trigrams.size()) * MIN_TRIGRAM_RATIO))
+	);
+
+	std::vector<SymbolMatch> matches;
+
+	for(SymbolId id : candidates)
+	{
+		const uint32_t shared = shared_counts.at(id);
+
+		if(shared < min_shared || !is_live(id)) { continue; }
+
+		matches.push_back(SymbolMatch{id, score(lower_query, id, shared, query_trigrams.size())});
+	}
+
+	rank(matches, max_results);
+
+	return matches;
+}
+
+std::size_t SymbolIndex::get_live_symbol_count() const
+{
+	return live_symbol_count;
+}
+
+std::shared_ptr<SymbolInterner> SymbolIndex::get_interner() const
+{
+	return interner;
+}
+
+void SymbolIndex::add_symbol(SymbolId id)
+{
+	if(id >= definition_counts.size())
+	{
+		definition_counts.resize(id + 1, 0);
+		lower_names.resize(id + 1);
+	}
+
+	if(definition_counts[id]++ == 0)
+	{
+		++live_symbol_count;
+	}
+
+	if(!lower_names[id].empty()) { return; }
+
+	const std::string& lower_qualified = lower_names[id] = to_lower(interner->get_name(id));
+	const std::string_view lower_member = get_member_name(lower_qualified);
+
+	std::vector<Trigram> trigrams;
+	collect_trigrams(lower_qualified, trigrams);
+	if(lower_member.size() != lower_qualified.size())
+	{
+		collect_trigrams(lower_member, trigrams);
+	}
+
+	std::sort(trigrams.begin(), trigrams.end());
+	trigrams.erase(std::unique(trigrams.begin(), trigrams.end()), trigrams.end());
+
+	for(Trigram trigram : trigrams)
+	{
+		postings[trigram].push_back(id);
+	}
+}
+
+void SymbolIndex::release_symbol(SymbolId id)
+{
+	if(--definition_counts[id] == 0)
+	{
+		--live_symbol_count;
+	}
+}
+
+bool SymbolIndex::is_live(SymbolId id) const
+{
+	return id < definition_counts.size() && definition_counts[id] > 0;
+}
+
+double SymbolIndex::score(std::string_view lower_query, SymbolId id, uint32_t shared_trigrams, std::size_t query_trigrams) const
+{
+	const std::string& lower_qualified = lower_names[id];
+	const std::string_view lower_member = get_member_name(lower_qualified);
+
+	double result = static_cast<double>(shared_trigrams) / static_cast<double>(query_trigrams);
+
+	if(lower_member == lower_query)                                 { result += 1.0; }
+	else if(lower_member.starts_with(lower_query))                  { result += 0.5; }
+	else if(lower_qualified.find(lower_query) != std::string::npos) { result += 0.25; }
+	else if(is_subsequence(lower_query, lower_qualified))           { result += 0.1; }
+
+	// Prefer shorter (less nested) identifiers among otherwise equal matches
+	result -= 0.001 * static_cast<double>(lower_qualified.size());
+
+	return result;
+}
+
+std::vector<SymbolMatch> SymbolIndex::search_short(std::string_view lower_query, std::size_t max_results) const
+{
+	std::vector<SymbolMatch> matches;
+
+	for(SymbolId id = 0; id < definition_counts.size(); ++id)
+	{
+		if(!is_live(id)) { continue; }
+
+		if(!get_member_name(lower_names[id]).starts_with(lower_query)) { continue; }
+
+		matches.push_back(SymbolMatch{id, score(lower_query, id, 1, 1)});
+	}
+
+	rank(matches, max_results);
+
+	return matches;
+}
+
+void SymbolIndex::rank(std::vector<SymbolMatch>& matches, std::size_t max_results) const
+{
+	const std::size_t count = std::min(max_results, matches.size());
+
+	std::partial_sort
+	(
+		matches.begin(),
+		matches.begin() + static_cast<std::ptrdiff_t>(count),
+		matches.end(),
+		[this](const SymbolMatch& a, const SymbolMatch& b)
+		{
+			if(a.score != b.score) { return a.score > b.score; }
+			return interner->get_name(a.id) < interner->get_name(b.id);
+		}
+	);
+
+	matches.resize(count);
+}
+
+void SymbolIndex::collect_trigrams(std::string_view lower_text, std::vector<Trigram>& out)
+{
+	std::string padded;
+	padded.reserve(lower_text.size() + 2);
+	padded += BOUNDARY;
+	padded += lower_text;
+	padded += BOUNDARY;
+
+	for(std::size_t i = 0; i + 2 < padded.size(); ++i)
+	{
+		out.push_back
+		(
+			static_cast<Trigram>(static_cast<unsigned char>(padded[i])) << 16 |
+			static_cast<Trigram>(static_cast<unsigned char>(padded[i + 1])) << 8 |
+			static_cast<Trigram>(static_cast<unsigned char>(padded[i + 2]))
+		);
+	}
+}
+
+std::string SymbolIndex::to_lower(std::string_view str)
+{
+	std::string lower{str};
+	for(char& c : lower)
+	{
+		c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+	}
+	return lower;
+}
+
+std::string_view SymbolIndex::get_member_name(std::string_view qualified_identifier)
+{
+	const std::size_t separator = qualified_identifier.rfind("::");
+
+	if(separator == std::string_view::npos)
+	{
+		return qualified_identifier;
+	}
+
+	return qualified_identifier.substr(separator + 2);
+}
+
+bool SymbolIndex::is_subsequence(std::string_view needle, std::string_view haystack)
+{
+	std::size_t i = 0;
+	for(char c : haystack)
+	{
+		if(i < needle.size() && needle[i] == c) { ++i; }
+	}
+	return i == needle.size();
+}
@@ -0,0 +1,74 @@
+#ifndef SYMBOL_INDEX_HPP
+#define SYMBOL_INDEX_HPP
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "symbol_interner.hpp"
+
+namespace neon_compiler::index
+{
+
+struct SymbolMatch
+{
+	SymbolId id;
+	/** Higher is better. Only meaningful relative to other matches of the same query. */
+	double score;
+};
+
+/** Trigram inverted index over package member identifiers, used for fuzzy workspace symbol search.
+ * Both the qualified identifier (`main::subpkg::Widget`) and the member name (`Widget`) are indexed, case-insensitively.
+ * Files are (re)indexed individually with `update_file`, so re-parsing one file does not rebuild the whole index. */
+class SymbolIndex
+{
+public:
+	explicit SymbolIndex(std::shared_ptr<SymbolInterner> init_interner);
+
+	/** Replaces the symbols defined by `file` with `qualified_identifiers`. */
+	void update_file(const std::string& file, const std::vector<std::string>& qualified_identifiers);
+	void remove_file(const std::string& file);
+
+	/** Returns at most `max_results` symbols matching `query`, best match first. */
+	std::vector<SymbolMatch> search(std::string_view query, std::size_t max_results) const;
+
+	std::size_t get_live_symbol_count() const;
+	std::shared_ptr<SymbolInterner> get_interner() const;
+
+private:
+	using Trigram = uint32_t;
+
+	/** Marks the start and end of indexed text, so prefixes and suffixes get their own trigrams. */
+	static constexpr char BOUNDARY = '\x1F';
+	/** Fraction of the query trigrams a symbol must share to be considered a candidate */
+	static constexpr double MIN_TRIGRAM_RATIO = 0.5;
+
+	std::shared_ptr<SymbolInterner> interner;
+	/** Posting lists. Append-only: removed symbols are filtered out through `definition_counts`. */
+	std::unordered_map<Trigram, std::vector<SymbolId>> postings;
+	/** Number of files defining each symbol, indexed by `SymbolId`. A symbol is live if this is non-zero. */
+	std::vector<uint32_t> definition_counts;
+	/** Lower case identifiers, indexed by `SymbolId`. Empty until the trigrams of a symbol have been added to `postings`. */
+	std::vector<std::string> lower_names;
+	/** Mapping from file path to symbols defined in that file */
+	std::unordered_map<std::string, std::vector<SymbolId>> file_symbols;
+	std::size_t live_symbol_count{0};
+
+	void add_symbol(SymbolId id);
+	void release_symbol(SymbolId id);
+	bool is_live(SymbolId id) const;
+	double score(std::string_view lower_query, SymbolId id, uint32_t shared_trigrams, std::size_t query_trigrams) const;
+	std::vector<SymbolMatch> search_short(std::string_view lower_query, std::size_t max_results) const;
+	void rank(std::vector<SymbolMatch>& matches, std::size_t max_results) const;
+
+	static void collect_trigrams(std::string_view lower_text, std::vector<Trigram>& out);
+	static std::string to_lower(std::string_view str);
+	static std::string_view get_member_name(std::string_view qualified_identifier);
+	static bool is_subsequence(std::string_view needle, std::string_view haystack);
+};
+
+}
+
+#endif // SYMBOL_INDEX_HPP
@@ -0,0 +1,41 @@
+#include "symbol_interner.hpp"
+
+using namespace neon_compiler::index;
+
+SymbolId SymbolInterner::intern(std::string_view name)
+{
+	std::unordered_map<std::string_view, SymbolId>::const_iterator it = ids.find(name);
+
+	if(it != ids.end())
+	{
+		return it->second;
+	}
+
+	const SymbolId id = static_cast<SymbolId>(names.size());
+	const std::string& stored = names.emplace_back(name);
+	ids.emplace(std::string_view{stored}, id);
+
+	return id;
+}
+
+std::optional<SymbolId> SymbolInterner::find(std::string_view name) const
+{
+	std::unordered_map<std::string_view, SymbolId>::const_iterator it = ids.find(name);
+
+	if(it == ids.end())
+	{
+		return std::nullopt;
+	}
+
+	return it->second;
+}
+
+const std::string& SymbolInterner::get_name(SymbolId id) const
+{
+	return names.at(id);
+}
+
+std::size_t SymbolInterner::size() const
+{
+	return names.size();
+}
@@ -0,0 +1,35 @@
+#ifndef SYMBOL_INTERNER_HPP
+#define SYMBOL_INTERNER_HPP
+
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace neon_compiler::index
+{
+
+/** Dense id of an interned symbol string (e.g. `main::subpkg::Widget`). Ids start at 0 and never change. */
+using SymbolId = uint32_t;
+
+/** Maps symbol strings to dense ids, so indexes can store 32-bit ids instead of strings.
+ * Interned strings are never removed; this keeps ids stable across incremental updates. */
+class SymbolInterner
+{
+public:
+	SymbolId intern(std::string_view name);
+	std::optional<SymbolId> find(std::string_view name) const;
+	const std::string& get_name(SymbolId id) const;
+	std::size_t size() const;
+
+private:
+	/** Owns the strings. A deque keeps references stable while growing, so `ids` can key on views. */
+	std::deque<std::string> names;
+	std::unordered_map<std::string_view, SymbolId> ids;
+};
+
+}
+
+#endif // SYMBOL_INTERNER_HPP
@@ -0,0 +1,37 @@
+#include "dead_value_elimination.hpp"
+
+#include <cstddef>
+#include <vector>
+
+using namespace neon_compiler::ir;
+
+std::string_view DeadValueElimination::get_name() const
+{
+	return "DeadValueElimination";
+}
+
+void DeadValueElimination::run(Function& function) const
+{
+	std::vector<bool> used(function.instructions.size(), false);
+	std::vector<bool> removed(function.instructions.size(), false);
+	bool any_removed{false};
+
+	for(std::size_t i = function.instructions.size(); i-- > 0;)
+	{
+		const Instruction& instruction = function.instructions[i];
+
+		if(!used[i] && is_pure(instruction.op_code))
+		{
+			removed[i] = true;
+			any_removed = true;
+			continue;
+		}
+
+		for(const ValueId operand : get_operands(function, instruction))
+		{
+			used[operand] = true;
+		}
+	}
+
+	if(any_removed) { remove_instructions(function, removed); }
+}
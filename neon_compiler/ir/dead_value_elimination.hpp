@@ -0,0 +1,23 @@
+#ifndef DEAD_VALUE_ELIMINATION_HPP
+#define DEAD_VALUE_ELIMINATION_HPP
+
+#include <string_view>
+#include "ir.hpp"
+#include "pass_manager.hpp"
+
+namespace neon_compiler::ir
+{
+
+/** Removes the instructions that only compute a value (see `is_pure`) whose value is not used, e.g. unused constants
+ * and the objects of constructor calls whose result is discarded. Values are defined before their uses,
+ * so one walk from the last instruction back sees all uses of a value before its definition. */
+class DeadValueElimination : public FunctionPass
+{
+public:
+	std::string_view get_name() const override;
+	void run(Function& function) const override;
+};
+
+}
+
+#endif // DEAD_VALUE_ELIMINATION_HPP
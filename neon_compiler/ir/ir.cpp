@@ -0,0 +1,235 @@
+#include "ir.hpp"
+
+#include <cstddef>
+#include <optional>
+#include <variant>
+
+using namespace neon_compiler;
+using namespace neon_compiler::evaluation;
+using namespace neon_compiler::ir;
+
+namespace
+{
+	std::string_view op_code_to_string(OpCode op_code)
+	{
+		switch(op_code)
+		{
+			case OpCode::PARAMETER:    { return "parameter"; }
+			case OpCode::CONSTANT:     { return "constant"; }
+			case OpCode::EMPTY:        { return "empty"; }
+			case OpCode::ALLOCATE:     { return "allocate"; }
+			case OpCode::GET_FIELD:    { return "get_field"; }
+			case OpCode::SET_FIELD:    { return "set_field"; }
+			case OpCode::CALL:         { return "call"; }
+			case OpCode::CALL_RUNTIME: { return "call_runtime"; }
+			case OpCode::FAIL:         { return "fail"; }
+			case OpCode::RETURN:       { return "return"; }
+			default: { return "unknown"; }
+		}
+	}
+
+	std::string constant_to_string(const ConstantValue& constant)
+	{
+		if(const NumberValue* number = std::get_if<NumberValue>(&constant)) { return number->literal; }
+		if(const std::string* string = std::get_if<std::string>(&constant)) { return "\"" + *string + "\""; }
+
+		return std::get<bool>(constant) ? "true" : "false";
+	}
+
+	/** `operand` of `instruction` as text, if it has one */
+	std::string operand_to_string(const Function& function, const Instruction& instruction)
+	{
+		switch(instruction.op_code)
+		{
+			case OpCode::PARAMETER:
+			case OpCode::ALLOCATE:
+			case OpCode::GET_FIELD:
+			case OpCode::SET_FIELD:    { return std::to_string(instruction.operand); }
+			case OpCode::CONSTANT:     { return constant_to_string(function.constants.at(instruction.operand)); }
+			case OpCode::CALL:         { return "#" + std::to_string(instruction.operand); }
+			case OpCode::CALL_RUNTIME:
+			case OpCode::FAIL:         { return "\"" + function.strings.at(instruction.operand) + "\""; }
+			default: { return ""; }
+		}
+	}
+
+	/** Number of entries of the table that `operand` of instructions with `op_code` indexes, if any */
+	std::optional<std::size_t> get_operand_limit(const Function& function, OpCode op_code)
+	{
+		switch(op_code)
+		{
+			case OpCode::PARAMETER:    { return function.parameter_count; }
+			case OpCode::CONSTANT:     { return function.constants.size(); }
+			case OpCode::CALL_RUNTIME:
+			case OpCode::FAIL:         { return function.strings.size(); }
+			default: { return std::nullopt; }
+		}
+	}
+}
+
+bool ir::is_pure(OpCode op_code)
+{
+	// Not `GET_FIELD`, which fails on values that are not objects
+	return op_code == OpCode::PARAMETER || op_code == OpCode::CONSTANT || op_code == OpCode::EMPTY || op_code == OpCode::ALLOCATE;
+}
+
+bool ir::has_value(OpCode op_code)
+{
+	return op_code != OpCode::SET_FIELD && op_code != OpCode::RETURN;
+}
+
+std::span<const ValueId> ir::get_operands(const Function& function, const Instruction& instruction)
+{
+	return std::span<const ValueId>{function.operands}.subspan(instruction.first_operand, instruction.operand_count);
+}
+
+void ir::remove_instructions(Function& function, const std::vector<bool>& removed)
+{
+	std::vector<ValueId> new_ids(function.instructions.size());
+	std::size_t kept{0};
+
+	for(std::size_t i = 0; i < function.instructions.size(); ++i)
+	{
+		new_ids[i] = static_cast<ValueId>(kept);
+		if(removed[i]) { continue; }
+
+		function.instructions[kept++] = function.instructions[i];
+	}
+
+	for(Block& block : function.blocks)
+	{
+		const std::size_t end = block.first_instruction + block.instruction_count;
+		const ValueId new_end = end == removed.size() ? static_cast<ValueId>(kept) : new_ids[end];
+
+		block.first_instruction = new_ids[block.first_instruction];
+		block.instruction_count = new_end - block.first_instruction;
+	}
+
+	function.instructions.resize(kept);
+
+	for(const Instruction& instruction : function.instructions)
+	{
+		for(uint32_t i = instruction.first_operand; i < instruction.first_operand + instruction.operand_count; ++i)
+		{
+			function.operands[i] = new_ids[function.operands[i]];
+		}
+	}
+}
+
+std::vector<std::string> ir::verify(const Function& function)
+{
+	std::vector<std::string> errors;
+
+	if(function.blocks.empty())
+	{
+		errors.emplace_back(ir_error_messages::NO_BLOCKS);
+		return errors;
+	}
+
+	std::size_t next_instruction{0};
+	for(std::size_t i = 0; i < function.blocks.size(); ++i)
+	{
+		const Block& block = function.blocks[i];
+		const std::size_t end = std::size_t{block.first_instruction} + block.instruction_count;
+
+		if(block.first_instruction != next_instruction || end > function.instructions.size())
+		{
+			errors.emplace_back(ir_error_messages::BLOCKS_NOT_CONTIGUOUS);
+			return errors;
+		}
+		if(block.instruction_count == 0 || function.instructions[end - 1].op_code != OpCode::RETURN)
+		{
+			errors.push_back(std::string{ir_error_messages::NO_TERMINATOR} + std::to_string(i));
+		}
+
+		next_instruction = end;
+	}
+	if(next_instruction != function.instructions.size())
+	{
+		errors.emplace_back(ir_error_messages::BLOCKS_NOT_CONTIGUOUS);
+	}
+
+	std::size_t block_end{0};
+	std::size_t block_index{0};
+	for(std::size_t i = 0; i < function.instructions.size(); ++i)
+	{
+		const Instruction& instruction = function.instructions[i];
+		const std::string id = std::to_string(i);
+
+		while(i >= block_end)
+		{
+			const Block& block = function.blocks[block_index++];
+			block_end = std::size_t{block.first_instruction} + block.instruction_count;
+		}
+
+		if(instruction.op_code == OpCode::RETURN && i + 1 != block_end)
+		{
+			errors.push_back(std::string{ir_error_messages::TERMINATOR_INSIDE_BLOCK} + id);
+		}
+
+		const std::optional<std::size_t> operand_limit = get_operand_limit(function, instruction.op_code);
+		if(operand_limit.has_value() && instruction.operand >= operand_limit.value())
+		{
+			errors.push_back(std::string{ir_error_messages::OPERAND_OUT_OF_RANGE} + id);
+		}
+
+		if(std::size_t{instruction.first_operand} + instruction.operand_count > function.operands.size())
+		{
+			errors.push_back(std::string{ir_error_messages::OPERANDS_OUT_OF_RANGE} + id);
+			continue;
+		}
+
+		// Blocks are in order and there are no branches yet, so a definition dominates the uses after it
+		for(const ValueId operand : get_operands(function, instruction))
+		{
+			if(operand >= i)
+			{
+				errors.push_back(std::string{ir_error_messages::USE_BEFORE_DEFINITION} + id);
+			}
+			else if(!has_value(function.instructions[operand].op_code))
+			{
+				errors.push_back(std::string{ir_error_messages::USE_WITHOUT_VALUE} + id);
+			}
+		}
+	}
+
+	return errors;
+}
+
+std::string ir::to_string(const Function& function)
+{
+	std::string text = "function " + function.name + "(" + std::to_string(function.parameter_count) + ")\n";
+
+	for(std::size_t i = 0; i < function.blocks.size(); ++i)
+	{
+		const Block& block = function.blocks[i];
+		text += "block " + std::to_string(i) + ":\n";
+
+		for(uint32_t id = block.first_instruction; id < block.first_instruction + block.instruction_count; ++id)
+		{
+			const Instruction& instruction = function.instructions[id];
+
+			text += "\t";
+			if(has_value(instruction.op_code)) { text += "%" + std::to_string(id) + " = "; }
+			text += op_code_to_string(instruction.op_code);
+
+			const std::string operand = operand_to_string(function, instruction);
+			if(!operand.empty()) { text += " " + operand; }
+
+			// Arguments of calls in brackets, e.g. `call #0(%1)`, other operands after a space, e.g. `return %1`
+			const bool call = instruction.op_code == OpCode::CALL || instruction.op_code == OpCode::CALL_RUNTIME;
+			const std::span<const ValueId> operands = get_operands(function, instruction);
+
+			if(call) { text += "("; }
+			for(std::size_t j = 0; j < operands.size(); ++j)
+			{
+				text += (j == 0 ? (call ? "%" : " %") : ", %") + std::to_string(operands[j]);
+			}
+			if(call) { text += ")"; }
+
+			text += "\n";
+		}
+	}
+
+	return text;
+}
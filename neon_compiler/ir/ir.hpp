@@ -0,0 +1,122 @@
+#ifndef IR_HPP
+#define IR_HPP
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "../evaluation/constant_value.hpp"
+
+namespace neon_compiler::ir
+{
+
+/** Index of the instruction defining the value */
+using ValueId = uint32_t;
+/** Index of a function in its module */
+using FunctionId = uint32_t;
+
+namespace ir_error_messages
+{
+	constexpr std::string_view NO_BLOCKS =
+		"Function has no blocks";
+	constexpr std::string_view BLOCKS_NOT_CONTIGUOUS =
+		"Blocks do not cover the instructions in order";
+	constexpr std::string_view NO_TERMINATOR =
+		"Block does not end with a return: block ";
+	constexpr std::string_view TERMINATOR_INSIDE_BLOCK =
+		"Return before the end of a block: %";
+	constexpr std::string_view OPERANDS_OUT_OF_RANGE =
+		"Operands out of range: %";
+	constexpr std::string_view USE_BEFORE_DEFINITION =
+		"Value used before it is defined: %";
+	constexpr std::string_view USE_WITHOUT_VALUE =
+		"Value of an instruction without value used: %";
+	constexpr std::string_view OPERAND_OUT_OF_RANGE =
+		"Operand out of range: %";
+}
+
+enum class OpCode : uint8_t
+{
+	/** Parameter `operand`. The object of a method is parameter 0, followed by the declared parameters. */
+	PARAMETER,
+	/** `constants[operand]` */
+	CONSTANT,
+	/** The empty value, e.g. of a local variable without initialisation */
+	EMPTY,
+	/** New object of a type with `operand` fields, which start empty */
+	ALLOCATE,
+	/** Field `operand` of operand 0 */
+	GET_FIELD,
+	/** Stores operand 1 in field `operand` of operand 0. Has no value. */
+	SET_FIELD,
+	/** Function `operand` of the module, called with the operands */
+	CALL,
+	/** Function `strings[operand]` of the runtime (e.g. `print`), called with the operands */
+	CALL_RUNTIME,
+	/** Stops the program with the message `strings[operand]`, for what could not be lowered */
+	FAIL,
+	/** Returns operand 0, or the empty value without operands. Ends its block and has no value. */
+	RETURN
+};
+
+/** One instruction, which defines the value with its index. Operands are values, apart from `operand`,
+ * whose meaning depends on the op code. */
+struct Instruction
+{
+	OpCode op_code;
+	/** Start of the operands in `Function::operands` */
+	uint32_t first_operand;
+	uint32_t operand_count;
+	uint32_t operand;
+};
+
+/** Instructions `first_instruction` to `first_instruction + instruction_count` of a function */
+struct Block
+{
+	uint32_t first_instruction;
+	uint32_t instruction_count;
+};
+
+/** One function in SSA form: every value is defined once, by one instruction, before it is used.
+ * Instructions, operands and constants are each stored in one vector, and refer to each other by index,
+ * so passes walk contiguous memory. Blocks are in order and cover all instructions.
+ * Neoncode has no branches yet, so a lowered function is a single block ending with its return.
+ * Owns everything its instructions refer to, apart from other functions, so functions can be changed in parallel. */
+struct Function
+{
+	std::string name;
+	uint32_t parameter_count{0};
+	std::vector<Block> blocks;
+	std::vector<Instruction> instructions;
+	std::vector<ValueId> operands;
+	std::vector<neon_compiler::evaluation::ConstantValue> constants;
+	std::vector<std::string> strings;
+};
+
+struct Module
+{
+	std::vector<Function> functions;
+};
+
+/** Whether instructions with `op_code` only compute their value, so they can be removed if it is not used */
+bool is_pure(OpCode op_code);
+/** Whether instructions with `op_code` define a value */
+bool has_value(OpCode op_code);
+
+std::span<const ValueId> get_operands(const Function& function, const Instruction& instruction);
+
+/** Removes the instructions for which `removed` is true, whose values must not be used, and renumbers the values of the others.
+ * Operands of removed instructions stay in `operands` until the function is lowered again. */
+void remove_instructions(Function& function, const std::vector<bool>& removed);
+
+/** Checks that `function` is in SSA form and that its blocks and operands are consistent.
+ * Returns the problems found, with messages from `ir_error_messages`. */
+std::vector<std::string> verify(const Function& function);
+
+/** Text of `function` for tests and debugging, e.g. `%1 = call #0(%0)` */
+std::string to_string(const Function& function);
+
+}
+
+#endif // IR_HPP
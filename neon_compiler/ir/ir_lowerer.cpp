@@ -0,0 +1,566 @@
+#include "ir_lowerer.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <variant>
+#include "../parser/operator.hpp"
+#include "../reference_counting/bodies.hpp"
+#include "../trace/trace.hpp"
+
+using namespace neon_compiler;
+using namespace neon_compiler::ast;
+using namespace neon_compiler::ast::nodes;
+using namespace neon_compiler::ir;
+using namespace neon_compiler::reference_counting;
+using namespace neon_compiler::resolution;
+
+namespace
+{
+	template<typename Value>
+	std::vector<std::string> get_sorted_names(const std::unordered_map<std::string, Value>& map)
+	{
+		std::vector<std::string> names;
+		names.reserve(map.size());
+
+		for(const std::pair<const std::string, Value>& pair : map)
+		{
+			names.push_back(pair.first);
+		}
+
+		std::sort(names.begin(), names.end());
+		return names;
+	}
+
+	std::vector<const VariableDeclaration*> get_parameters(const ParameterDeclarationList& parameter_list)
+	{
+		std::vector<const VariableDeclaration*> parameters;
+		parameters.reserve(parameter_list.size());
+
+		for(const VariableDeclaration& parameter : parameter_list)
+		{
+			parameters.push_back(&parameter);
+		}
+
+		return parameters;
+	}
+
+	/** Node of the only overload of `callee` taking `argument_count` arguments, if it is an entrypoint, method or pure function */
+	const ASTNode* find_overload(const Resolution& resolution, DeclarationId callee, std::size_t argument_count)
+	{
+		const Declaration& declaration = resolution.get_declaration(callee);
+		const ASTNode* found{nullptr};
+
+		for(const ASTNode* node : declaration.nodes)
+		{
+			std::size_t parameter_count{0};
+
+			switch(declaration.kind)
+			{
+				case DeclarationKind::ENTRYPOINT:    { parameter_count = static_cast<const Entrypoint*>(node)->parameters.size(); break; }
+				case DeclarationKind::METHOD:        { parameter_count = static_cast<const Method*>(node)->parameters.size(); break; }
+				case DeclarationKind::PURE_FUNCTION: { parameter_count = static_cast<const PureFunction*>(node)->parameters.size(); break; }
+				default: { return nullptr; }
+			}
+
+			if(parameter_count != argument_count) { continue; }
+			if(found) { return nullptr; }
+
+			found = node;
+		}
+
+		return found;
+	}
+}
+
+/** Lowers one body into its `Function`, in a single block */
+class IrLowerer::BodyLowerer
+{
+public:
+	BodyLowerer(const IrLowerer& init_lowerer, Function& init_function)
+		: lowerer{init_lowerer}, function{init_function} {}
+
+	void lower(const Source& source)
+	{
+		uint32_t parameter_count{0};
+
+		if(source.has_self) { self = emit(OpCode::PARAMETER, {}, parameter_count++); }
+		for(const VariableDeclaration* parameter : source.parameters)
+		{
+			values[parameter] = emit(OpCode::PARAMETER, {}, parameter_count++);
+		}
+		function.parameter_count = parameter_count;
+
+		bool returned{false};
+		for(const std::unique_ptr<Statement>& statement : source.body->statements)
+		{
+			if(!lower_statement(statement.get()))
+			{
+				returned = true;
+				break;
+			}
+		}
+
+		if(!returned) { emit(OpCode::RETURN, {}, 0); }
+
+		function.blocks.push_back(Block{0, static_cast<uint32_t>(function.instructions.size())});
+	}
+
+private:
+	const IrLowerer& lowerer;
+	Function& function;
+	std::optional<ValueId> self;
+	/** Value each parameter and local variable stands for */
+	std::unordered_map<const VariableDeclaration*, ValueId> values;
+	std::unordered_map<std::string, uint32_t> string_indices;
+
+	ValueId emit(OpCode op_code, const std::vector<ValueId>& operands, uint32_t operand)
+	{
+		const ValueId id = static_cast<ValueId>(function.instructions.size());
+
+		function.instructions.push_back(Instruction{op_code, static_cast<uint32_t>(function.operands.size()), static_cast<uint32_t>(operands.size()), operand});
+		function.operands.insert(function.operands.end(), operands.begin(), operands.end());
+
+		return id;
+	}
+
+	ValueId emit_constant(evaluation::ConstantValue constant)
+	{
+		function.constants.push_back(std::move(constant));
+		return emit(OpCode::CONSTANT, {}, static_cast<uint32_t>(function.constants.size() - 1));
+	}
+
+	uint32_t add_string(const std::string& string)
+	{
+		const std::pair<std::unordered_map<std::string, uint32_t>::iterator, bool> inserted =
+			string_indices.emplace(string, static_cast<uint32_t>(function.strings.size()));
+
+		if(inserted.second) { function.strings.push_back(string); }
+
+		return inserted.first->second;
+	}
+
+	ValueId fail(std::string_view message, std::string_view detail = "")
+	{
+		return emit(OpCode::FAIL, {}, add_string(std::string{message} + std::string{detail}));
+	}
+
+	/** Returns whether the statements after it are reached */
+	bool lower_statement(const Statement* statement)
+	{
+		if(const DiscardExpression* discard = dynamic_cast<const DiscardExpression*>(statement))
+		{
+			lower(discard->expression.get());
+		}
+		else if(const LocalDeclaration* local = dynamic_cast<const LocalDeclaration*>(statement))
+		{
+			const VariableDeclaration& variable = local->variable_declaration;
+			values[&variable] = variable.initialisation ? lower(variable.initialisation.get()) : emit(OpCode::EMPTY, {}, 0);
+		}
+		else if(const Return* ret = dynamic_cast<const Return*>(statement))
+		{
+			emit(OpCode::RETURN, {lower(ret->value.get())}, 0);
+			return false;
+		}
+		else if(const AutoCall* auto_call = dynamic_cast<const AutoCall*>(statement))
+		{
+			const evaluation::Expansion* expansion = lowerer.interpreter ? lowerer.interpreter->find_expansion(*auto_call) : nullptr;
+
+			if(!expansion || !expansion->error.empty())
+			{
+				fail(ir_lowerer_error_messages::EXPANSION_FAILED, expansion ? expansion->error : auto_call->function_name);
+			}
+			else if(expansion->value.has_value() && std::holds_alternative<evaluation::AstHandle>(expansion->value.value()))
+			{
+				const ASTNode& node = lowerer.interpreter->get_node(std::get<evaluation::AstHandle>(expansion->value.value()));
+
+				if(const Expression* expression = dynamic_cast<const Expression*>(&node))
+				{
+					lower(expression);
+				}
+				else if(const Statement* expanded = dynamic_cast<const Statement*>(&node))
+				{
+					return lower_statement(expanded);
+				}
+			}
+			// A constant on its own does nothing
+		}
+
+		return true;
+	}
+
+	ValueId lower(const Expression* expression)
+	{
+		if(!expression) { return emit(OpCode::EMPTY, {}, 0); }
+
+		const evaluation::FoldedCalls::const_iterator folded = lowerer.folded_calls.find(expression);
+		if(folded != lowerer.folded_calls.end()) { return emit_constant(folded->second); }
+
+		if(const LiteralNumberExpression* number = dynamic_cast<const LiteralNumberExpression*>(expression))
+		{
+			return emit_constant(evaluation::make_number_value(number->value));
+		}
+		if(const LiteralStringExpression* string = dynamic_cast<const LiteralStringExpression*>(expression))
+		{
+			return emit_constant(string->value);
+		}
+		if(const LiteralBooleanExpression* boolean = dynamic_cast<const LiteralBooleanExpression*>(expression))
+		{
+			return emit_constant(boolean->value);
+		}
+		if(dynamic_cast<const OptEmpty*>(expression))
+		{
+			return emit(OpCode::EMPTY, {}, 0);
+		}
+		if(const SimpleRead* read = dynamic_cast<const SimpleRead*>(expression))
+		{
+			return lower_read(*read);
+		}
+		if(const Assignment* assignment = dynamic_cast<const Assignment*>(expression))
+		{
+			return lower_assignment(*assignment);
+		}
+		if(const FunctionCall* function_call = dynamic_cast<const FunctionCall*>(expression))
+		{
+			return lower_call(*function_call);
+		}
+		if(const ObjectFunctionCall* object_call = dynamic_cast<const ObjectFunctionCall*>(expression))
+		{
+			return lower_member_call(*object_call);
+		}
+		if(const ObjectRead* object_read = dynamic_cast<const ObjectRead*>(expression))
+		{
+			const ValueId object = lower(object_read->object.get());
+			const std::optional<uint32_t> field = find_field_index(object_read->object.get(), object_read->member_name);
+
+			if(!field.has_value()) { return fail(ir_lowerer_error_messages::UNRESOLVED_MEMBER, object_read->member_name); }
+
+			return emit(OpCode::GET_FIELD, {object}, field.value());
+		}
+		if(const OperatorCallExpression* operator_call = dynamic_cast<const OperatorCallExpression*>(expression))
+		{
+			const std::vector<ValueId> arguments = lower_arguments(operator_call->arguments);
+			const OperatorFunction* operator_function = evaluation::find_operator_function(lowerer.operator_functions, *operator_call);
+
+			if(!operator_function) { return fail(ir_lowerer_error_messages::NO_OPERATOR_FUNCTION); }
+
+			return emit(OpCode::CALL, arguments, lowerer.function_ids.at(operator_function));
+		}
+		if(const OptFunctionCall* opt_call = dynamic_cast<const OptFunctionCall*>(expression))
+		{
+			lower_arguments(opt_call->arguments);
+			return fail(ir_lowerer_error_messages::UNSUPPORTED, "opt:" + opt_call->function_name);
+		}
+
+		return fail(ir_lowerer_error_messages::UNSUPPORTED, "expression");
+	}
+
+	ValueId lower_read(const SimpleRead& read)
+	{
+		if(const VariableDeclaration* variable = find_variable(lowerer.resolution, &read))
+		{
+			const std::unordered_map<const VariableDeclaration*, ValueId>::const_iterator value = values.find(variable);
+
+			// e.g. in the expansion of an `auto:` call
+			if(value == values.end()) { return fail(ir_lowerer_error_messages::UNSUPPORTED, "variable of another body " + read.reference_name); }
+
+			return value->second;
+		}
+
+		if(read.declaration == UNRESOLVED_DECLARATION) { return fail(ir_lowerer_error_messages::UNRESOLVED_READ, read.reference_name); }
+
+		const Declaration& declaration = lowerer.resolution.get_declaration(read.declaration);
+
+		if(declaration.kind == DeclarationKind::FIELD && self.has_value())
+		{
+			const std::unordered_map<const Field*, uint32_t>::const_iterator field =
+				lowerer.field_indices.find(static_cast<const Field*>(declaration.nodes.front()));
+
+			if(field != lowerer.field_indices.end()) { return emit(OpCode::GET_FIELD, {self.value()}, field->second); }
+		}
+
+		return fail(ir_lowerer_error_messages::UNSUPPORTED, read.reference_name);
+	}
+
+	ValueId lower_assignment(const Assignment& assignment)
+	{
+		if(const VariableDeclaration* target = find_variable(lowerer.resolution, assignment.target.get()))
+		{
+			const ValueId value = lower(assignment.value.get());
+
+			if(!values.contains(target)) { return fail(ir_lowerer_error_messages::NOT_ASSIGNABLE); }
+
+			values[target] = value;
+			return value;
+		}
+
+		if(const ObjectRead* field_target = dynamic_cast<const ObjectRead*>(assignment.target.get()))
+		{
+			const ValueId object = lower(field_target->object.get());
+			const std::optional<uint32_t> field = find_field_index(field_target->object.get(), field_target->member_name);
+			const ValueId value = lower(assignment.value.get());
+
+			if(!field.has_value()) { return fail(ir_lowerer_error_messages::UNRESOLVED_MEMBER, field_target->member_name); }
+
+			emit(OpCode::SET_FIELD, {object, value}, field.value());
+			return value;
+		}
+
+		lower(assignment.value.get());
+		return fail(ir_lowerer_error_messages::NOT_ASSIGNABLE);
+	}
+
+	std::vector<ValueId> lower_arguments(const std::vector<std::unique_ptr<Expression>>& arguments)
+	{
+		std::vector<ValueId> lowered;
+		lowered.reserve(arguments.size());
+
+		for(const std::unique_ptr<Expression>& argument : arguments)
+		{
+			lowered.push_back(lower(argument.get()));
+		}
+
+		return lowered;
+	}
+
+	/** Calls the function of `node`, or fails if it has no body */
+	ValueId call(const ASTNode& node, const std::vector<ValueId>& arguments, const std::string& name)
+	{
+		const std::unordered_map<const ASTNode*, FunctionId>::const_iterator id = lowerer.function_ids.find(&node);
+
+		if(id == lowerer.function_ids.end()) { return fail(ir_lowerer_error_messages::NOT_IMPLEMENTED, name); }
+
+		return emit(OpCode::CALL, arguments, id->second);
+	}
+
+	ValueId lower_call(const FunctionCall& function_call)
+	{
+		std::vector<ValueId> arguments = lower_arguments(function_call.arguments);
+
+		if(function_call.declaration == UNRESOLVED_DECLARATION)
+		{
+			if(function_call.function_name == PRINT_FUNCTION && arguments.size() == 1)
+			{
+				return emit(OpCode::CALL_RUNTIME, arguments, add_string(std::string{PRINT_FUNCTION}));
+			}
+
+			return fail(ir_lowerer_error_messages::UNRESOLVED_CALL, function_call.function_name);
+		}
+
+		const Declaration& declaration = lowerer.resolution.get_declaration(function_call.declaration);
+
+		switch(declaration.kind)
+		{
+			case DeclarationKind::TYPE:
+			{
+				// Constructors are not declared yet, so the arguments are not stored
+				return emit(OpCode::ALLOCATE, {}, lowerer.field_counts.at(static_cast<const Type*>(declaration.nodes.front())));
+			}
+			case DeclarationKind::ENTRYPOINT:
+			case DeclarationKind::METHOD:
+			case DeclarationKind::PURE_FUNCTION:
+			{
+				const ASTNode* callee = find_overload(lowerer.resolution, function_call.declaration, arguments.size());
+
+				if(!callee) { return fail(ir_lowerer_error_messages::NO_UNIQUE_OVERLOAD, declaration.name); }
+
+				if(declaration.kind == DeclarationKind::METHOD)
+				{
+					if(!self.has_value()) { return fail(ir_lowerer_error_messages::NOT_CALLABLE, declaration.name); }
+
+					arguments.insert(arguments.begin(), self.value());
+				}
+
+				return call(*callee, arguments, declaration.name);
+			}
+			default:
+			{
+				return fail(ir_lowerer_error_messages::NOT_CALLABLE, declaration.name);
+			}
+		}
+	}
+
+	ValueId lower_member_call(const ObjectFunctionCall& object_call)
+	{
+		const bool on_variable = find_variable(lowerer.resolution, object_call.object.get()) != nullptr;
+		const DeclarationId member = find_member(lowerer.resolution, object_call);
+		const ValueId object = lower(object_call.object.get());
+		std::vector<ValueId> arguments = lower_arguments(object_call.arguments);
+
+		if(member == UNRESOLVED_DECLARATION) { return fail(ir_lowerer_error_messages::UNRESOLVED_MEMBER, object_call.member_name); }
+
+		const Declaration& declaration = lowerer.resolution.get_declaration(member);
+		const ASTNode* callee = find_overload(lowerer.resolution, member, arguments.size());
+
+		if(!callee) { return fail(ir_lowerer_error_messages::NO_UNIQUE_OVERLOAD, declaration.name); }
+
+		if(declaration.kind == DeclarationKind::METHOD)
+		{
+			if(!on_variable) { return fail(ir_lowerer_error_messages::NOT_CALLABLE, declaration.name); }
+
+			arguments.insert(arguments.begin(), object);
+		}
+
+		return call(*callee, arguments, declaration.name);
+	}
+
+	/** Index of the field `member` of the variable `object` */
+	std::optional<uint32_t> find_field_index(const Expression* object, const std::string& member) const
+	{
+		const VariableDeclaration* variable = find_variable(lowerer.resolution, object);
+		if(!variable || variable->reference_type.declaration == UNRESOLVED_DECLARATION) { return std::nullopt; }
+
+		const Scope* member_scope = lowerer.resolution.get_member_scope(lowerer.resolution.get_declaration(variable->reference_type.declaration).name);
+		if(!member_scope) { return std::nullopt; }
+
+		const std::optional<DeclarationId> field = member_scope->find(member);
+		if(!field.has_value()) { return std::nullopt; }
+
+		const Declaration& declaration = lowerer.resolution.get_declaration(field.value());
+		if(declaration.kind != DeclarationKind::FIELD) { return std::nullopt; }
+
+		const std::unordered_map<const Field*, uint32_t>::const_iterator it =
+			lowerer.field_indices.find(static_cast<const Field*>(declaration.nodes.front()));
+
+		if(it == lowerer.field_indices.end()) { return std::nullopt; }
+
+		return it->second;
+	}
+};
+
+IrLowerer::IrLowerer
+(
+	const Resolution& init_resolution,
+	const evaluation::FoldedCalls& init_folded_calls,
+	const evaluation::CompileFunctionInterpreter* init_interpreter,
+	concurrency::WorkStealingPool& init_pool
+) :
+	resolution{init_resolution},
+	folded_calls{init_folded_calls},
+	interpreter{init_interpreter},
+	pool{init_pool}
+{}
+
+Module IrLowerer::run(const Root& root)
+{
+	const trace::Span span{"IrLowerer::run"};
+
+	Module module;
+	collect_functions(root, module);
+	operator_functions = evaluation::PureEvaluator::find_operator_functions(resolution);
+
+	pool.run(module.functions.size(), [&] (std::size_t i)
+	{
+		BodyLowerer{*this, module.functions[i]}.lower(sources[i]);
+	});
+
+	return module;
+}
+
+void IrLowerer::collect_functions(const Root& root, Module& module)
+{
+	function_ids.clear();
+	sources.clear();
+	field_indices.clear();
+	field_counts.clear();
+
+	for(const std::string& identifier : get_sorted_names(root.package_members))
+	{
+		collect_package_member(identifier, *root.package_members.at(identifier), module);
+	}
+}
+
+void IrLowerer::collect_package_member(const std::string& identifier, const PackageMember& package_member, Module& module)
+{
+	if(const Entrypoint* entrypoint = dynamic_cast<const Entrypoint*>(&package_member))
+	{
+		add_function(*entrypoint, identifier, get_parameters(entrypoint->parameters), &entrypoint->body, false, module);
+	}
+	else if(const Type* type = dynamic_cast<const Type*>(&package_member))
+	{
+		const std::vector<std::string> field_names = get_sorted_names(type->fields);
+		for(std::size_t i = 0; i < field_names.size(); ++i)
+		{
+			field_indices.emplace(&type->fields.at(field_names[i]), static_cast<uint32_t>(i));
+		}
+		field_counts.emplace(type, static_cast<uint32_t>(field_names.size()));
+
+		for(const std::string& name : get_sorted_names(type->methods))
+		{
+			const std::vector<Method>& overloads = type->methods.at(name);
+
+			for(std::size_t i = 0; i < overloads.size(); ++i)
+			{
+				const Method& method = overloads[i];
+				add_function(method, identifier + "::" + name + "#" + std::to_string(i), get_parameters(method.parameters),
+					method.implementation.has_value() ? &method.implementation.value() : nullptr, true, module);
+			}
+		}
+
+		collect_pure_functions(type->pure_functions, identifier, module);
+	}
+	else if(const PureFunctionSet* pure_function_set = dynamic_cast<const PureFunctionSet*>(&package_member))
+	{
+		collect_pure_functions(pure_function_set->methods, identifier, module);
+	}
+	else if(const OperatorModule* operator_module = dynamic_cast<const OperatorModule*>(&package_member))
+	{
+		for(std::size_t i = 0; i < operator_module->functions.size(); ++i)
+		{
+			const OperatorFunction& operator_function = operator_module->functions[i];
+
+			std::vector<const VariableDeclaration*> parameters;
+			for(const OperatorFunctionPatternElement& element : operator_function.pattern)
+			{
+				if(const OperatorFunctionParameter* parameter = std::get_if<OperatorFunctionParameter>(&element))
+				{
+					parameters.push_back(&parameter->parameter);
+				}
+			}
+
+			add_function(operator_function, identifier + "::operator#" + std::to_string(i), parameters, &operator_function.body, false, module);
+		}
+	}
+	// Compile functions run in the compiler, so they are not lowered
+}
+
+void IrLowerer::collect_pure_functions
+(
+	const std::unordered_map<std::string, std::vector<PureFunction>>& pure_functions,
+	const std::string& prefix,
+	Module& module
+)
+{
+	for(const std::string& name : get_sorted_names(pure_functions))
+	{
+		const std::vector<PureFunction>& overloads = pure_functions.at(name);
+
+		for(std::size_t i = 0; i < overloads.size(); ++i)
+		{
+			const PureFunction& pure_function = overloads[i];
+			add_function(pure_function, prefix + "::" + name + "#" + std::to_string(i), get_parameters(pure_function.parameters),
+				pure_function.implementation.has_value() ? &pure_function.implementation.value() : nullptr, false, module);
+		}
+	}
+}
+
+void IrLowerer::add_function
+(
+	const ASTNode& node,
+	std::string name,
+	std::vector<const VariableDeclaration*> parameters,
+	const CodeBlock* body,
+	bool has_self,
+	Module& module
+)
+{
+	// Calls to functions without body fail where they are lowered
+	if(!body) { return; }
+
+	function_ids.emplace(&node, static_cast<FunctionId>(module.functions.size()));
+	sources.push_back(Source{std::move(parameters), body, has_self});
+
+	Function& function = module.functions.emplace_back();
+	function.name = std::move(name);
+}
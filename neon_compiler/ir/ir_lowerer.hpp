@@ -0,0 +1,117 @@
+#ifndef IR_LOWERER_HPP
+#define IR_LOWERER_HPP
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "ir.hpp"
+#include "../ast/nodes/nodes.hpp"
+#include "../ast/nodes/statement_nodes.hpp"
+#include "../evaluation/compile_function_interpreter.hpp"
+#include "../evaluation/pure_evaluator.hpp"
+#include "../resolution/resolution.hpp"
+#include "../../concurrency/work_stealing_pool.hpp"
+
+namespace neon_compiler::ir
+{
+
+/** Messages of the `FAIL` instructions lowered for what has no instructions */
+namespace ir_lowerer_error_messages
+{
+	constexpr std::string_view UNRESOLVED_CALL =
+		"Unresolved call: ";
+	constexpr std::string_view UNRESOLVED_READ =
+		"Unresolved read: ";
+	constexpr std::string_view UNRESOLVED_MEMBER =
+		"Unresolved member: ";
+	constexpr std::string_view NO_UNIQUE_OVERLOAD =
+		"No unique overload takes this number of arguments: ";
+	constexpr std::string_view NOT_IMPLEMENTED =
+		"Not implemented: ";
+	constexpr std::string_view NOT_CALLABLE =
+		"Not callable: ";
+	constexpr std::string_view NOT_ASSIGNABLE =
+		"Not assignable";
+	constexpr std::string_view NO_OPERATOR_FUNCTION =
+		"No unique operator function implements this operator";
+	constexpr std::string_view EXPANSION_FAILED =
+		"auto: call could not be expanded: ";
+	constexpr std::string_view UNSUPPORTED =
+		"Not supported by the IR yet: ";
+}
+
+/** Lowers the implemented entrypoints, methods, pure functions and operator functions of an AST to a `Module`.
+ * Parameters and local variables are not stored anywhere: each name stands for the value last assigned to it,
+ * so every assignment to a variable only changes which value later reads use.
+ * Calls folded at compile time (see `evaluation::PureEvaluator`) and expanded `auto:` calls are replaced by their values,
+ * and what cannot be lowered (e.g. unresolved names) becomes a `FAIL` instruction.
+ *
+ * Functions are numbered in the order of the identifiers of their package members, then of their names and overloads,
+ * and their bodies are lowered in parallel. Only reads the AST and the analyses, which must outlive the lowerer. */
+class IrLowerer
+{
+public:
+	IrLowerer
+	(
+		const neon_compiler::resolution::Resolution& init_resolution,
+		const neon_compiler::evaluation::FoldedCalls& init_folded_calls,
+		const neon_compiler::evaluation::CompileFunctionInterpreter* init_interpreter,
+		concurrency::WorkStealingPool& init_pool
+	);
+
+	Module run(const neon_compiler::ast::nodes::Root& root);
+
+private:
+	/** Function to lower */
+	struct Source
+	{
+		std::vector<const neon_compiler::ast::nodes::VariableDeclaration*> parameters;
+		const neon_compiler::ast::nodes::CodeBlock* body;
+		/** Whether it is a method, whose object is parameter 0 */
+		bool has_self;
+	};
+
+	class BodyLowerer;
+
+	const neon_compiler::resolution::Resolution& resolution;
+	const neon_compiler::evaluation::FoldedCalls& folded_calls;
+	const neon_compiler::evaluation::CompileFunctionInterpreter* interpreter;
+	concurrency::WorkStealingPool& pool;
+
+	std::unordered_map<const neon_compiler::ast::ASTNode*, FunctionId> function_ids;
+	/** By `FunctionId` */
+	std::vector<Source> sources;
+	std::unordered_map<const neon_compiler::ast::nodes::Field*, uint32_t> field_indices;
+	std::unordered_map<const neon_compiler::ast::nodes::Type*, uint32_t> field_counts;
+	neon_compiler::evaluation::OperatorFunctions operator_functions;
+
+	/** Numbers the functions and fields, before the bodies are lowered in parallel */
+	void collect_functions(const neon_compiler::ast::nodes::Root& root, Module& module);
+	void collect_package_member
+	(
+		const std::string& identifier,
+		const neon_compiler::ast::nodes::PackageMember& package_member,
+		Module& module
+	);
+	void collect_pure_functions
+	(
+		const std::unordered_map<std::string, std::vector<neon_compiler::ast::nodes::PureFunction>>& pure_functions,
+		const std::string& prefix,
+		Module& module
+	);
+	void add_function
+	(
+		const neon_compiler::ast::ASTNode& node,
+		std::string name,
+		std::vector<const neon_compiler::ast::nodes::VariableDeclaration*> parameters,
+		const neon_compiler::ast::nodes::CodeBlock* body,
+		bool has_self,
+		Module& module
+	);
+};
+
+}
+
+#endif // IR_LOWERER_HPP
@@ -0,0 +1,27 @@
+#include "pass_manager.hpp"
+
+#include "../trace/trace.hpp"
+
+using namespace neon_compiler::ir;
+
+PassManager::PassManager(concurrency::WorkStealingPool& init_pool)
+	: pool{init_pool} {}
+
+void PassManager::add_pass(std::unique_ptr<FunctionPass> pass)
+{
+	passes.push_back(std::move(pass));
+}
+
+void PassManager::run(Module& module) const
+{
+	const trace::Span span{"PassManager::run"};
+
+	pool.run(module.functions.size(), [&] (std::size_t i)
+	{
+		for(const std::unique_ptr<FunctionPass>& pass : passes)
+		{
+			const trace::Span pass_span{pass->get_name()};
+			pass->run(module.functions[i]);
+		}
+	});
+}
@@ -0,0 +1,43 @@
+#ifndef PASS_MANAGER_HPP
+#define PASS_MANAGER_HPP
+
+#include <memory>
+#include <string_view>
+#include <vector>
+#include "ir.hpp"
+#include "../../concurrency/work_stealing_pool.hpp"
+
+namespace neon_compiler::ir
+{
+
+/** Transformation of one function at a time */
+class FunctionPass
+{
+public:
+	virtual ~FunctionPass() = default;
+
+	/** Name of the trace span of the pass; string literals are expected */
+	virtual std::string_view get_name() const = 0;
+	/** Called for several functions at the same time, so it must not change state shared between calls */
+	virtual void run(Function& function) const = 0;
+};
+
+/** Runs a pipeline of passes on every function of a module. Functions are independent of each other
+ * (see `Function`), so each function goes through the whole pipeline as one task on the pool. */
+class PassManager
+{
+public:
+	explicit PassManager(concurrency::WorkStealingPool& init_pool);
+
+	/** Adds `pass` at the end of the pipeline */
+	void add_pass(std::unique_ptr<FunctionPass> pass);
+	void run(Module& module) const;
+
+private:
+	concurrency::WorkStealingPool& pool;
+	std::vector<std::unique_ptr<FunctionPass>> passes;
+};
+
+}
+
+#endif // PASS_MANAGER_HPP
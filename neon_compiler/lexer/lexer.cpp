@@ -1,5 +1,7 @@
 #include "lexer.hpp"
 
+#include "../trace/trace.hpp"
+
 using namespace neon_compiler::lexer;
 
 Lexer::Lexer(std::unique_ptr<reading::CharReader> init_reader)
@@ -7,6 +9,8 @@ Lexer::Lexer(std::unique_ptr<reading::CharReader> init_reader)
 
 void Lexer::run()
 {
+	const trace::Span span{"Lexer::run"};
+
 	while(!reader->end_of_file_reached())
 	{
 		skip_whitespace();
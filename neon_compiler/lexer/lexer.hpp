@@ -1,6 +1,7 @@
 #ifndef TOKENISER_HPP
 #define TOKENISER_HPP
 
+#include <array>
 #include <optional>
 #include <vector>
 #include "../../reading/char_reader.hpp"
@@ -37,8 +38,28 @@ namespace error_messages
 			"binary number notation (prefix `0b`) uses digits 0 and 1.";
 	constexpr std::string_view DECIMAL_POINT_IN_NON_DECIMAL_LITERAL =
 			"Decimal point in non decimal literal. Only base 10 number literals can have a decimal point.";
+
+	/** All messages, so errors can be stored by index (e.g. in the token cache). Only append to this list. */
+	constexpr std::array<std::string_view, 11> ALL
+	{
+		UNKNOWN_ESCAPE_SEQUENCE,
+		UNTERMINATED_STRING_LITERAL,
+		UNTERMINATED_CHARACTER_LITERAL,
+		NEWLINE_IN_STRING_LITERAL,
+		NEWLINE_IN_CHARACTER_LITERAL,
+		EMPTY_CHARACTER_LITERAL,
+		CHARACTER_LITERAL_TOO_LONG,
+		MULTIPLE_DECIMAL_POINTS_IN_NUMBER_LITERAL,
+		NUMBER_BASE_PREFIX_WITHOUT_DIGITS,
+		ILLEGAL_DIGITS_IN_NUMBER_LITERAL,
+		DECIMAL_POINT_IN_NON_DECIMAL_LITERAL
+	};
 }
 
+/** Version of the tokenisation rules. Increase it whenever the lexer produces different tokens or errors
+ * for the same input, so cached token streams from older versions are not used. */
+constexpr uint32_t LEXER_VERSION = 1;
+
 enum class NumberNotation
 {
 	BINARY,
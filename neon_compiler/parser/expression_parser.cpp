@@ -150,10 +150,12 @@ std::unique_ptr<Expression> ExpressionParser::parse_expression(PeekCursor peek_c
 
 	FuncParseExpressionWCursor func_parse_expression_w_cursor = [this] (uint peek_offset, uint expression_max_subordination)
 	{
-		parse_expression(&peek_offset, expression_max_subordination);
-		return peek_offset;
+		return parse_expression_speculatively(peek_offset, expression_max_subordination);
 	};
 
+	const reading::SourcePosition source_position = peek_w_peek_cursor(peek_cursor).get_source_position();
+	const bool parenthesised = peek_w_peek_cursor(peek_cursor).get_type() == TokenType::BRACKET_ROUND_OPEN;
+
 	std::unique_ptr<Expression> left = parse_prefix_expression(peek_cursor, func_parse_expression_w_cursor);
 
 	if(!left)
@@ -162,6 +164,10 @@ std::unique_ptr<Expression> ExpressionParser::parse_expression(PeekCursor peek_c
 		return nullptr;
 	}
 
+	// Set before the loop too, as `left` may become the first argument of an operator call.
+	// A parenthesised expression keeps its own position, that of its first token within the brackets.
+	if(!parenthesised) { left->source_position = source_position; }
+
 	while(true)
 	{
 		std::shared_ptr<const Operator> op = operator_table->match_infix(*reader, peek_cursor, func_parse_expression_w_cursor);
@@ -173,11 +179,31 @@ std::unique_ptr<Expression> ExpressionParser::parse_expression(PeekCursor peek_c
 		if(op->get_declaration()->subordination > max_subordination) { break; }
 
 		left = parse_operator_call_expression(peek_cursor, op, std::move(left));
+
+		if(left) { left->source_position = source_position; }
 	}
 
 	return left;
 }
 
+uint ExpressionParser::parse_expression_speculatively(uint peek_offset, uint max_subordination)
+{
+	// The reader does not move during a speculative parse, but may between them, so positions are kept from the file start.
+	const uint position = reader->get_position();
+	const uint64_t key = (static_cast<uint64_t>(position + peek_offset) << 32) | max_subordination;
+
+	const std::unordered_map<uint64_t, uint>::const_iterator it = speculative_parse_ends.find(key);
+	if(it != speculative_parse_ends.end())
+	{
+		return it->second - position;
+	}
+
+	parse_expression(&peek_offset, max_subordination);
+	speculative_parse_ends.emplace(key, position + peek_offset);
+
+	return peek_offset;
+}
+
 std::unique_ptr<Expression> ExpressionParser::parse_prefix_expression(PeekCursor peek_cursor, FuncParseExpressionWCursor func_parse_expression_w_cursor)
 {
 	{
@@ -369,7 +395,7 @@ std::unique_ptr<Expression> ExpressionParser::parse_operator_call_expression
 
 		if(!argument)
 		{
-			logger->info("Operator call expression failed to parse argument. (pattern element index: " + std::to_string(i) + ")");
+			logger->info("Operator call expression failed to parse argument. (pattern element index: ", i, ")");
 			return nullptr;
 		}
 
@@ -1,6 +1,8 @@
 #ifndef EXPRESSION_PARSER_HPP
 #define EXPRESSION_PARSER_HPP
 
+#include <cstdint>
+#include <unordered_map>
 #include "operator_table.hpp"
 #include "../ast/nodes/statement_nodes.hpp"
 #include "../analysis/analysis_entry.hpp"
@@ -71,6 +73,12 @@ private:
 	neon_compiler::TokenReader* reader;
 	FuncReportToken* func_report_token;
 	neon_compiler::parser::OperatorTable* operator_table;
+	/**
+	 * End positions of the speculative parses done to match operators, by start position and maximum subordination.
+	 * Matching parses the arguments of every candidate operator ahead, which nests, so without reuse nested operator
+	 * calls take exponential time.
+	 */
+	std::unordered_map<uint64_t, uint> speculative_parse_ends;
 
 	const neon_compiler::Token& peek_w_peek_cursor(PeekCursor peek_cursor, uint offset = 0);
 	const neon_compiler::Token& consume_w_peek_cursor(PeekCursor peek_cursor, uint offset = 0);
@@ -81,6 +89,7 @@ private:
 		PeekCursor peek_cursor = nullptr,
 		std::optional<std::string> info = std::nullopt
 	);
+	uint parse_expression_speculatively(uint peek_offset, uint max_subordination);
 	std::unique_ptr<neon_compiler::ast::nodes::Expression> parse_prefix_expression(PeekCursor peek_cursor, FuncParseExpressionWCursor func_parse_expression_w_cursor);
 	std::unique_ptr<neon_compiler::ast::nodes::Expression> parse_terminating_expression(PeekCursor peek_cursor);
 	std::unique_ptr<neon_compiler::ast::nodes::Expression> parse_parenthesised_expression(PeekCursor peek_cursor);
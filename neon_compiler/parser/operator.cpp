@@ -2,6 +2,7 @@
 
 #include <stdexcept>
 #include "../token_reader.hpp"
+#include "../stats/operator_profiler.hpp"
 #include <iostream>
 
 using namespace neon_compiler;
@@ -121,7 +122,15 @@ bool Operator::matches
 		{
 			uint max_subordination = declaration->subordination - 1;
 			if(i == pattern.size() - 1 && declaration->associativity == OperatorAssociativity::RIGHT) { ++max_subordination; }
+			const uint parse_start = peek_offset;
 			peek_offset = func_parse_expression_w_cursor(peek_offset, max_subordination);
+
+			if(stats::operator_profiler::is_enabled())
+			{
+				stats::OperatorProfile& profile = stats::operator_profiler::get_thread_profile(declaration);
+				++profile.speculative_parses;
+				profile.speculative_tokens += peek_offset - parse_start;
+			}
 			continue;
 		}
 
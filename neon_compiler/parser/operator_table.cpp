@@ -2,6 +2,9 @@
 
 #include <stdexcept>
 #include <algorithm>
+#include "../stats/counters.hpp"
+#include "../stats/operator_profiler.hpp"
+#include "../trace/trace.hpp"
 
 using namespace neon_compiler;
 using namespace neon_compiler::parser;
@@ -88,6 +91,8 @@ std::shared_ptr<const Operator> OperatorTable::match_postfix
 
 void OperatorTable::finalise()
 {
+	const trace::Span span{"OperatorTable::finalise"};
+
 	sort_operator_list(prefix_operators);
 	sort_operator_list(infix_operators);
 	sort_operator_list(postfix_operators);
@@ -124,8 +129,17 @@ std::shared_ptr<const Operator> OperatorTable::match
 
 	for(std::size_t i = 0; i < operators.size(); ++i)
 	{
+		++stats::thread_counters.operator_match_attempts;
+
+		stats::OperatorProfile* profile = stats::operator_profiler::is_enabled() ?
+			&stats::operator_profiler::get_thread_profile(operators[i]->get_declaration()) : nullptr;
+
+		if(profile) { ++profile->attempts; }
+
 		if(operators[i]->matches(reader, peek_cursor, func_parse_expression_w_cursor, skip_first))
 		{
+			if(profile) { ++profile->matches; }
+
 			return operators[i];
 		}
 	}
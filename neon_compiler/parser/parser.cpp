@@ -1,5 +1,7 @@
 #include "parser.hpp"
 
+#include "../trace/trace.hpp"
+
 using namespace neon_compiler;
 using namespace neon_compiler::parser;
 using namespace neon_compiler::analysis;
@@ -24,6 +26,9 @@ Parser::Parser
 
 void Parser::run_a()
 {
+	trace::Span span{"Parser::run_a"};
+	if(span.is_recording()) { span.set_detail(std::string{file}); }
+
 	parse_and_register_expected_package_declaration();
 
 	while(!reader.end_of_file_reached())
@@ -62,6 +67,9 @@ void Parser::run_a()
 
 void Parser::run_b(std::shared_ptr<OperatorTable> operator_table)
 {
+	trace::Span span{"Parser::run_b"};
+	if(span.is_recording()) { span.set_detail(std::string{file}); }
+
 	skip_until_statement_end();
 
 	while(!reader.end_of_file_reached())
@@ -86,11 +94,31 @@ void Parser::run_b(std::shared_ptr<OperatorTable> operator_table)
 	}
 }
 
+void Parser::restore_a(neon_compiler::ast::Identifier cached_package)
+{
+	package = std::move(cached_package);
+}
+
 std::shared_ptr<neon_compiler::ast::nodes::Root> Parser::get_root_node() const
 {
 	return root_node;
 }
 
+const neon_compiler::ast::Identifier& Parser::get_package() const
+{
+	return package;
+}
+
+const std::vector<std::string>& Parser::get_used_operator_modules() const
+{
+	return used_operator_modules;
+}
+
+const std::vector<std::string>& Parser::get_imported_package_members() const
+{
+	return imported_package_members;
+}
+
 void Parser::skip_until_statement_end()
 {
 	while(!reader.end_of_file_reached())
@@ -115,15 +143,18 @@ void Parser::skip_until_block_start()
 
 void Parser::skip_until_block_end()
 {
+	// Counts the depth instead of recursing, so that deeply nested blocks cannot overflow the stack
+	std::size_t depth{1};
+
 	while(!reader.end_of_file_reached())
 	{
 		const TokenType token_type = reader.consume().get_type();
 
 		if(token_type == TokenType::BRACKET_CURLY_OPEN)
 		{
-			skip_until_block_end();
+			++depth;
 		}
-		else if(token_type == TokenType::BRACKET_CURLY_CLOSE)
+		else if(token_type == TokenType::BRACKET_CURLY_CLOSE && --depth == 0)
 		{
 			return;
 		}
@@ -138,9 +169,36 @@ void Parser::report_token
 	std::optional<std::string> info
 )
 {
+	if(type == AnalysisEntryType::REFERENCE && info.has_value())
+	{
+		info = resolve_reference(info.value(), false);
+	}
+
 	analysis_reporter->report(AnalysisEntry{file, type, severity, token.get_source_position(), token.get_length(), info});
 }
 
+std::string Parser::get_trace_location() const
+{
+	return std::string{file} + ":" + std::to_string(reader.peek().get_source_position().newlines_count + 1);
+}
+
+std::string Parser::resolve_reference(const std::string& reference, bool package_member) const
+{
+	std::unordered_map<std::string, std::string>::const_iterator it = imports.find(reference);
+
+	if(it != imports.end())
+	{
+		return it->second;
+	}
+
+	if(package_member && reference.find("::") == std::string::npos)
+	{
+		return package.to_string() + "::" + reference;
+	}
+
+	return reference;
+}
+
 std::string Parser::append_ast(std::unique_ptr<PackageMember> node, const std::string& identifier)
 {
 	std::string full_identifier{package.to_string() + "::" + identifier};
@@ -148,7 +206,7 @@ std::string Parser::append_ast(std::unique_ptr<PackageMember> node, const std::s
 	root_node->file_package_members[std::string{file}].push_back(full_identifier);
 	root_node->package_members[full_identifier] = std::move(node);
 
-	logger->info("Appended to AST: " + full_identifier);
+	logger->info("Appended to AST: ", full_identifier);
 
 	return full_identifier;
 }
@@ -197,23 +255,14 @@ const std::vector<std::shared_ptr<const Operator>>* Parser::parse_use_statement(
 
 	const neon_compiler::ast::Identifier& id = opt_id.value();
 
-	std::string id_str = id.to_string();
+	// `use` always names an operator module, which may not have been declared yet
+	const std::string id_str = resolve_reference(id.to_string(), true);
 
-	if(id.parts.size() == 1)
-	{
-		if(imports.contains(id_str))
-		{
-			id_str = imports[id_str];
-		}
-		else
-		{
-			id_str = package.to_string() + "::" + id_str;
-		}
-	}
+	used_operator_modules.push_back(id_str);
 
 	if(!operator_map->contains(id_str))
 	{
-		logger->info("Could not find operators: " + id_str);
+		logger->info("Could not find operators: ", id_str);
 		return nullptr;
 	}
 
@@ -292,6 +341,7 @@ void Parser::parse_and_register_import_statement()
 	const neon_compiler::ast::Identifier& id = opt_id.value();
 
 	imports[id.parts[id.parts.size() - 1]] = id.to_string();
+	imported_package_members.push_back(id.to_string());
 }
 
 Access Parser::parse_access()
@@ -398,6 +448,9 @@ PackageMemberPattern Parser::parse_package_member_pattern()
 
 void Parser::parse_expected_package_member(const Access& access, std::shared_ptr<OperatorTable> operator_table)
 {
+	trace::Span span{"Parser::parse_package_member"};
+	if(span.is_recording()) { span.set_detail(get_trace_location()); }
+
 	if(reader.peek().get_type() == TokenType::PACKAGE_MEMBER_ENTRYPOINT)
 	{
 		report_token(AnalysisEntryType::KEYWORD, AnalysisSeverity::INFO, reader.consume());
@@ -441,7 +494,7 @@ std::string Parser::parse_expected_declaration_name(AnalysisEntryType analysis_e
 	if(reader.peek().get_type() == TokenType::IDENTIFIER)
 	{
 		std::string name{reader.peek().get_lexeme().value()};
-		report_token(analysis_entry_type, AnalysisSeverity::INFO, reader.consume(), name);
+		report_token(analysis_entry_type, AnalysisSeverity::INFO, reader.consume(), package.to_string() + "::" + name);
 		return name;
 	}
 	else
@@ -479,6 +532,9 @@ void Parser::parse_and_register_expected_entrypoint(const Access& access, std::s
 
 void Parser::parse_expected_operator_module_a_and_register(const Access& access)
 {
+	trace::Span span{"Parser::parse_operator_module_a"};
+	if(span.is_recording()) { span.set_detail(get_trace_location()); }
+
 	const std::string name = parse_expected_declaration_name(AnalysisEntryType::DECLARATION);
 
 	if(reader.peek().get_type() == TokenType::BRACKET_CURLY_OPEN)
@@ -542,7 +598,7 @@ void Parser::parse_expected_operator_module_a_and_register(const Access& access)
 		}
 		catch(const std::invalid_argument& e)
 		{
-			logger->info("Invalid operator: " + std::string{e.what()});
+			logger->info("Invalid operator: ", e.what());
 		}
 	}
 
@@ -591,7 +647,7 @@ void Parser::parse_expected_operator_module_b(std::shared_ptr<OperatorTable> ope
 
 	if(it == root_node->package_members.end())
 	{
-		logger->error("Could not complete operator module \"" + full_identifier + "\"; could not find by identifier.");
+		logger->error("Could not complete operator module \"", full_identifier, "\"; could not find by identifier.");
 		return;
 	}
 
@@ -609,6 +665,7 @@ void Parser::parse_expected_operator_module_b(std::shared_ptr<OperatorTable> ope
 OperatorDeclaration Parser::parse_expected_operator_declaration()
 {
 	// At this point, `operator` should be guaranteed.
+	const reading::SourcePosition source_position = reader.peek().get_source_position();
 	report_token(AnalysisEntryType::KEYWORD, AnalysisSeverity::INFO, reader.consume());
 
 	std::vector<OperatorSyntaxPatternElement> pattern;
@@ -711,7 +768,7 @@ OperatorDeclaration Parser::parse_expected_operator_declaration()
 
 	report_token(AnalysisEntryType::SEPARATOR, AnalysisSeverity::INFO, reader.consume()); // Consume `}`
 
-	return OperatorDeclaration{std::move(pattern), subordination, associativity, BuiltinOperatorKind::NOT_BUILT_IN};
+	return OperatorDeclaration{std::move(pattern), subordination, associativity, BuiltinOperatorKind::NOT_BUILT_IN, source_position};
 }
 
 OperatorFunction Parser::parse_expected_operator_function(std::shared_ptr<OperatorTable> operator_table)
@@ -19,6 +19,9 @@
 namespace neon_compiler::parser
 {
 
+/** Version of the parser output (AST and analysis entries). Increase when parsing the same tokens gives a different result. */
+constexpr uint32_t PARSER_VERSION = 3;
+
 namespace error_messages
 {
 	constexpr std::string_view UNEXPECTED_END_OF_FILE =
@@ -126,7 +129,15 @@ public:
 	/** Should be run second in the parsing phase to parse other package member types. */
 	void run_b(std::shared_ptr<neon_compiler::parser::OperatorTable> operator_table);
 
+	/** Replaces `run_a` when its results (the package and operator modules) have been restored from a cache. */
+	void restore_a(neon_compiler::ast::Identifier cached_package);
+
 	std::shared_ptr<neon_compiler::ast::nodes::Root> get_root_node() const;
+	const neon_compiler::ast::Identifier& get_package() const;
+	/** Identifiers of the operator modules referred to by `use` statements, including ones that could not be found */
+	const std::vector<std::string>& get_used_operator_modules() const;
+	/** Full identifiers of the package members imported by `import` statements */
+	const std::vector<std::string>& get_imported_package_members() const;
 private:
 	std::shared_ptr<logging::Logger> logger;
 	neon_compiler::TokenReader reader;
@@ -137,8 +148,10 @@ private:
 
 	/** Mapping from reference name to declaration path */
 	std::unordered_map<std::string, std::string> imports;
+	std::vector<std::string> imported_package_members;
 	/** Mapping from package member identifier to operator lists */
 	std::shared_ptr<OperatorMap> operator_map;
+	std::vector<std::string> used_operator_modules;
 
 	void skip_until_statement_end();
 	void skip_until_block_start();
@@ -151,6 +164,13 @@ private:
 		const neon_compiler::Token& token,
 		std::optional<std::string> info = std::nullopt
 	);
+	/** Resolves an imported name (e.g. `Widget` after `import main::subpkg::Widget;`) to its full identifier.
+	 * If `package_member` is true, any other name without package is qualified with the package of the file,
+	 * e.g. `Widget` becomes `main::Widget`. Other references are returned unchanged: whether they name a package member,
+	 * a local variable or e.g. a generic parameter is only known after name resolution. */
+	std::string resolve_reference(const std::string& reference, bool package_member) const;
+	/** `file:line` of the next token, as detail of trace spans */
+	std::string get_trace_location() const;
 
 	std::string append_ast(std::unique_ptr<neon_compiler::ast::nodes::PackageMember> node, const std::string& identifier);
 
@@ -180,6 +200,7 @@ private:
 		const neon_compiler::ast::nodes::Access& access,
 		std::shared_ptr<neon_compiler::parser::OperatorTable> operator_table
 	);
+	/** Parses the name of a package member. The name is reported with the full identifier as info. */
 	std::string parse_expected_declaration_name
 	(
 		neon_compiler::analysis::AnalysisEntryType analysis_entry_type
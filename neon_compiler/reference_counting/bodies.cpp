@@ -0,0 +1,147 @@
+#include "bodies.hpp"
+
+#include <string>
+#include <variant>
+
+using namespace neon_compiler;
+using namespace neon_compiler::ast;
+using namespace neon_compiler::ast::nodes;
+using namespace neon_compiler::resolution;
+
+namespace
+{
+	using BodyFunction = std::function<void(const std::vector<const VariableDeclaration*>&, const CodeBlock&)>;
+
+	std::vector<const VariableDeclaration*> get_parameters(const ParameterDeclarationList& parameter_list)
+	{
+		std::vector<const VariableDeclaration*> parameters;
+		parameters.reserve(parameter_list.size());
+
+		for(const VariableDeclaration& parameter : parameter_list)
+		{
+			parameters.push_back(&parameter);
+		}
+
+		return parameters;
+	}
+
+	void for_each_pure_function(const std::vector<PureFunction>& overloads, const BodyFunction& function)
+	{
+		for(const PureFunction& pure_function : overloads)
+		{
+			if(pure_function.implementation.has_value())
+			{
+				function(get_parameters(pure_function.parameters), pure_function.implementation.value());
+			}
+		}
+	}
+}
+
+void reference_counting::for_each_body(const PackageMember& package_member, const BodyFunction& function)
+{
+	if(const Entrypoint* entrypoint = dynamic_cast<const Entrypoint*>(&package_member))
+	{
+		function(get_parameters(entrypoint->parameters), entrypoint->body);
+	}
+	else if(const Type* type = dynamic_cast<const Type*>(&package_member))
+	{
+		for(const std::pair<const std::string, std::vector<Method>>& overloads : type->methods)
+		{
+			for(const Method& method : overloads.second)
+			{
+				if(method.implementation.has_value()) { function(get_parameters(method.parameters), method.implementation.value()); }
+			}
+		}
+		for(const std::pair<const std::string, std::vector<PureFunction>>& overloads : type->pure_functions)
+		{
+			for_each_pure_function(overloads.second, function);
+		}
+	}
+	else if(const PureFunctionSet* pure_function_set = dynamic_cast<const PureFunctionSet*>(&package_member))
+	{
+		for(const std::pair<const std::string, std::vector<PureFunction>>& overloads : pure_function_set->methods)
+		{
+			for_each_pure_function(overloads.second, function);
+		}
+	}
+	else if(const OperatorModule* operator_module = dynamic_cast<const OperatorModule*>(&package_member))
+	{
+		for(const OperatorFunction& operator_function : operator_module->functions)
+		{
+			std::vector<const VariableDeclaration*> parameters;
+			for(const OperatorFunctionPatternElement& element : operator_function.pattern)
+			{
+				if(const OperatorFunctionParameter* parameter = std::get_if<OperatorFunctionParameter>(&element))
+				{
+					parameters.push_back(&parameter->parameter);
+				}
+			}
+
+			function(parameters, operator_function.body);
+		}
+	}
+}
+
+const VariableDeclaration* reference_counting::find_variable(const Resolution& resolution, const Expression* expression)
+{
+	const SimpleRead* read = dynamic_cast<const SimpleRead*>(expression);
+
+	if(!read || read->declaration == UNRESOLVED_DECLARATION) { return nullptr; }
+
+	const Declaration& declaration = resolution.get_declaration(read->declaration);
+
+	if(declaration.kind != DeclarationKind::PARAMETER && declaration.kind != DeclarationKind::LOCAL) { return nullptr; }
+
+	return static_cast<const VariableDeclaration*>(declaration.nodes.front());
+}
+
+const ParameterDeclarationList* reference_counting::find_parameters(const Resolution& resolution, DeclarationId callee, std::size_t argument_count)
+{
+	if(callee == UNRESOLVED_DECLARATION) { return nullptr; }
+
+	const Declaration& declaration = resolution.get_declaration(callee);
+	const ParameterDeclarationList* found{nullptr};
+
+	for(const ASTNode* node : declaration.nodes)
+	{
+		const ParameterDeclarationList* parameters{nullptr};
+
+		switch(declaration.kind)
+		{
+			case DeclarationKind::ENTRYPOINT:    { parameters = &static_cast<const Entrypoint*>(node)->parameters; break; }
+			case DeclarationKind::METHOD:        { parameters = &static_cast<const Method*>(node)->parameters; break; }
+			case DeclarationKind::PURE_FUNCTION: { parameters = &static_cast<const PureFunction*>(node)->parameters; break; }
+			default: { return nullptr; }
+		}
+
+		if(parameters->size() != argument_count) { continue; }
+		if(found) { return nullptr; }
+
+		found = parameters;
+	}
+
+	return found;
+}
+
+DeclarationId reference_counting::find_member(const Resolution& resolution, const ObjectFunctionCall& call)
+{
+	const SimpleRead* object = dynamic_cast<const SimpleRead*>(call.object.get());
+	if(!object || object->declaration == UNRESOLVED_DECLARATION) { return UNRESOLVED_DECLARATION; }
+
+	DeclarationId type{object->declaration};
+	if(const VariableDeclaration* variable = find_variable(resolution, object))
+	{
+		type = variable->reference_type.declaration;
+		if(type == UNRESOLVED_DECLARATION) { return UNRESOLVED_DECLARATION; }
+	}
+
+	const Scope* member_scope = resolution.get_member_scope(resolution.get_declaration(type).name);
+	if(!member_scope) { return UNRESOLVED_DECLARATION; }
+
+	return member_scope->find(call.member_name).value_or(UNRESOLVED_DECLARATION);
+}
+
+const ParameterDeclarationList* reference_counting::find_member_parameters(const Resolution& resolution, const ObjectFunctionCall& call)
+{
+	return find_parameters(resolution, find_member(resolution, call), call.arguments.size());
+}
@@ -0,0 +1,54 @@
+#ifndef BODIES_HPP
+#define BODIES_HPP
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+#include "../ast/nodes/nodes.hpp"
+#include "../ast/nodes/statement_nodes.hpp"
+#include "../resolution/resolution.hpp"
+
+namespace neon_compiler::reference_counting
+{
+
+/** Calls `function(parameters, body)` for every implemented body of `package_member` that ends up in the program:
+ * entrypoints, methods, pure functions and operator functions. Compile functions run in the compiler, so they are skipped. */
+void for_each_body
+(
+	const neon_compiler::ast::nodes::PackageMember& package_member,
+	const std::function<void(const std::vector<const neon_compiler::ast::nodes::VariableDeclaration*>&,
+		const neon_compiler::ast::nodes::CodeBlock&)>& function
+);
+
+/** The parameter or local variable `expression` reads, if it is a read of one */
+const neon_compiler::ast::nodes::VariableDeclaration* find_variable
+(
+	const neon_compiler::resolution::Resolution& resolution,
+	const neon_compiler::ast::nodes::Expression* expression
+);
+
+/** Parameters of the only overload of `callee` taking `argument_count` arguments, if it is an entrypoint, method or pure function */
+const neon_compiler::ast::nodes::ParameterDeclarationList* find_parameters
+(
+	const neon_compiler::resolution::Resolution& resolution,
+	neon_compiler::ast::nodes::DeclarationId callee,
+	std::size_t argument_count
+);
+
+/** Declaration of the method or pure function called on a variable, type or pure function set. `UNRESOLVED_DECLARATION` if not found. */
+neon_compiler::ast::nodes::DeclarationId find_member
+(
+	const neon_compiler::resolution::Resolution& resolution,
+	const neon_compiler::ast::nodes::ObjectFunctionCall& call
+);
+
+/** Parameters of the method or pure function called on a variable, type or pure function set */
+const neon_compiler::ast::nodes::ParameterDeclarationList* find_member_parameters
+(
+	const neon_compiler::resolution::Resolution& resolution,
+	const neon_compiler::ast::nodes::ObjectFunctionCall& call
+);
+
+}
+
+#endif // BODIES_HPP
@@ -0,0 +1,328 @@
+#include "refcount_analyser.hpp"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+#include "bodies.hpp"
+#include "../trace/trace.hpp"
+
+using namespace neon_compiler;
+using namespace neon_compiler::ast;
+using namespace neon_compiler::ast::nodes;
+using namespace neon_compiler::reference_counting;
+using namespace neon_compiler::resolution;
+
+namespace
+{
+	enum class EventKind
+	{
+		/** The variable gets a new reference, by initialisation or assignment */
+		DEFINITION,
+		READ,
+		/** Every variable might be read and kept, e.g. by the expansion of a compile function call */
+		KEEP_ALL
+	};
+
+	struct Event
+	{
+		EventKind kind;
+		const VariableDeclaration* variable;
+		const SimpleRead* read;
+		/** Whether the value read is kept beyond the expression */
+		bool kept;
+	};
+
+	bool is_counted(const VariableDeclaration& variable)
+	{
+		return variable.reference_type.mutability == MutabilityMode::SHARED;
+	}
+
+	/** Analyses the bodies of one package member, in the order of their statements */
+	class PackageMemberAnalyser
+	{
+	public:
+		RefcountAnnotations annotations;
+
+		explicit PackageMemberAnalyser(const Resolution& init_resolution)
+			: resolution{init_resolution} {}
+
+		void analyse(const PackageMember& package_member)
+		{
+			for_each_body(package_member, [this] (const std::vector<const VariableDeclaration*>& parameters, const CodeBlock& body)
+			{
+				analyse_body(parameters, body);
+			});
+		}
+
+	private:
+		const Resolution& resolution;
+		/** Events of the body being analysed, in order */
+		std::vector<Event> events;
+		/** `shared` parameters and then local variables of the body being analysed */
+		std::vector<const VariableDeclaration*> variables;
+		std::size_t local_count{0};
+
+		void analyse_body(const std::vector<const VariableDeclaration*>& parameters, const CodeBlock& body)
+		{
+			events.clear();
+			variables.clear();
+			local_count = 0;
+
+			for(const VariableDeclaration* parameter : parameters)
+			{
+				if(!is_counted(*parameter)) { continue; }
+
+				variables.push_back(parameter);
+				events.push_back(Event{EventKind::DEFINITION, parameter, nullptr, false});
+			}
+
+			for(const std::unique_ptr<Statement>& statement : body.statements)
+			{
+				if(!visit_statement(statement.get())) { break; }
+			}
+
+			classify_reads();
+			summarise_variables();
+			find_borrowing_locals();
+			count_elisions();
+		}
+
+		/** Returns whether the statements after it are reached */
+		bool visit_statement(const Statement* statement)
+		{
+			if(const DiscardExpression* discard = dynamic_cast<const DiscardExpression*>(statement))
+			{
+				visit(discard->expression.get(), false);
+			}
+			else if(const LocalDeclaration* local = dynamic_cast<const LocalDeclaration*>(statement))
+			{
+				const VariableDeclaration& variable = local->variable_declaration;
+
+				visit(variable.initialisation.get(), variable.reference_type.mutability != MutabilityMode::BORROW);
+
+				if(is_counted(variable))
+				{
+					variables.push_back(&variable);
+					++local_count;
+					if(variable.initialisation) { events.push_back(Event{EventKind::DEFINITION, &variable, nullptr, false}); }
+				}
+			}
+			else if(const Return* ret = dynamic_cast<const Return*>(statement))
+			{
+				visit(ret->value.get(), true);
+				return false;
+			}
+			else if(dynamic_cast<const AutoCall*>(statement))
+			{
+				events.push_back(Event{EventKind::KEEP_ALL, nullptr, nullptr, true});
+			}
+
+			return true;
+		}
+
+		void visit(const Expression* expression, bool kept)
+		{
+			if(!expression) { return; }
+
+			if(const SimpleRead* read = dynamic_cast<const SimpleRead*>(expression))
+			{
+				const VariableDeclaration* variable = find_variable(resolution, read);
+				if(variable && is_counted(*variable)) { events.push_back(Event{EventKind::READ, variable, read, kept}); }
+			}
+			else if(const Assignment* assignment = dynamic_cast<const Assignment*>(expression))
+			{
+				const VariableDeclaration* target = find_variable(resolution, assignment->target.get());
+
+				if(target)
+				{
+					visit(assignment->value.get(), kept || target->reference_type.mutability != MutabilityMode::BORROW);
+					if(is_counted(*target)) { events.push_back(Event{EventKind::DEFINITION, target, nullptr, false}); }
+				}
+				else
+				{
+					// e.g. a field, which keeps the value
+					visit(assignment->target.get(), false);
+					visit(assignment->value.get(), true);
+				}
+			}
+			else if(const FunctionCall* function_call = dynamic_cast<const FunctionCall*>(expression))
+			{
+				visit_arguments(function_call->arguments, find_parameters(resolution, function_call->declaration, function_call->arguments.size()));
+			}
+			else if(const ObjectFunctionCall* object_call = dynamic_cast<const ObjectFunctionCall*>(expression))
+			{
+				visit(object_call->object.get(), false);
+				visit_arguments(object_call->arguments, find_member_parameters(resolution, *object_call));
+			}
+			else if(const ObjectRead* object_read = dynamic_cast<const ObjectRead*>(expression))
+			{
+				visit(object_read->object.get(), false);
+			}
+			else if(const OperatorCallExpression* operator_call = dynamic_cast<const OperatorCallExpression*>(expression))
+			{
+				visit_arguments(operator_call->arguments, nullptr);
+			}
+			else if(const OptFunctionCall* opt_call = dynamic_cast<const OptFunctionCall*>(expression))
+			{
+				visit_arguments(opt_call->arguments, nullptr);
+			}
+		}
+
+		/** `parameters` are those of the callee, or `nullptr` if not known, in which case all arguments are kept */
+		void visit_arguments(const std::vector<std::unique_ptr<Expression>>& arguments, const ParameterDeclarationList* parameters)
+		{
+			for(std::size_t i = 0; i < arguments.size(); ++i)
+			{
+				visit(arguments[i].get(), !parameters || (*parameters)[i].reference_type.mutability != MutabilityMode::BORROW);
+			}
+		}
+
+		/** Backward pass: a kept read is a move if the variable is not read again before it ends or gets a new reference */
+		void classify_reads()
+		{
+			std::unordered_map<const VariableDeclaration*, bool> live;
+
+			for(std::vector<Event>::const_reverse_iterator it = events.rbegin(); it != events.rend(); ++it)
+			{
+				switch(it->kind)
+				{
+					case EventKind::DEFINITION:
+					{
+						live[it->variable] = false;
+						break;
+					}
+					case EventKind::READ:
+					{
+						ReferenceTransfer transfer{ReferenceTransfer::BORROW};
+						if(it->kept) { transfer = live[it->variable] ? ReferenceTransfer::COPY : ReferenceTransfer::MOVE; }
+
+						annotations.reads.insert_or_assign(it->read, transfer);
+						live[it->variable] = true;
+						break;
+					}
+					case EventKind::KEEP_ALL:
+					{
+						for(const VariableDeclaration* variable : variables) { live[variable] = true; }
+						break;
+					}
+				}
+			}
+		}
+
+		/** Forward pass: whether each variable escapes and still holds its reference at the end */
+		void summarise_variables()
+		{
+			for(const VariableDeclaration* variable : variables)
+			{
+				annotations.variables.insert_or_assign(variable, VariableRefcount{});
+			}
+
+			for(const Event& event : events)
+			{
+				if(event.kind == EventKind::KEEP_ALL)
+				{
+					for(const VariableDeclaration* variable : variables) { annotations.variables.at(variable).escapes = true; }
+					continue;
+				}
+
+				VariableRefcount& refcount = annotations.variables.at(event.variable);
+
+				if(event.kind == EventKind::DEFINITION)
+				{
+					refcount.released_at_end = true;
+				}
+				else if(event.kept)
+				{
+					refcount.escapes = true;
+					if(annotations.reads.at(event.read) == ReferenceTransfer::MOVE) { refcount.released_at_end = false; }
+				}
+			}
+		}
+	
+		/** A local initialised with a copy of another variable's reference, that it never keeps, can borrow it instead,
+		 * if the other variable holds it until the end of the body: it is neither moved nor reassigned afterwards */
+		void find_borrowing_locals()
+		{
+			for(std::size_t v = variables.size() - local_count; v < variables.size(); ++v)
+			{
+				const VariableDeclaration* local = variables[v];
+				VariableRefcount& refcount = annotations.variables.at(local);
+
+				const SimpleRead* initialisation = dynamic_cast<const SimpleRead*>(local->initialisation.get());
+				if(refcount.escapes || !initialisation) { continue; }
+
+				const std::unordered_map<const SimpleRead*, ReferenceTransfer>::iterator read_it = annotations.reads.find(initialisation);
+				if(read_it == annotations.reads.end() || read_it->second != ReferenceTransfer::COPY) { continue; }
+
+				const std::vector<Event>::const_iterator read_event = std::find_if(events.begin(), events.end(),
+					[initialisation] (const Event& event) { return event.read == initialisation; });
+				const VariableDeclaration* source = read_event->variable;
+
+				const bool reassigned = std::count_if(events.begin(), events.end(), [local] (const Event& event)
+				{
+					return event.kind == EventKind::DEFINITION && event.variable == local;
+				}) > 1;
+				const bool source_released = std::any_of(read_event + 1, events.cend(), [this, source] (const Event& event)
+				{
+					return event.variable == source && (event.kind == EventKind::DEFINITION
+						|| (event.kind == EventKind::READ && annotations.reads.at(event.read) == ReferenceTransfer::MOVE));
+				});
+
+				if(reassigned || source_released) { continue; }
+
+				read_it->second = ReferenceTransfer::BORROW;
+				refcount.counted = false;
+				refcount.released_at_end = false;
+			}
+		}
+
+		void count_elisions()
+		{
+			for(const Event& event : events)
+			{
+				if(event.kind == EventKind::READ && annotations.reads.at(event.read) != ReferenceTransfer::COPY)
+				{
+					++annotations.elided_increment_count;
+				}
+			}
+
+			for(const VariableDeclaration* variable : variables)
+			{
+				if(!annotations.variables.at(variable).released_at_end) { ++annotations.elided_decrement_count; }
+			}
+		}
+	};
+}
+
+RefcountAnalyser::RefcountAnalyser(concurrency::WorkStealingPool& init_pool)
+	: pool{init_pool} {}
+
+RefcountAnnotations RefcountAnalyser::run(const Root& root, const Resolution& resolution)
+{
+	const trace::Span span{"RefcountAnalyser::run"};
+
+	std::vector<const PackageMember*> package_members;
+	package_members.reserve(root.package_members.size());
+	for(const std::pair<const std::string, std::unique_ptr<PackageMember>>& pair : root.package_members)
+	{
+		package_members.push_back(pair.second.get());
+	}
+
+	std::vector<PackageMemberAnalyser> member_analysers(package_members.size(), PackageMemberAnalyser{resolution});
+
+	pool.run(package_members.size(), [&] (std::size_t i)
+	{
+		member_analysers[i].analyse(*package_members[i]);
+	});
+
+	RefcountAnnotations annotations;
+	for(PackageMemberAnalyser& member_analyser : member_analysers)
+	{
+		annotations.reads.merge(member_analyser.annotations.reads);
+		annotations.variables.merge(member_analyser.annotations.variables);
+		annotations.elided_increment_count += member_analyser.annotations.elided_increment_count;
+		annotations.elided_decrement_count += member_analyser.annotations.elided_decrement_count;
+	}
+
+	return annotations;
+}
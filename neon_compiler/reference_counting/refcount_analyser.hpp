@@ -0,0 +1,83 @@
+#ifndef REFCOUNT_ANALYSER_HPP
+#define REFCOUNT_ANALYSER_HPP
+
+#include <cstdint>
+#include <unordered_map>
+#include "../ast/nodes/nodes.hpp"
+#include "../ast/nodes/statement_nodes.hpp"
+#include "../resolution/resolution.hpp"
+#include "../../concurrency/work_stealing_pool.hpp"
+
+namespace neon_compiler::reference_counting
+{
+
+/** What a read of a `shared` variable does with the reference count */
+enum class ReferenceTransfer
+{
+	/** The reference is only used while the variable holds it (e.g. as receiver of a call or for a `borrow` parameter): not counted */
+	BORROW,
+	/** The reference is kept elsewhere and the variable is used again afterwards: one increment */
+	COPY,
+	/** The reference is kept elsewhere at the last use of the variable, which hands its count over: not counted */
+	MOVE
+};
+
+/** How a `shared` parameter or local variable is counted */
+struct VariableRefcount
+{
+	/** Whether the variable holds a count of its own. Not for a local that only borrows the reference of a variable
+	 * that outlives it, in which case its initialisation is a `BORROW` and it is never released. */
+	bool counted{true};
+	/** Whether the variable still holds its count at the end of the body, where it is released.
+	 * Not if its last use moved the reference out. */
+	bool released_at_end{false};
+	/** Whether the reference is, or might be, kept beyond the variable */
+	bool escapes{false};
+};
+
+/** What the backend needs to leave out reference count traffic that is not needed */
+struct RefcountAnnotations
+{
+	/** Transfers of the reads of `shared` parameters and local variables. Reads of others are not counted. */
+	std::unordered_map<const neon_compiler::ast::nodes::SimpleRead*, ReferenceTransfer> reads;
+	/** `shared` parameters and local variables of the bodies */
+	std::unordered_map<const neon_compiler::ast::nodes::VariableDeclaration*, VariableRefcount> variables;
+
+	/** Increments left out: reads that borrow or move instead of copying */
+	uint64_t elided_increment_count{0};
+	/** Decrements left out: variables that are not released at the end, because they were moved out or do not count */
+	uint64_t elided_decrement_count{0};
+};
+
+/** Finds which increments and decrements of `shared` references a body can do without.
+ * `own` references have a single owner and `borrow` references are never counted, so only `shared` ones are analysed.
+ *
+ * The naive lowering increments the count whenever a `shared` variable is read and decrements it for every variable
+ * at the end of the body. A backward pass over the statements, which have no branches or loops,
+ * finds for each read whether the variable is used again (liveness): the last use before the variable ends
+ * or is reassigned moves the reference instead of copying it. Reads whose value is not kept (receivers of calls,
+ * objects of member reads, `borrow` parameters and variables) borrow it. A local that is initialised from another
+ * variable and only borrows its reference, while that variable is neither moved nor reassigned, does not count at all.
+ *
+ * Values are assumed kept wherever that is not known, e.g. arguments of unresolved calls or operator calls.
+ * Compile function calls (`auto:`) may expand to anything, so a body that has one keeps all its references.
+ *
+ * Package members are analysed in parallel, like in `type_checking::TypeChecker`. */
+class RefcountAnalyser
+{
+public:
+	explicit RefcountAnalyser(concurrency::WorkStealingPool& init_pool);
+
+	RefcountAnnotations run
+	(
+		const neon_compiler::ast::nodes::Root& root,
+		const neon_compiler::resolution::Resolution& resolution
+	);
+
+private:
+	concurrency::WorkStealingPool& pool;
+};
+
+}
+
+#endif // REFCOUNT_ANALYSER_HPP
@@ -0,0 +1,111 @@
+#ifndef REFCOUNT_RUNTIME_HPP
+#define REFCOUNT_RUNTIME_HPP
+
+#include <string_view>
+
+namespace neon_compiler::reference_counting
+{
+
+/** Macro that makes the runtime check that objects of thread-local allocations are only counted on their own thread.
+ * Has no effect if `NDEBUG` is defined too, so release builds never pay for it. */
+constexpr std::string_view VERIFY_THREAD_LOCAL_MACRO = "NEON_VERIFY_THREAD_LOCAL";
+
+/** C source of the reference counting runtime, included in the generated code.
+ * Every object starts with a `neon_object` header, whose `destroy` releases what the object refers to before it is freed.
+ * Objects of allocations that `ThreadEscapeAnalyser` classified as thread-local are counted with plain loads and stores, the others with atomic read-modify-writes.
+ * With verification, using a thread-local object on another thread than the one that allocated it aborts the program. */
+constexpr std::string_view REFCOUNT_RUNTIME_SOURCE = R"(#include <stdatomic.h>
+#include <stddef.h>
+#include <stdlib.h>
+
+#if defined(NEON_VERIFY_THREAD_LOCAL) && !defined(NDEBUG)
+#define NEON_VERIFYING_THREAD_LOCAL 1
+#include <stdio.h>
+#include <threads.h>
+#else
+#define NEON_VERIFYING_THREAD_LOCAL 0
+#endif
+
+typedef struct neon_object
+{
+	_Atomic size_t count;
+	void (*destroy)(struct neon_object*);
+	/* Whether the object never leaves the thread that allocated it */
+	unsigned char single_thread;
+#if NEON_VERIFYING_THREAD_LOCAL
+	thrd_t owner;
+	const char* site;
+#endif
+} neon_object;
+
+/* `size` includes the header. `site` names the allocation in the messages of the verification. */
+static inline void* neon_allocate(size_t size, void (*destroy)(neon_object*), int single_thread, const char* site)
+{
+	neon_object* object = calloc(1, size);
+	if(!object) { abort(); }
+
+	atomic_init(&object->count, 1);
+	object->destroy = destroy;
+	object->single_thread = (unsigned char)single_thread;
+#if NEON_VERIFYING_THREAD_LOCAL
+	object->owner = thrd_current();
+	object->site = site;
+#else
+	(void)site;
+#endif
+	return object;
+}
+
+static inline void neon_verify_thread(const neon_object* object)
+{
+#if NEON_VERIFYING_THREAD_LOCAL
+	if(object->single_thread && !thrd_equal(object->owner, thrd_current()))
+	{
+		fprintf(stderr, "Object allocated at %s was classified as thread-local, but is used on another thread\n", object->site);
+		abort();
+	}
+#else
+	(void)object;
+#endif
+}
+
+static inline void neon_retain(neon_object* object)
+{
+	neon_verify_thread(object);
+
+	if(object->single_thread)
+	{
+		atomic_store_explicit(&object->count, atomic_load_explicit(&object->count, memory_order_relaxed) + 1, memory_order_relaxed);
+	}
+	else
+	{
+		atomic_fetch_add_explicit(&object->count, 1, memory_order_relaxed);
+	}
+}
+
+static inline void neon_release(neon_object* object)
+{
+	neon_verify_thread(object);
+
+	size_t previous;
+	if(object->single_thread)
+	{
+		previous = atomic_load_explicit(&object->count, memory_order_relaxed);
+		atomic_store_explicit(&object->count, previous - 1, memory_order_relaxed);
+	}
+	else
+	{
+		previous = atomic_fetch_sub_explicit(&object->count, 1, memory_order_acq_rel);
+	}
+
+	if(previous == 1)
+	{
+		if(object->destroy) { object->destroy(object); }
+		free(object);
+	}
+}
+)";
+
+}
+
+#endif // REFCOUNT_RUNTIME_HPP
@@ -0,0 +1,250 @@
+#include "thread_escape_analyser.hpp"
+
+#include <string>
+#include <unordered_set>
+#include <vector>
+#include "bodies.hpp"
+#include "../trace/trace.hpp"
+
+using namespace neon_compiler;
+using namespace neon_compiler::ast;
+using namespace neon_compiler::ast::nodes;
+using namespace neon_compiler::reference_counting;
+using namespace neon_compiler::resolution;
+
+namespace
+{
+	enum class DestinationKind
+	{
+		/** The value is only used by the expression, e.g. as receiver of a call */
+		BORROWED,
+		/** The value is held by a variable of the body */
+		VARIABLE,
+		/** The value is, or might be, kept beyond the body */
+		ESCAPED
+	};
+
+	/** Where the value of an expression goes */
+	struct Destination
+	{
+		DestinationKind kind;
+		const VariableDeclaration* variable;
+	};
+
+	constexpr Destination BORROWED{DestinationKind::BORROWED, nullptr};
+	constexpr Destination ESCAPED{DestinationKind::ESCAPED, nullptr};
+
+	/** Analyses the bodies of one package member. Allocations and variables are the nodes of a flow graph. */
+	class PackageMemberAnalyser
+	{
+	public:
+		AllocationAnnotations annotations;
+
+		explicit PackageMemberAnalyser(const Resolution& init_resolution)
+			: resolution{init_resolution} {}
+
+		void analyse(const PackageMember& package_member)
+		{
+			for_each_body(package_member, [this] (const std::vector<const VariableDeclaration*>& parameters, const CodeBlock& body)
+			{
+				analyse_body(parameters, body);
+			});
+		}
+
+	private:
+		const Resolution& resolution;
+		/** Mapping from variable to the allocations and variables whose objects flow into it */
+		std::unordered_map<const ASTNode*, std::vector<const ASTNode*>> sources;
+		/** Allocations and variables whose objects escape directly */
+		std::vector<const ASTNode*> escaping;
+		std::vector<const FunctionCall*> allocations;
+		/** Parameters and local variables declared so far */
+		std::vector<const VariableDeclaration*> variables;
+
+		void analyse_body(const std::vector<const VariableDeclaration*>& parameters, const CodeBlock& body)
+		{
+			sources.clear();
+			escaping.clear();
+			allocations.clear();
+			variables = parameters;
+
+			for(const std::unique_ptr<Statement>& statement : body.statements)
+			{
+				if(!visit_statement(statement.get())) { break; }
+			}
+
+			classify_allocations();
+		}
+
+		/** Returns whether the statements after it are reached */
+		bool visit_statement(const Statement* statement)
+		{
+			if(const DiscardExpression* discard = dynamic_cast<const DiscardExpression*>(statement))
+			{
+				visit(discard->expression.get(), BORROWED);
+			}
+			else if(const LocalDeclaration* local = dynamic_cast<const LocalDeclaration*>(statement))
+			{
+				const VariableDeclaration& variable = local->variable_declaration;
+
+				variables.push_back(&variable);
+				visit(variable.initialisation.get(), Destination{DestinationKind::VARIABLE, &variable});
+			}
+			else if(const Return* ret = dynamic_cast<const Return*>(statement))
+			{
+				visit(ret->value.get(), ESCAPED);
+				return false;
+			}
+			else if(dynamic_cast<const AutoCall*>(statement))
+			{
+				escaping.insert(escaping.end(), variables.begin(), variables.end());
+			}
+
+			return true;
+		}
+
+		void flow(const ASTNode* source, Destination destination)
+		{
+			switch(destination.kind)
+			{
+				case DestinationKind::BORROWED: { break; }
+				case DestinationKind::VARIABLE: { sources[destination.variable].push_back(source); break; }
+				case DestinationKind::ESCAPED:  { escaping.push_back(source); break; }
+			}
+		}
+
+		void visit(const Expression* expression, Destination destination)
+		{
+			if(!expression) { return; }
+
+			if(dynamic_cast<const SimpleRead*>(expression))
+			{
+				if(const VariableDeclaration* variable = find_variable(resolution, expression)) { flow(variable, destination); }
+			}
+			else if(const Assignment* assignment = dynamic_cast<const Assignment*>(expression))
+			{
+				if(const VariableDeclaration* target = find_variable(resolution, assignment->target.get()))
+				{
+					visit(assignment->value.get(), Destination{DestinationKind::VARIABLE, target});
+					flow(target, destination);
+				}
+				else
+				{
+					// e.g. a field, which may be reached from anywhere
+					visit(assignment->target.get(), BORROWED);
+					visit(assignment->value.get(), ESCAPED);
+				}
+			}
+			else if(const FunctionCall* function_call = dynamic_cast<const FunctionCall*>(expression))
+			{
+				if(is_allocation(*function_call))
+				{
+					// The arguments are stored in the fields of the new object
+					allocations.push_back(function_call);
+					visit_arguments(function_call->arguments, nullptr);
+					flow(function_call, destination);
+				}
+				else
+				{
+					visit_arguments(function_call->arguments,
+						find_parameters(resolution, function_call->declaration, function_call->arguments.size()));
+				}
+			}
+			else if(const ObjectFunctionCall* object_call = dynamic_cast<const ObjectFunctionCall*>(expression))
+			{
+				visit(object_call->object.get(), BORROWED);
+				visit_arguments(object_call->arguments, find_member_parameters(resolution, *object_call));
+			}
+			else if(const ObjectRead* object_read = dynamic_cast<const ObjectRead*>(expression))
+			{
+				visit(object_read->object.get(), BORROWED);
+			}
+			else if(const OperatorCallExpression* operator_call = dynamic_cast<const OperatorCallExpression*>(expression))
+			{
+				visit_arguments(operator_call->arguments, nullptr);
+			}
+			else if(const OptFunctionCall* opt_call = dynamic_cast<const OptFunctionCall*>(expression))
+			{
+				visit_arguments(opt_call->arguments, nullptr);
+			}
+		}
+
+		/** `parameters` are those of the callee, or `nullptr` if not known, in which case all arguments escape */
+		void visit_arguments(const std::vector<std::unique_ptr<Expression>>& arguments, const ParameterDeclarationList* parameters)
+		{
+			for(std::size_t i = 0; i < arguments.size(); ++i)
+			{
+				const bool borrowed = parameters && (*parameters)[i].reference_type.mutability == MutabilityMode::BORROW;
+				visit(arguments[i].get(), borrowed ? BORROWED : ESCAPED);
+			}
+		}
+
+		bool is_allocation(const FunctionCall& function_call) const
+		{
+			return function_call.declaration != UNRESOLVED_DECLARATION
+				&& resolution.get_declaration(function_call.declaration).kind == DeclarationKind::TYPE;
+		}
+
+		/** Everything that flows into an escaping node escapes too */
+		void classify_allocations()
+		{
+			std::unordered_set<const ASTNode*> escaped;
+			std::vector<const ASTNode*> pending = escaping;
+
+			while(!pending.empty())
+			{
+				const ASTNode* node = pending.back();
+				pending.pop_back();
+
+				if(!escaped.insert(node).second) { continue; }
+
+				const std::unordered_map<const ASTNode*, std::vector<const ASTNode*>>::const_iterator it = sources.find(node);
+				if(it != sources.end()) { pending.insert(pending.end(), it->second.begin(), it->second.end()); }
+			}
+
+			for(const FunctionCall* allocation : allocations)
+			{
+				if(escaped.count(allocation))
+				{
+					annotations.allocations.insert_or_assign(allocation, AllocationSharing::SHARED);
+				}
+				else
+				{
+					annotations.allocations.insert_or_assign(allocation, AllocationSharing::THREAD_LOCAL);
+					++annotations.thread_local_count;
+				}
+			}
+		}
+	};
+}
+
+ThreadEscapeAnalyser::ThreadEscapeAnalyser(concurrency::WorkStealingPool& init_pool)
+	: pool{init_pool} {}
+
+AllocationAnnotations ThreadEscapeAnalyser::run(const Root& root, const Resolution& resolution)
+{
+	const trace::Span span{"ThreadEscapeAnalyser::run"};
+
+	std::vector<const PackageMember*> package_members;
+	package_members.reserve(root.package_members.size());
+	for(const std::pair<const std::string, std::unique_ptr<PackageMember>>& pair : root.package_members)
+	{
+		package_members.push_back(pair.second.get());
+	}
+
+	std::vector<PackageMemberAnalyser> member_analysers(package_members.size(), PackageMemberAnalyser{resolution});
+
+	pool.run(package_members.size(), [&] (std::size_t i)
+	{
+		member_analysers[i].analyse(*package_members[i]);
+	});
+
+	AllocationAnnotations annotations;
+	for(PackageMemberAnalyser& member_analyser : member_analysers)
+	{
+		annotations.allocations.merge(member_analyser.annotations.allocations);
+		annotations.thread_local_count += member_analyser.annotations.thread_local_count;
+	}
+
+	return annotations;
+}
@@ -0,0 +1,64 @@
+#ifndef THREAD_ESCAPE_ANALYSER_HPP
+#define THREAD_ESCAPE_ANALYSER_HPP
+
+#include <cstdint>
+#include <unordered_map>
+#include "../ast/nodes/nodes.hpp"
+#include "../ast/nodes/statement_nodes.hpp"
+#include "../resolution/resolution.hpp"
+#include "../../concurrency/work_stealing_pool.hpp"
+
+namespace neon_compiler::reference_counting
+{
+
+/** Whether the objects made by an allocation can be reached from other threads */
+enum class AllocationSharing
+{
+	/** The objects never leave the body that makes them, so only its thread counts their references:
+	 * plain counters suffice */
+	THREAD_LOCAL,
+	/** The objects are, or might be, kept beyond the body: their counters must be atomic */
+	SHARED
+};
+
+/** What the backend needs to count the references of thread-local objects without atomics */
+struct AllocationAnnotations
+{
+	/** Classification of the allocations of the bodies, which are the calls of constructors */
+	std::unordered_map<const neon_compiler::ast::nodes::FunctionCall*, AllocationSharing> allocations;
+
+	/** Allocations classified as `THREAD_LOCAL` */
+	uint64_t thread_local_count{0};
+};
+
+/** Finds the allocations whose objects do not escape the body that makes them, and so stay on its thread.
+ *
+ * Within a body, objects flow from allocations into the variables they initialise (`VariableDeclaration`)
+ * or are assigned to (`Assignment`), and from variable to variable. They escape when they are returned (`Return`),
+ * stored in a field, passed as an argument that the callee may keep, or passed to a constructor. Receivers of calls,
+ * objects of member reads and `borrow` arguments do not escape: the callee cannot keep them, so it is assumed
+ * not to hand them to another thread. An allocation is thread-local unless some variable it flows into escapes.
+ * The analysis does not follow the order of the statements, as a variable may hold any of the objects assigned to it.
+ *
+ * Like in `RefcountAnalyser`, arguments of unresolved and operator calls are assumed kept,
+ * and a body with a compile function call (`auto:`) lets all its variables escape.
+ *
+ * Package members are analysed in parallel, like in `type_checking::TypeChecker`. */
+class ThreadEscapeAnalyser
+{
+public:
+	explicit ThreadEscapeAnalyser(concurrency::WorkStealingPool& init_pool);
+
+	AllocationAnnotations run
+	(
+		const neon_compiler::ast::nodes::Root& root,
+		const neon_compiler::resolution::Resolution& resolution
+	);
+
+private:
+	concurrency::WorkStealingPool& pool;
+};
+
+}
+
+#endif // THREAD_ESCAPE_ANALYSER_HPP
@@ -0,0 +1,546 @@
+#include "name_resolver.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <optional>
+#include <utility>
+#include "../ast/nodes/statement_nodes.hpp"
+#include "../trace/trace.hpp"
+
+using namespace neon_compiler;
+using namespace neon_compiler::ast;
+using namespace neon_compiler::ast::nodes;
+using namespace neon_compiler::resolution;
+
+namespace
+{
+	constexpr std::string_view SEPARATOR = "::";
+
+	/** Marks the ids of local declarations (parameters and local variables) while a package member is resolved on its own.
+	 * Until all package members are resolved, these ids are indices in the declarations of the package member. */
+	constexpr DeclarationId LOCAL_DECLARATION_FLAG = DeclarationId{1} << 31;
+
+	/** e.g. `main::subpkg` for `main::subpkg::Widget` */
+	std::string_view get_package(std::string_view identifier)
+	{
+		const std::size_t separator = identifier.rfind(SEPARATOR);
+		return separator == std::string_view::npos ? std::string_view{} : identifier.substr(0, separator);
+	}
+
+	/** e.g. `Widget` for `main::subpkg::Widget` */
+	std::string_view get_name(std::string_view identifier)
+	{
+		const std::size_t separator = identifier.rfind(SEPARATOR);
+		return separator == std::string_view::npos ? identifier : identifier.substr(separator + SEPARATOR.size());
+	}
+
+	std::optional<DeclarationKind> get_package_member_kind(const PackageMember& package_member)
+	{
+		if(dynamic_cast<const Entrypoint*>(&package_member))      { return DeclarationKind::ENTRYPOINT; }
+		if(dynamic_cast<const Type*>(&package_member))            { return DeclarationKind::TYPE; }
+		if(dynamic_cast<const PureFunctionSet*>(&package_member)) { return DeclarationKind::PURE_FUNCTION_SET; }
+		if(dynamic_cast<const OperatorModule*>(&package_member))  { return DeclarationKind::OPERATOR_MODULE; }
+		if(dynamic_cast<const CompileFunction*>(&package_member)) { return DeclarationKind::COMPILE_FUNCTION; }
+		return std::nullopt;
+	}
+
+	template<typename Overload>
+	std::vector<const ASTNode*> get_overload_nodes(const std::vector<Overload>& overloads)
+	{
+		std::vector<const ASTNode*> nodes;
+		nodes.reserve(overloads.size());
+
+		for(const Overload& overload : overloads)
+		{
+			nodes.push_back(&overload);
+		}
+
+		return nodes;
+	}
+
+	/** Keys of a map, sorted, so that declaration ids do not depend on the order of a hash map */
+	template<typename Map>
+	std::vector<const std::string*> get_sorted_keys(const Map& map)
+	{
+		std::vector<const std::string*> keys;
+		keys.reserve(map.size());
+
+		for(const typename Map::value_type& pair : map)
+		{
+			keys.push_back(&pair.first);
+		}
+
+		std::sort(keys.begin(), keys.end(), [] (const std::string* a, const std::string* b) { return *a < *b; });
+
+		return keys;
+	}
+
+	/** Resolves the references within one package member. Its local declarations are kept apart from the global ones
+	 * until all package members are resolved, and then appended to the resolution by `merge_into`. */
+	class PackageMemberResolver
+	{
+	public:
+		explicit PackageMemberResolver(const Scope& init_global_scope) : global_scope{init_global_scope} {}
+
+		std::vector<Declaration> local_declarations;
+		/** Id fields referring to a local declaration, holding its index in `local_declarations` until merged */
+		std::vector<DeclarationId*> local_references;
+		/** Reads and calls in bodies, with their id fields. The ids are final once merged. */
+		std::vector<std::pair<reading::SourcePosition, const DeclarationId*>> body_references;
+		uint64_t resolved_count{0};
+		std::vector<std::string> unresolved_names;
+
+		void resolve(PackageMember& package_member, const Scope& enclosing_scope, const Scope* member_scope)
+		{
+			if(Entrypoint* entrypoint = dynamic_cast<Entrypoint*>(&package_member))
+			{
+				Scope method_scope{ScopeKind::METHOD, &enclosing_scope};
+				resolve_parameters(entrypoint->parameters, method_scope);
+				resolve_code_block(entrypoint->body, method_scope);
+			}
+			else if(Type* type = dynamic_cast<Type*>(&package_member))
+			{
+				resolve_type(*type, *member_scope);
+			}
+			else if(PureFunctionSet* pure_function_set = dynamic_cast<PureFunctionSet*>(&package_member))
+			{
+				for(std::pair<const std::string, std::vector<PureFunction>>& overloads : pure_function_set->methods)
+				{
+					for(PureFunction& pure_function : overloads.second) { resolve_pure_function(pure_function, *member_scope); }
+				}
+			}
+			else if(OperatorModule* operator_module = dynamic_cast<OperatorModule*>(&package_member))
+			{
+				for(OperatorFunction& operator_function : operator_module->functions)
+				{
+					resolve_operator_function(operator_function, enclosing_scope);
+				}
+			}
+			else if(CompileFunction* compile_function = dynamic_cast<CompileFunction*>(&package_member))
+			{
+				resolve_code_block(compile_function->body, enclosing_scope);
+			}
+		}
+
+		/** Appends the local declarations to `declarations`, and sets the references to them to their final ids */
+		void merge_into(std::vector<Declaration>& declarations)
+		{
+			const DeclarationId first_id = static_cast<DeclarationId>(declarations.size());
+
+			for(DeclarationId* reference : local_references)
+			{
+				*reference += first_id;
+			}
+
+			std::move(local_declarations.begin(), local_declarations.end(), std::back_inserter(declarations));
+		}
+
+	private:
+		const Scope& global_scope;
+
+		void resolve_type(Type& type, const Scope& type_scope)
+		{
+			for(std::pair<const std::string, Field>& field : type.fields)
+			{
+				resolve_reference_type(field.second.reference_type, type_scope);
+			}
+			for(std::pair<const std::string, std::vector<Method>>& overloads : type.methods)
+			{
+				for(Method& method : overloads.second)
+				{
+					Scope method_scope{ScopeKind::METHOD, &type_scope};
+
+					if(method.return_type.has_value()) { resolve_reference_type(method.return_type.value(), type_scope); }
+					resolve_parameters(method.parameters, method_scope);
+					if(method.implementation.has_value()) { resolve_code_block(method.implementation.value(), method_scope); }
+				}
+			}
+			for(std::pair<const std::string, Constant>& constant : type.constants)
+			{
+				resolve_reference_type(constant.second.type, type_scope);
+			}
+			for(std::pair<const std::string, std::vector<PureFunction>>& overloads : type.pure_functions)
+			{
+				for(PureFunction& pure_function : overloads.second) { resolve_pure_function(pure_function, type_scope); }
+			}
+		}
+
+		void resolve_pure_function(PureFunction& pure_function, const Scope& enclosing_scope)
+		{
+			Scope method_scope{ScopeKind::METHOD, &enclosing_scope};
+
+			resolve_reference_type(pure_function.return_type, enclosing_scope);
+			resolve_parameters(pure_function.parameters, method_scope);
+			if(pure_function.implementation.has_value()) { resolve_code_block(pure_function.implementation.value(), method_scope); }
+		}
+
+		void resolve_operator_function(OperatorFunction& operator_function, const Scope& enclosing_scope)
+		{
+			Scope method_scope{ScopeKind::METHOD, &enclosing_scope};
+
+			for(const GenericParameter& generic_parameter : operator_function.generic_parameters)
+			{
+				declare(generic_parameter.reference_name, DeclarationKind::GENERIC_PARAMETER, nullptr, method_scope);
+			}
+
+			resolve_reference_type(operator_function.return_type, method_scope);
+
+			for(OperatorFunctionPatternElement& element : operator_function.pattern)
+			{
+				if(std::holds_alternative<OperatorFunctionParameter>(element))
+				{
+					resolve_variable_declaration
+					(
+						std::get<OperatorFunctionParameter>(element).parameter,
+						DeclarationKind::PARAMETER,
+						method_scope
+					);
+				}
+			}
+
+			resolve_code_block(operator_function.body, method_scope);
+		}
+
+		void resolve_parameters(ParameterDeclarationList& parameters, Scope& method_scope)
+		{
+			for(VariableDeclaration& parameter : parameters)
+			{
+				resolve_variable_declaration(parameter, DeclarationKind::PARAMETER, method_scope);
+			}
+		}
+
+		/** Declared after resolving the initialisation, which cannot refer to the variable itself */
+		void resolve_variable_declaration(VariableDeclaration& variable_declaration, DeclarationKind kind, Scope& scope)
+		{
+			resolve_reference_type(variable_declaration.reference_type, scope);
+			resolve_expression(variable_declaration.initialisation.get(), scope);
+			declare(variable_declaration.reference_name, kind, &variable_declaration, scope);
+		}
+
+		void resolve_code_block(CodeBlock& code_block, const Scope& enclosing_scope)
+		{
+			Scope block_scope{ScopeKind::BLOCK, &enclosing_scope};
+
+			for(std::unique_ptr<Statement>& statement : code_block.statements)
+			{
+				resolve_statement(*statement, block_scope);
+			}
+		}
+
+		void resolve_statement(Statement& statement, Scope& block_scope)
+		{
+			if(DiscardExpression* discard = dynamic_cast<DiscardExpression*>(&statement))
+			{
+				resolve_expression(discard->expression.get(), block_scope);
+			}
+			else if(LocalDeclaration* local = dynamic_cast<LocalDeclaration*>(&statement))
+			{
+				resolve_variable_declaration(local->variable_declaration, DeclarationKind::LOCAL, block_scope);
+			}
+			else if(AutoCall* auto_call = dynamic_cast<AutoCall*>(&statement))
+			{
+				resolve_name(auto_call->function_name, block_scope, auto_call->declaration);
+			}
+			else if(Return* ret = dynamic_cast<Return*>(&statement))
+			{
+				resolve_expression(ret->value.get(), block_scope);
+			}
+		}
+
+		/** `expression` may be null, for expressions that failed to parse */
+		void resolve_expression(Expression* expression, const Scope& scope)
+		{
+			if(!expression) { return; }
+
+			if(SimpleRead* read = dynamic_cast<SimpleRead*>(expression))
+			{
+				resolve_name(read->reference_name, scope, read->declaration);
+				body_references.emplace_back(read->source_position, &read->declaration);
+			}
+			else if(FunctionCall* call = dynamic_cast<FunctionCall*>(expression))
+			{
+				resolve_name(call->function_name, scope, call->declaration);
+				body_references.emplace_back(call->source_position, &call->declaration);
+				resolve_generic_arguments(call->generic_arguments, scope);
+				resolve_expressions(call->arguments, scope);
+			}
+			else if(OperatorCallExpression* operator_call = dynamic_cast<OperatorCallExpression*>(expression))
+			{
+				resolve_expressions(operator_call->arguments, scope);
+			}
+			else if(Assignment* assignment = dynamic_cast<Assignment*>(expression))
+			{
+				resolve_expression(assignment->target.get(), scope);
+				resolve_expression(assignment->value.get(), scope);
+			}
+			// Members are resolved by the type of the object, which is not known here
+			else if(ObjectFunctionCall* object_call = dynamic_cast<ObjectFunctionCall*>(expression))
+			{
+				resolve_expression(object_call->object.get(), scope);
+				resolve_generic_arguments(object_call->generic_arguments, scope);
+				resolve_expressions(object_call->arguments, scope);
+			}
+			else if(ObjectRead* object_read = dynamic_cast<ObjectRead*>(expression))
+			{
+				resolve_expression(object_read->object.get(), scope);
+			}
+			else if(OptFunctionCall* opt_call = dynamic_cast<OptFunctionCall*>(expression))
+			{
+				resolve_expressions(opt_call->arguments, scope);
+			}
+		}
+
+		void resolve_expressions(std::vector<std::unique_ptr<Expression>>& expressions, const Scope& scope)
+		{
+			for(std::unique_ptr<Expression>& expression : expressions)
+			{
+				resolve_expression(expression.get(), scope);
+			}
+		}
+
+		void resolve_reference_type(ReferenceType& reference_type, const Scope& scope)
+		{
+			resolve_name(reference_type.type, scope, reference_type.declaration);
+			resolve_generic_arguments(reference_type.generic_arguments, scope);
+		}
+
+		void resolve_generic_arguments(std::vector<GenericArgument>& generic_arguments, const Scope& scope)
+		{
+			for(GenericArgument& generic_argument : generic_arguments)
+			{
+				if(!generic_argument.is_reference) { continue; }
+
+				resolve_name(generic_argument.value, scope, generic_argument.declaration);
+				resolve_generic_arguments(generic_argument.nested_generic_args, scope);
+			}
+		}
+
+		void resolve_name(const std::string& name, const Scope& scope, DeclarationId& declaration)
+		{
+			const std::optional<DeclarationId> found =
+				name.find(SEPARATOR) == std::string::npos ? scope.lookup(name) : global_scope.find(name);
+
+			if(!found.has_value())
+			{
+				declaration = UNRESOLVED_DECLARATION;
+				unresolved_names.push_back(name);
+				return;
+			}
+
+			++resolved_count;
+
+			if(found.value() & LOCAL_DECLARATION_FLAG)
+			{
+				declaration = found.value() & ~LOCAL_DECLARATION_FLAG;
+				local_references.push_back(&declaration);
+			}
+			else
+			{
+				declaration = found.value();
+			}
+		}
+
+		void declare(const std::string& name, DeclarationKind kind, const ASTNode* node, Scope& scope)
+		{
+			const DeclarationId index = static_cast<DeclarationId>(local_declarations.size());
+
+			local_declarations.push_back(Declaration{kind, name, node ? std::vector<const ASTNode*>{node} : std::vector<const ASTNode*>{}});
+			scope.declare(name, index | LOCAL_DECLARATION_FLAG);
+		}
+	};
+}
+
+NameResolver::NameResolver(concurrency::WorkStealingPool& init_pool)
+	: pool{init_pool} {}
+
+std::shared_ptr<const Resolution> NameResolver::run(Root& root) const
+{
+	const trace::Span span{"NameResolver::run"};
+
+	std::shared_ptr<Resolution> resolution = std::make_shared<Resolution>();
+
+	const std::unordered_map<std::string_view, const Scope*> enclosing_scopes = declare_package_members(*resolution, root);
+
+	std::vector<const std::string*> identifiers = get_sorted_keys(root.package_members);
+	std::erase_if(identifiers, [&enclosing_scopes] (const std::string* identifier) { return !enclosing_scopes.contains(*identifier); });
+
+	for(const std::string* identifier : identifiers)
+	{
+		declare_type_members(*resolution, *identifier, *root.package_members.at(*identifier), *enclosing_scopes.at(*identifier));
+	}
+
+	std::vector<PackageMemberResolver> member_resolvers(identifiers.size(), PackageMemberResolver{resolution->get_global_scope()});
+
+	pool.run(identifiers.size(), [&] (std::size_t i)
+	{
+		trace::Span member_span{"NameResolver::resolve_package_member"};
+		if(member_span.is_recording()) { member_span.set_detail(*identifiers[i]); }
+
+		member_resolvers[i].resolve
+		(
+			*root.package_members.at(*identifiers[i]),
+			*enclosing_scopes.at(*identifiers[i]),
+			resolution->get_member_scope(*identifiers[i])
+		);
+	});
+
+	for(std::size_t i = 0; i < member_resolvers.size(); ++i)
+	{
+		PackageMemberResolver& member_resolver = member_resolvers[i];
+		member_resolver.merge_into(resolution->declarations);
+
+		if(!member_resolver.body_references.empty())
+		{
+			std::vector<BodyReference>& body_references = resolution->body_references[*identifiers[i]];
+			body_references.reserve(member_resolver.body_references.size());
+
+			for(const std::pair<reading::SourcePosition, const DeclarationId*>& body_reference : member_resolver.body_references)
+			{
+				if(*body_reference.second != UNRESOLVED_DECLARATION)
+				{
+					body_references.push_back(BodyReference{body_reference.first, *body_reference.second});
+				}
+			}
+		}
+
+		resolution->resolved_count += member_resolver.resolved_count;
+		resolution->unresolved_count += member_resolver.unresolved_names.size();
+		std::move
+		(
+			member_resolver.unresolved_names.begin(),
+			member_resolver.unresolved_names.end(),
+			std::back_inserter(resolution->unresolved_names)
+		);
+	}
+
+	std::vector<std::string>& unresolved_names = resolution->unresolved_names;
+	std::sort(unresolved_names.begin(), unresolved_names.end());
+	unresolved_names.erase(std::unique(unresolved_names.begin(), unresolved_names.end()), unresolved_names.end());
+
+	return resolution;
+}
+
+std::unordered_map<std::string_view, const Scope*> NameResolver::declare_package_members(Resolution& resolution, const Root& root)
+{
+	Scope& global_scope = resolution.scopes.front();
+	std::unordered_map<std::string_view, const Scope*> enclosing_scopes;
+
+	for(const std::string* identifier : get_sorted_keys(root.package_members))
+	{
+		const std::optional<DeclarationKind> kind = get_package_member_kind(*root.package_members.at(*identifier));
+
+		if(!kind.has_value()) { continue; }
+
+		const DeclarationId id = add_declaration(resolution, kind.value(), *identifier, {root.package_members.at(*identifier).get()});
+		global_scope.declare(*identifier, id);
+
+		Scope*& package_scope = resolution.package_scopes[std::string{get_package(*identifier)}];
+
+		if(!package_scope)
+		{
+			package_scope = &resolution.scopes.emplace_back(ScopeKind::PACKAGE, &global_scope);
+		}
+
+		package_scope->declare(get_name(*identifier), id);
+		enclosing_scopes[*identifier] = package_scope;
+	}
+
+	for(const std::pair<const std::string, std::vector<std::string>>& pair : root.file_package_members)
+	{
+		if(pair.second.empty()) { continue; }
+
+		const Scope* package_scope = resolution.get_package_scope(get_package(pair.second.front()));
+
+		if(!package_scope) { continue; }
+
+		Scope& file_scope = resolution.scopes.emplace_back(ScopeKind::FILE, package_scope);
+		resolution.file_scopes[pair.first] = &file_scope;
+
+		std::unordered_map<std::string, std::vector<std::string>>::const_iterator imports_it = root.file_imports.find(pair.first);
+
+		if(imports_it != root.file_imports.end())
+		{
+			for(const std::string& import : imports_it->second)
+			{
+				const std::optional<DeclarationId> id = global_scope.find(import);
+
+				if(id.has_value())
+				{
+					file_scope.declare(get_name(import), id.value());
+				}
+				else
+				{
+					++resolution.unresolved_count;
+					resolution.unresolved_names.push_back(import);
+				}
+			}
+		}
+
+		for(const std::string& identifier : pair.second)
+		{
+			std::unordered_map<std::string_view, const Scope*>::iterator it = enclosing_scopes.find(identifier);
+			if(it != enclosing_scopes.end()) { it->second = &file_scope; }
+		}
+	}
+
+	return enclosing_scopes;
+}
+
+void NameResolver::declare_type_members
+(
+	Resolution& resolution,
+	const std::string& identifier,
+	const PackageMember& package_member,
+	const Scope& enclosing_scope
+)
+{
+	const std::string prefix = identifier + std::string{SEPARATOR};
+
+	if(const Type* type = dynamic_cast<const Type*>(&package_member))
+	{
+		Scope& type_scope = resolution.scopes.emplace_back(ScopeKind::TYPE, &enclosing_scope);
+		resolution.member_scopes[identifier] = &type_scope;
+
+		for(const std::string* name : get_sorted_keys(type->fields))
+		{
+			type_scope.declare(*name, add_declaration(resolution, DeclarationKind::FIELD, prefix + *name, {&type->fields.at(*name)}));
+		}
+		for(const std::string* name : get_sorted_keys(type->constants))
+		{
+			type_scope.declare(*name, add_declaration(resolution, DeclarationKind::CONSTANT, prefix + *name, {&type->constants.at(*name)}));
+		}
+		for(const std::string* name : get_sorted_keys(type->methods))
+		{
+			type_scope.declare(*name, add_declaration(resolution, DeclarationKind::METHOD, prefix + *name, get_overload_nodes(type->methods.at(*name))));
+		}
+		for(const std::string* name : get_sorted_keys(type->pure_functions))
+		{
+			type_scope.declare
+			(
+				*name,
+				add_declaration(resolution, DeclarationKind::PURE_FUNCTION, prefix + *name, get_overload_nodes(type->pure_functions.at(*name)))
+			);
+		}
+	}
+	else if(const PureFunctionSet* pure_function_set = dynamic_cast<const PureFunctionSet*>(&package_member))
+	{
+		Scope& set_scope = resolution.scopes.emplace_back(ScopeKind::TYPE, &enclosing_scope);
+		resolution.member_scopes[identifier] = &set_scope;
+
+		for(const std::string* name : get_sorted_keys(pure_function_set->methods))
+		{
+			set_scope.declare
+			(
+				*name,
+				add_declaration(resolution, DeclarationKind::PURE_FUNCTION, prefix + *name, get_overload_nodes(pure_function_set->methods.at(*name)))
+			);
+		}
+	}
+}
+
+DeclarationId NameResolver::add_declaration(Resolution& resolution, DeclarationKind kind, std::string name, std::vector<const ASTNode*> nodes)
+{
+	resolution.declarations.push_back(Declaration{kind, std::move(name), std::move(nodes)});
+
+	return static_cast<DeclarationId>(resolution.declarations.size() - 1);
+}
@@ -0,0 +1,58 @@
+#ifndef NAME_RESOLVER_HPP
+#define NAME_RESOLVER_HPP
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+#include "resolution.hpp"
+#include "scope.hpp"
+#include "../ast/nodes/nodes.hpp"
+#include "../../concurrency/work_stealing_pool.hpp"
+
+namespace neon_compiler::resolution
+{
+
+/** Resolves the references in an AST to declaration ids, which are written to the referring nodes
+ * (e.g. `SimpleRead::declaration`). Unqualified names are looked up from the innermost scope outwards:
+ * block, method, type, the imports of the file, then the package. Qualified names are full identifiers.
+ *
+ * The scope tree down to the types is built first. The package members are then resolved in parallel:
+ * once the AST is complete they are independent, as each only reads the shared scopes and writes to its own nodes. */
+class NameResolver
+{
+public:
+	explicit NameResolver(concurrency::WorkStealingPool& init_pool);
+
+	std::shared_ptr<const Resolution> run(neon_compiler::ast::nodes::Root& root) const;
+
+private:
+	concurrency::WorkStealingPool& pool;
+
+	/** Declares the package members in the global and package scopes, and the imports in the file scopes.
+	 * Returns the scope enclosing each package member: that of its file, or of its package if it has no file. */
+	static std::unordered_map<std::string_view, const Scope*> declare_package_members
+	(
+		Resolution& resolution,
+		const neon_compiler::ast::nodes::Root& root
+	);
+	/** Creates the scope of a type or pure function set */
+	static void declare_type_members
+	(
+		Resolution& resolution,
+		const std::string& identifier,
+		const neon_compiler::ast::nodes::PackageMember& package_member,
+		const Scope& enclosing_scope
+	);
+	static neon_compiler::ast::nodes::DeclarationId add_declaration
+	(
+		Resolution& resolution,
+		DeclarationKind kind,
+		std::string name,
+		std::vector<const neon_compiler::ast::ASTNode*> nodes
+	);
+};
+
+}
+
+#endif // NAME_RESOLVER_HPP
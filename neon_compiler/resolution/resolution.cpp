@@ -0,0 +1,75 @@
+#include "resolution.hpp"
+
+using namespace neon_compiler::ast::nodes;
+using namespace neon_compiler::resolution;
+
+Resolution::Resolution()
+{
+	scopes.emplace_back(ScopeKind::GLOBAL, nullptr);
+}
+
+const Declaration& Resolution::get_declaration(DeclarationId id) const
+{
+	return declarations.at(id);
+}
+
+std::size_t Resolution::get_declaration_count() const
+{
+	return declarations.size();
+}
+
+const Scope& Resolution::get_global_scope() const
+{
+	return scopes.front();
+}
+
+const Scope* Resolution::get_package_scope(std::string_view package) const
+{
+	return find_scope(package_scopes, package);
+}
+
+const Scope* Resolution::get_file_scope(std::string_view file) const
+{
+	return find_scope(file_scopes, file);
+}
+
+const Scope* Resolution::get_member_scope(std::string_view package_member) const
+{
+	return find_scope(member_scopes, package_member);
+}
+
+const std::vector<BodyReference>& Resolution::get_body_references(std::string_view package_member) const
+{
+	static const std::vector<BodyReference> none{};
+
+	std::unordered_map<std::string, std::vector<BodyReference>>::const_iterator it = body_references.find(std::string{package_member});
+
+	return it == body_references.end() ? none : it->second;
+}
+
+uint64_t Resolution::get_resolved_count() const
+{
+	return resolved_count;
+}
+
+uint64_t Resolution::get_unresolved_count() const
+{
+	return unresolved_count;
+}
+
+const std::vector<std::string>& Resolution::get_unresolved_names() const
+{
+	return unresolved_names;
+}
+
+const Scope* Resolution::find_scope(const std::unordered_map<std::string, Scope*>& scope_map, std::string_view key)
+{
+	std::unordered_map<std::string, Scope*>::const_iterator it = scope_map.find(std::string{key});
+
+	if(it == scope_map.end())
+	{
+		return nullptr;
+	}
+
+	return it->second;
+}
@@ -0,0 +1,101 @@
+#ifndef RESOLUTION_HPP
+#define RESOLUTION_HPP
+
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "scope.hpp"
+#include "../ast/ast_node.hpp"
+#include "../ast/nodes/nodes.hpp"
+#include "../../reading/source_position.hpp"
+
+namespace neon_compiler::resolution
+{
+
+/** Function that the runtime provides, e.g. `print(value)`. It is not declared, so calls of it stay unresolved. */
+constexpr std::string_view PRINT_FUNCTION = "print";
+
+enum class DeclarationKind
+{
+	ENTRYPOINT,
+	TYPE,
+	PURE_FUNCTION_SET,
+	OPERATOR_MODULE,
+	COMPILE_FUNCTION,
+	FIELD,
+	METHOD,
+	CONSTANT,
+	PURE_FUNCTION,
+	PARAMETER,
+	GENERIC_PARAMETER,
+	LOCAL
+};
+
+struct Declaration
+{
+	DeclarationKind kind;
+	/** Full identifier of package members and their members (e.g. `main::Widget::speed`), the name of others */
+	std::string name;
+	/** Declaring nodes: one per overload for methods and pure functions, none for generic parameters */
+	std::vector<const neon_compiler::ast::ASTNode*> nodes;
+};
+
+/** Resolved read or call in a body, e.g. the `helper` of `helper(1)` */
+struct BodyReference
+{
+	/** Start of the name as written */
+	reading::SourcePosition source_position;
+	neon_compiler::ast::nodes::DeclarationId declaration;
+};
+
+/** Declarations that the references in an AST were resolved to, and the scopes of its package members.
+ * Refers to the names and nodes in the AST, so it is only valid until that AST changes. */
+class Resolution
+{
+public:
+	/** Starts with an empty global scope */
+	Resolution();
+
+	const Declaration& get_declaration(neon_compiler::ast::nodes::DeclarationId id) const;
+	std::size_t get_declaration_count() const;
+
+	const Scope& get_global_scope() const;
+	/** Scope of the package members of `package` (e.g. `main::subpkg`). Null if it has none. */
+	const Scope* get_package_scope(std::string_view package) const;
+	/** Scope of the imports of `file`, enclosed by its package scope. Null if it declares no package members. */
+	const Scope* get_file_scope(std::string_view file) const;
+	/** Scope of the members of a type or pure function set, by its full identifier. Null for other package members. */
+	const Scope* get_member_scope(std::string_view package_member) const;
+	/** Resolved reads and calls in the bodies of a package member, by its full identifier */
+	const std::vector<BodyReference>& get_body_references(std::string_view package_member) const;
+
+	uint64_t get_resolved_count() const;
+	uint64_t get_unresolved_count() const;
+	/** Names of the references and imports that were not resolved, sorted, without duplicates */
+	const std::vector<std::string>& get_unresolved_names() const;
+
+private:
+	friend class NameResolver;
+
+	/** Package members sorted by identifier, then the members of types and pure function sets,
+	 * then the parameters and local variables of each package member */
+	std::vector<Declaration> declarations;
+	/** Owns the scopes; a deque keeps them in place, so scopes can point to their parents */
+	std::deque<Scope> scopes;
+	std::unordered_map<std::string, Scope*> package_scopes;
+	std::unordered_map<std::string, Scope*> file_scopes;
+	std::unordered_map<std::string, Scope*> member_scopes;
+	std::unordered_map<std::string, std::vector<BodyReference>> body_references;
+	uint64_t resolved_count{0};
+	uint64_t unresolved_count{0};
+	std::vector<std::string> unresolved_names;
+
+	static const Scope* find_scope(const std::unordered_map<std::string, Scope*>& scope_map, std::string_view key);
+};
+
+}
+
+#endif // RESOLUTION_HPP
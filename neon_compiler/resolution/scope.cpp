@@ -0,0 +1,44 @@
+#include "scope.hpp"
+
+using namespace neon_compiler::ast::nodes;
+using namespace neon_compiler::resolution;
+
+Scope::Scope(ScopeKind init_kind, const Scope* init_parent)
+	: kind{init_kind}, parent{init_parent} {}
+
+ScopeKind Scope::get_kind() const
+{
+	return kind;
+}
+
+const Scope* Scope::get_parent() const
+{
+	return parent;
+}
+
+bool Scope::declare(std::string_view name, DeclarationId declaration)
+{
+	return symbols.insert(name, SymbolTable::hash(name), declaration);
+}
+
+std::optional<DeclarationId> Scope::lookup(std::string_view name) const
+{
+	const std::size_t name_hash = SymbolTable::hash(name);
+
+	for(const Scope* scope = this; scope; scope = scope->parent)
+	{
+		std::optional<DeclarationId> declaration = scope->symbols.find(name, name_hash);
+
+		if(declaration.has_value())
+		{
+			return declaration;
+		}
+	}
+
+	return std::nullopt;
+}
+
+std::optional<DeclarationId> Scope::find(std::string_view name) const
+{
+	return symbols.find(name, SymbolTable::hash(name));
+}
@@ -0,0 +1,53 @@
+#ifndef SCOPE_HPP
+#define SCOPE_HPP
+
+#include <optional>
+#include <string_view>
+#include "symbol_table.hpp"
+#include "../ast/nodes/nodes.hpp"
+
+namespace neon_compiler::resolution
+{
+
+enum class ScopeKind
+{
+	/** All package members, by full identifier (e.g. `main::subpkg::Widget`) */
+	GLOBAL,
+	/** The package members of one package, by name */
+	PACKAGE,
+	/** The package members imported by one file, by name */
+	FILE,
+	/** The members of a type or pure function set */
+	TYPE,
+	/** The parameters of a method, function or entrypoint */
+	METHOD,
+	/** The local variables of a code block */
+	BLOCK
+};
+
+/** Scope in the scope tree: the names declared in it and the enclosing scope */
+class Scope
+{
+public:
+	Scope(ScopeKind init_kind, const Scope* init_parent);
+
+	ScopeKind get_kind() const;
+	/** Enclosing scope; null for the global scope */
+	const Scope* get_parent() const;
+
+	/** Returns false, keeping the existing declaration, if `name` is already declared in this scope. */
+	bool declare(std::string_view name, neon_compiler::ast::nodes::DeclarationId declaration);
+	/** Finds the declaration of `name` in this scope or, failing that, in the closest enclosing scope declaring it. */
+	std::optional<neon_compiler::ast::nodes::DeclarationId> lookup(std::string_view name) const;
+	/** Finds the declaration of `name` in this scope only. */
+	std::optional<neon_compiler::ast::nodes::DeclarationId> find(std::string_view name) const;
+
+private:
+	ScopeKind kind;
+	const Scope* parent;
+	SymbolTable symbols;
+};
+
+}
+
+#endif // SCOPE_HPP
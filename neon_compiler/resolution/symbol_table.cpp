@@ -0,0 +1,87 @@
+#include "symbol_table.hpp"
+
+#include <functional>
+#include <utility>
+
+using namespace neon_compiler::ast::nodes;
+using namespace neon_compiler::resolution;
+
+namespace
+{
+	constexpr std::size_t MIN_CAPACITY = 8;
+}
+
+std::size_t SymbolTable::hash(std::string_view name)
+{
+	return std::hash<std::string_view>{}(name);
+}
+
+bool SymbolTable::insert(std::string_view name, std::size_t name_hash, DeclarationId declaration)
+{
+	if((count + 1) * 4 > slots.size() * 3)
+	{
+		grow();
+	}
+
+	Slot& slot = slots[find_slot(name, name_hash)];
+
+	if(slot.declaration != UNRESOLVED_DECLARATION)
+	{
+		return false;
+	}
+
+	slot = Slot{name, name_hash, declaration};
+	++count;
+
+	return true;
+}
+
+std::optional<DeclarationId> SymbolTable::find(std::string_view name, std::size_t name_hash) const
+{
+	if(slots.empty())
+	{
+		return std::nullopt;
+	}
+
+	const Slot& slot = slots[find_slot(name, name_hash)];
+
+	if(slot.declaration == UNRESOLVED_DECLARATION)
+	{
+		return std::nullopt;
+	}
+
+	return slot.declaration;
+}
+
+std::size_t SymbolTable::size() const
+{
+	return count;
+}
+
+void SymbolTable::grow()
+{
+	std::vector<Slot> old_slots = std::exchange(slots, std::vector<Slot>(slots.empty() ? MIN_CAPACITY : slots.size() * 2));
+
+	for(const Slot& slot : old_slots)
+	{
+		if(slot.declaration != UNRESOLVED_DECLARATION)
+		{
+			slots[find_slot(slot.name, slot.name_hash)] = slot;
+		}
+	}
+}
+
+std::size_t SymbolTable::find_slot(std::string_view name, std::size_t name_hash) const
+{
+	const std::size_t mask = slots.size() - 1;
+
+	for(std::size_t i = name_hash & mask; ; i = (i + 1) & mask)
+	{
+		const Slot& slot = slots[i];
+
+		if(slot.declaration == UNRESOLVED_DECLARATION || (slot.name_hash == name_hash && slot.name == name))
+		{
+			return i;
+		}
+	}
+}
@@ -0,0 +1,46 @@
+#ifndef SYMBOL_TABLE_HPP
+#define SYMBOL_TABLE_HPP
+
+#include <cstddef>
+#include <optional>
+#include <string_view>
+#include <vector>
+#include "../ast/nodes/nodes.hpp"
+
+namespace neon_compiler::resolution
+{
+
+/** Open-addressing hash table from names to declarations.
+ * Callers pass the hash of the name, so a name looked up through a chain of scopes is hashed once.
+ * Names are stored as views: the strings must outlive the table. */
+class SymbolTable
+{
+public:
+	static std::size_t hash(std::string_view name);
+
+	/** Returns false, keeping the existing declaration, if `name` is already in the table. */
+	bool insert(std::string_view name, std::size_t name_hash, neon_compiler::ast::nodes::DeclarationId declaration);
+	std::optional<neon_compiler::ast::nodes::DeclarationId> find(std::string_view name, std::size_t name_hash) const;
+	std::size_t size() const;
+
+private:
+	struct Slot
+	{
+		std::string_view name;
+		std::size_t name_hash{0};
+		/** `UNRESOLVED_DECLARATION` for an empty slot */
+		neon_compiler::ast::nodes::DeclarationId declaration{neon_compiler::ast::nodes::UNRESOLVED_DECLARATION};
+	};
+
+	/** Zero or a power of two slots, of which at most three quarters are used */
+	std::vector<Slot> slots;
+	std::size_t count{0};
+
+	void grow();
+	/** Index of the slot holding `name`, or of the empty slot where it would go */
+	std::size_t find_slot(std::string_view name, std::size_t name_hash) const;
+};
+
+}
+
+#endif // SYMBOL_TABLE_HPP
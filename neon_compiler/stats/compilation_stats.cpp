@@ -0,0 +1,308 @@
+#include "compilation_stats.hpp"
+
+#include <algorithm>
+#include <ctime>
+#include <iomanip>
+#include <sys/resource.h>
+#include "counters.hpp"
+
+using namespace neon_compiler::stats;
+
+namespace
+{
+	constexpr std::size_t NAME_WIDTH = 10;
+	constexpr int COLUMN_WIDTH = 13;
+
+	double to_milliseconds(std::chrono::nanoseconds duration)
+	{
+		return std::chrono::duration<double, std::milli>{duration}.count();
+	}
+
+	double to_mebibytes(uint64_t bytes)
+	{
+		return static_cast<double>(bytes) / (1024.0 * 1024.0);
+	}
+
+	std::string escape_json(std::string_view str)
+	{
+		std::string escaped;
+		escaped.reserve(str.size());
+
+		for(char c : str)
+		{
+			switch(c)
+			{
+				case '"':  { escaped += "\\\""; break; }
+				case '\\': { escaped += "\\\\"; break; }
+				case '\n': { escaped += "\\n"; break; }
+				case '\t': { escaped += "\\t"; break; }
+				default:
+				{
+					if(static_cast<unsigned char>(c) < 0x20)
+					{
+						constexpr std::string_view HEX_DIGITS = "0123456789abcdef";
+						escaped += "\\u00";
+						escaped += HEX_DIGITS[static_cast<unsigned char>(c) >> 4];
+						escaped += HEX_DIGITS[static_cast<unsigned char>(c) & 0xF];
+					}
+					else
+					{
+						escaped += c;
+					}
+					break;
+				}
+			}
+		}
+
+		return escaped;
+	}
+
+	void print_json_stats(std::ostream& out, const PhaseStats& stats, bool with_peak_rss)
+	{
+		out << "{\"wall_ms\": " << to_milliseconds(stats.wall_time)
+			<< ", \"cpu_ms\": " << to_milliseconds(stats.cpu_time)
+			<< ", \"tokens\": " << stats.tokens
+			<< ", \"ast_nodes\": " << stats.ast_nodes
+			<< ", \"operator_match_attempts\": " << stats.operator_match_attempts
+			<< ", \"folded_calls\": " << stats.folded_calls;
+
+		if(with_peak_rss)
+		{
+			out << ", \"peak_rss_bytes\": " << stats.peak_rss;
+		}
+
+		out << "}";
+	}
+
+	void print_table_row(std::ostream& out, std::size_t name_width, std::string_view name, const PhaseStats& stats, bool with_peak_rss)
+	{
+		out << std::left << std::setw(static_cast<int>(name_width)) << name << std::right
+			<< std::setw(COLUMN_WIDTH) << to_milliseconds(stats.wall_time)
+			<< std::setw(COLUMN_WIDTH) << to_milliseconds(stats.cpu_time)
+			<< std::setw(COLUMN_WIDTH) << stats.tokens
+			<< std::setw(COLUMN_WIDTH) << stats.ast_nodes
+			<< std::setw(COLUMN_WIDTH) << stats.operator_match_attempts
+			<< std::setw(COLUMN_WIDTH) << stats.folded_calls;
+
+		if(with_peak_rss)
+		{
+			out << std::setw(COLUMN_WIDTH) << to_mebibytes(stats.peak_rss);
+		}
+
+		out << "\n";
+	}
+
+	void print_table_header(std::ostream& out, std::size_t name_width, std::string_view name, bool with_peak_rss)
+	{
+		out << std::left << std::setw(static_cast<int>(name_width)) << name << std::right
+			<< std::setw(COLUMN_WIDTH) << "wall ms"
+			<< std::setw(COLUMN_WIDTH) << "cpu ms"
+			<< std::setw(COLUMN_WIDTH) << "tokens"
+			<< std::setw(COLUMN_WIDTH) << "ast nodes"
+			<< std::setw(COLUMN_WIDTH) << "op matches"
+			<< std::setw(COLUMN_WIDTH) << "folded";
+
+		if(with_peak_rss)
+		{
+			out << std::setw(COLUMN_WIDTH) << "peak rss MiB";
+		}
+
+		out << "\n";
+	}
+}
+
+std::string_view neon_compiler::stats::phase_to_string(Phase phase)
+{
+	switch(phase)
+	{
+		case Phase::LEX:     { return "lex"; }
+		case Phase::PARSE_A: { return "parse_a"; }
+		case Phase::PARSE_B: { return "parse_b"; }
+		case Phase::RESOLVE: { return "resolve"; }
+		case Phase::TYPE_CHECK: { return "type_check"; }
+		case Phase::EVALUATE: { return "evaluate"; }
+		case Phase::INDEX:   { return "index"; }
+		case Phase::PRINT:   { return "print"; }
+		case Phase::LOWER_IR: { return "lower_ir"; }
+		case Phase::GENERATE: { return "generate"; }
+		case Phase::COMPILE_C: { return "compile_c"; }
+		default: { return "unknown"; }
+	}
+}
+
+PhaseStats& PhaseStats::operator+=(const PhaseStats& other)
+{
+	wall_time += other.wall_time;
+	cpu_time += other.cpu_time;
+	tokens += other.tokens;
+	ast_nodes += other.ast_nodes;
+	operator_match_attempts += other.operator_match_attempts;
+	folded_calls += other.folded_calls;
+	peak_rss = std::max(peak_rss, other.peak_rss);
+
+	return *this;
+}
+
+Measurement::Measurement(CpuClock init_cpu_clock) :
+	cpu_clock{init_cpu_clock},
+	wall_start{std::chrono::steady_clock::now()},
+	cpu_start{get_cpu_time()},
+	operator_match_attempts_start{thread_counters.operator_match_attempts}
+{}
+
+PhaseStats Measurement::stop() const
+{
+	PhaseStats stats{};
+	stats.wall_time = std::chrono::steady_clock::now() - wall_start;
+	stats.cpu_time = get_cpu_time() - cpu_start;
+	stats.operator_match_attempts = thread_counters.operator_match_attempts - operator_match_attempts_start;
+
+	return stats;
+}
+
+std::chrono::nanoseconds Measurement::get_cpu_time() const
+{
+	timespec time{};
+	clock_gettime(cpu_clock == CpuClock::THREAD ? CLOCK_THREAD_CPUTIME_ID : CLOCK_PROCESS_CPUTIME_ID, &time);
+
+	return std::chrono::seconds{time.tv_sec} + std::chrono::nanoseconds{time.tv_nsec};
+}
+
+void CompilationStats::add_file(Phase phase, const std::string& file, const PhaseStats& stats)
+{
+	const std::size_t index = static_cast<std::size_t>(phase);
+
+	files[file][index] += stats;
+	recorded_phases[index] = true;
+	phases[index].tokens += stats.tokens;
+	phases[index].ast_nodes += stats.ast_nodes;
+}
+
+void CompilationStats::add_phase(Phase phase, const PhaseStats& stats)
+{
+	PhaseStats& phase_stats = phases[static_cast<std::size_t>(phase)];
+	recorded_phases[static_cast<std::size_t>(phase)] = true;
+
+	phase_stats.wall_time += stats.wall_time;
+	phase_stats.cpu_time += stats.cpu_time;
+	phase_stats.operator_match_attempts += stats.operator_match_attempts;
+	phase_stats.folded_calls += stats.folded_calls;
+	phase_stats.peak_rss = std::max(phase_stats.peak_rss, get_peak_rss());
+}
+
+const PhaseStats& CompilationStats::get_phase(Phase phase) const
+{
+	return phases[static_cast<std::size_t>(phase)];
+}
+
+bool CompilationStats::is_recorded(Phase phase) const
+{
+	return recorded_phases[static_cast<std::size_t>(phase)];
+}
+
+const std::map<std::string, std::array<PhaseStats, PHASE_COUNT>>& CompilationStats::get_files() const
+{
+	return files;
+}
+
+void CompilationStats::print_table(std::ostream& out) const
+{
+	const std::ios_base::fmtflags flags = out.flags();
+	out << std::fixed << std::setprecision(2);
+
+	print_table_header(out, NAME_WIDTH, "phase", true);
+	for(std::size_t i = 0; i < PHASE_COUNT; ++i)
+	{
+		if(!recorded_phases[i]) { continue; }
+
+		print_table_row(out, NAME_WIDTH, phase_to_string(static_cast<Phase>(i)), phases[i], true);
+	}
+	print_table_row(out, NAME_WIDTH, "total", get_total(), true);
+
+	if(files.empty()) { return; }
+
+	std::size_t file_width{NAME_WIDTH};
+	for(const std::pair<const std::string, std::array<PhaseStats, PHASE_COUNT>>& pair : files)
+	{
+		file_width = std::max(file_width, pair.first.size() + 2);
+	}
+
+	// Per file, all phases together. `print_json` has the breakdown by phase.
+	out << "\n";
+	print_table_header(out, file_width, "file", false);
+	for(const std::pair<const std::string, std::array<PhaseStats, PHASE_COUNT>>& pair : files)
+	{
+		PhaseStats file_total{};
+		for(const PhaseStats& phase_stats : pair.second)
+		{
+			file_total += phase_stats;
+		}
+
+		print_table_row(out, file_width, pair.first, file_total, false);
+	}
+
+	out.flags(flags);
+}
+
+void CompilationStats::print_json(std::ostream& out) const
+{
+	const std::ios_base::fmtflags flags = out.flags();
+	out << std::fixed << std::setprecision(3);
+
+	out << "{\"phases\": {";
+	bool first_phase{true};
+	for(std::size_t i = 0; i < PHASE_COUNT; ++i)
+	{
+		if(!recorded_phases[i]) { continue; }
+
+		out << (first_phase ? "" : ", ") << "\"" << phase_to_string(static_cast<Phase>(i)) << "\": ";
+		first_phase = false;
+		print_json_stats(out, phases[i], true);
+	}
+	out << "}, \"total\": ";
+	print_json_stats(out, get_total(), true);
+
+	out << ", \"files\": {";
+	bool first{true};
+	for(const std::pair<const std::string, std::array<PhaseStats, PHASE_COUNT>>& pair : files)
+	{
+		out << (first ? "" : ", ") << "\"" << escape_json(pair.first) << "\": {";
+		first = false;
+
+		bool first_file_phase{true};
+		for(std::size_t i = 0; i < PHASE_COUNT; ++i)
+		{
+			if(!recorded_phases[i]) { continue; }
+
+			out << (first_file_phase ? "" : ", ") << "\"" << phase_to_string(static_cast<Phase>(i)) << "\": ";
+			first_file_phase = false;
+			print_json_stats(out, pair.second[i], false);
+		}
+
+		out << "}";
+	}
+	out << "}}\n";
+
+	out.flags(flags);
+}
+
+uint64_t CompilationStats::get_peak_rss()
+{
+	rusage usage{};
+	getrusage(RUSAGE_SELF, &usage);
+
+	// Linux reports kibibytes
+	return static_cast<uint64_t>(usage.ru_maxrss) * 1024;
+}
+
+PhaseStats CompilationStats::get_total() const
+{
+	PhaseStats total{};
+
+	for(const PhaseStats& phase_stats : phases)
+	{
+		total += phase_stats;
+	}
+
+	return total;
+}
@@ -0,0 +1,109 @@
+#ifndef COMPILATION_STATS_HPP
+#define COMPILATION_STATS_HPP
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+namespace neon_compiler::stats
+{
+
+enum class Phase
+{
+	LEX,
+	PARSE_A,
+	PARSE_B,
+	RESOLVE,
+	TYPE_CHECK,
+	EVALUATE,
+	INDEX,
+	PRINT,
+	LOWER_IR,
+	GENERATE,
+	COMPILE_C
+};
+
+constexpr std::size_t PHASE_COUNT = 11;
+
+std::string_view phase_to_string(Phase phase);
+
+struct PhaseStats
+{
+	std::chrono::nanoseconds wall_time{0};
+	std::chrono::nanoseconds cpu_time{0};
+	uint64_t tokens{0};
+	uint64_t ast_nodes{0};
+	uint64_t operator_match_attempts{0};
+	/** Calls replaced by their value at compile time (see `evaluation::PureEvaluator::fold_calls`) */
+	uint64_t folded_calls{0};
+	/** Peak resident set size of the process at the end of the phase, in bytes. Not tracked per file. */
+	uint64_t peak_rss{0};
+
+	/** Sums everything but the peak resident set size, of which the maximum is kept */
+	PhaseStats& operator+=(const PhaseStats& other);
+};
+
+enum class CpuClock
+{
+	/** CPU time of the calling thread, for work done on one thread */
+	THREAD,
+	/** CPU time of all threads of the process */
+	PROCESS
+};
+
+/** Measures wall time, CPU time and the calling thread's `ThreadCounters` from construction until `stop`. */
+class Measurement
+{
+public:
+	explicit Measurement(CpuClock init_cpu_clock = CpuClock::THREAD);
+
+	/** Returns what was measured so far. Tokens and AST nodes are left for the caller to fill in. */
+	PhaseStats stop() const;
+private:
+	CpuClock cpu_clock;
+	std::chrono::steady_clock::time_point wall_start;
+	std::chrono::nanoseconds cpu_start;
+	uint64_t operator_match_attempts_start;
+
+	std::chrono::nanoseconds get_cpu_time() const;
+};
+
+/** Wall time, CPU time and counters of a compilation, per phase and per file.
+ * Enabled with `--stats`; printed as a table for people or as JSON for tools. */
+class CompilationStats
+{
+public:
+	/** Adds the measurements of one file. Its tokens and AST nodes also count towards the phase. */
+	void add_file(Phase phase, const std::string& file, const PhaseStats& stats);
+	/** Adds the measurements of a whole phase, which include work not attributed to a file.
+	 * Tokens and AST nodes are ignored, as they come from `add_file`. Records the current peak resident set size.
+	 * Folded calls are only counted for the whole phase. */
+	void add_phase(Phase phase, const PhaseStats& stats);
+
+	const PhaseStats& get_phase(Phase phase) const;
+	/** Whether anything was added for `phase`. Phases that were not are left out when printing,
+	 * e.g. `lower_ir`, `generate` and `compile_c` outside of the build task. */
+	bool is_recorded(Phase phase) const;
+	/** Mapping from file path to stats by phase */
+	const std::map<std::string, std::array<PhaseStats, PHASE_COUNT>>& get_files() const;
+
+	void print_table(std::ostream& out) const;
+	void print_json(std::ostream& out) const;
+
+	/** Peak resident set size of the process so far, in bytes */
+	static uint64_t get_peak_rss();
+private:
+	std::array<PhaseStats, PHASE_COUNT> phases{};
+	std::array<bool, PHASE_COUNT> recorded_phases{};
+	std::map<std::string, std::array<PhaseStats, PHASE_COUNT>> files;
+
+	PhaseStats get_total() const;
+};
+
+}
+
+#endif // COMPILATION_STATS_HPP
@@ -0,0 +1,20 @@
+#ifndef COUNTERS_HPP
+#define COUNTERS_HPP
+
+#include <cstdint>
+
+namespace neon_compiler::stats
+{
+
+/** Events counted on one thread. Read before and after a unit of work to attribute the events in between to it. */
+struct ThreadCounters
+{
+	/** Number of times an operator pattern was tried against the tokens */
+	uint64_t operator_match_attempts{0};
+};
+
+inline thread_local ThreadCounters thread_counters{};
+
+}
+
+#endif // COUNTERS_HPP
@@ -0,0 +1,143 @@
+#include "operator_profiler.hpp"
+
+#include <algorithm>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+
+using namespace neon_compiler::stats;
+using namespace neon_compiler::ast::nodes;
+
+namespace
+{
+	constexpr int COLUMN_WIDTH = 14;
+
+	using Profiles = std::unordered_map<const OperatorDeclaration*, OperatorProfile>;
+
+	std::mutex profiles_mutex;
+	/** Profiles of each thread. Only the owning thread updates its profiles, so profiling takes no lock. */
+	std::vector<std::shared_ptr<Profiles>> thread_profiles;
+
+	Profiles& get_profiles()
+	{
+		thread_local std::shared_ptr<Profiles> profiles = []
+		{
+			const std::lock_guard<std::mutex> lock{profiles_mutex};
+
+			std::shared_ptr<Profiles> new_profiles = std::make_shared<Profiles>();
+			thread_profiles.push_back(new_profiles);
+
+			return new_profiles;
+		}();
+
+		return *profiles;
+	}
+
+	bool is_more_expensive(const OperatorProfileEntry& a, const OperatorProfileEntry& b)
+	{
+		if(a.profile.speculative_tokens != b.profile.speculative_tokens)
+		{
+			return a.profile.speculative_tokens > b.profile.speculative_tokens;
+		}
+
+		if(a.profile.attempts != b.profile.attempts)
+		{
+			return a.profile.attempts > b.profile.attempts;
+		}
+
+		return a.location < b.location;
+	}
+}
+
+OperatorProfile& OperatorProfile::operator+=(const OperatorProfile& other)
+{
+	attempts += other.attempts;
+	speculative_parses += other.speculative_parses;
+	speculative_tokens += other.speculative_tokens;
+	matches += other.matches;
+
+	return *this;
+}
+
+void operator_profiler::enable()
+{
+	state::enabled.store(true, std::memory_order_relaxed);
+}
+
+void operator_profiler::disable()
+{
+	state::enabled.store(false, std::memory_order_relaxed);
+}
+
+void operator_profiler::clear()
+{
+	const std::lock_guard<std::mutex> lock{profiles_mutex};
+
+	for(const std::shared_ptr<Profiles>& profiles : thread_profiles)
+	{
+		profiles->clear();
+	}
+}
+
+OperatorProfile& operator_profiler::get_thread_profile(const OperatorDeclaration* declaration)
+{
+	return get_profiles()[declaration];
+}
+
+Profiles operator_profiler::collect()
+{
+	Profiles collected{};
+
+	const std::lock_guard<std::mutex> lock{profiles_mutex};
+
+	for(const std::shared_ptr<Profiles>& profiles : thread_profiles)
+	{
+		for(const std::pair<const OperatorDeclaration* const, OperatorProfile>& pair : *profiles)
+		{
+			collected[pair.first] += pair.second;
+		}
+	}
+
+	return collected;
+}
+
+void operator_profiler::print_report(std::ostream& out, std::vector<OperatorProfileEntry> entries, std::size_t max_entries)
+{
+	std::sort(entries.begin(), entries.end(), is_more_expensive);
+
+	if(entries.size() > max_entries)
+	{
+		entries.resize(max_entries);
+	}
+
+	const std::ios_base::fmtflags flags = out.flags();
+
+	out << std::right
+		<< std::setw(COLUMN_WIDTH) << "attempts"
+		<< std::setw(COLUMN_WIDTH) << "matches"
+		<< std::setw(COLUMN_WIDTH) << "sub-parses"
+		<< std::setw(COLUMN_WIDTH) << "sub-tokens"
+		<< "  operator\n";
+
+	for(const OperatorProfileEntry& entry : entries)
+	{
+		out << std::setw(COLUMN_WIDTH) << entry.profile.attempts
+			<< std::setw(COLUMN_WIDTH) << entry.profile.matches
+			<< std::setw(COLUMN_WIDTH) << entry.profile.speculative_parses
+			<< std::setw(COLUMN_WIDTH) << entry.profile.speculative_tokens
+			<< "  `" << entry.pattern << "`";
+
+		if(entry.operator_module.empty())
+		{
+			out << " (built-in)";
+		}
+		else
+		{
+			out << " in " << entry.operator_module << " at " << entry.location;
+		}
+
+		out << "\n";
+	}
+
+	out.flags(flags);
+}
@@ -0,0 +1,79 @@
+#ifndef OPERATOR_PROFILER_HPP
+#define OPERATOR_PROFILER_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// forward declaration
+namespace neon_compiler::ast::nodes
+{
+	struct OperatorDeclaration;
+}
+
+namespace neon_compiler::stats
+{
+
+/** How much matching one operator cost */
+struct OperatorProfile
+{
+	/** Number of times the pattern was tried against the tokens */
+	uint64_t attempts{0};
+	/** Number of expressions parsed ahead for parameters of the pattern, whether the pattern matched or not */
+	uint64_t speculative_parses{0};
+	/** Number of tokens covered by those expressions, including those of nested operators */
+	uint64_t speculative_tokens{0};
+	uint64_t matches{0};
+
+	OperatorProfile& operator+=(const OperatorProfile& other);
+};
+
+/** Profile of an operator, with what identifies it in a report */
+struct OperatorProfileEntry
+{
+	/** Pattern as written in the declaration, e.g. `__ + __` */
+	std::string pattern;
+	/** Identifier of the operator module declaring the operator; empty for built-in operators */
+	std::string operator_module;
+	/** `file:line:column` of the declaration; empty for built-in operators */
+	std::string location;
+	OperatorProfile profile;
+};
+
+namespace operator_profiler
+{
+
+namespace state
+{
+	inline std::atomic<bool> enabled{false};
+}
+
+/** Whether operator matching is profiled. When disabled, profiling costs this one check per operator tried. */
+inline bool is_enabled()
+{
+	return state::enabled.load(std::memory_order_relaxed);
+}
+
+void enable();
+void disable();
+/** Removes all profiles. Must not run while other threads are matching operators. */
+void clear();
+
+/** Profile of `declaration` on the calling thread. Profiles are kept by declaration address,
+ * so clear them before declarations are replaced, e.g. between incremental analyses. */
+OperatorProfile& get_thread_profile(const neon_compiler::ast::nodes::OperatorDeclaration* declaration);
+
+/** Profiles of all threads, summed per declaration. Threads matching operators at the same time are not included consistently. */
+std::unordered_map<const neon_compiler::ast::nodes::OperatorDeclaration*, OperatorProfile> collect();
+
+/** Ranks `entries` by the tokens parsed ahead, then by attempts, and prints the first `max_entries` as a table. */
+void print_report(std::ostream& out, std::vector<OperatorProfileEntry> entries, std::size_t max_entries);
+
+}
+
+}
+
+#endif // OPERATOR_PROFILER_HPP
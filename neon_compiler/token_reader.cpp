@@ -35,3 +35,8 @@ void TokenReader::reset()
 {
 	reading_index = 0;
 }
+
+uint TokenReader::get_position() const
+{
+	return reading_index;
+}
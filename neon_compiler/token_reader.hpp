@@ -16,6 +16,8 @@ namespace neon_compiler
 		const neon_compiler::Token& peek(uint offset = 0) const;
 		bool end_of_file_reached(uint offset = 0) const;
 		void reset();
+		/** Index of the token that `peek()` returns */
+		uint get_position() const;
 
 	private:
 		std::span<const neon_compiler::Token> tokens;
@@ -0,0 +1,168 @@
+#include "trace.hpp"
+
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+using namespace neon_compiler::trace;
+
+namespace
+{
+	struct TraceEvent
+	{
+		std::string_view name;
+		std::string detail;
+		std::chrono::nanoseconds start;
+		std::chrono::nanoseconds duration;
+	};
+
+	/** Events of one thread. Only that thread appends, so recording takes no lock. */
+	struct ThreadBuffer
+	{
+		uint32_t thread_id;
+		std::vector<TraceEvent> events;
+	};
+
+	std::mutex buffers_mutex;
+	std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+	/** Start of the trace, in nanoseconds since the epoch of `steady_clock`. Zero until tracing is first enabled. */
+	std::atomic<int64_t> trace_start{0};
+
+	ThreadBuffer& get_thread_buffer()
+	{
+		thread_local std::shared_ptr<ThreadBuffer> buffer = []
+		{
+			const std::lock_guard<std::mutex> lock{buffers_mutex};
+
+			std::shared_ptr<ThreadBuffer> new_buffer = std::make_shared<ThreadBuffer>();
+			new_buffer->thread_id = static_cast<uint32_t>(buffers.size() + 1);
+			buffers.push_back(new_buffer);
+
+			return new_buffer;
+		}();
+
+		return *buffer;
+	}
+
+	std::chrono::nanoseconds since_trace_start(std::chrono::steady_clock::time_point time_point)
+	{
+		return time_point.time_since_epoch() - std::chrono::nanoseconds{trace_start.load(std::memory_order_relaxed)};
+	}
+
+	double to_microseconds(std::chrono::nanoseconds duration)
+	{
+		return std::chrono::duration<double, std::micro>{duration}.count();
+	}
+
+	void write_json_string(std::ostream& out, std::string_view str)
+	{
+		out << '"';
+
+		for(char c : str)
+		{
+			switch(c)
+			{
+				case '"':  { out << "\\\""; break; }
+				case '\\': { out << "\\\\"; break; }
+				case '\n': { out << "\\n"; break; }
+				case '\t': { out << "\\t"; break; }
+				default:
+				{
+					if(static_cast<unsigned char>(c) < 0x20)
+					{
+						out << "\\u00" << std::hex << std::setw(2) << std::setfill('0')
+							<< static_cast<int>(c) << std::dec << std::setfill(' ');
+					}
+					else
+					{
+						out << c;
+					}
+					break;
+				}
+			}
+		}
+
+		out << '"';
+	}
+}
+
+void neon_compiler::trace::enable()
+{
+	int64_t expected{0};
+	trace_start.compare_exchange_strong
+	(
+		expected,
+		std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count()
+	);
+
+	state::enabled.store(true, std::memory_order_release);
+}
+
+void neon_compiler::trace::disable()
+{
+	state::enabled.store(false, std::memory_order_release);
+}
+
+void neon_compiler::trace::clear()
+{
+	const std::lock_guard<std::mutex> lock{buffers_mutex};
+
+	for(const std::shared_ptr<ThreadBuffer>& buffer : buffers)
+	{
+		buffer->events.clear();
+	}
+}
+
+void neon_compiler::trace::write_chrome_trace(std::ostream& out)
+{
+	const std::lock_guard<std::mutex> lock{buffers_mutex};
+
+	const std::ios_base::fmtflags flags = out.flags();
+	out << std::fixed << std::setprecision(3);
+
+	out << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n";
+	out << "{\"name\": \"process_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": 0, \"args\": {\"name\": \"neon_compiler\"}}";
+
+	for(const std::shared_ptr<ThreadBuffer>& buffer : buffers)
+	{
+		out << ",\n{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": " << buffer->thread_id
+			<< ", \"args\": {\"name\": \"thread " << buffer->thread_id << "\"}}";
+
+		for(const TraceEvent& event : buffer->events)
+		{
+			out << ",\n{\"name\": ";
+			write_json_string(out, event.name);
+			out << ", \"cat\": \"neon\", \"ph\": \"X\", \"pid\": 1, \"tid\": " << buffer->thread_id
+				<< ", \"ts\": " << to_microseconds(event.start)
+				<< ", \"dur\": " << to_microseconds(event.duration);
+
+			if(!event.detail.empty())
+			{
+				out << ", \"args\": {\"detail\": ";
+				write_json_string(out, event.detail);
+				out << "}";
+			}
+
+			out << "}";
+		}
+	}
+
+	out << "\n]}\n";
+
+	out.flags(flags);
+}
+
+void Span::begin(std::string_view init_name)
+{
+	recording = true;
+	name = init_name;
+	start = std::chrono::steady_clock::now();
+}
+
+void Span::end()
+{
+	const std::chrono::steady_clock::time_point end_time = std::chrono::steady_clock::now();
+
+	get_thread_buffer().events.push_back(TraceEvent{name, std::move(detail), since_trace_start(start), end_time - start});
+}
@@ -0,0 +1,76 @@
+#ifndef TRACE_HPP
+#define TRACE_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+namespace neon_compiler::trace
+{
+
+namespace state
+{
+	inline std::atomic<bool> enabled{false};
+}
+
+/** Whether spans are recorded. When disabled, a span costs this one check. */
+inline bool is_enabled()
+{
+	return state::enabled.load(std::memory_order_relaxed);
+}
+
+/** Starts recording spans. Timestamps are relative to the first time tracing is enabled. */
+void enable();
+void disable();
+/** Removes all recorded spans */
+void clear();
+/** Writes all recorded spans in the Chrome trace event format, loadable in Perfetto and `chrome://tracing`.
+ * Threads recording spans at the same time are not included consistently. */
+void write_chrome_trace(std::ostream& out);
+
+/** Records the time from construction to destruction as one trace event on the calling thread.
+ * `name` must outlive the span; string literals are expected. */
+class Span
+{
+public:
+	explicit Span(std::string_view init_name)
+	{
+		if(is_enabled()) { begin(init_name); }
+	}
+
+	~Span()
+	{
+		if(recording) { end(); }
+	}
+
+	Span(const Span&) = delete;
+	Span& operator=(const Span&) = delete;
+
+	/** Whether this span is recorded. Check before building a detail. */
+	bool is_recording() const
+	{
+		return recording;
+	}
+
+	/** Shown as an argument of the event, e.g. the file being parsed */
+	void set_detail(std::string new_detail)
+	{
+		detail = std::move(new_detail);
+	}
+
+private:
+	bool recording{false};
+	std::string_view name;
+	std::string detail;
+	std::chrono::steady_clock::time_point start;
+
+	void begin(std::string_view init_name);
+	void end();
+};
+
+}
+
+#endif // TRACE_HPP
@@ -0,0 +1,114 @@
+#include "overload_cache.hpp"
+
+#include <algorithm>
+
+using namespace neon_compiler::ast::nodes;
+using namespace neon_compiler::type_checking;
+
+namespace
+{
+	/** Hashed in place of an argument type that is not known */
+	constexpr std::size_t UNKNOWN_TYPE_HASH = 0x9e3779b97f4a7c15;
+
+	std::size_t combine(std::size_t seed, std::size_t value)
+	{
+		return seed ^ (value + 0x9e3779b97f4a7c15 + (seed << 6) + (seed >> 2));
+	}
+}
+
+OverloadResolution OverloadCache::resolve
+(
+	DeclarationId callee,
+	ArgumentTypes argument_types,
+	const std::function<OverloadResolution()>& resolve
+)
+{
+	const std::size_t key_hash = hash(callee, argument_types);
+	Shard& shard = shards[key_hash % SHARD_COUNT];
+
+	{
+		const std::lock_guard<std::mutex> lock{shard.mutex};
+		const ResolutionMap::const_iterator it = shard.resolutions.find(KeyView{callee, argument_types, key_hash});
+
+		if(it != shard.resolutions.end())
+		{
+			++hit_count;
+			return it->second;
+		}
+	}
+
+	// Resolved without the lock, so that other threads are not held up. Another thread resolving the same key
+	// at the same time gets the same result, so whichever is stored first is kept.
+	const OverloadResolution resolution = resolve();
+	++miss_count;
+
+	const std::lock_guard<std::mutex> lock{shard.mutex};
+	shard.resolutions.emplace(Key{callee, {argument_types.begin(), argument_types.end()}, key_hash}, resolution);
+
+	return resolution;
+}
+
+uint64_t OverloadCache::get_hit_count() const
+{
+	return hit_count;
+}
+
+uint64_t OverloadCache::get_miss_count() const
+{
+	return miss_count;
+}
+
+bool OverloadCache::KeyEqual::operator()(const Key& a, const Key& b) const
+{
+	return equal(a.callee, a.argument_types, b.callee, b.argument_types);
+}
+
+bool OverloadCache::KeyEqual::operator()(const KeyView& a, const Key& b) const
+{
+	return equal(a.callee, a.argument_types, b.callee, b.argument_types);
+}
+
+bool OverloadCache::KeyEqual::operator()(const Key& a, const KeyView& b) const
+{
+	return equal(a.callee, a.argument_types, b.callee, b.argument_types);
+}
+
+std::size_t OverloadCache::hash(DeclarationId callee, ArgumentTypes argument_types)
+{
+	std::size_t seed = std::hash<DeclarationId>{}(callee);
+
+	for(const std::optional<ValueType>& type : argument_types)
+	{
+		if(!type.has_value())
+		{
+			seed = combine(seed, UNKNOWN_TYPE_HASH);
+		}
+		else
+		{
+			seed = combine(seed, std::hash<DeclarationId>{}(type->declaration));
+			seed = combine(seed, std::hash<std::string_view>{}(type->name));
+		}
+	}
+
+	return seed;
+}
+
+bool OverloadCache::equal
+(
+	DeclarationId callee_a,
+	ArgumentTypes argument_types_a,
+	DeclarationId callee_b,
+	ArgumentTypes argument_types_b
+)
+{
+	return callee_a == callee_b && std::equal
+	(
+		argument_types_a.begin(), argument_types_a.end(),
+		argument_types_b.begin(), argument_types_b.end(),
+		[] (const std::optional<ValueType>& a, const std::optional<ValueType>& b)
+		{
+			if(!a.has_value() || !b.has_value()) { return a.has_value() == b.has_value(); }
+			return a->declaration == b->declaration && a->name == b->name;
+		}
+	);
+}
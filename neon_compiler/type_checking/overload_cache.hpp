@@ -0,0 +1,117 @@
+#ifndef OVERLOAD_CACHE_HPP
+#define OVERLOAD_CACHE_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <unordered_map>
+#include <vector>
+#include "value_type.hpp"
+#include "../ast/nodes/nodes.hpp"
+
+namespace neon_compiler::type_checking
+{
+
+enum class OverloadStatus
+{
+	MATCHED,
+	/** Several overloads match, which happens while argument types are unknown */
+	AMBIGUOUS,
+	NO_ARGUMENT_COUNT_MATCH,
+	NO_ARGUMENT_TYPES_MATCH
+};
+
+struct OverloadResolution
+{
+	OverloadStatus status;
+	/** Index of the matching overload in the nodes of the callee declaration. Only meaningful if `MATCHED`. */
+	std::size_t overload_index;
+};
+
+/** Results of overload resolution by callee declaration and argument types, shared by the threads of a type check.
+ * A call with the same callee and argument types as an earlier one is resolved by one hash lookup,
+ * without scanning the overloads. Locks one of several shards per access, so threads seldom wait for each other.
+ *
+ * Keys refer to the type names in the AST and the resolution, so a cache is only valid for one type check. */
+class OverloadCache
+{
+public:
+	using ArgumentTypes = std::span<const std::optional<ValueType>>;
+
+	/** Returns the cached resolution, or calls `resolve` and caches its result */
+	OverloadResolution resolve
+	(
+		neon_compiler::ast::nodes::DeclarationId callee,
+		ArgumentTypes argument_types,
+		const std::function<OverloadResolution()>& resolve
+	);
+
+	uint64_t get_hit_count() const;
+	uint64_t get_miss_count() const;
+
+private:
+	static constexpr std::size_t SHARD_COUNT = 16;
+
+	struct Key
+	{
+		neon_compiler::ast::nodes::DeclarationId callee;
+		std::vector<std::optional<ValueType>> argument_types;
+		std::size_t hash;
+	};
+
+	/** A key to look up without copying the argument types */
+	struct KeyView
+	{
+		neon_compiler::ast::nodes::DeclarationId callee;
+		ArgumentTypes argument_types;
+		std::size_t hash;
+	};
+
+	struct KeyHash
+	{
+		using is_transparent = void;
+
+		std::size_t operator()(const Key& key) const { return key.hash; }
+		std::size_t operator()(const KeyView& key) const { return key.hash; }
+	};
+
+	struct KeyEqual
+	{
+		using is_transparent = void;
+
+		bool operator()(const Key& a, const Key& b) const;
+		bool operator()(const KeyView& a, const Key& b) const;
+		bool operator()(const Key& a, const KeyView& b) const;
+	};
+
+	using ResolutionMap = std::unordered_map<Key, OverloadResolution, KeyHash, KeyEqual>;
+
+	struct Shard
+	{
+		std::mutex mutex;
+		ResolutionMap resolutions;
+	};
+
+	std::array<Shard, SHARD_COUNT> shards;
+	std::atomic<uint64_t> hit_count{0};
+	std::atomic<uint64_t> miss_count{0};
+
+	static std::size_t hash(neon_compiler::ast::nodes::DeclarationId callee, ArgumentTypes argument_types);
+	/** Unlike `ValueType::operator==`, an unknown type only equals an unknown type, and names are always compared */
+	static bool equal
+	(
+		neon_compiler::ast::nodes::DeclarationId callee_a,
+		ArgumentTypes argument_types_a,
+		neon_compiler::ast::nodes::DeclarationId callee_b,
+		ArgumentTypes argument_types_b
+	);
+};
+
+}
+
+#endif // OVERLOAD_CACHE_HPP
@@ -0,0 +1,712 @@
+#include "type_checker.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "value_type.hpp"
+#include "../ast/nodes/statement_nodes.hpp"
+#include "../evaluation/bytecode.hpp"
+#include "../trace/trace.hpp"
+
+using namespace neon_compiler;
+using namespace neon_compiler::analysis;
+using namespace neon_compiler::ast;
+using namespace neon_compiler::ast::nodes;
+using namespace neon_compiler::resolution;
+using namespace neon_compiler::type_checking;
+
+namespace
+{
+	/** Length reported for expressions that do not start with their name */
+	constexpr uint32_t DEFAULT_REPORT_LENGTH = 1;
+
+	struct Diagnostic
+	{
+		reading::SourcePosition source_position;
+		uint32_t length;
+		std::string message;
+	};
+
+	/** Parameters and return type of one overload of a function */
+	struct Signature
+	{
+		const ParameterDeclarationList* parameters;
+		std::optional<ValueType> return_type;
+	};
+
+	/** What a `ret` statement in a body must return */
+	struct ReturnContext
+	{
+		/** False for bodies whose return values are not checked (e.g. entrypoints) */
+		bool checked;
+		/** Whether a value may be returned at all */
+		bool returns_value;
+		std::optional<ValueType> type;
+	};
+
+	/** Checks the bodies of one package member, collecting its diagnostics */
+	class PackageMemberChecker
+	{
+	public:
+		PackageMemberChecker
+		(
+			const Resolution& init_resolution,
+			const std::unordered_map<DeclarationId, TypeSnapshot>& init_type_snapshots,
+			OverloadCache& init_overload_cache
+		) :
+			resolution{init_resolution},
+			type_snapshots{init_type_snapshots},
+			overload_cache{init_overload_cache}
+		{}
+
+		std::vector<Diagnostic> diagnostics;
+
+		void check(const PackageMember& package_member)
+		{
+			if(const Entrypoint* entrypoint = dynamic_cast<const Entrypoint*>(&package_member))
+			{
+				check_code_block(entrypoint->body, ReturnContext{false, true, std::nullopt});
+			}
+			else if(const Type* type = dynamic_cast<const Type*>(&package_member))
+			{
+				for(const std::pair<const std::string, std::vector<Method>>& overloads : type->methods)
+				{
+					for(const Method& method : overloads.second)
+					{
+						if(!method.implementation.has_value()) { continue; }
+
+						const ReturnContext return_context
+						{
+							true,
+							method.return_type.has_value(),
+							method.return_type.has_value() ? get_value_type(method.return_type.value()) : std::nullopt
+						};
+						check_code_block(method.implementation.value(), return_context);
+					}
+				}
+				for(const std::pair<const std::string, std::vector<PureFunction>>& overloads : type->pure_functions)
+				{
+					for(const PureFunction& pure_function : overloads.second) { check_pure_function(pure_function); }
+				}
+			}
+			else if(const PureFunctionSet* pure_function_set = dynamic_cast<const PureFunctionSet*>(&package_member))
+			{
+				for(const std::pair<const std::string, std::vector<PureFunction>>& overloads : pure_function_set->methods)
+				{
+					for(const PureFunction& pure_function : overloads.second) { check_pure_function(pure_function); }
+				}
+			}
+			else if(const OperatorModule* operator_module = dynamic_cast<const OperatorModule*>(&package_member))
+			{
+				for(const OperatorFunction& operator_function : operator_module->functions)
+				{
+					check_code_block(operator_function.body, ReturnContext{true, true, get_value_type(operator_function.return_type)});
+				}
+			}
+			else if(const CompileFunction* compile_function = dynamic_cast<const CompileFunction*>(&package_member))
+			{
+				in_compile_function = true;
+				check_code_block(compile_function->body, ReturnContext{false, true, std::nullopt});
+			}
+		}
+
+	private:
+		const Resolution& resolution;
+		const std::unordered_map<DeclarationId, TypeSnapshot>& type_snapshots;
+		OverloadCache& overload_cache;
+		/** Whether intrinsics may be called */
+		bool in_compile_function{false};
+
+		void report(const Expression& expression, std::size_t length, std::string message)
+		{
+			diagnostics.push_back(Diagnostic{expression.source_position, static_cast<uint32_t>(length), std::move(message)});
+		}
+
+		/** Empty for generic parameters and other declarations that are not types */
+		std::optional<ValueType> get_value_type(const ReferenceType& reference_type) const
+		{
+			if(reference_type.declaration == UNRESOLVED_DECLARATION)
+			{
+				return ValueType{UNRESOLVED_DECLARATION, reference_type.type};
+			}
+
+			return get_declared_type(reference_type.declaration);
+		}
+
+		std::optional<ValueType> get_declared_type(DeclarationId id) const
+		{
+			const Declaration& declaration = resolution.get_declaration(id);
+
+			if(declaration.kind != DeclarationKind::TYPE) { return std::nullopt; }
+
+			return ValueType{id, declaration.name};
+		}
+
+		const TypeSnapshot* find_type_snapshot(const std::optional<ValueType>& type) const
+		{
+			if(!type.has_value()) { return nullptr; }
+
+			const std::unordered_map<DeclarationId, TypeSnapshot>::const_iterator it = type_snapshots.find(type->declaration);
+			return it == type_snapshots.end() ? nullptr : &it->second;
+		}
+
+		void check_pure_function(const PureFunction& pure_function)
+		{
+			if(!pure_function.implementation.has_value()) { return; }
+
+			check_code_block(pure_function.implementation.value(), ReturnContext{true, true, get_value_type(pure_function.return_type)});
+		}
+
+		void check_code_block(const CodeBlock& code_block, const ReturnContext& return_context)
+		{
+			for(const std::unique_ptr<Statement>& statement : code_block.statements)
+			{
+				if(!statement) { continue; }
+
+				if(const DiscardExpression* discard = dynamic_cast<const DiscardExpression*>(statement.get()))
+				{
+					check_optional_expression(discard->expression.get());
+				}
+				else if(const Return* ret = dynamic_cast<const Return*>(statement.get()))
+				{
+					check_return(*ret, return_context);
+				}
+				else if(const LocalDeclaration* local = dynamic_cast<const LocalDeclaration*>(statement.get()))
+				{
+					check_variable_declaration(local->variable_declaration);
+				}
+			}
+		}
+
+		void check_return(const Return& ret, const ReturnContext& return_context)
+		{
+			if(!ret.value) { return; }
+
+			const std::optional<ValueType> type = check_expression(*ret.value);
+
+			if(!return_context.checked) { return; }
+
+			if(!return_context.returns_value)
+			{
+				report(*ret.value, DEFAULT_REPORT_LENGTH, std::string{type_checker_error_messages::VALUE_RETURNED_FROM_VOID});
+			}
+			else if(!matches(type, return_context.type))
+			{
+				report
+				(
+					*ret.value,
+					DEFAULT_REPORT_LENGTH,
+					std::string{type_checker_error_messages::RETURNED_TYPE_MISMATCH} + std::string{to_string(return_context.type)}
+				);
+			}
+		}
+
+		void check_variable_declaration(const VariableDeclaration& variable_declaration)
+		{
+			if(!variable_declaration.initialisation) { return; }
+
+			const std::optional<ValueType> type = check_expression(*variable_declaration.initialisation);
+			const std::optional<ValueType> expected = get_value_type(variable_declaration.reference_type);
+
+			if(!matches(type, expected))
+			{
+				report
+				(
+					*variable_declaration.initialisation,
+					DEFAULT_REPORT_LENGTH,
+					std::string{type_checker_error_messages::ASSIGNED_TYPE_MISMATCH} + std::string{to_string(expected)}
+				);
+			}
+		}
+
+		std::optional<ValueType> check_optional_expression(const Expression* expression)
+		{
+			return expression ? check_expression(*expression) : std::nullopt;
+		}
+
+		std::vector<std::optional<ValueType>> check_arguments(const std::vector<std::unique_ptr<Expression>>& arguments)
+		{
+			std::vector<std::optional<ValueType>> types;
+			types.reserve(arguments.size());
+
+			for(const std::unique_ptr<Expression>& argument : arguments)
+			{
+				types.push_back(check_optional_expression(argument.get()));
+			}
+
+			return types;
+		}
+
+		std::optional<ValueType> check_expression(const Expression& expression)
+		{
+			if(const SimpleRead* read = dynamic_cast<const SimpleRead*>(&expression))
+			{
+				return check_simple_read(*read);
+			}
+			if(const FunctionCall* call = dynamic_cast<const FunctionCall*>(&expression))
+			{
+				return check_function_call(*call);
+			}
+			if(const ObjectRead* object_read = dynamic_cast<const ObjectRead*>(&expression))
+			{
+				return check_object_read(*object_read);
+			}
+			if(const ObjectFunctionCall* object_call = dynamic_cast<const ObjectFunctionCall*>(&expression))
+			{
+				return check_object_function_call(*object_call);
+			}
+			if(const Assignment* assignment = dynamic_cast<const Assignment*>(&expression))
+			{
+				return check_assignment(*assignment);
+			}
+			if(const OperatorCallExpression* operator_call = dynamic_cast<const OperatorCallExpression*>(&expression))
+			{
+				check_arguments(operator_call->arguments);
+			}
+			else if(const OptFunctionCall* opt_call = dynamic_cast<const OptFunctionCall*>(&expression))
+			{
+				check_arguments(opt_call->arguments);
+			}
+
+			return std::nullopt;
+		}
+
+		std::optional<ValueType> check_simple_read(const SimpleRead& read)
+		{
+			if(read.declaration == UNRESOLVED_DECLARATION)
+			{
+				report(read, read.reference_name.size(), std::string{type_checker_error_messages::UNRESOLVED_READ} + read.reference_name);
+				return std::nullopt;
+			}
+
+			const Declaration& declaration = resolution.get_declaration(read.declaration);
+
+			switch(declaration.kind)
+			{
+				case DeclarationKind::PARAMETER:
+				case DeclarationKind::LOCAL:
+				{
+					return get_value_type(static_cast<const VariableDeclaration*>(declaration.nodes.front())->reference_type);
+				}
+				case DeclarationKind::FIELD:
+				{
+					return get_value_type(static_cast<const Field*>(declaration.nodes.front())->reference_type);
+				}
+				case DeclarationKind::CONSTANT:
+				{
+					return get_value_type(static_cast<const Constant*>(declaration.nodes.front())->type);
+				}
+				case DeclarationKind::GENERIC_PARAMETER:
+				{
+					return std::nullopt;
+				}
+				default:
+				{
+					report(read, read.reference_name.size(), std::string{type_checker_error_messages::NOT_A_VALUE} + read.reference_name);
+					return std::nullopt;
+				}
+			}
+		}
+
+		std::optional<ValueType> check_function_call(const FunctionCall& call)
+		{
+			const std::vector<std::optional<ValueType>> argument_types = check_arguments(call.arguments);
+
+			if(call.declaration == UNRESOLVED_DECLARATION)
+			{
+				if(!is_runtime_function(call.function_name))
+				{
+					report(call, call.function_name.size(), std::string{type_checker_error_messages::UNRESOLVED_CALL} + call.function_name);
+				}
+				return std::nullopt;
+			}
+
+			switch(resolution.get_declaration(call.declaration).kind)
+			{
+				case DeclarationKind::TYPE:
+				{
+					// Constructors are not declared yet, so only the type of the result is known
+					return get_declared_type(call.declaration);
+				}
+				case DeclarationKind::ENTRYPOINT:
+				case DeclarationKind::METHOD:
+				case DeclarationKind::PURE_FUNCTION:
+				{
+					return check_call(call.declaration, argument_types, call, call.function_name.size(), call.function_name);
+				}
+				default:
+				{
+					report(call, call.function_name.size(), std::string{type_checker_error_messages::NOT_CALLABLE} + call.function_name);
+					return std::nullopt;
+				}
+			}
+		}
+
+		/** Whether `name` is provided without declaration where it is called */
+		bool is_runtime_function(std::string_view name) const
+		{
+			if(name == PRINT_FUNCTION) { return true; }
+			if(!in_compile_function) { return false; }
+
+			return std::any_of(std::begin(evaluation::INTRINSICS), std::end(evaluation::INTRINSICS),
+				[name] (const evaluation::IntrinsicInfo& intrinsic) { return intrinsic.name == name; });
+		}
+
+		std::optional<ValueType> check_object_read(const ObjectRead& read)
+		{
+			return get_member_type(check_object_read_member(read));
+		}
+
+		/** Checks the object of a read, and finds the field or constant read. Null if the type of the object is not known. */
+		const TypeMember* check_object_read_member(const ObjectRead& read)
+		{
+			const std::optional<ValueType> object_type = check_optional_expression(read.object.get());
+			const TypeSnapshot* snapshot = find_type_snapshot(object_type);
+
+			if(!snapshot) { return nullptr; }
+
+			const TypeMember* member = snapshot->find(read.member_name);
+
+			if(member && (member->field || member->constant)) { return member; }
+
+			report
+			(
+				read,
+				DEFAULT_REPORT_LENGTH,
+				std::string{type_checker_error_messages::UNKNOWN_MEMBER} + std::string{object_type->name} + "::" + read.member_name
+			);
+			return nullptr;
+		}
+
+		std::optional<ValueType> get_member_type(const TypeMember* member) const
+		{
+			if(member && member->field) { return get_value_type(member->field->reference_type); }
+			if(member && member->constant) { return get_value_type(member->constant->type); }
+			return std::nullopt;
+		}
+
+		std::optional<ValueType> check_object_function_call(const ObjectFunctionCall& call)
+		{
+			const std::optional<ValueType> object_type = check_optional_expression(call.object.get());
+			const std::vector<std::optional<ValueType>> argument_types = check_arguments(call.arguments);
+			const TypeSnapshot* snapshot = find_type_snapshot(object_type);
+
+			if(!snapshot) { return std::nullopt; }
+
+			const TypeMember* member = snapshot->find(call.member_name);
+			const std::string name = std::string{object_type->name} + "::" + call.member_name;
+
+			if(!member || !is_callable(member->declaration))
+			{
+				report(call, DEFAULT_REPORT_LENGTH, std::string{type_checker_error_messages::UNKNOWN_MEMBER} + name);
+				return std::nullopt;
+			}
+
+			return check_call(member->declaration, argument_types, call, DEFAULT_REPORT_LENGTH, name);
+		}
+
+		std::optional<ValueType> check_assignment(const Assignment& assignment)
+		{
+			std::optional<ValueType> target_type;
+			bool reassignable{true};
+			std::string target_name{UNKNOWN_TYPE_NAME};
+
+			if(const ObjectRead* read = dynamic_cast<const ObjectRead*>(assignment.target.get()))
+			{
+				const TypeMember* member = check_object_read_member(*read);
+
+				target_type = get_member_type(member);
+				reassignable = !member || (member->field && member->field->var);
+				target_name = read->member_name;
+			}
+			else
+			{
+				target_type = check_optional_expression(assignment.target.get());
+
+				if(const SimpleRead* simple_read = dynamic_cast<const SimpleRead*>(assignment.target.get()))
+				{
+					reassignable = is_reassignable(*simple_read);
+					target_name = simple_read->reference_name;
+				}
+			}
+
+			const std::optional<ValueType> value_type = check_optional_expression(assignment.value.get());
+
+			if(!reassignable)
+			{
+				report(*assignment.target, DEFAULT_REPORT_LENGTH, std::string{type_checker_error_messages::NOT_REASSIGNABLE} + target_name);
+			}
+			else if(assignment.value && !matches(value_type, target_type))
+			{
+				report
+				(
+					*assignment.value,
+					DEFAULT_REPORT_LENGTH,
+					std::string{type_checker_error_messages::ASSIGNED_TYPE_MISMATCH} + std::string{to_string(target_type)}
+				);
+			}
+
+			return target_type;
+		}
+
+		/** False for variables and fields without `var`, and for constants */
+		bool is_reassignable(const SimpleRead& read) const
+		{
+			if(read.declaration == UNRESOLVED_DECLARATION) { return true; }
+
+			const Declaration& declaration = resolution.get_declaration(read.declaration);
+
+			switch(declaration.kind)
+			{
+				case DeclarationKind::PARAMETER:
+				case DeclarationKind::LOCAL:    return static_cast<const VariableDeclaration*>(declaration.nodes.front())->var;
+				case DeclarationKind::FIELD:    return static_cast<const Field*>(declaration.nodes.front())->var;
+				case DeclarationKind::CONSTANT: return false;
+				default:                        return true;
+			}
+		}
+
+		bool is_callable(DeclarationId id) const
+		{
+			if(id == UNRESOLVED_DECLARATION) { return false; }
+
+			const DeclarationKind kind = resolution.get_declaration(id).kind;
+			return kind == DeclarationKind::METHOD || kind == DeclarationKind::PURE_FUNCTION;
+		}
+
+		/** `overload` is one of the nodes of a declaration of an entrypoint, method or pure function */
+		Signature get_signature(DeclarationKind kind, const ASTNode& overload) const
+		{
+			switch(kind)
+			{
+				case DeclarationKind::ENTRYPOINT:
+				{
+					return Signature{&static_cast<const Entrypoint&>(overload).parameters, std::nullopt};
+				}
+				case DeclarationKind::METHOD:
+				{
+					const Method& method = static_cast<const Method&>(overload);
+					return Signature
+					{
+						&method.parameters,
+						method.return_type.has_value() ? get_value_type(method.return_type.value()) : std::nullopt
+					};
+				}
+				default:
+				{
+					const PureFunction& pure_function = static_cast<const PureFunction&>(overload);
+					return Signature{&pure_function.parameters, get_value_type(pure_function.return_type)};
+				}
+			}
+		}
+
+		/** Scans the overloads of `callee` for the ones taking arguments of these types */
+		OverloadResolution resolve_overload(DeclarationId callee, const std::vector<std::optional<ValueType>>& argument_types) const
+		{
+			const Declaration& declaration = resolution.get_declaration(callee);
+			bool argument_count_matched{false};
+			std::size_t match_index{0};
+			std::size_t match_count{0};
+
+			for(std::size_t overload_index = 0; overload_index < declaration.nodes.size(); ++overload_index)
+			{
+				const Signature signature = get_signature(declaration.kind, *declaration.nodes[overload_index]);
+
+				if(signature.parameters->size() != argument_types.size()) { continue; }
+
+				argument_count_matched = true;
+
+				bool arguments_matched{true};
+				for(std::size_t i = 0; i < argument_types.size() && arguments_matched; ++i)
+				{
+					arguments_matched = matches(argument_types[i], get_value_type((*signature.parameters)[i].reference_type));
+				}
+
+				if(arguments_matched)
+				{
+					match_index = overload_index;
+					++match_count;
+				}
+			}
+
+			if(!argument_count_matched) { return OverloadResolution{OverloadStatus::NO_ARGUMENT_COUNT_MATCH, 0}; }
+			if(match_count == 0)        { return OverloadResolution{OverloadStatus::NO_ARGUMENT_TYPES_MATCH, 0}; }
+			if(match_count > 1)         { return OverloadResolution{OverloadStatus::AMBIGUOUS, 0}; }
+
+			return OverloadResolution{OverloadStatus::MATCHED, match_index};
+		}
+
+		/** Checks the arguments of a call against the overloads of `callee`.
+		 * Returns the type of the call if a single overload matches. */
+		std::optional<ValueType> check_call
+		(
+			DeclarationId callee,
+			const std::vector<std::optional<ValueType>>& argument_types,
+			const Expression& call,
+			std::size_t length,
+			std::string_view name
+		)
+		{
+			const OverloadResolution overload = overload_cache.resolve
+			(
+				callee,
+				argument_types,
+				[&] { return resolve_overload(callee, argument_types); }
+			);
+
+			switch(overload.status)
+			{
+				case OverloadStatus::MATCHED:
+				{
+					const Declaration& declaration = resolution.get_declaration(callee);
+					return get_signature(declaration.kind, *declaration.nodes[overload.overload_index]).return_type;
+				}
+				case OverloadStatus::AMBIGUOUS:
+				{
+					// Several overloads match while argument types are unknown, so the type of the call is unknown too
+					return std::nullopt;
+				}
+				case OverloadStatus::NO_ARGUMENT_COUNT_MATCH:
+				{
+					report(call, length, std::string{type_checker_error_messages::NO_OVERLOAD_WITH_ARGUMENT_COUNT} + std::string{name});
+					return std::nullopt;
+				}
+				case OverloadStatus::NO_ARGUMENT_TYPES_MATCH:
+				{
+					std::string message = std::string{type_checker_error_messages::NO_OVERLOAD_WITH_ARGUMENT_TYPES} + std::string{name} + "(";
+					for(std::size_t i = 0; i < argument_types.size(); ++i)
+					{
+						if(i > 0) { message += ", "; }
+						message += to_string(argument_types[i]);
+					}
+					report(call, length, message + ")");
+					return std::nullopt;
+				}
+			}
+
+			return std::nullopt;
+		}
+	};
+
+	/** e.g. `main::subpkg::Widget` to `main/widget.neon` */
+	std::unordered_map<std::string_view, std::string_view> get_package_member_files(const Root& root)
+	{
+		std::unordered_map<std::string_view, std::string_view> files;
+
+		for(const std::pair<const std::string, std::vector<std::string>>& pair : root.file_package_members)
+		{
+			for(const std::string& identifier : pair.second)
+			{
+				files.emplace(identifier, pair.first);
+			}
+		}
+
+		return files;
+	}
+}
+
+TypeChecker::TypeChecker(concurrency::WorkStealingPool& init_pool)
+	: pool{init_pool} {}
+
+std::size_t TypeChecker::run(const Root& root, const Resolution& resolution, AnalysisReporter& reporter)
+{
+	const trace::Span span{"TypeChecker::run"};
+
+	const std::unordered_map<DeclarationId, TypeSnapshot> type_snapshots = create_type_snapshots(resolution);
+	const std::unordered_map<std::string_view, std::string_view> files = get_package_member_files(root);
+
+	std::vector<const std::string*> identifiers;
+	identifiers.reserve(root.package_members.size());
+	for(const std::pair<const std::string, std::unique_ptr<PackageMember>>& pair : root.package_members)
+	{
+		identifiers.push_back(&pair.first);
+	}
+	std::sort(identifiers.begin(), identifiers.end(), [] (const std::string* a, const std::string* b) { return *a < *b; });
+
+	OverloadCache overload_cache;
+	std::vector<PackageMemberChecker> member_checkers(identifiers.size(), PackageMemberChecker{resolution, type_snapshots, overload_cache});
+
+	pool.run(identifiers.size(), [&] (std::size_t i)
+	{
+		trace::Span member_span{"TypeChecker::check_package_member"};
+		if(member_span.is_recording()) { member_span.set_detail(*identifiers[i]); }
+
+		member_checkers[i].check(*root.package_members.at(*identifiers[i]));
+	});
+
+	struct FileDiagnostic
+	{
+		std::string_view file;
+		const Diagnostic* diagnostic;
+	};
+
+	std::vector<FileDiagnostic> file_diagnostics;
+	for(std::size_t i = 0; i < identifiers.size(); ++i)
+	{
+		const std::unordered_map<std::string_view, std::string_view>::const_iterator file_it = files.find(*identifiers[i]);
+		const std::string_view file = file_it == files.end() ? std::string_view{} : file_it->second;
+
+		for(const Diagnostic& diagnostic : member_checkers[i].diagnostics)
+		{
+			file_diagnostics.push_back(FileDiagnostic{file, &diagnostic});
+		}
+	}
+
+	// Stable, so that diagnostics at the same position stay in the order they were found in
+	std::stable_sort(file_diagnostics.begin(), file_diagnostics.end(), [] (const FileDiagnostic& a, const FileDiagnostic& b)
+	{
+		if(a.file != b.file) { return a.file < b.file; }
+		return a.diagnostic->source_position.offset_in_file < b.diagnostic->source_position.offset_in_file;
+	});
+
+	for(const FileDiagnostic& file_diagnostic : file_diagnostics)
+	{
+		reporter.report(AnalysisEntry
+		{
+			file_diagnostic.file,
+			AnalysisEntryType::REFERENCE,
+			AnalysisSeverity::ERROR,
+			file_diagnostic.diagnostic->source_position,
+			file_diagnostic.diagnostic->length,
+			file_diagnostic.diagnostic->message
+		});
+	}
+
+	overload_cache_hit_count = overload_cache.get_hit_count();
+	overload_cache_miss_count = overload_cache.get_miss_count();
+
+	return file_diagnostics.size();
+}
+
+uint64_t TypeChecker::get_overload_cache_hit_count() const
+{
+	return overload_cache_hit_count;
+}
+
+uint64_t TypeChecker::get_overload_cache_miss_count() const
+{
+	return overload_cache_miss_count;
+}
+
+std::unordered_map<DeclarationId, TypeSnapshot> TypeChecker::create_type_snapshots(const Resolution& resolution)
+{
+	std::unordered_map<DeclarationId, TypeSnapshot> type_snapshots;
+
+	for(DeclarationId id = 0; id < resolution.get_declaration_count(); ++id)
+	{
+		const Declaration& declaration = resolution.get_declaration(id);
+
+		if(declaration.kind != DeclarationKind::TYPE) { continue; }
+
+		type_snapshots.emplace
+		(
+			id,
+			TypeSnapshot{*static_cast<const Type*>(declaration.nodes.front()), resolution.get_member_scope(declaration.name)}
+		);
+	}
+
+	return type_snapshots;
+}
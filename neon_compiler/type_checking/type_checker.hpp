@@ -0,0 +1,88 @@
+#ifndef TYPE_CHECKER_HPP
+#define TYPE_CHECKER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <unordered_map>
+#include "overload_cache.hpp"
+#include "type_snapshot.hpp"
+#include "../analysis/analysis_reporter.hpp"
+#include "../ast/nodes/nodes.hpp"
+#include "../resolution/resolution.hpp"
+#include "../../concurrency/work_stealing_pool.hpp"
+
+namespace neon_compiler::type_checking
+{
+
+namespace type_checker_error_messages
+{
+	constexpr std::string_view UNRESOLVED_READ =
+		"Unresolved read: ";
+	constexpr std::string_view UNRESOLVED_CALL =
+		"Unresolved call: ";
+	constexpr std::string_view NOT_A_VALUE =
+		"Not a value: ";
+	constexpr std::string_view NOT_CALLABLE =
+		"Not callable: ";
+	constexpr std::string_view NO_OVERLOAD_WITH_ARGUMENT_COUNT =
+		"No overload takes this number of arguments: ";
+	constexpr std::string_view NO_OVERLOAD_WITH_ARGUMENT_TYPES =
+		"No overload takes arguments of these types: ";
+	constexpr std::string_view UNKNOWN_MEMBER =
+		"Unknown member: ";
+	constexpr std::string_view NOT_REASSIGNABLE =
+		"Not reassignable: ";
+	constexpr std::string_view ASSIGNED_TYPE_MISMATCH =
+		"Assigned value does not have the type ";
+	constexpr std::string_view RETURNED_TYPE_MISMATCH =
+		"Returned value does not have the return type ";
+	constexpr std::string_view VALUE_RETURNED_FROM_VOID =
+		"Value returned from a method without return type";
+}
+
+/** Checks the bodies of the package members against the declared types, once names are resolved.
+ * Reads and calls of names that were not resolved are errors, apart from calls of `resolution::PRINT_FUNCTION`
+ * and, in compile functions, of intrinsics (see `evaluation::INTRINSICS`).
+ * Only types that follow from declarations are checked: a value of an unknown type (e.g. an operator call) matches any type.
+ * Types that were not resolved (e.g. built-in types) are compared by name.
+ *
+ * Package members are checked in parallel, as checking one only reads the AST and the resolution.
+ * Each collects its own diagnostics, which are reported afterwards by file and position,
+ * so that their order does not depend on the scheduling.
+ *
+ * Overload resolution is memoized by callee and argument types for the duration of a run,
+ * so repeated calls of the same shape (common in generated code) scan the overloads only once. */
+class TypeChecker
+{
+public:
+	explicit TypeChecker(concurrency::WorkStealingPool& init_pool);
+
+	/** Reports the errors found to `reporter` and returns their number */
+	std::size_t run
+	(
+		const neon_compiler::ast::nodes::Root& root,
+		const neon_compiler::resolution::Resolution& resolution,
+		neon_compiler::analysis::AnalysisReporter& reporter
+	);
+
+	/** Calls of the last run whose overload was resolved from the cache */
+	uint64_t get_overload_cache_hit_count() const;
+	/** Calls of the last run whose overload was resolved by scanning the overloads */
+	uint64_t get_overload_cache_miss_count() const;
+
+private:
+	concurrency::WorkStealingPool& pool;
+	uint64_t overload_cache_hit_count{0};
+	uint64_t overload_cache_miss_count{0};
+
+	/** Snapshots of all types, made before the parallel part, so that it only reads them */
+	static std::unordered_map<neon_compiler::ast::nodes::DeclarationId, TypeSnapshot> create_type_snapshots
+	(
+		const neon_compiler::resolution::Resolution& resolution
+	);
+};
+
+}
+
+#endif // TYPE_CHECKER_HPP
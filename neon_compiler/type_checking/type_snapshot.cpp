@@ -0,0 +1,46 @@
+#include "type_snapshot.hpp"
+
+using namespace neon_compiler::ast::nodes;
+using namespace neon_compiler::resolution;
+using namespace neon_compiler::type_checking;
+
+TypeSnapshot::TypeSnapshot(const Type& type, const Scope* member_scope)
+{
+	members.reserve(type.fields.size() + type.constants.size() + type.methods.size() + type.pure_functions.size());
+
+	for(const std::pair<const std::string, Field>& pair : type.fields)
+	{
+		members[pair.first].field = &pair.second;
+	}
+	for(const std::pair<const std::string, Constant>& pair : type.constants)
+	{
+		members[pair.first].constant = &pair.second;
+	}
+	// Methods and pure functions are called through their declaration, which has all overloads
+	for(const std::pair<const std::string, std::vector<Method>>& pair : type.methods)
+	{
+		members.try_emplace(pair.first);
+	}
+	for(const std::pair<const std::string, std::vector<PureFunction>>& pair : type.pure_functions)
+	{
+		members.try_emplace(pair.first);
+	}
+
+	if(!member_scope) { return; }
+
+	for(std::pair<const std::string_view, TypeMember>& pair : members)
+	{
+		pair.second.declaration = member_scope->find(pair.first).value_or(UNRESOLVED_DECLARATION);
+	}
+}
+
+const TypeMember* TypeSnapshot::find(std::string_view name) const
+{
+	const std::unordered_map<std::string_view, TypeMember>::const_iterator it = members.find(name);
+	return it == members.end() ? nullptr : &it->second;
+}
+
+std::size_t TypeSnapshot::size() const
+{
+	return members.size();
+}
@@ -0,0 +1,41 @@
+#ifndef TYPE_SNAPSHOT_HPP
+#define TYPE_SNAPSHOT_HPP
+
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "../ast/nodes/nodes.hpp"
+#include "../resolution/scope.hpp"
+
+namespace neon_compiler::type_checking
+{
+
+/** What a member name of a type refers to. Null for the kinds of members it does not name. */
+struct TypeMember
+{
+	const neon_compiler::ast::nodes::Field* field{nullptr};
+	const neon_compiler::ast::nodes::Constant* constant{nullptr};
+	/** Declaration the name resolves to in the scope of the type, which has the overloads of methods and pure functions */
+	neon_compiler::ast::nodes::DeclarationId declaration{neon_compiler::ast::nodes::UNRESOLVED_DECLARATION};
+};
+
+/** Members of a type by name, looked up with one probe instead of one per kind of member.
+ * Immutable once built, so it can be shared by threads without locking.
+ * Refers to the names and nodes of the type, so it is only valid until that type changes. */
+class TypeSnapshot
+{
+public:
+	/** `member_scope` is the scope of the members of `type`. Null if it has none. */
+	TypeSnapshot(const neon_compiler::ast::nodes::Type& type, const neon_compiler::resolution::Scope* member_scope);
+
+	/** Null if the type has no member with this name */
+	const TypeMember* find(std::string_view name) const;
+	std::size_t size() const;
+
+private:
+	std::unordered_map<std::string_view, TypeMember> members;
+};
+
+}
+
+#endif // TYPE_SNAPSHOT_HPP
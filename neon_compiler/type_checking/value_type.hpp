@@ -0,0 +1,46 @@
+#ifndef VALUE_TYPE_HPP
+#define VALUE_TYPE_HPP
+
+#include <optional>
+#include <string_view>
+#include "../ast/nodes/nodes.hpp"
+
+namespace neon_compiler::type_checking
+{
+
+/** Shown for a type that is not known */
+constexpr std::string_view UNKNOWN_TYPE_NAME = "?";
+
+/** Type of a value: a type declaration, or the name of a type that was not resolved (e.g. `str`).
+ * The name refers to the AST or the resolution, so it is only valid as long as they are. */
+struct ValueType
+{
+	neon_compiler::ast::nodes::DeclarationId declaration;
+	std::string_view name;
+
+	bool operator==(const ValueType& other) const
+	{
+		if(declaration != neon_compiler::ast::nodes::UNRESOLVED_DECLARATION
+			|| other.declaration != neon_compiler::ast::nodes::UNRESOLVED_DECLARATION)
+		{
+			return declaration == other.declaration;
+		}
+
+		return name == other.name;
+	}
+};
+
+/** Whether a value of type `value` may be used where `expected` is. Unknown types match any type. */
+inline bool matches(const std::optional<ValueType>& value, const std::optional<ValueType>& expected)
+{
+	return !value.has_value() || !expected.has_value() || value.value() == expected.value();
+}
+
+inline std::string_view to_string(const std::optional<ValueType>& type)
+{
+	return type.has_value() ? type->name : UNKNOWN_TYPE_NAME;
+}
+
+}
+
+#endif // VALUE_TYPE_HPP
@@ -0,0 +1,163 @@
+#include "../../../libs/doctest/doctest.hpp"
+
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "../../../benchmarks/allocation_counter/allocation_counter.hpp"
+#include "../../../benchmarks/corpus_generator/corpus_generator.hpp"
+#include "../../../logging/logger.hpp"
+#include "../../../logging/impl/stream_log_sink.hpp"
+#include "../../../neon_compiler/token.hpp"
+#include "../../../neon_compiler/token_reader.hpp"
+#include "../../../neon_compiler/analysis/analysis_reporter.hpp"
+#include "../../../neon_compiler/ast/nodes/nodes.hpp"
+#include "../../../neon_compiler/lexer/lexer.hpp"
+#include "../../../neon_compiler/parser/parser.hpp"
+#include "../../../reading/char_reader.hpp"
+
+using namespace benchmarks::allocation_counter;
+using namespace benchmarks::corpus_generator;
+using namespace neon_compiler;
+using namespace neon_compiler::analysis;
+using namespace neon_compiler::ast::nodes;
+using namespace neon_compiler::parser;
+
+// Upper bounds on the allocations of the compiler's hot paths, so that allocation regressions fail the tests.
+// Lower a bound when an optimisation makes it lower; raise one only for a change that needs the allocations.
+
+constexpr double MAX_ALLOCATIONS_PER_TOKEN_LEXED = 0.1;
+constexpr double MAX_ALLOCATIONS_PER_STATEMENT_PARSED = 11;
+constexpr double MAX_ALLOCATIONS_PER_OPERATOR_CALL_PARSED = 25;
+
+constexpr const char* TEST_OPERATORS =
+	"pkg main::ops;\n"
+	"public operator_module arith\n"
+	"{\n"
+	"\toperator __ + __ { subordination 2; associativity left; }\n"
+	"\toperator __ * __ { subordination 1; associativity left; }\n"
+	"\toperator - __ { subordination 0; }\n"
+	"}\n";
+
+class IgnoringAnalysisReporter : public AnalysisReporter
+{
+public:
+	void report(const AnalysisEntry&) override {}
+};
+
+static std::vector<Token> lex(const std::string& source)
+{
+	lexer::Lexer lexer{std::make_unique<reading::CharReader>(std::make_unique<std::istringstream>(source))};
+	lexer.run();
+	return lexer.take_tokens();
+}
+
+/** Source of an entrypoint with `statement_count` times `statement` */
+static std::string make_source(const std::string& statement, std::size_t statement_count)
+{
+	std::string source = "pkg main;\nimport main::ops::arith;\nuse arith;\npublic entrypoint start(borrow str arg)\n{\n";
+
+	for(std::size_t i = 0; i < statement_count; ++i)
+	{
+		source += "\t" + statement + "\n";
+	}
+
+	return source + "}\n";
+}
+
+/** Allocations of parsing `source` after the operators, both phases */
+static uint64_t count_parse_allocations(const std::string& source)
+{
+	std::shared_ptr<logging::Logger> logger = std::make_shared<logging::Logger>
+	(
+		std::make_shared<logging::impl::StreamLogSink>(std::cerr),
+		logging::LogLevel::ERROR
+	);
+	std::shared_ptr<AnalysisReporter> reporter = std::make_shared<IgnoringAnalysisReporter>();
+	std::shared_ptr<Root> root_node = std::make_shared<Root>();
+	std::shared_ptr<OperatorMap> operator_map = std::make_shared<OperatorMap>();
+	std::shared_ptr<OperatorTable> operator_table = std::make_shared<OperatorTable>();
+
+	const std::vector<Token> operator_tokens = lex(TEST_OPERATORS);
+	const std::vector<Token> tokens = lex(source);
+
+	Parser operator_parser{logger, operator_tokens, reporter, root_node, "ops.neon", operator_map};
+	operator_parser.run_a();
+	operator_parser.run_b(operator_table);
+
+	Parser parser{logger, tokens, reporter, root_node, "test.neon", operator_map};
+
+	const AllocationScope scope{};
+	parser.run_a();
+	parser.run_b(operator_table);
+
+	return scope.get_counts().allocations;
+}
+
+/** Allocations per statement, without those of the rest of the file, by parsing files of two sizes */
+static double count_allocations_per_statement(const std::string& statement)
+{
+	constexpr std::size_t SMALL_STATEMENT_COUNT = 100;
+	constexpr std::size_t LARGE_STATEMENT_COUNT = 200;
+
+	const uint64_t small = count_parse_allocations(make_source(statement, SMALL_STATEMENT_COUNT));
+	const uint64_t large = count_parse_allocations(make_source(statement, LARGE_STATEMENT_COUNT));
+
+	return static_cast<double>(large - small) / static_cast<double>(LARGE_STATEMENT_COUNT - SMALL_STATEMENT_COUNT);
+}
+
+TEST_CASE("Lexing allocates little per token")
+{
+	// Arrange
+	CorpusOptions options{};
+	options.file_count = 10;
+
+	std::string source{};
+	for(const CorpusFile& file : CorpusGenerator{options}.generate())
+	{
+		source += file.source;
+	}
+
+	lexer::Lexer lexer{std::make_unique<reading::CharReader>(std::make_unique<std::istringstream>(source))};
+
+	// Act
+	const AllocationScope scope{};
+	lexer.run();
+	const AllocationCounts counts = scope.get_counts();
+
+	// Assert
+	const std::vector<Token> tokens = lexer.take_tokens();
+	REQUIRE(tokens.size() > 0);
+	CHECK(static_cast<double>(counts.allocations) / static_cast<double>(tokens.size()) <= MAX_ALLOCATIONS_PER_TOKEN_LEXED);
+}
+
+TEST_CASE("Reading tokens does not allocate")
+{
+	// Arrange
+	const std::vector<Token> tokens = lex(make_source("print(1 + 2 * x.y(3));", 10));
+	TokenReader reader{tokens};
+
+	// Act
+	const AllocationScope scope{};
+	while(!reader.end_of_file_reached())
+	{
+		reader.peek(1);
+		reader.consume();
+	}
+	reader.reset();
+
+	// Assert
+	CHECK(scope.get_counts().allocations == 0);
+}
+
+TEST_CASE("Parsing a statement allocates a bounded amount")
+{
+	// Act
+	const double per_statement = count_allocations_per_statement("print(x);");
+	const double per_operator_call = (count_allocations_per_statement("print(x + x + x + x + x);") - per_statement) / 4;
+
+	// Assert
+	CHECK(per_statement <= MAX_ALLOCATIONS_PER_STATEMENT_PARSED);
+	CHECK(per_operator_call <= MAX_ALLOCATIONS_PER_OPERATOR_CALL_PARSED);
+}
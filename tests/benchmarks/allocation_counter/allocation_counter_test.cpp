@@ -0,0 +1,73 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "../../../libs/doctest/doctest.hpp"
+
+#include <memory>
+#include <thread>
+#include <vector>
+#include "../../../benchmarks/allocation_counter/allocation_counter.hpp"
+
+using namespace benchmarks::allocation_counter;
+
+TEST_CASE("Allocations and their sizes are counted")
+{
+	// Arrange
+	const AllocationScope scope{};
+
+	// Act
+	std::unique_ptr<int> value = std::make_unique<int>(1);
+	std::vector<char> buffer(1000);
+	std::unique_ptr<int[]> array = std::make_unique<int[]>(10);
+	array.reset();
+
+	// Assert
+	const AllocationCounts counts = scope.get_counts();
+	CHECK(counts.allocations == 3);
+	CHECK(counts.allocated_bytes >= sizeof(int) + 1000 + 10 * sizeof(int));
+	CHECK(counts.live_bytes >= static_cast<int64_t>(sizeof(int) + 1000));
+	CHECK(counts.live_bytes < static_cast<int64_t>(counts.allocated_bytes));
+}
+
+TEST_CASE("The peak of a scope is what it had in use at most")
+{
+	// Arrange
+	const AllocationScope outer_scope{};
+	std::vector<char> outer_buffer(10'000);
+	outer_buffer.clear();
+	outer_buffer.shrink_to_fit();
+
+	AllocationCounts inner_counts{};
+
+	// Act
+	{
+		const AllocationScope inner_scope{};
+		std::vector<char> inner_buffer(1000);
+		inner_buffer = std::vector<char>{};
+		inner_counts = inner_scope.get_counts();
+	}
+
+	// Assert
+	CHECK(inner_counts.live_bytes == 0);
+	CHECK(inner_counts.peak_live_bytes >= 1000);
+	CHECK(inner_counts.peak_live_bytes < 10'000);
+
+	const AllocationCounts outer_counts = outer_scope.get_counts();
+	CHECK(outer_counts.live_bytes == 0);
+	CHECK(outer_counts.peak_live_bytes >= 10'000);
+}
+
+TEST_CASE("Allocations of other threads are not counted")
+{
+	// Arrange
+	const AllocationScope scope{};
+	std::thread thread{};
+	const uint64_t allocations_before = scope.get_counts().allocations;
+
+	// Act
+	thread = std::thread{[] { std::vector<char> buffer(1000); }};
+	const uint64_t allocations_started = scope.get_counts().allocations;
+	thread.join();
+
+	// Assert
+	CHECK(scope.get_counts().allocations == allocations_started);
+	CHECK(allocations_started - allocations_before <= 1);
+}
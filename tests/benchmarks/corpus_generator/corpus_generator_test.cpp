@@ -0,0 +1,140 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "../../../libs/doctest/doctest.hpp"
+
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "../../../benchmarks/corpus_generator/corpus_generator.hpp"
+#include "../../../logging/logger.hpp"
+#include "../../../logging/impl/stream_log_sink.hpp"
+#include "../../../neon_compiler/token.hpp"
+#include "../../../neon_compiler/analysis/analysis_reporter.hpp"
+#include "../../../neon_compiler/ast/nodes/nodes.hpp"
+#include "../../../neon_compiler/lexer/lexer.hpp"
+#include "../../../neon_compiler/parser/parser.hpp"
+#include "../../../reading/char_reader.hpp"
+
+using namespace benchmarks::corpus_generator;
+using namespace neon_compiler;
+using namespace neon_compiler::analysis;
+using namespace neon_compiler::ast::nodes;
+using namespace neon_compiler::parser;
+
+class CountingAnalysisReporter : public AnalysisReporter
+{
+public:
+	std::size_t error_count{0};
+	std::size_t operator_count{0};
+
+	void report(const AnalysisEntry& entry) override
+	{
+		if(entry.severity == AnalysisSeverity::ERROR) { ++error_count; }
+		if(entry.type == AnalysisEntryType::OPERATOR) { ++operator_count; }
+	}
+};
+
+static std::shared_ptr<CountingAnalysisReporter> parse(const std::vector<CorpusFile>& files)
+{
+	std::shared_ptr<logging::Logger> logger = std::make_shared<logging::Logger>
+	(
+		std::make_shared<logging::impl::StreamLogSink>(std::cerr),
+		logging::LogLevel::ERROR
+	);
+	std::shared_ptr<CountingAnalysisReporter> reporter = std::make_shared<CountingAnalysisReporter>();
+	std::shared_ptr<Root> root_node = std::make_shared<Root>();
+	std::shared_ptr<OperatorMap> operator_map = std::make_shared<OperatorMap>();
+
+	std::vector<std::vector<Token>> file_tokens;
+	for(const CorpusFile& file : files)
+	{
+		lexer::Lexer lexer{std::make_unique<reading::CharReader>(std::make_unique<std::istringstream>(file.source))};
+		lexer.run();
+		REQUIRE(lexer.take_errors().empty());
+		file_tokens.push_back(lexer.take_tokens());
+	}
+
+	std::vector<Parser> parsers;
+	parsers.reserve(files.size());
+	for(std::size_t i = 0; i < files.size(); ++i)
+	{
+		parsers.emplace_back(logger, file_tokens[i], reporter, root_node, files[i].name, operator_map);
+	}
+
+	for(Parser& parser : parsers) { parser.run_a(); }
+
+	std::shared_ptr<OperatorTable> operator_table = std::make_shared<OperatorTable>();
+	for(Parser& parser : parsers) { parser.run_b(operator_table); }
+
+	return reporter;
+}
+
+TEST_CASE("The same seed generates the same corpus")
+{
+	// Arrange
+	CorpusOptions options{};
+	options.file_count = 10;
+
+	CorpusOptions other_seed_options = options;
+	other_seed_options.seed = options.seed + 1;
+
+	// Act
+	const std::vector<CorpusFile> files = CorpusGenerator{options}.generate();
+	const std::vector<CorpusFile> same_seed_files = CorpusGenerator{options}.generate();
+	const std::vector<CorpusFile> other_seed_files = CorpusGenerator{other_seed_options}.generate();
+
+	// Assert
+	REQUIRE(files.size() == options.operator_module_count + options.file_count);
+	REQUIRE(same_seed_files.size() == files.size());
+	REQUIRE(other_seed_files.size() == files.size());
+
+	bool any_difference = false;
+	for(std::size_t i = 0; i < files.size(); ++i)
+	{
+		CHECK(files[i].name == same_seed_files[i].name);
+		CHECK(files[i].source == same_seed_files[i].source);
+		any_difference = any_difference || files[i].source != other_seed_files[i].source;
+	}
+	CHECK(any_difference);
+}
+
+TEST_CASE("Generated corpora parse without errors")
+{
+	for(uint64_t seed = 1; seed <= 3; ++seed)
+	{
+		// Arrange
+		CorpusOptions options{};
+		options.seed = seed;
+		options.file_count = 10;
+		options.operator_module_count = seed + 1;
+		options.max_nesting_depth = 6;
+
+		// Act
+		const std::shared_ptr<CountingAnalysisReporter> reporter = parse(CorpusGenerator{options}.generate());
+
+		// Assert
+		CHECK(reporter->error_count == 0);
+		CHECK(reporter->operator_count > 0);
+	}
+}
+
+TEST_CASE("Expressions are not nested beyond the maximum depth")
+{
+	// Arrange
+	CorpusOptions options{};
+	options.file_count = 10;
+	options.max_nesting_depth = 1;
+
+	// Act
+	const std::vector<CorpusFile> files = CorpusGenerator{options}.generate();
+	const std::shared_ptr<CountingAnalysisReporter> reporter = parse(files);
+
+	// Assert
+	CHECK(reporter->error_count == 0);
+	for(std::size_t i = options.operator_module_count; i < files.size(); ++i)
+	{
+		CHECK(files[i].source.find("print((") == std::string::npos);
+		CHECK(files[i].source.find(" + ") == std::string::npos);
+	}
+}
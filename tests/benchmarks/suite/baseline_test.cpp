@@ -0,0 +1,75 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "../../../libs/doctest/doctest.hpp"
+
+#include <chrono>
+#include <optional>
+#include <sstream>
+#include <vector>
+#include "../../../benchmarks/suite/baseline.hpp"
+
+using namespace benchmarks::suite;
+
+TEST_CASE("Written baselines are read back")
+{
+	// Arrange
+	BenchmarkResult result{"lexer", std::chrono::milliseconds{250}, 2'000'000, 50'000, 0};
+	result.allocations = 1200;
+	result.peak_heap_bytes = 4096;
+
+	const Baseline baseline = to_baseline(std::vector<BenchmarkResult>{result});
+
+	std::stringstream stream{};
+	write_baseline(stream, baseline);
+
+	// Act
+	const std::optional<Baseline> read = read_baseline(stream);
+
+	// Assert
+	REQUIRE(read.has_value());
+	CHECK(read->at("lexer").at("mb_per_s") == doctest::Approx(8.0));
+	CHECK(read->at("lexer").at("tokens_per_s") == doctest::Approx(200'000.0));
+	CHECK(read->at("lexer").at("allocations") == doctest::Approx(1200.0));
+	CHECK(read->at("lexer").count("nodes_per_s") == 0);
+	CHECK(read.value() == to_baseline(std::vector<BenchmarkResult>{result}));
+}
+
+TEST_CASE("Malformed baselines are not read")
+{
+	for(const char* json : {"", "{", "{\"lexer\": 1}", "{\"lexer\": {\"mb_per_s\": }}", "{\"lexer\": {}} x"})
+	{
+		// Arrange
+		std::istringstream stream{json};
+
+		// Act
+		const std::optional<Baseline> read = read_baseline(stream);
+
+		// Assert
+		CHECK_FALSE(read.has_value());
+	}
+}
+
+TEST_CASE("Only changes beyond the tolerance in the worse direction are regressions")
+{
+	// Arrange
+	const Baseline baseline
+	{
+		{"parse_b", {{"mb_per_s", 10.0}, {"allocations", 1000.0}, {"wall_ms", 100.0}}},
+		{"lexer", {{"mb_per_s", 10.0}}}
+	};
+	const Baseline current
+	{
+		{"parse_b", {{"mb_per_s", 8.0}, {"allocations", 1050.0}, {"wall_ms", 125.0}}},
+		{"lexer", {{"mb_per_s", 20.0}, {"allocations", 5000.0}}},
+		{"analyse", {{"mb_per_s", 1.0}}}
+	};
+
+	// Act
+	const std::vector<Regression> regressions = compare(baseline, current, 0.1);
+
+	// Assert
+	REQUIRE(regressions.size() == 1);
+	CHECK(regressions[0].benchmark == "parse_b");
+	CHECK(regressions[0].metric == "mb_per_s");
+	CHECK(regressions[0].baseline == doctest::Approx(10.0));
+	CHECK(regressions[0].current == doctest::Approx(8.0));
+}
@@ -0,0 +1,68 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "../../libs/doctest/doctest.hpp"
+
+#include <algorithm>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../../concurrency/mpsc_queue.hpp"
+
+using namespace concurrency;
+
+TEST_CASE("Values are popped in the order they were pushed")
+{
+	// Arrange
+	MpscQueue<std::string> queue{};
+
+	// Act
+	queue.push("a");
+	queue.push("b");
+
+	// Assert
+	CHECK(queue.pop() == std::optional<std::string>{"a"});
+	CHECK(queue.pop() == std::optional<std::string>{"b"});
+	CHECK(!queue.pop().has_value());
+}
+
+TEST_CASE("Values pushed from several threads are all popped once")
+{
+	// Arrange
+	MpscQueue<int> queue{};
+
+	constexpr int THREAD_COUNT = 4;
+	constexpr int VALUE_COUNT = 1000;
+
+	std::vector<std::thread> threads;
+	for(int t = 0; t < THREAD_COUNT; ++t)
+	{
+		threads.emplace_back([&queue, t]
+		{
+			for(int v = 0; v < VALUE_COUNT; ++v)
+			{
+				queue.push(t * VALUE_COUNT + v);
+			}
+		});
+	}
+
+	// Act
+	std::vector<int> popped_count(THREAD_COUNT * VALUE_COUNT, 0);
+	int total = 0;
+	while(total < THREAD_COUNT * VALUE_COUNT)
+	{
+		if(std::optional<int> value = queue.pop())
+		{
+			++popped_count[static_cast<std::size_t>(value.value())];
+			++total;
+		}
+	}
+
+	for(std::thread& thread : threads)
+	{
+		thread.join();
+	}
+
+	// Assert
+	CHECK(!queue.pop().has_value());
+	CHECK(std::count(popped_count.begin(), popped_count.end(), 1) == THREAD_COUNT * VALUE_COUNT);
+}
@@ -0,0 +1,47 @@
+#include "../../libs/doctest/doctest.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+#include "../../concurrency/work_stealing_pool.hpp"
+
+using namespace concurrency;
+
+TEST_CASE("Every task of every batch runs once")
+{
+	// Arrange
+	constexpr std::size_t TASK_COUNT = 1000;
+	WorkStealingPool pool{4};
+
+	for(std::size_t batch = 0; batch < 3; ++batch)
+	{
+		std::vector<std::atomic<int>> run_count(TASK_COUNT);
+
+		// Act
+		pool.run(TASK_COUNT, [&run_count](std::size_t i) { ++run_count[i]; });
+
+		// Assert
+		CHECK(std::all_of(run_count.begin(), run_count.end(), [](const std::atomic<int>& count) { return count == 1; }));
+	}
+}
+
+TEST_CASE("An exception thrown by a task is rethrown, and the pool can be used again")
+{
+	// Arrange
+	WorkStealingPool pool{4};
+	std::atomic<std::size_t> run_count{0};
+
+	// Act & Assert
+	CHECK_THROWS_AS
+	(
+		pool.run(100, [](std::size_t i)
+		{
+			if(i == 10) { throw std::runtime_error{"failed"}; }
+		}),
+		std::runtime_error
+	);
+
+	pool.run(100, [&run_count](std::size_t) { ++run_count; });
+	CHECK(run_count == 100);
+}
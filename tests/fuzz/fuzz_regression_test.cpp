@@ -0,0 +1,71 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "../../libs/doctest/doctest.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <optional>
+#include <string>
+#include <vector>
+#include "../../fuzz/fuzz_targets.hpp"
+
+// Inputs once found to take too long or too much memory for their size. Add the minimised input of every such find.
+
+constexpr const char* REGRESSIONS_DIRECTORY = "fuzz/regressions";
+
+static std::vector<std::filesystem::path> list_regressions()
+{
+	std::vector<std::filesystem::path> files;
+	for(const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator{REGRESSIONS_DIRECTORY})
+	{
+		if(entry.is_regular_file()) { files.push_back(entry.path()); }
+	}
+	std::sort(files.begin(), files.end());
+
+	return files;
+}
+
+static std::string read_file(const std::filesystem::path& path)
+{
+	std::ifstream stream{path, std::ios::binary};
+	return std::string{std::istreambuf_iterator<char>{stream}, std::istreambuf_iterator<char>{}};
+}
+
+TEST_CASE("Regression inputs are lexed within the budget")
+{
+	const std::vector<std::filesystem::path> files = list_regressions();
+	REQUIRE(!files.empty());
+
+	for(const std::filesystem::path& file : files)
+	{
+		// Arrange
+		const std::string input = read_file(file);
+
+		// Act
+		const std::optional<std::string> exceeded = fuzz::check_budget(fuzz::run_lexer(input), input.size());
+
+		// Assert
+		INFO(file.string(), ": ", exceeded.value_or(""));
+		CHECK(!exceeded.has_value());
+	}
+}
+
+TEST_CASE("Regression inputs are parsed within the budget")
+{
+	const std::vector<std::filesystem::path> files = list_regressions();
+	REQUIRE(!files.empty());
+
+	for(const std::filesystem::path& file : files)
+	{
+		// Arrange
+		const std::string input = read_file(file);
+
+		// Act
+		const std::optional<std::string> exceeded = fuzz::check_budget(fuzz::run_parser(input), input.size());
+
+		// Assert
+		INFO(file.string(), ": ", exceeded.value_or(""));
+		CHECK(!exceeded.has_value());
+	}
+}
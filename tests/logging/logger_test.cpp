@@ -0,0 +1,155 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "../../libs/doctest/doctest.hpp"
+
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "../../logging/logger.hpp"
+#include "../../logging/impl/async_log_sink.hpp"
+#include "../../logging/impl/stream_log_sink.hpp"
+
+using namespace logging;
+using namespace logging::impl;
+
+class RecordingLogSink : public LogSink
+{
+public:
+	void write(LogLevel level, std::string message) override
+	{
+		const std::lock_guard<std::mutex> lock{mutex};
+		messages.emplace_back(level, std::move(message));
+	}
+
+	void flush() override {}
+
+	std::vector<std::pair<LogLevel, std::string>> get_messages()
+	{
+		const std::lock_guard<std::mutex> lock{mutex};
+		return messages;
+	}
+private:
+	std::mutex mutex;
+	std::vector<std::pair<LogLevel, std::string>> messages;
+};
+
+/** Counts how often it is formatted */
+struct FormatCounter
+{
+	int* count;
+};
+
+std::ostream& operator<<(std::ostream& out, const FormatCounter& counter)
+{
+	++*counter.count;
+	return out << "counted";
+}
+
+TEST_CASE("Messages below the minimum level are not formatted")
+{
+	// Arrange
+	std::shared_ptr<RecordingLogSink> sink = std::make_shared<RecordingLogSink>();
+	Logger logger{sink, LogLevel::INFO};
+	int format_count = 0;
+
+	// Act
+	logger.debug("Skipped ", FormatCounter{&format_count});
+	logger.info("Index ", 3, ": ", FormatCounter{&format_count});
+	logger.set_min_level(LogLevel::ERROR);
+	logger.warning("Skipped ", FormatCounter{&format_count});
+
+	// Assert
+	CHECK(format_count == 1);
+	REQUIRE(sink->get_messages().size() == 1);
+	CHECK(sink->get_messages()[0].first == LogLevel::INFO);
+	CHECK(sink->get_messages()[0].second == "Index 3: counted");
+	CHECK(!logger.is_enabled(LogLevel::WARNING));
+	CHECK(logger.is_enabled(LogLevel::ERROR));
+}
+
+TEST_CASE("Asynchronous sink keeps the order of each thread and writes everything by flush")
+{
+	// Arrange
+	std::shared_ptr<RecordingLogSink> target = std::make_shared<RecordingLogSink>();
+	std::shared_ptr<AsyncLogSink> sink = std::make_shared<AsyncLogSink>(target);
+	Logger logger{sink, LogLevel::DEBUG};
+
+	constexpr int THREAD_COUNT = 4;
+	constexpr int MESSAGE_COUNT = 500;
+
+	// Act
+	std::vector<std::thread> threads;
+	for(int t = 0; t < THREAD_COUNT; ++t)
+	{
+		threads.emplace_back([&logger, t]
+		{
+			for(int m = 0; m < MESSAGE_COUNT; ++m)
+			{
+				logger.debug(t, " ", m);
+			}
+		});
+	}
+	for(std::thread& thread : threads)
+	{
+		thread.join();
+	}
+
+	logger.flush();
+
+	// Assert
+	const std::vector<std::pair<LogLevel, std::string>> messages = target->get_messages();
+	REQUIRE(messages.size() == THREAD_COUNT * MESSAGE_COUNT);
+
+	std::vector<int> next_message(THREAD_COUNT, 0);
+	bool in_order = true;
+	for(const std::pair<LogLevel, std::string>& message : messages)
+	{
+		std::istringstream in{message.second};
+		int t{};
+		int m{};
+		in >> t >> m;
+
+		in_order = in_order && m == next_message[static_cast<std::size_t>(t)];
+		next_message[static_cast<std::size_t>(t)] = m + 1;
+	}
+	CHECK(in_order);
+}
+
+TEST_CASE("Asynchronous sink writes the remaining messages when destroyed")
+{
+	// Arrange
+	std::shared_ptr<RecordingLogSink> target = std::make_shared<RecordingLogSink>();
+
+	{
+		AsyncLogSink sink{target};
+
+		// Act
+		for(int m = 0; m < 100; ++m)
+		{
+			sink.write(LogLevel::INFO, std::to_string(m));
+		}
+	}
+
+	// Assert
+	const std::vector<std::pair<LogLevel, std::string>> messages = target->get_messages();
+	REQUIRE(messages.size() == 100);
+	CHECK(messages.back().second == "99");
+}
+
+TEST_CASE("Stream sink writes one line per message")
+{
+	// Arrange
+	std::ostringstream out{};
+	StreamLogSink sink{out};
+
+	// Act
+	sink.write(LogLevel::WARNING, "first");
+	sink.write(LogLevel::ERROR, "second");
+	sink.flush();
+
+	// Assert
+	CHECK(out.str() == "[Log] \x1B[33mWarning\033[0m first\n[Log] \x1B[31mError\033[0m second\n");
+}
@@ -0,0 +1,238 @@
+#include "../../../libs/doctest/doctest.hpp"
+
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "../../../logging/logger.hpp"
+#include "../../../neon_compiler/token.hpp"
+#include "../../../neon_compiler/analysis/analysis_reporter.hpp"
+#include "../../../neon_compiler/ast/nodes/nodes.hpp"
+#include "../../../neon_compiler/cache/ast_cache.hpp"
+#include "../../../neon_compiler/cache/ast_serializer.hpp"
+#include "../../../neon_compiler/cache/binary_io.hpp"
+#include "../../../neon_compiler/lexer/lexer.hpp"
+#include "../../../neon_compiler/parser/parser.hpp"
+#include "../../../reading/char_reader.hpp"
+
+using namespace neon_compiler;
+using namespace neon_compiler::analysis;
+using namespace neon_compiler::ast::nodes;
+using namespace neon_compiler::cache;
+using namespace neon_compiler::parser;
+
+constexpr const char
+	*TEST_OPERATORS =
+		"pkg main::ops;\n"
+		"public operator_module arith\n"
+		"{\n"
+		"\toperator __ + __ { subordination 2; associativity left; }\n"
+		"\toperator - __ { subordination 0; }\n"
+		"\tint (int a) + (int b) { ret add(a, b); }\n"
+		"}\n",
+	*TEST_ENTRYPOINT =
+		"pkg main;\n"
+		"import main::ops::arith;\n"
+		"use arith;\n"
+		"public entrypoint start(borrow str arg)\n"
+		"{\n"
+		"\tprint(1 + -2);\n"
+		"\tret foo.bar(0x1F, \"a\") + x;\n"
+		"}\n";
+
+class IgnoringAnalysisReporter : public AnalysisReporter
+{
+public:
+	void report(const AnalysisEntry&) override {}
+};
+
+struct ParsedSources
+{
+	std::vector<std::vector<Token>> tokens;
+	std::shared_ptr<Root> root_node = std::make_shared<Root>();
+	std::shared_ptr<OperatorMap> operator_map = std::make_shared<OperatorMap>();
+};
+
+static void parse(ParsedSources& parsed, const std::vector<std::string>& sources)
+{
+	std::shared_ptr<logging::Logger> logger = std::make_shared<logging::Logger>();
+	std::vector<Parser> parsers;
+
+	parsed.tokens.reserve(sources.size());
+	for(std::size_t i = 0; i < sources.size(); ++i)
+	{
+		lexer::Lexer lexer{std::make_unique<reading::CharReader>(std::make_unique<std::istringstream>(sources[i]))};
+		lexer.run();
+		parsed.tokens.push_back(lexer.take_tokens());
+	}
+
+	for(const std::vector<Token>& tokens : parsed.tokens)
+	{
+		parsers.emplace_back(logger, tokens, std::make_shared<IgnoringAnalysisReporter>(), parsed.root_node, "test.neon", parsed.operator_map);
+	}
+
+	for(Parser& parser : parsers) { parser.run_a(); }
+
+	std::shared_ptr<OperatorTable> operator_table = std::make_shared<OperatorTable>();
+	for(Parser& parser : parsers) { parser.run_b(operator_table); }
+}
+
+static std::string serialize(const PackageMember& package_member, const OperatorMap& operator_map)
+{
+	const OperatorReferences operator_references = create_operator_references(operator_map);
+	BinaryWriter writer{};
+	ASTSerializer serializer{writer, operator_references};
+
+	serializer.write_package_member(package_member);
+
+	return writer.get_buffer();
+}
+
+TEST_CASE("Serialized package members are read back unchanged")
+{
+	// Arrange
+	ParsedSources parsed{};
+	parse(parsed, std::vector<std::string>{TEST_OPERATORS, TEST_ENTRYPOINT});
+
+	for(const std::string identifier : {"main::ops::arith", "main::start"})
+	{
+		const std::string data = serialize(*parsed.root_node->package_members.at(identifier), *parsed.operator_map);
+
+		// Act
+		BinaryReader reader{data};
+		ASTDeserializer deserializer{reader, parsed.operator_map.get()};
+		const std::unique_ptr<PackageMember> read = deserializer.read_package_member();
+
+		// Assert
+		CHECK(reader.end_reached());
+		CHECK(serialize(*read, *parsed.operator_map) == data);
+	}
+}
+
+TEST_CASE("Operator calls refer to the operators in the operator map")
+{
+	// Arrange
+	ParsedSources parsed{};
+	parse(parsed, std::vector<std::string>{TEST_OPERATORS, TEST_ENTRYPOINT});
+
+	const std::string data = serialize(*parsed.root_node->package_members.at("main::start"), *parsed.operator_map);
+
+	// Act
+	BinaryReader reader{data};
+	ASTDeserializer deserializer{reader, parsed.operator_map.get()};
+	const std::unique_ptr<PackageMember> read = deserializer.read_package_member();
+	const Entrypoint* entrypoint = dynamic_cast<const Entrypoint*>(read.get());
+
+	// Assert
+	REQUIRE(entrypoint);
+	REQUIRE(entrypoint->body.statements.size() == 2);
+	const DiscardExpression* discard = dynamic_cast<const DiscardExpression*>(entrypoint->body.statements[0].get());
+	REQUIRE(discard);
+	const FunctionCall* call = dynamic_cast<const FunctionCall*>(discard->expression.get());
+	REQUIRE(call);
+	REQUIRE(call->arguments.size() == 1);
+	const OperatorCallExpression* op_call = dynamic_cast<const OperatorCallExpression*>(call->arguments[0].get());
+	REQUIRE(op_call);
+	CHECK(op_call->op == parsed.operator_map->at("main::ops::arith")[0]);
+}
+
+TEST_CASE("Reading operator calls without operator map fails")
+{
+	// Arrange
+	ParsedSources parsed{};
+	parse(parsed, std::vector<std::string>{TEST_OPERATORS, TEST_ENTRYPOINT});
+
+	const std::string data = serialize(*parsed.root_node->package_members.at("main::start"), *parsed.operator_map);
+
+	// Act
+	BinaryReader reader{data};
+	ASTDeserializer deserializer{reader, nullptr};
+
+	// Assert
+	CHECK_THROWS_AS(deserializer.read_package_member(), CacheFormatException);
+}
+
+TEST_CASE("Operator module fingerprints change with the operator declarations")
+{
+	// Arrange
+	ParsedSources original{};
+	parse(original, std::vector<std::string>{TEST_OPERATORS});
+	ParsedSources same{};
+	parse(same, std::vector<std::string>{TEST_OPERATORS});
+
+	std::string changed_source{TEST_OPERATORS};
+	changed_source.replace(changed_source.find("subordination 2"), 15, "subordination 3");
+	ParsedSources changed{};
+	parse(changed, std::vector<std::string>{changed_source});
+	ParsedSources moved{};
+	parse(moved, std::vector<std::string>{"\n\n" + std::string{TEST_OPERATORS}});
+
+	// Act
+	const uint64_t original_fingerprint = AstCache::fingerprint_operator_module(*original.operator_map, "main::ops::arith");
+
+	// Assert
+	CHECK(original_fingerprint == AstCache::fingerprint_operator_module(*same.operator_map, "main::ops::arith"));
+	CHECK(original_fingerprint != AstCache::fingerprint_operator_module(*changed.operator_map, "main::ops::arith"));
+	CHECK(original_fingerprint == AstCache::fingerprint_operator_module(*moved.operator_map, "main::ops::arith"));
+	CHECK(AstCache::fingerprint_operator_module(*original.operator_map, "main::ops::missing") == 0);
+}
+
+TEST_CASE("Stored parse results are loaded back")
+{
+	// Arrange
+	const std::filesystem::path directory = std::filesystem::temp_directory_path() / "neon_ast_cache_test";
+	std::filesystem::remove_all(directory);
+	AstCache cache{directory};
+
+	ParsedSources parsed{};
+	parse(parsed, std::vector<std::string>{TEST_OPERATORS, TEST_ENTRYPOINT});
+
+	const OperatorModule* arith = dynamic_cast<const OperatorModule*>(parsed.root_node->package_members.at("main::ops::arith").get());
+	REQUIRE(arith);
+
+	const ast::Identifier package{{"main", "ops"}};
+	const std::vector<AnalysisEntry> entries_a{AnalysisEntry{"a.neon", AnalysisEntryType::KEYWORD, AnalysisSeverity::INFO, {0, 0, 0}, 3, std::nullopt}};
+	const std::vector<AnalysisEntry> entries_b{};
+	const std::vector<std::string> imported_package_members{"main::Widget"};
+	const ParsedFile parsed_file
+	{
+		package,
+		{{"main::ops::arith", arith}},
+		entries_a,
+		{{"main::ops::other", 0}},
+		imported_package_members,
+		{{"main::start", parsed.root_node->package_members.at("main::start").get()}},
+		entries_b
+	};
+
+	// Act
+	const bool stored = cache.store(42, parsed_file, *parsed.operator_map);
+	const std::optional<AstCacheEntry> entry = cache.load(42);
+
+	// Assert
+	REQUIRE(stored);
+	REQUIRE(entry.has_value());
+	CHECK(entry->fragment_a.package.to_string() == "main::ops");
+	REQUIRE(entry->fragment_a.operator_modules.size() == 1);
+	REQUIRE(entry->fragment_a.operator_modules[0].second->operators.size() == 2);
+	CHECK(entry->fragment_a.operator_modules[0].second->operators[0].source_position.newlines_count == 3);
+	CHECK(entry->fragment_a.operator_modules[0].second->operators[0].source_position.offset_in_line == 1);
+	CHECK(entry->fragment_a.operator_modules[0].second->functions.empty());
+	REQUIRE(entry->fragment_a.entries.size() == 1);
+	CHECK(entry->fragment_a.entries[0].length == 3);
+	REQUIRE(entry->used_operator_modules.size() == 1);
+	CHECK(entry->used_operator_modules[0].first == "main::ops::other");
+	CHECK(entry->imported_package_members == imported_package_members);
+	CHECK(!cache.load(43).has_value());
+
+	const std::optional<AstFragmentB> fragment_b = cache.read_fragment_b(entry.value(), *parsed.operator_map);
+	REQUIRE(fragment_b.has_value());
+	REQUIRE(fragment_b->package_members.size() == 1);
+	CHECK(fragment_b->package_members[0].first == "main::start");
+	REQUIRE(fragment_b->operator_functions.size() == 1);
+	CHECK(fragment_b->operator_functions[0].size() == 1);
+
+	std::filesystem::remove_all(directory);
+}
@@ -0,0 +1,90 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "../../../libs/doctest/doctest.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "../../../neon_compiler/token.hpp"
+#include "../../../neon_compiler/cache/content_hash.hpp"
+#include "../../../neon_compiler/cache/token_cache.hpp"
+#include "../../../neon_compiler/lexer/lexer.hpp"
+#include "../../../reading/char_reader.hpp"
+
+using namespace neon_compiler;
+using namespace neon_compiler::cache;
+using namespace neon_compiler::lexer;
+
+constexpr const char* TEST_SOURCE = "pkg main;\nentrypoint { var x = 0x1F + 'c'; \"a\\qb\" }";
+
+static std::filesystem::path make_cache_directory(const std::string& name)
+{
+	const std::filesystem::path directory = std::filesystem::temp_directory_path() / name;
+	std::filesystem::remove_all(directory);
+	return directory;
+}
+
+TEST_CASE("Content hash matches XXH64")
+{
+	CHECK(hash_content("") == 0xef46db3751d8e999ULL);
+	CHECK(hash_content("abc") == 0x44bc2cf5ad770999ULL);
+	CHECK(hash_content("abc") != hash_content("abd"));
+}
+
+TEST_CASE("Cached tokens and errors are loaded back unchanged")
+{
+	// Arrange
+	const std::filesystem::path directory = make_cache_directory("neon_token_cache_test_round_trip");
+	TokenCache cache{directory};
+
+	Lexer lexer{std::make_unique<reading::CharReader>(std::make_unique<std::istringstream>(TEST_SOURCE))};
+	lexer.run();
+	const std::vector<Token> tokens = lexer.take_tokens();
+	const std::vector<TokenisationError> errors = lexer.take_errors();
+	const uint64_t content_hash = hash_content(TEST_SOURCE);
+
+	// Act
+	const bool stored = cache.store(content_hash, tokens, errors);
+	const std::optional<CachedTokens> cached = cache.load(content_hash);
+
+	// Assert
+	REQUIRE(stored);
+	REQUIRE(cached.has_value());
+	REQUIRE(cached->tokens.size() == tokens.size());
+	for(std::size_t i = 0; i < tokens.size(); ++i)
+	{
+		CHECK(cached->tokens[i].get_type() == tokens[i].get_type());
+		CHECK(cached->tokens[i].get_source_position().offset_in_file == tokens[i].get_source_position().offset_in_file);
+		CHECK(cached->tokens[i].get_length() == tokens[i].get_length());
+		CHECK(cached->tokens[i].get_lexeme() == tokens[i].get_lexeme());
+	}
+	REQUIRE(!errors.empty());
+	REQUIRE(cached->errors.size() == errors.size());
+	CHECK(cached->errors[0].message == errors[0].message);
+
+	std::filesystem::remove_all(directory);
+}
+
+TEST_CASE("Missing and corrupt entries are cache misses")
+{
+	// Arrange
+	const std::filesystem::path directory = make_cache_directory("neon_token_cache_test_corrupt");
+	TokenCache cache{directory};
+
+	Lexer lexer{std::make_unique<reading::CharReader>(std::make_unique<std::istringstream>(TEST_SOURCE))};
+	lexer.run();
+	REQUIRE(cache.store(1, lexer.take_tokens(), lexer.take_errors()));
+
+	// Truncate the entry
+	const std::filesystem::path entry = directory / "0000000000000001.ntok";
+	std::filesystem::resize_file(entry, std::filesystem::file_size(entry) / 2);
+
+	// Act & Assert
+	CHECK(!cache.load(1).has_value());
+	CHECK(!cache.load(2).has_value());
+
+	std::filesystem::remove_all(directory);
+}
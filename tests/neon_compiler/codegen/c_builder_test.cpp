@@ -0,0 +1,114 @@
+#include "../../../libs/doctest/doctest.hpp"
+
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+#include "../../../concurrency/work_stealing_pool.hpp"
+#include "../../../neon_compiler/ast/nodes/nodes.hpp"
+#include "../../../neon_compiler/codegen/c_builder.hpp"
+#include "../../../neon_compiler/codegen/c_generator.hpp"
+#include "../../../neon_compiler/evaluation/pure_evaluator.hpp"
+#include "../../../neon_compiler/reference_counting/refcount_analyser.hpp"
+#include "../../../neon_compiler/reference_counting/thread_escape_analyser.hpp"
+#include "../../../neon_compiler/resolution/name_resolver.hpp"
+#include "../../test_support/parse.hpp"
+
+using namespace neon_compiler;
+using namespace neon_compiler::ast::nodes;
+using namespace neon_compiler::codegen;
+using namespace neon_compiler::evaluation;
+using namespace neon_compiler::reference_counting;
+using namespace neon_compiler::resolution;
+using namespace test_support;
+
+static std::string read_file(const std::filesystem::path& path)
+{
+	std::ifstream in{path};
+	return std::string{std::istreambuf_iterator<char>{in}, std::istreambuf_iterator<char>{}};
+}
+
+TEST_CASE("Built programs run their entrypoint with the command line arguments")
+{
+	if(std::system("cc --version > /dev/null 2>&1") != 0)
+	{
+		MESSAGE("Skipped, as there is no C compiler");
+		return;
+	}
+
+	// Arrange
+	std::shared_ptr<Root> root_node = parse_with_box
+	(
+		"main.neon",
+		"pkg main;\n"
+		"public entrypoint show(borrow Box box)\n"
+		"{\n"
+		"\tprint(box.size);\n"
+		"}\n"
+		"public entrypoint start(borrow Str name, shared Box box)\n"
+		"{\n"
+		"\tbox = Box();\n"
+		"\tbox.size = 5;\n"
+		"\tshow(box);\n"
+		"\tprint(name);\n"
+		"\tprint(true);\n"
+		"}\n"
+	);
+	concurrency::WorkStealingPool pool{2};
+	const std::shared_ptr<const Resolution> resolution = NameResolver{pool}.run(*root_node);
+
+	const RefcountAnnotations refcounts = RefcountAnalyser{pool}.run(*root_node, *resolution);
+	const AllocationAnnotations allocations = ThreadEscapeAnalyser{pool}.run(*root_node, *resolution);
+	const FoldedCalls folded_calls{};
+	const std::optional<GeneratedProgram> program =
+		CGenerator{*root_node, *resolution, refcounts, allocations, folded_calls, nullptr, pool}.generate("main::start");
+	REQUIRE(program.has_value());
+
+	const std::filesystem::path directory = std::filesystem::temp_directory_path() / "neon_c_builder_test";
+	std::filesystem::remove_all(directory);
+
+	const CBuilder builder{pool, CBuildOptions{directory, "cc", true}};
+
+	// Act
+	const std::vector<std::string> errors = builder.build(program.value());
+
+	// Assert
+	REQUIRE(errors.empty());
+
+	const std::filesystem::path output = directory / "output.txt";
+	const std::string command = builder.get_executable_path().string() + " world > " + output.string();
+	CHECK(std::system(command.c_str()) == 0);
+	CHECK(read_file(output) == "5\nworld\ntrue\n");
+
+	std::filesystem::remove_all(directory);
+}
+
+TEST_CASE("C compiler errors are reported per unit")
+{
+	if(std::system("cc --version > /dev/null 2>&1") != 0)
+	{
+		MESSAGE("Skipped, as there is no C compiler");
+		return;
+	}
+
+	// Arrange
+	GeneratedProgram program{TranslationUnit{"program.h", ""}, {TranslationUnit{"unit_0.c", "int broken("}}, {}};
+
+	const std::filesystem::path directory = std::filesystem::temp_directory_path() / "neon_c_builder_errors_test";
+	std::filesystem::remove_all(directory);
+
+	concurrency::WorkStealingPool pool{1};
+
+	// Act
+	const std::vector<std::string> errors = CBuilder{pool, CBuildOptions{directory}}.build(program);
+
+	// Assert
+	REQUIRE(errors.size() == 1);
+	CHECK(errors.front().starts_with(std::string{c_builder_error_messages::COMPILATION_FAILED} + "unit_0.c"));
+
+	std::filesystem::remove_all(directory);
+}
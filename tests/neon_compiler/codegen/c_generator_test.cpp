@@ -0,0 +1,139 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "../../../libs/doctest/doctest.hpp"
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+#include "../../../concurrency/work_stealing_pool.hpp"
+#include "../../../neon_compiler/ast/nodes/nodes.hpp"
+#include "../../../neon_compiler/codegen/c_generator.hpp"
+#include "../../../neon_compiler/evaluation/pure_evaluator.hpp"
+#include "../../../neon_compiler/reference_counting/refcount_analyser.hpp"
+#include "../../../neon_compiler/reference_counting/thread_escape_analyser.hpp"
+#include "../../../neon_compiler/resolution/name_resolver.hpp"
+#include "../../test_support/parse.hpp"
+
+using namespace neon_compiler;
+using namespace neon_compiler::ast::nodes;
+using namespace neon_compiler::codegen;
+using namespace neon_compiler::evaluation;
+using namespace neon_compiler::reference_counting;
+using namespace neon_compiler::resolution;
+using namespace test_support;
+
+/** Generates the program of `root_node`, without folded calls or `auto:` calls */
+static std::optional<GeneratedProgram> generate(Root& root_node, const std::string& entrypoint)
+{
+	concurrency::WorkStealingPool pool{2};
+	const std::shared_ptr<const Resolution> resolution = NameResolver{pool}.run(root_node);
+
+	const RefcountAnnotations refcounts = RefcountAnalyser{pool}.run(root_node, *resolution);
+	const AllocationAnnotations allocations = ThreadEscapeAnalyser{pool}.run(root_node, *resolution);
+	const FoldedCalls folded_calls{};
+
+	return CGenerator{root_node, *resolution, refcounts, allocations, folded_calls, nullptr, pool}.generate(entrypoint);
+}
+
+static bool contains(const std::string& text, const std::string& part)
+{
+	return text.find(part) != std::string::npos;
+}
+
+TEST_CASE("Each file becomes a unit calling the runtime, with thread-local allocations counted without atomics")
+{
+	// Arrange
+	std::shared_ptr<Root> root_node = parse_with_box
+	(
+		"main.neon",
+		"pkg main;\n"
+		"public entrypoint keep(shared Box box)\n"
+		"{\n"
+		"}\n"
+		"public entrypoint start(borrow Str name)\n"
+		"{\n"
+		"\tBox();\n"
+		"\tkeep(Box());\n"
+		"\tprint(name);\n"
+		"\tret 0x1F;\n"
+		"}\n"
+	);
+
+	// Act
+	const std::optional<GeneratedProgram> program = generate(*root_node, "main::start");
+
+	// Assert
+	REQUIRE(program.has_value());
+	CHECK(program->errors.empty());
+	REQUIRE(program->units.size() == 2);
+
+	const std::string& header = program->header.source;
+	CHECK(program->header.file_name == "program.h");
+	CHECK(contains(header, "neon_value neon_main__keep(neon_value p0_box);\nneon_value neon_main__start(neon_value p0_name);\n"));
+
+	const std::string& unit = program->units[0].source;
+	CHECK(program->units[0].file_name == "unit_0.c");
+	CHECK(contains(unit, "neon_new(1, 1, \"main.neon:7\")"));
+	CHECK(contains(unit, "neon_new(1, 0, \"main.neon:8\")"));
+	CHECK(contains(unit, "neon_print(neon_copy(p0_name))"));
+	CHECK(contains(unit, "neon_value result = neon_number(31.0);"));
+
+	CHECK(program->units[1].file_name == "main.c");
+	CHECK(contains(program->units[1].source, "neon_exit_code(neon_main__start(argc > 1 ? neon_string(argv[1]) : neon_string(\"\")))"));
+}
+
+TEST_CASE("Underscores are escaped, so that distinct names get distinct C names")
+{
+	// Arrange
+	std::shared_ptr<Root> root_node = parse_with_box
+	(
+		"main.neon",
+		"pkg main;\n"
+		"public entrypoint a_b()\n"
+		"{\n"
+		"}\n"
+		"public entrypoint start()\n"
+		"{\n"
+		"\ta_b();\n"
+		"}\n"
+	);
+
+	// Act
+	const std::optional<GeneratedProgram> program = generate(*root_node, "main::start");
+
+	// Assert
+	REQUIRE(program.has_value());
+	CHECK(program->errors.empty());
+	// Not `neon_main__a_b`, which would be the name of the entrypoint `b` of the package `main::a`
+	CHECK(contains(program->header.source, "neon_value neon_main__a_ub(void);"));
+	CHECK(contains(program->units[0].source, "neon_main__a_ub()"));
+}
+
+TEST_CASE("Unresolved names fail at run time, and a missing entrypoint generates nothing")
+{
+	// Arrange
+	std::shared_ptr<Root> root_node = parse_with_box
+	(
+		"main.neon",
+		"pkg main;\n"
+		"public entrypoint start()\n"
+		"{\n"
+		"\tmissing(1);\n"
+		"\tret unknown;\n"
+		"}\n"
+	);
+
+	// Act
+	const std::optional<GeneratedProgram> program = generate(*root_node, "main::start");
+	const std::optional<GeneratedProgram> missing = generate(*root_node, "main::other");
+
+	// Assert
+	REQUIRE(program.has_value());
+	// Reported by the type checker, before code is generated
+	CHECK(program->errors.empty());
+	CHECK(contains(program->units[0].source, "neon_fail(\"Unresolved call: missing\");"));
+	CHECK(contains(program->units[0].source, "neon_fail(\"Unresolved read: unknown\");"));
+	CHECK(contains(program->header.source, "neon_value neon_main__start(void);"));
+
+	CHECK_FALSE(missing.has_value());
+}
@@ -0,0 +1,58 @@
+#include "../../../libs/doctest/doctest.hpp"
+
+#include <memory>
+#include <vector>
+#include "../../../neon_compiler/ast/nodes/nodes.hpp"
+#include "../../../neon_compiler/ast/nodes/statement_nodes.hpp"
+#include "../../../neon_compiler/evaluation/bytecode_compiler.hpp"
+#include "../../../neon_compiler/resolution/resolution.hpp"
+
+using namespace neon_compiler::ast::nodes;
+using namespace neon_compiler::evaluation;
+using namespace neon_compiler::resolution;
+
+static std::unique_ptr<FunctionCall> make_call(const std::string& name, std::vector<std::unique_ptr<Expression>> arguments)
+{
+	return std::make_unique<FunctionCall>(name, std::vector<GenericArgument>{}, std::move(arguments));
+}
+
+TEST_CASE("Call arguments are computed into consecutive registers, which are reused after the call")
+{
+	// Arrange
+	std::vector<std::unique_ptr<Expression>> argument_arguments;
+	argument_arguments.push_back(std::make_unique<LiteralNumberExpression>("0"));
+
+	std::vector<std::unique_ptr<Expression>> concat_arguments;
+	concat_arguments.push_back(make_call("argument", std::move(argument_arguments)));
+	concat_arguments.push_back(std::make_unique<LiteralStringExpression>("x"));
+
+	std::vector<std::unique_ptr<Statement>> statements;
+	statements.push_back(std::make_unique<Return>(make_call("concat", std::move(concat_arguments))));
+	const CodeBlock body{std::move(statements)};
+
+	const Resolution resolution{};
+
+	// Act
+	const CompiledFunction compiled = BytecodeCompiler{resolution}.compile(body);
+
+	// Assert
+	REQUIRE(compiled.chunk.has_value());
+	const std::vector<Instruction>& instructions = compiled.chunk->instructions;
+	REQUIRE(instructions.size() == 6);
+
+	CHECK(instructions[0].op_code == OpCode::LOAD_CONSTANT);
+	CHECK(instructions[0].destination == 3);
+	CHECK(instructions[1].op_code == OpCode::CALL_INTRINSIC);
+	CHECK(instructions[1].destination == 1);
+	CHECK(instructions[1].first == 3);
+	CHECK(instructions[1].operand == static_cast<uint32_t>(Intrinsic::ARGUMENT));
+	CHECK(instructions[2].op_code == OpCode::LOAD_CONSTANT);
+	CHECK(instructions[2].destination == 2);
+	CHECK(instructions[3].op_code == OpCode::CALL_INTRINSIC);
+	CHECK(instructions[3].destination == 0);
+	CHECK(instructions[3].first == 1);
+	CHECK(instructions[3].count == 2);
+	CHECK(instructions[4].op_code == OpCode::RETURN);
+	CHECK(instructions[5].op_code == OpCode::RETURN_VOID);
+	CHECK(compiled.chunk->register_count == 4);
+}
@@ -0,0 +1,121 @@
+#include "../../../libs/doctest/doctest.hpp"
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "../../../neon_compiler/token.hpp"
+#include "../../../neon_compiler/ast/nodes/nodes.hpp"
+#include "../../../neon_compiler/ast/nodes/statement_nodes.hpp"
+#include "../../../neon_compiler/evaluation/bytecode_compiler.hpp"
+#include "../../../neon_compiler/evaluation/compile_function_interpreter.hpp"
+#include "../../../neon_compiler/resolution/name_resolver.hpp"
+#include "../../test_support/parse.hpp"
+
+using namespace neon_compiler;
+using namespace neon_compiler::ast::nodes;
+using namespace neon_compiler::evaluation;
+using namespace neon_compiler::resolution;
+using namespace test_support;
+
+/** Replaces the entrypoint `main::<name>` by a compile function with its body, as compile functions are not parsed yet */
+static void make_compile_function(Root& root_node, const std::string& name)
+{
+	Entrypoint& entrypoint = static_cast<Entrypoint&>(*root_node.package_members.at("main::" + name));
+
+	root_node.package_members["main::" + name] =
+		std::make_unique<CompileFunction>(entrypoint.access, CompileFunctionScope::CODE_BLOCK, std::move(entrypoint.body));
+}
+
+/** Appends `auto: <name>(<arguments>)` to the entrypoint `main::start`, with each argument a single token */
+static void add_auto_call(Root& root_node, const std::string& name, const std::vector<Token>& arguments)
+{
+	std::unique_ptr<AutoCall> auto_call = std::make_unique<AutoCall>();
+	auto_call->function_name = name;
+	for(const Token& argument : arguments)
+	{
+		auto_call->arguments.push_back({argument});
+	}
+
+	static_cast<Entrypoint&>(*root_node.package_members.at("main::start")).body.statements.push_back(std::move(auto_call));
+}
+
+static Token make_string_token(const std::string& value)
+{
+	return Token{TokenType::LITERAL_STRING, reading::SourcePosition{}, static_cast<uint>(value.size() + 2), value};
+}
+
+static const AutoCall& get_auto_call(const Root& root_node, std::size_t index)
+{
+	const Entrypoint& start = static_cast<const Entrypoint&>(*root_node.package_members.at("main::start"));
+	return static_cast<const AutoCall&>(*start.body.statements.at(index));
+}
+
+constexpr const char* COMPILE_FUNCTIONS_SOURCE =
+	"pkg main;\n"
+	"public entrypoint describe()\n"
+	"{\n"
+	"\tret concat(kind(package_member(argument(0))), concat(\":\", argument_count()));\n"
+	"}\n"
+	"public entrypoint broken()\n"
+	"{\n"
+	"\tret unknown_function();\n"
+	"}\n"
+	"public entrypoint second()\n"
+	"{\n"
+	"\tret argument(1);\n"
+	"}\n"
+	"public entrypoint start()\n"
+	"{\n"
+	"}\n";
+
+TEST_CASE("Compile functions are compiled once and their expansions are cached by argument tokens")
+{
+	// Arrange
+	std::shared_ptr<Root> root_node = parse("main.neon", COMPILE_FUNCTIONS_SOURCE);
+	make_compile_function(*root_node, "describe");
+	add_auto_call(*root_node, "describe", {make_string_token("main::start")});
+	add_auto_call(*root_node, "describe", {make_string_token("main::describe")});
+	add_auto_call(*root_node, "describe", {make_string_token("main::start")});
+	concurrency::WorkStealingPool pool{1};
+	const std::shared_ptr<const Resolution> resolution = NameResolver{pool}.run(*root_node);
+
+	CompileFunctionInterpreter interpreter{*root_node, *resolution};
+
+	// Act
+	const std::size_t failed_count = interpreter.expand_all();
+
+	// Assert
+	CHECK(failed_count == 0);
+	CHECK(interpreter.find_expansion(get_auto_call(*root_node, 0))->value == Value{std::string{"entrypoint:1"}});
+	CHECK(interpreter.find_expansion(get_auto_call(*root_node, 1))->value == Value{std::string{"compile_function:1"}});
+	CHECK(interpreter.find_expansion(get_auto_call(*root_node, 2)) == interpreter.find_expansion(get_auto_call(*root_node, 0)));
+	CHECK(interpreter.get_compiled_count() == 1);
+	CHECK(interpreter.get_expansion_cache_miss_count() == 2);
+	CHECK(interpreter.get_expansion_cache_hit_count() == 1);
+}
+
+TEST_CASE("Compile functions that cannot be compiled or run expand to an error")
+{
+	// Arrange
+	std::shared_ptr<Root> root_node = parse("main.neon", COMPILE_FUNCTIONS_SOURCE);
+	make_compile_function(*root_node, "broken");
+	make_compile_function(*root_node, "second");
+	add_auto_call(*root_node, "broken", {});
+	add_auto_call(*root_node, "second", {make_string_token("one")});
+	add_auto_call(*root_node, "describe", {});
+	concurrency::WorkStealingPool pool{1};
+	const std::shared_ptr<const Resolution> resolution = NameResolver{pool}.run(*root_node);
+
+	CompileFunctionInterpreter interpreter{*root_node, *resolution};
+
+	// Act
+	const Expansion& broken = interpreter.expand(get_auto_call(*root_node, 0));
+	const Expansion& second = interpreter.expand(get_auto_call(*root_node, 1));
+	const Expansion& entrypoint = interpreter.expand(get_auto_call(*root_node, 2));
+
+	// Assert
+	CHECK(broken.error == std::string{bytecode_compiler_error_messages::UNKNOWN_FUNCTION} + "unknown_function");
+	CHECK(second.error == std::string{compile_function_interpreter_error_messages::ARGUMENT_OUT_OF_RANGE} + "1");
+	CHECK(entrypoint.error == std::string{compile_function_interpreter_error_messages::NOT_A_COMPILE_FUNCTION} + "describe");
+	CHECK_FALSE(broken.value.has_value());
+}
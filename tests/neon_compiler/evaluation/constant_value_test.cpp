@@ -0,0 +1,53 @@
+#include "../../../libs/doctest/doctest.hpp"
+
+#include <string>
+#include "../../../neon_compiler/evaluation/constant_value.hpp"
+
+using namespace neon_compiler::evaluation;
+
+TEST_CASE("Number literals are normalised to decimal notation")
+{
+	// Act
+	const std::string hexadecimal = normalise_number_literal("0x1F");
+	const std::string lowercase_hexadecimal = normalise_number_literal("0xff");
+	const std::string binary = normalise_number_literal("0b101");
+	const std::string binary_zero = normalise_number_literal("0b0000");
+	const std::string padded_decimal = normalise_number_literal("007.50");
+	const std::string whole_decimal = normalise_number_literal("10.0");
+	const std::string beyond_64_bits = normalise_number_literal("0x10000000000000000");
+
+	// Assert
+	CHECK(hexadecimal == "31");
+	CHECK(lowercase_hexadecimal == "255");
+	CHECK(binary == "5");
+	CHECK(binary_zero == "0");
+	CHECK(padded_decimal == "7.5");
+	CHECK(whole_decimal == "10");
+	CHECK(beyond_64_bits == "18446744073709551616");
+}
+
+TEST_CASE("Invalid number literals are left unchanged")
+{
+	// Act
+	const std::string prefix_only = normalise_number_literal("0x");
+	const std::string wrong_digit = normalise_number_literal("0b102");
+	const std::string two_points = normalise_number_literal("1.2.3");
+
+	// Assert
+	CHECK(prefix_only == "0x");
+	CHECK(wrong_digit == "0b102");
+	CHECK(two_points == "1.2.3");
+}
+
+TEST_CASE("Literals of the same number make equal values")
+{
+	// Act
+	const NumberValue hexadecimal = make_number_value("0x1F");
+	const NumberValue binary = make_number_value("0b11111");
+	const NumberValue decimal = make_number_value("31.000");
+
+	// Assert
+	CHECK(hexadecimal == binary);
+	CHECK(hexadecimal == decimal);
+	CHECK_FALSE(hexadecimal == make_number_value("32"));
+}
@@ -0,0 +1,195 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "../../../libs/doctest/doctest.hpp"
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "../../../concurrency/work_stealing_pool.hpp"
+#include "../../../neon_compiler/ast/nodes/nodes.hpp"
+#include "../../../neon_compiler/ast/nodes/statement_nodes.hpp"
+#include "../../../neon_compiler/evaluation/pure_evaluator.hpp"
+#include "../../../neon_compiler/resolution/name_resolver.hpp"
+#include "../../test_support/parse.hpp"
+
+using namespace neon_compiler;
+using namespace neon_compiler::ast::nodes;
+using namespace neon_compiler::evaluation;
+using namespace neon_compiler::resolution;
+using namespace test_support;
+
+/** Moves the entrypoints `main::<name>` into the pure function set `main::Tables`, as pure functions are not parsed yet */
+static void make_pure_functions(Root& root_node, const std::vector<std::string>& names)
+{
+	std::unique_ptr<PureFunctionSet> tables = std::make_unique<PureFunctionSet>();
+
+	for(const std::string& name : names)
+	{
+		Entrypoint& entrypoint = static_cast<Entrypoint&>(*root_node.package_members.at("main::" + name));
+
+		tables->methods[name].emplace_back
+		(
+			entrypoint.access,
+			ReferenceType{false, MutabilityMode::OWN, false, "int"},
+			std::move(entrypoint.parameters),
+			std::move(entrypoint.body)
+		);
+
+		root_node.package_members.erase("main::" + name);
+	}
+
+	root_node.package_members["main::Tables"] = std::move(tables);
+}
+
+/** Call expressions of the statements of the entrypoint `main::start`, in order */
+static std::vector<const Expression*> get_start_expressions(const Root& root_node)
+{
+	std::vector<const Expression*> expressions;
+
+	for(const std::unique_ptr<Statement>& statement : static_cast<const Entrypoint&>(*root_node.package_members.at("main::start")).body.statements)
+	{
+		expressions.push_back(static_cast<const DiscardExpression&>(*statement).expression.get());
+	}
+
+	return expressions;
+}
+
+constexpr const char* TABLES_SOURCE =
+	"pkg main;\n"
+	"public entrypoint identity(borrow int value)\n"
+	"{\n"
+	"\tret value;\n"
+	"}\n"
+	"public entrypoint second(borrow int first, borrow int second)\n"
+	"{\n"
+	"\tfirst = identity(second);\n"
+	"\tret first;\n"
+	"}\n"
+	"public entrypoint forever(borrow int value)\n"
+	"{\n"
+	"\tret forever(value);\n"
+	"}\n"
+	"public entrypoint start(borrow int number)\n"
+	"{\n"
+	"\tTables.second(1, \"two\");\n"
+	"\tTables.second(true, Tables.identity(0x1F));\n"
+	"\tTables.second(number, 3);\n"
+	"\tTables.forever(4);\n"
+	"\tTables.second(5);\n"
+	"}\n";
+
+TEST_CASE("Calls of pure functions with constant arguments are evaluated")
+{
+	// Arrange
+	std::shared_ptr<Root> root_node = parse("main.neon", TABLES_SOURCE);
+	make_pure_functions(*root_node, {"identity", "second", "forever"});
+	concurrency::WorkStealingPool pool{1};
+	const std::shared_ptr<const Resolution> resolution = NameResolver{pool}.run(*root_node);
+	const std::vector<const Expression*> expressions = get_start_expressions(*root_node);
+
+	PureEvaluator evaluator{*resolution};
+
+	// Act
+	const std::optional<ConstantValue> strings = evaluator.evaluate(*expressions[0]);
+	const std::optional<ConstantValue> numbers = evaluator.evaluate(*expressions[1]);
+	const std::optional<ConstantValue> parameter = evaluator.evaluate(*expressions[2]);
+	const std::optional<ConstantValue> endless = evaluator.evaluate(*expressions[3]);
+	const std::optional<ConstantValue> no_overload = evaluator.evaluate(*expressions[4]);
+
+	// Assert
+	CHECK(strings == ConstantValue{std::string{"two"}});
+	CHECK(numbers == ConstantValue{NumberValue{"31"}});
+	CHECK_FALSE(parameter.has_value());
+	CHECK_FALSE(endless.has_value());
+	CHECK_FALSE(no_overload.has_value());
+}
+
+TEST_CASE("Calls with the same function and argument values are evaluated once")
+{
+	// Arrange
+	std::string source = TABLES_SOURCE;
+	source.replace(source.rfind("}\n"), 2, "");
+	for(int i = 0; i < 20; ++i)
+	{
+		source += "\tTables.second(" + std::to_string(i % 2) + ", \"value\");\n";
+	}
+	source += "}\n";
+
+	std::shared_ptr<Root> root_node = parse("main.neon", source);
+	make_pure_functions(*root_node, {"identity", "second", "forever"});
+	concurrency::WorkStealingPool pool{1};
+	const std::shared_ptr<const Resolution> resolution = NameResolver{pool}.run(*root_node);
+	const std::vector<const Expression*> expressions = get_start_expressions(*root_node);
+
+	PureEvaluator evaluator{*resolution};
+
+	// Act
+	const FoldedCalls folded_calls = evaluator.fold_calls(*root_node);
+
+	// Assert
+	// The calls in `start` with constant arguments
+	CHECK(folded_calls.size() == 22);
+	CHECK(folded_calls.at(expressions[0]) == ConstantValue{std::string{"two"}});
+	CHECK(folded_calls.count(expressions[2]) == 0);
+	CHECK(folded_calls.at(expressions.back()) == ConstantValue{std::string{"value"}});
+	// The repeated `second(0, "value")` and `second(1, "value")`, and the repeated calls of `identity` within them
+	CHECK(evaluator.get_memo_hit_count() == 20);
+}
+
+constexpr const char* OPERATORS_SOURCE =
+	"pkg main::ops;\n"
+	"public operator_module picks\n"
+	"{\n"
+	"\toperator __ ~~ __ { subordination 1; associativity left; }\n"
+	"\toperator __ + __ { subordination 2; associativity left; }\n"
+	"\toperator - __ { subordination 0; }\n"
+	"\tint (int first) ~~ (int second)\n"
+	"\t{\n"
+	"\t\tret second;\n"
+	"\t}\n"
+	"\tint (int a) + (int b)\n"
+	"\t{\n"
+	"\t\tret add(a, b);\n"
+	"\t}\n"
+	"}\n";
+
+constexpr const char* OPERATOR_CALLS_SOURCE =
+	"pkg main;\n"
+	"import main::ops::picks;\n"
+	"use picks;\n"
+	"public entrypoint start(borrow int number)\n"
+	"{\n"
+	"\t0x10 ~~ 0b101;\n"
+	"\t1 ~~ 2 ~~ 007.50;\n"
+	"\t1 + 2;\n"
+	"\tnumber ~~ 3;\n"
+	"\t-4;\n"
+	"\t1 + (0b11 ~~ 0x0a);\n"
+	"}\n";
+
+TEST_CASE("Calls of operator functions with constant arguments are folded")
+{
+	// Arrange
+	std::shared_ptr<Root> root_node = parse({SourceFile{"ops.neon", OPERATORS_SOURCE}, SourceFile{"main.neon", OPERATOR_CALLS_SOURCE}});
+	concurrency::WorkStealingPool pool{1};
+	const std::shared_ptr<const Resolution> resolution = NameResolver{pool}.run(*root_node);
+	const std::vector<const Expression*> expressions = get_start_expressions(*root_node);
+	REQUIRE(expressions.size() == 6);
+
+	PureEvaluator evaluator{*resolution};
+
+	// Act
+	const FoldedCalls folded_calls = evaluator.fold_calls(*root_node);
+
+	// Assert
+	CHECK(folded_calls.size() == 3);
+	CHECK(folded_calls.at(expressions[0]) == ConstantValue{NumberValue{"5"}});
+	CHECK(folded_calls.at(expressions[1]) == ConstantValue{NumberValue{"7.5"}});
+	CHECK(folded_calls.count(expressions[2]) == 0);
+	CHECK(folded_calls.count(expressions[3]) == 0);
+	CHECK(folded_calls.count(expressions[4]) == 0);
+
+	const OperatorCallExpression& sum = static_cast<const OperatorCallExpression&>(*expressions[5]);
+	CHECK(folded_calls.count(expressions[5]) == 0);
+	CHECK(folded_calls.at(sum.arguments[1].get()) == ConstantValue{NumberValue{"10"}});
+}
@@ -0,0 +1,65 @@
+#include "../../../libs/doctest/doctest.hpp"
+
+#include <string>
+#include <vector>
+#include "../../../neon_compiler/index/dependency_graph.hpp"
+
+using namespace neon_compiler::index;
+
+TEST_CASE("Files depend on the files declaring what they import and use")
+{
+	// Arrange
+	DependencyGraph graph{};
+
+	graph.update_file("ops.neon", std::vector<std::string>{"main::ops::arith"}, std::vector<Dependency>{});
+	graph.update_file("widget.neon", std::vector<std::string>{"main::Widget"}, std::vector<Dependency>{});
+	graph.update_file("main.neon", std::vector<std::string>{"main::start"}, std::vector<Dependency>
+	{
+		Dependency{"main::ops::arith", DependencyKind::USE},
+		Dependency{"main::Widget", DependencyKind::IMPORT},
+		Dependency{"main::Missing", DependencyKind::IMPORT}
+	});
+
+	// Act
+	const std::vector<std::string> dependencies = graph.get_dependencies("main.neon");
+
+	// Assert
+	CHECK(dependencies == std::vector<std::string>{"ops.neon", "widget.neon"});
+	CHECK(graph.get_dependents("ops.neon") == std::vector<std::string>{"main.neon"});
+	CHECK(graph.get_dependents("main.neon").empty());
+	CHECK(graph.get_dependents_of("main::ops::arith", DependencyKind::USE) == std::vector<std::string>{"main.neon"});
+	CHECK(graph.get_dependents_of("main::Widget", DependencyKind::USE).empty());
+}
+
+TEST_CASE("Dependencies on undeclared package members apply once they are declared")
+{
+	// Arrange
+	DependencyGraph graph{};
+
+	graph.update_file("main.neon", std::vector<std::string>{}, std::vector<Dependency>{Dependency{"main::ops::arith", DependencyKind::USE}});
+
+	// Act
+	graph.update_file("ops.neon", std::vector<std::string>{"main::ops::arith"}, std::vector<Dependency>{});
+
+	// Assert
+	CHECK(graph.get_dependencies("main.neon") == std::vector<std::string>{"ops.neon"});
+	CHECK(graph.get_dependents("ops.neon") == std::vector<std::string>{"main.neon"});
+}
+
+TEST_CASE("Updating a file replaces its edges")
+{
+	// Arrange
+	DependencyGraph graph{};
+
+	graph.update_file("ops.neon", std::vector<std::string>{"main::ops::arith"}, std::vector<Dependency>{});
+	graph.update_file("main.neon", std::vector<std::string>{}, std::vector<Dependency>{Dependency{"main::ops::arith", DependencyKind::USE}});
+
+	// Act
+	graph.update_file("main.neon", std::vector<std::string>{}, std::vector<Dependency>{});
+	graph.remove_file("ops.neon");
+
+	// Assert
+	CHECK(graph.get_dependencies("main.neon").empty());
+	CHECK(graph.get_dependents_of("main::ops::arith", DependencyKind::USE).empty());
+	CHECK(graph.get_declarations("ops.neon").empty());
+}
@@ -0,0 +1,137 @@
+#include "../../../libs/doctest/doctest.hpp"
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+#include "../../../neon_compiler/analysis/analysis_entry.hpp"
+#include "../../../neon_compiler/analysis/impl/reference_indexing_analysis_reporter.hpp"
+#include "../../../neon_compiler/index/reference_index.hpp"
+
+using namespace neon_compiler::analysis;
+using namespace neon_compiler::analysis::impl;
+using namespace neon_compiler::index;
+
+namespace
+{
+	class NullAnalysisReporter : public AnalysisReporter
+	{
+	public:
+		void report(const AnalysisEntry&) override {}
+	};
+
+	void report(AnalysisReporter& reporter, AnalysisEntryType type, uint32_t offset, uint32_t length, std::optional<std::string> info = std::nullopt)
+	{
+		reporter.report(AnalysisEntry{"", type, AnalysisSeverity::INFO, reading::SourcePosition{offset, 0, offset}, length, info});
+	}
+}
+
+TEST_CASE("References are found across files")
+{
+	// Arrange
+	std::shared_ptr<SymbolInterner> interner = std::make_shared<SymbolInterner>();
+	std::shared_ptr<ReferenceIndex> index = std::make_shared<ReferenceIndex>(interner);
+
+	ReferenceIndexingAnalysisReporter a{std::make_shared<NullAnalysisReporter>(), index, "a.neon"};
+	report(a, AnalysisEntryType::DECLARATION, 10, 6, "main::Widget");
+	a.commit();
+
+	ReferenceIndexingAnalysisReporter b{std::make_shared<NullAnalysisReporter>(), index, "b.neon"};
+	// `main::Widget` is reported per token
+	report(b, AnalysisEntryType::REFERENCE, 20, 4, "main::Widget");
+	report(b, AnalysisEntryType::REFERENCE, 24, 2, "main::Widget");
+	report(b, AnalysisEntryType::REFERENCE, 26, 6, "main::Widget");
+	report(b, AnalysisEntryType::SEPARATOR, 32, 1);
+	report(b, AnalysisEntryType::REFERENCE, 40, 6, "main::Widget");
+	b.commit();
+
+	const SymbolId id = interner->find("main::Widget").value();
+
+	// Act
+	const std::vector<SymbolLocation> references = index->find_references(id);
+	const std::vector<SymbolLocation> declarations = index->find_declarations(id);
+	const std::vector<SymbolLocation> rename_locations = index->find_rename_locations(id);
+
+	// Assert
+	CHECK(references.size() == 3);
+	REQUIRE(declarations.size() == 1);
+	CHECK(declarations[0].file == "a.neon");
+
+	REQUIRE(rename_locations.size() == 3);
+	for(const SymbolLocation& location : rename_locations)
+	{
+		CHECK(location.occurrence.length == 6);
+	}
+}
+
+TEST_CASE("Errors at references are forwarded but not indexed")
+{
+	// Arrange
+	std::shared_ptr<SymbolInterner> interner = std::make_shared<SymbolInterner>();
+	std::shared_ptr<ReferenceIndex> index = std::make_shared<ReferenceIndex>(interner);
+
+	ReferenceIndexingAnalysisReporter reporter{std::make_shared<NullAnalysisReporter>(), index, "a.neon"};
+	report(reporter, AnalysisEntryType::REFERENCE, 0, 4, "main::show");
+
+	// Act
+	reporter.report(AnalysisEntry
+	{
+		"", AnalysisEntryType::REFERENCE, AnalysisSeverity::ERROR, reading::SourcePosition{0, 0, 0}, 4, "Argument type mismatch"
+	});
+	reporter.commit();
+
+	// Assert
+	CHECK(index->find_references(interner->find("main::show").value()).size() == 1);
+	CHECK_FALSE(interner->find("Argument type mismatch").has_value());
+}
+
+TEST_CASE("Recomputing a file replaces only its references")
+{
+	// Arrange
+	std::shared_ptr<SymbolInterner> interner = std::make_shared<SymbolInterner>();
+	ReferenceIndex index{interner};
+
+	const SymbolOccurrence occurrence{reading::SourcePosition{0, 0, 0}, 3, false};
+
+	index.replace_file("a.neon", {{"main::foo", occurrence}, {"main::bar", occurrence}});
+	index.replace_file("b.neon", {{"main::foo", occurrence}});
+
+	// Act
+	index.replace_file("a.neon", {{"main::bar", occurrence}});
+
+	// Assert
+	CHECK(index.find_references(interner->find("main::foo").value()).size() == 1);
+	CHECK(index.find_references(interner->find("main::bar").value()).size() == 1);
+
+	index.remove_file("b.neon");
+
+	CHECK(index.find_references(interner->find("main::foo").value()).empty());
+}
+
+TEST_CASE("References are resolved on commit, and left out if they resolve to nothing")
+{
+	// Arrange
+	std::shared_ptr<SymbolInterner> interner = std::make_shared<SymbolInterner>();
+	std::shared_ptr<ReferenceIndex> index = std::make_shared<ReferenceIndex>(interner);
+
+	ReferenceIndexingAnalysisReporter reporter{std::make_shared<NullAnalysisReporter>(), index, "a.neon"};
+	report(reporter, AnalysisEntryType::DECLARATION, 0, 5, "main::start");
+	report(reporter, AnalysisEntryType::SEPARATOR, 5, 1);
+	report(reporter, AnalysisEntryType::REFERENCE, 10, 6, "helper");
+	report(reporter, AnalysisEntryType::SEPARATOR, 16, 1);
+	// A local variable, which has no symbol
+	report(reporter, AnalysisEntryType::REFERENCE, 20, 1, "x");
+
+	// Act
+	reporter.commit([] (const std::string& symbol, const SymbolOccurrence&) -> std::optional<std::string>
+	{
+		if(symbol == "helper") { return "main::helper"; }
+		return std::nullopt;
+	});
+
+	// Assert
+	CHECK(index->find_declarations(interner->find("main::start").value()).size() == 1);
+	CHECK(index->find_references(interner->find("main::helper").value()).size() == 1);
+	CHECK_FALSE(interner->find("helper").has_value());
+	CHECK_FALSE(interner->find("x").has_value());
+}
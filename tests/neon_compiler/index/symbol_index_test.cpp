@@ -0,0 +1,101 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "../../../libs/doctest/doctest.hpp"
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "../../../neon_compiler/index/symbol_interner.hpp"
+#include "../../../neon_compiler/index/symbol_index.hpp"
+
+using namespace neon_compiler::index;
+
+TEST_CASE("Interned symbols keep their ids")
+{
+	// Arrange
+	SymbolInterner interner{};
+
+	// Act
+	const SymbolId a = interner.intern("main::Widget");
+	const SymbolId b = interner.intern("main::Gadget");
+
+	// Assert
+	CHECK(a != b);
+	CHECK(interner.intern("main::Widget") == a);
+	CHECK(interner.find("main::Gadget").value() == b);
+	CHECK(!interner.find("main::Missing").has_value());
+	CHECK(interner.get_name(a) == "main::Widget");
+}
+
+TEST_CASE("Symbol search ranks exact member names first")
+{
+	// Arrange
+	std::shared_ptr<SymbolInterner> interner = std::make_shared<SymbolInterner>();
+	SymbolIndex index{interner};
+
+	index.update_file("a.neon", std::vector<std::string>{"main::subpkg::Widget", "main::subpkg::WidgetFactory"});
+	index.update_file("b.neon", std::vector<std::string>{"main::other::Gadget", "main::widgets::Panel"});
+
+	// Act
+	const std::vector<SymbolMatch> matches = index.search("widget", 10);
+
+	// Assert
+	REQUIRE(matches.size() >= 2);
+	CHECK(interner->get_name(matches[0].id) == "main::subpkg::Widget");
+	CHECK(interner->get_name(matches[1].id) == "main::subpkg::WidgetFactory");
+}
+
+TEST_CASE("Symbol search tolerates typos")
+{
+	// Arrange
+	std::shared_ptr<SymbolInterner> interner = std::make_shared<SymbolInterner>();
+	SymbolIndex index{interner};
+
+	index.update_file("a.neon", std::vector<std::string>{"main::OperatorTable", "main::Parser"});
+
+	// Act
+	const std::vector<SymbolMatch> matches = index.search("operatortabel", 10);
+
+	// Assert
+	REQUIRE(matches.size() == 1);
+	CHECK(interner->get_name(matches[0].id) == "main::OperatorTable");
+}
+
+TEST_CASE("Re-indexing a file replaces its symbols")
+{
+	// Arrange
+	std::shared_ptr<SymbolInterner> interner = std::make_shared<SymbolInterner>();
+	SymbolIndex index{interner};
+
+	index.update_file("a.neon", std::vector<std::string>{"main::Alpha", "main::Beta"});
+	index.update_file("b.neon", std::vector<std::string>{"main::Gamma"});
+
+	// Act
+	index.update_file("a.neon", std::vector<std::string>{"main::Beta", "main::Delta"});
+
+	// Assert
+	CHECK(index.get_live_symbol_count() == 3);
+	CHECK(index.search("alpha", 10).empty());
+	CHECK(index.search("beta", 10).size() == 1);
+	CHECK(index.search("delta", 10).size() == 1);
+
+	index.remove_file("b.neon");
+
+	CHECK(index.search("gamma", 10).empty());
+	CHECK(index.get_live_symbol_count() == 2);
+}
+
+TEST_CASE("Single character queries match member name prefixes")
+{
+	// Arrange
+	std::shared_ptr<SymbolInterner> interner = std::make_shared<SymbolInterner>();
+	SymbolIndex index{interner};
+
+	index.update_file("a.neon", std::vector<std::string>{"main::Widget", "main::Gadget", "widgets::Panel"});
+
+	// Act
+	const std::vector<SymbolMatch> matches = index.search("w", 10);
+
+	// Assert
+	REQUIRE(matches.size() == 1);
+	CHECK(interner->get_name(matches[0].id) == "main::Widget");
+}
@@ -0,0 +1,103 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "../../../libs/doctest/doctest.hpp"
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "../../../concurrency/work_stealing_pool.hpp"
+#include "../../../neon_compiler/ast/nodes/nodes.hpp"
+#include "../../../neon_compiler/evaluation/pure_evaluator.hpp"
+#include "../../../neon_compiler/ir/ir.hpp"
+#include "../../../neon_compiler/ir/ir_lowerer.hpp"
+#include "../../../neon_compiler/resolution/name_resolver.hpp"
+#include "../../test_support/parse.hpp"
+
+using namespace neon_compiler;
+using namespace neon_compiler::ast::nodes;
+using namespace neon_compiler::ir;
+using namespace neon_compiler::resolution;
+using namespace test_support;
+
+TEST_CASE("Bodies are lowered to one block in SSA form, with variables standing for their last values")
+{
+	// Arrange
+	std::shared_ptr<Root> root_node = parse_with_box
+	(
+		"main.neon",
+		"pkg main;\n"
+		"public entrypoint start(shared Box box)\n"
+		"{\n"
+		"\tbox = Box();\n"
+		"\tbox.size = 0x1F;\n"
+		"\tshow(box);\n"
+		"\tmissing();\n"
+		"\tret box;\n"
+		"\tprint(\"unreached\");\n"
+		"}\n"
+		"public entrypoint show(borrow Box box)\n"
+		"{\n"
+		"\tprint(box.size);\n"
+		"}\n"
+	);
+	concurrency::WorkStealingPool pool{2};
+	const std::shared_ptr<const Resolution> resolution = NameResolver{pool}.run(*root_node);
+	const evaluation::FoldedCalls folded_calls{};
+
+	// Act
+	const Module module = IrLowerer{*resolution, folded_calls, nullptr, pool}.run(*root_node);
+
+	// Assert
+	REQUIRE(module.functions.size() == 2);
+
+	CHECK(to_string(module.functions[0]) ==
+		"function main::show(1)\n"
+		"block 0:\n"
+		"\t%0 = parameter 0\n"
+		"\t%1 = get_field 0 %0\n"
+		"\t%2 = call_runtime \"print\"(%1)\n"
+		"\treturn\n"
+	);
+	CHECK(to_string(module.functions[1]) ==
+		"function main::start(1)\n"
+		"block 0:\n"
+		"\t%0 = parameter 0\n"
+		"\t%1 = allocate 1\n"
+		"\t%2 = constant 31\n"
+		"\tset_field 0 %1, %2\n"
+		"\t%4 = call #0(%1)\n"
+		"\t%5 = fail \"Unresolved call: missing\"\n"
+		"\treturn %1\n"
+	);
+
+	for(const Function& function : module.functions)
+	{
+		CAPTURE(function.name);
+		CHECK(verify(function).empty());
+	}
+}
+
+TEST_CASE("Verification finds uses before definitions and blocks without return")
+{
+	// Arrange
+	Function function;
+	function.name = "broken";
+	function.constants.push_back(evaluation::NumberValue{"1"});
+	function.operands = {1};
+	function.instructions =
+	{
+		Instruction{OpCode::RETURN, 0, 1, 0},
+		Instruction{OpCode::CONSTANT, 1, 0, 0}
+	};
+	function.blocks = {Block{0, 2}};
+
+	// Act
+	const std::vector<std::string> errors = verify(function);
+
+	// Assert
+	CHECK(errors == std::vector<std::string>
+	{
+		std::string{ir_error_messages::NO_TERMINATOR} + "0",
+		std::string{ir_error_messages::TERMINATOR_INSIDE_BLOCK} + "0",
+		std::string{ir_error_messages::USE_BEFORE_DEFINITION} + "0"
+	});
+}
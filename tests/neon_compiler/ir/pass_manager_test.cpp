@@ -0,0 +1,108 @@
+#include "../../../libs/doctest/doctest.hpp"
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "../../../concurrency/work_stealing_pool.hpp"
+#include "../../../neon_compiler/ir/dead_value_elimination.hpp"
+#include "../../../neon_compiler/ir/ir.hpp"
+#include "../../../neon_compiler/ir/pass_manager.hpp"
+
+using namespace neon_compiler;
+using namespace neon_compiler::evaluation;
+using namespace neon_compiler::ir;
+
+/** Appends `suffix` to the name of each function, to record the order in which passes ran */
+class NamingPass : public FunctionPass
+{
+public:
+	explicit NamingPass(std::string init_suffix)
+		: suffix{std::move(init_suffix)} {}
+
+	std::string_view get_name() const override
+	{
+		return "NamingPass";
+	}
+
+	void run(Function& function) const override
+	{
+		function.name += suffix;
+	}
+
+private:
+	std::string suffix;
+};
+
+/** `%0 = parameter 0`, `%1 = constant 1`, `%2 = allocate 0`, `%3 = call #0(%0)`, `%4 = constant 2`, `return %4` */
+static Function make_function()
+{
+	Function function;
+	function.name = "f";
+	function.parameter_count = 1;
+	function.constants = {NumberValue{"1"}, NumberValue{"2"}};
+	function.operands = {0, 4};
+	function.instructions =
+	{
+		Instruction{OpCode::PARAMETER, 0, 0, 0},
+		Instruction{OpCode::CONSTANT, 0, 0, 0},
+		Instruction{OpCode::ALLOCATE, 0, 0, 0},
+		Instruction{OpCode::CALL, 0, 1, 0},
+		Instruction{OpCode::CONSTANT, 1, 0, 1},
+		Instruction{OpCode::RETURN, 1, 1, 0}
+	};
+	function.blocks = {Block{0, 6}};
+	return function;
+}
+
+TEST_CASE("Every function goes through the passes in order")
+{
+	// Arrange
+	Module module;
+	for(std::size_t i = 0; i < 100; ++i)
+	{
+		module.functions.push_back(Function{});
+		module.functions.back().name = std::to_string(i);
+	}
+
+	concurrency::WorkStealingPool pool{4};
+	PassManager pass_manager{pool};
+	pass_manager.add_pass(std::make_unique<NamingPass>("a"));
+	pass_manager.add_pass(std::make_unique<NamingPass>("b"));
+
+	// Act
+	pass_manager.run(module);
+
+	// Assert
+	for(std::size_t i = 0; i < module.functions.size(); ++i)
+	{
+		CHECK(module.functions[i].name == std::to_string(i) + "ab");
+	}
+}
+
+TEST_CASE("Dead value elimination removes unused pure values and renumbers the others")
+{
+	// Arrange
+	Module module;
+	module.functions.push_back(make_function());
+
+	concurrency::WorkStealingPool pool{1};
+	PassManager pass_manager{pool};
+	pass_manager.add_pass(std::make_unique<DeadValueElimination>());
+
+	// Act
+	pass_manager.run(module);
+
+	// Assert
+	const Function& function = module.functions.front();
+
+	CHECK(to_string(function) ==
+		"function f(1)\n"
+		"block 0:\n"
+		"\t%0 = parameter 0\n"
+		"\t%1 = call #0(%0)\n"
+		"\t%2 = constant 2\n"
+		"\treturn %2\n"
+	);
+	CHECK(verify(function).empty());
+}
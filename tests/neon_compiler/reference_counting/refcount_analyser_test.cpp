@@ -0,0 +1,185 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "../../../libs/doctest/doctest.hpp"
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "../../../concurrency/work_stealing_pool.hpp"
+#include "../../../neon_compiler/ast/nodes/nodes.hpp"
+#include "../../../neon_compiler/ast/nodes/statement_nodes.hpp"
+#include "../../../neon_compiler/reference_counting/refcount_analyser.hpp"
+#include "../../../neon_compiler/resolution/name_resolver.hpp"
+#include "../../test_support/parse.hpp"
+
+using namespace neon_compiler;
+using namespace neon_compiler::ast::nodes;
+using namespace neon_compiler::reference_counting;
+using namespace neon_compiler::resolution;
+using namespace test_support;
+
+static Entrypoint& get_entrypoint(Root& root_node, const std::string& name)
+{
+	return static_cast<Entrypoint&>(*root_node.package_members.at("main::" + name));
+}
+
+/** The read of the statement at `index` of `entrypoint`, which is `<name>`, `<name>.<member>(...)`, `<function>(<name>)`,
+ * `<target> = <name>` or `ret <name>` */
+static const SimpleRead* get_read(const Entrypoint& entrypoint, std::size_t index)
+{
+	const Statement* statement = entrypoint.body.statements.at(index).get();
+
+	if(const Return* ret = dynamic_cast<const Return*>(statement))
+	{
+		return static_cast<const SimpleRead*>(ret->value.get());
+	}
+
+	const Expression* expression = static_cast<const DiscardExpression*>(statement)->expression.get();
+
+	if(const FunctionCall* call = dynamic_cast<const FunctionCall*>(expression))
+	{
+		return static_cast<const SimpleRead*>(call->arguments.front().get());
+	}
+	if(const ObjectFunctionCall* object_call = dynamic_cast<const ObjectFunctionCall*>(expression))
+	{
+		return static_cast<const SimpleRead*>(object_call->object.get());
+	}
+	if(const Assignment* assignment = dynamic_cast<const Assignment*>(expression))
+	{
+		return static_cast<const SimpleRead*>(assignment->value.get());
+	}
+
+	return static_cast<const SimpleRead*>(expression);
+}
+
+/** Adds `shared str <name> = <source>;` at the start of the body of `entrypoint`, as local declarations are not parsed yet */
+static void declare_local(Entrypoint& entrypoint, const std::string& name, const std::string& source)
+{
+	std::unique_ptr<Statement> local = std::make_unique<LocalDeclaration>
+	(
+		VariableDeclaration{false, ReferenceType{false, MutabilityMode::SHARED, false, "str"}, name, std::make_unique<SimpleRead>(source)}
+	);
+
+	entrypoint.body.statements.insert(entrypoint.body.statements.begin(), std::move(local));
+}
+
+TEST_CASE("Reads of shared references borrow, copy or move by what follows them")
+{
+	// Arrange
+	std::shared_ptr<Root> root_node = parse
+	(
+		"main.neon",
+		"pkg main;\n"
+		"public entrypoint log(borrow str text)\n"
+		"{\n"
+		"}\n"
+		"public entrypoint start(shared str a, shared str b, borrow str c, shared str d)\n"
+		"{\n"
+		"\tprint(a);\n"
+		"\tlog(a);\n"
+		"\tkeep(a);\n"
+		"\tb.length();\n"
+		"\tc = b;\n"
+		"\td = b;\n"
+		"\tret d;\n"
+		"}\n"
+	);
+	concurrency::WorkStealingPool pool{2};
+	const std::shared_ptr<const Resolution> resolution = NameResolver{pool}.run(*root_node);
+	const Entrypoint& start = get_entrypoint(*root_node, "start");
+
+
+	// Act
+	const RefcountAnnotations annotations = RefcountAnalyser{pool}.run(*root_node, *resolution);
+
+	// Assert
+	REQUIRE(annotations.reads.size() == 7);
+	CHECK(annotations.reads.at(get_read(start, 0)) == ReferenceTransfer::COPY);
+	CHECK(annotations.reads.at(get_read(start, 1)) == ReferenceTransfer::BORROW);
+	CHECK(annotations.reads.at(get_read(start, 2)) == ReferenceTransfer::MOVE);
+	CHECK(annotations.reads.at(get_read(start, 3)) == ReferenceTransfer::BORROW);
+	CHECK(annotations.reads.at(get_read(start, 4)) == ReferenceTransfer::BORROW);
+	CHECK(annotations.reads.at(get_read(start, 5)) == ReferenceTransfer::MOVE);
+	CHECK(annotations.reads.at(get_read(start, 6)) == ReferenceTransfer::MOVE);
+
+	// `c` is a borrow, so it is not counted
+	CHECK(annotations.variables.size() == 3);
+	CHECK_FALSE(annotations.variables.at(&start.parameters[0]).released_at_end);
+	CHECK(annotations.variables.at(&start.parameters[0]).escapes);
+	CHECK_FALSE(annotations.variables.at(&start.parameters[3]).released_at_end);
+
+	CHECK(annotations.elided_increment_count == 6);
+	CHECK(annotations.elided_decrement_count == 3);
+}
+
+TEST_CASE("Locals that only borrow the reference of a longer lived variable are not counted")
+{
+	// Arrange
+	std::shared_ptr<Root> root_node = parse
+	(
+		"main.neon",
+		"pkg main;\n"
+		"public entrypoint log(borrow str text)\n"
+		"{\n"
+		"}\n"
+		"public entrypoint borrowing(shared str a)\n"
+		"{\n"
+		"\talias.length();\n"
+		"\tlog(alias);\n"
+		"\tlog(a);\n"
+		"}\n"
+		"public entrypoint keeping(shared str a)\n"
+		"{\n"
+		"\tkeep(alias);\n"
+		"\tlog(a);\n"
+		"}\n"
+		"public entrypoint outliving(shared str a)\n"
+		"{\n"
+		"\tlog(alias);\n"
+		"\tkeep(a);\n"
+		"}\n"
+		"public entrypoint expanding(shared str a)\n"
+		"{\n"
+		"\tlog(alias);\n"
+		"}\n"
+	);
+	for(const std::string name : {"borrowing", "keeping", "outliving", "expanding"})
+	{
+		declare_local(get_entrypoint(*root_node, name), "alias", "a");
+	}
+	std::unique_ptr<AutoCall> auto_call = std::make_unique<AutoCall>();
+	auto_call->function_name = "generate";
+	get_entrypoint(*root_node, "expanding").body.statements.push_back(std::move(auto_call));
+
+	concurrency::WorkStealingPool pool{1};
+	const std::shared_ptr<const Resolution> resolution = NameResolver{pool}.run(*root_node);
+
+	// Act
+	const RefcountAnnotations annotations = RefcountAnalyser{pool}.run(*root_node, *resolution);
+
+	// Assert
+	struct Expectation
+	{
+		std::string name;
+		bool borrows;
+		bool released_at_end;
+	};
+
+	// `keeping` moves `alias` out at its last use, the others hold their references until the end
+	for(const Expectation& expectation : std::vector<Expectation>{
+		{"borrowing", true, false}, {"keeping", false, false}, {"outliving", false, true}, {"expanding", false, true}})
+	{
+		CAPTURE(expectation.name);
+
+		const Entrypoint& entrypoint = get_entrypoint(*root_node, expectation.name);
+		const VariableDeclaration& alias = static_cast<const LocalDeclaration&>(*entrypoint.body.statements[0]).variable_declaration;
+
+		CHECK(annotations.variables.at(&alias).counted == !expectation.borrows);
+		CHECK(annotations.variables.at(&alias).released_at_end == expectation.released_at_end);
+		CHECK(annotations.reads.at(static_cast<const SimpleRead*>(alias.initialisation.get()))
+			== (expectation.borrows ? ReferenceTransfer::BORROW : ReferenceTransfer::COPY));
+	}
+
+	const Entrypoint& expanding = get_entrypoint(*root_node, "expanding");
+	CHECK(annotations.variables.at(&expanding.parameters[0]).escapes);
+	CHECK(annotations.variables.at(&expanding.parameters[0]).released_at_end);
+}
@@ -0,0 +1,147 @@
+#include "../../../libs/doctest/doctest.hpp"
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "../../../concurrency/work_stealing_pool.hpp"
+#include "../../../neon_compiler/ast/nodes/nodes.hpp"
+#include "../../../neon_compiler/ast/nodes/statement_nodes.hpp"
+#include "../../../neon_compiler/reference_counting/thread_escape_analyser.hpp"
+#include "../../../neon_compiler/resolution/name_resolver.hpp"
+#include "../../test_support/parse.hpp"
+
+using namespace neon_compiler;
+using namespace neon_compiler::ast::nodes;
+using namespace neon_compiler::reference_counting;
+using namespace neon_compiler::resolution;
+using namespace test_support;
+
+static Entrypoint& get_entrypoint(Root& root_node, const std::string& name)
+{
+	return static_cast<Entrypoint&>(*root_node.package_members.at("main::" + name));
+}
+
+/** The expression of the statement at `index` of `entrypoint` */
+static const Expression* get_expression(const Entrypoint& entrypoint, std::size_t index)
+{
+	return static_cast<const DiscardExpression&>(*entrypoint.body.statements.at(index)).expression.get();
+}
+
+/** The first argument of the call at `index` of `entrypoint` */
+static const FunctionCall* get_argument(const Entrypoint& entrypoint, std::size_t index)
+{
+	return static_cast<const FunctionCall*>(static_cast<const FunctionCall*>(get_expression(entrypoint, index))->arguments.front().get());
+}
+
+/** The value assigned by the statement at `index` of `entrypoint` */
+static const FunctionCall* get_assigned(const Entrypoint& entrypoint, std::size_t index)
+{
+	return static_cast<const FunctionCall*>(static_cast<const Assignment*>(get_expression(entrypoint, index))->value.get());
+}
+
+TEST_CASE("Allocations are thread-local unless a variable they flow into escapes")
+{
+	// Arrange
+	std::shared_ptr<Root> root_node = parse_with_box
+	(
+		"main.neon",
+		"pkg main;\n"
+		"public entrypoint keep(shared Box box)\n"
+		"{\n"
+		"}\n"
+		"public entrypoint log(borrow Box box)\n"
+		"{\n"
+		"}\n"
+		"public entrypoint start(shared Box a, shared Box b, shared Box c, shared Box d)\n"
+		"{\n"
+		"\tBox();\n"
+		"\ta = Box();\n"
+		"\ta.size();\n"
+		"\tlog(a);\n"
+		"\tb = Box();\n"
+		"\tkeep(b);\n"
+		"\tc = Box();\n"
+		"\td = c;\n"
+		"\tkeep(Box(Box()));\n"
+		"\tlog(Box());\n"
+		"\tret d;\n"
+		"}\n"
+	);
+	concurrency::WorkStealingPool pool{2};
+	const std::shared_ptr<const Resolution> resolution = NameResolver{pool}.run(*root_node);
+	const Entrypoint& start = get_entrypoint(*root_node, "start");
+
+
+	// Act
+	const AllocationAnnotations annotations = ThreadEscapeAnalyser{pool}.run(*root_node, *resolution);
+
+	// Assert
+	const FunctionCall* outer = get_argument(start, 8);
+	const FunctionCall* inner = static_cast<const FunctionCall*>(outer->arguments.front().get());
+
+	REQUIRE(annotations.allocations.size() == 7);
+	CHECK(annotations.allocations.at(static_cast<const FunctionCall*>(get_expression(start, 0))) == AllocationSharing::THREAD_LOCAL);
+	CHECK(annotations.allocations.at(get_assigned(start, 1)) == AllocationSharing::THREAD_LOCAL);
+	CHECK(annotations.allocations.at(get_assigned(start, 4)) == AllocationSharing::SHARED);
+	CHECK(annotations.allocations.at(get_assigned(start, 6)) == AllocationSharing::SHARED);
+	CHECK(annotations.allocations.at(outer) == AllocationSharing::SHARED);
+	CHECK(annotations.allocations.at(inner) == AllocationSharing::SHARED);
+	CHECK(annotations.allocations.at(get_argument(start, 9)) == AllocationSharing::THREAD_LOCAL);
+
+	CHECK(annotations.thread_local_count == 3);
+}
+
+TEST_CASE("Locals escape when a compile function call might keep them")
+{
+	// Arrange
+	std::shared_ptr<Root> root_node = parse_with_box
+	(
+		"main.neon",
+		"pkg main;\n"
+		"public entrypoint log(borrow Box box)\n"
+		"{\n"
+		"}\n"
+		"public entrypoint local()\n"
+		"{\n"
+		"\tlog(box);\n"
+		"}\n"
+		"public entrypoint expanding()\n"
+		"{\n"
+		"\tlog(box);\n"
+		"}\n"
+	);
+	for(const std::string name : {"local", "expanding"})
+	{
+		std::unique_ptr<Expression> allocation = std::make_unique<FunctionCall>
+		(
+			"Box", std::vector<GenericArgument>{}, std::vector<std::unique_ptr<Expression>>{}
+		);
+		std::unique_ptr<Statement> box = std::make_unique<LocalDeclaration>
+		(
+			VariableDeclaration{false, ReferenceType{false, MutabilityMode::SHARED, false, "Box"}, "box", std::move(allocation)}
+		);
+		Entrypoint& entrypoint = get_entrypoint(*root_node, name);
+		entrypoint.body.statements.insert(entrypoint.body.statements.begin(), std::move(box));
+	}
+	std::unique_ptr<AutoCall> auto_call = std::make_unique<AutoCall>();
+	auto_call->function_name = "generate";
+	get_entrypoint(*root_node, "expanding").body.statements.push_back(std::move(auto_call));
+
+	concurrency::WorkStealingPool pool{1};
+	const std::shared_ptr<const Resolution> resolution = NameResolver{pool}.run(*root_node);
+
+	// Act
+	const AllocationAnnotations annotations = ThreadEscapeAnalyser{pool}.run(*root_node, *resolution);
+
+	// Assert
+	for(const std::string name : {"local", "expanding"})
+	{
+		CAPTURE(name);
+
+		const Entrypoint& entrypoint = get_entrypoint(*root_node, name);
+		const VariableDeclaration& box = static_cast<const LocalDeclaration&>(*entrypoint.body.statements[0]).variable_declaration;
+
+		CHECK(annotations.allocations.at(static_cast<const FunctionCall*>(box.initialisation.get()))
+			== (name == "local" ? AllocationSharing::THREAD_LOCAL : AllocationSharing::SHARED));
+	}
+}
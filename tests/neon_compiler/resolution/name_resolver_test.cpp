@@ -0,0 +1,196 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "../../../libs/doctest/doctest.hpp"
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "../../../benchmarks/corpus_generator/corpus_generator.hpp"
+#include "../../../concurrency/work_stealing_pool.hpp"
+#include "../../../neon_compiler/ast/nodes/nodes.hpp"
+#include "../../../neon_compiler/ast/nodes/statement_nodes.hpp"
+#include "../../../neon_compiler/resolution/name_resolver.hpp"
+#include "../../test_support/parse.hpp"
+
+using namespace benchmarks::corpus_generator;
+using namespace neon_compiler;
+using namespace neon_compiler::ast::nodes;
+using namespace neon_compiler::resolution;
+using namespace test_support;
+
+static const FunctionCall& get_call(const Entrypoint& entrypoint, std::size_t statement_index)
+{
+	const DiscardExpression& statement = dynamic_cast<const DiscardExpression&>(*entrypoint.body.statements.at(statement_index));
+	return dynamic_cast<const FunctionCall&>(*statement.expression);
+}
+
+static const std::string& get_declaration_name(const Resolution& resolution, DeclarationId id)
+{
+	REQUIRE(id != UNRESOLVED_DECLARATION);
+	return resolution.get_declaration(id).name;
+}
+
+TEST_CASE("References resolve to parameters, package members and imports")
+{
+	// Arrange
+	std::shared_ptr<Root> root_node = parse
+	({
+		SourceFile
+		{
+			"util.neon",
+			"pkg main::util;\n"
+			"public entrypoint helper(borrow str text)\n"
+			"{\n"
+			"\tprint(text);\n"
+			"}\n"
+		},
+		SourceFile
+		{
+			"start.neon",
+			"pkg main;\n"
+			"import main::util::helper;\n"
+			"public entrypoint start(borrow str arg)\n"
+			"{\n"
+			"\thelper(arg);\n"
+			"\tother(arg);\n"
+			"\tmain::util::helper(arg);\n"
+			"\tmissing(arg);\n"
+			"}\n"
+			"public entrypoint other(borrow str arg)\n"
+			"{\n"
+			"\tret arg;\n"
+			"}\n"
+		}
+	});
+
+	// Act
+	concurrency::WorkStealingPool pool{concurrency::get_default_thread_count()};
+	const std::shared_ptr<const Resolution> resolution = NameResolver{pool}.run(*root_node);
+
+	// Assert
+	const Entrypoint& start = dynamic_cast<const Entrypoint&>(*root_node->package_members.at("main::start"));
+
+	CHECK(get_declaration_name(*resolution, get_call(start, 0).declaration) == "main::util::helper");
+	CHECK(get_declaration_name(*resolution, get_call(start, 1).declaration) == "main::other");
+	CHECK(get_declaration_name(*resolution, get_call(start, 2).declaration) == "main::util::helper");
+	CHECK(get_call(start, 3).declaration == UNRESOLVED_DECLARATION);
+
+	const DeclarationId argument = dynamic_cast<const SimpleRead&>(*get_call(start, 0).arguments.at(0)).declaration;
+	REQUIRE(argument != UNRESOLVED_DECLARATION);
+	CHECK(resolution->get_declaration(argument).kind == DeclarationKind::PARAMETER);
+	REQUIRE(resolution->get_declaration(argument).nodes.size() == 1);
+	CHECK(resolution->get_declaration(argument).nodes[0] == &start.parameters[0]);
+
+	const std::vector<std::string> unresolved_names = resolution->get_unresolved_names();
+	CHECK(unresolved_names == std::vector<std::string>{"missing", "print", "str"});
+}
+
+TEST_CASE("Reads and calls in bodies are recorded at the position of their name")
+{
+	// Arrange
+	const std::string source
+	{
+		"pkg main;\n"
+		"public entrypoint start(borrow str arg)\n"
+		"{\n"
+		"\tstart((arg));\n"
+		"\tmissing(arg);\n"
+		"}\n"
+	};
+	std::shared_ptr<Root> root_node = parse({SourceFile{"start.neon", source}});
+
+	// Act
+	concurrency::WorkStealingPool pool{concurrency::get_default_thread_count()};
+	const std::shared_ptr<const Resolution> resolution = NameResolver{pool}.run(*root_node);
+
+	// Assert
+	const std::vector<BodyReference>& body_references = resolution->get_body_references("main::start");
+
+	// `missing` is not resolved, so it is left out
+	REQUIRE(body_references.size() == 3);
+
+	CHECK(body_references[0].source_position.offset_in_file == source.find("\tstart") + 1);
+	CHECK(get_declaration_name(*resolution, body_references[0].declaration) == "main::start");
+
+	// The brackets around `arg` are not part of its position
+	CHECK(body_references[1].source_position.offset_in_file == source.find("arg))"));
+	CHECK(resolution->get_declaration(body_references[1].declaration).kind == DeclarationKind::PARAMETER);
+
+	CHECK(resolution->get_body_references("main::other").empty());
+}
+
+TEST_CASE("Names in a type resolve to its members before package members")
+{
+	// Arrange
+	std::unique_ptr<Type> type = std::make_unique<Type>();
+
+	Method first{};
+	std::vector<std::unique_ptr<Statement>> statements;
+	statements.push_back(std::make_unique<DiscardExpression>
+	(
+		std::make_unique<FunctionCall>("second", std::vector<GenericArgument>{}, std::vector<std::unique_ptr<Expression>>{})
+	));
+	first.implementation.emplace(std::move(statements));
+
+	type->methods["first"].push_back(std::move(first));
+	type->methods["second"].push_back(Method{});
+	type->methods["second"].push_back(Method{});
+
+	const Type* type_ptr = type.get();
+
+	Root root_node{};
+	root_node.package_members["main::Widget"] = std::move(type);
+	root_node.package_members["main::second"] = std::make_unique<Entrypoint>
+	(
+		Access{AccessType::PUBLIC}, ParameterDeclarationList{}, CodeBlock{std::vector<std::unique_ptr<Statement>>{}}
+	);
+
+	// Act
+	concurrency::WorkStealingPool pool{concurrency::get_default_thread_count()};
+	const std::shared_ptr<const Resolution> resolution = NameResolver{pool}.run(root_node);
+
+	// Assert
+	const Method& method = type_ptr->methods.at("first").at(0);
+	const DiscardExpression& statement = dynamic_cast<const DiscardExpression&>(*method.implementation->statements.at(0));
+	const DeclarationId id = dynamic_cast<const FunctionCall&>(*statement.expression).declaration;
+
+	REQUIRE(id != UNRESOLVED_DECLARATION);
+	CHECK(resolution->get_declaration(id).kind == DeclarationKind::METHOD);
+	CHECK(resolution->get_declaration(id).name == "main::Widget::second");
+	CHECK(resolution->get_declaration(id).nodes.size() == 2);
+	CHECK(resolution->get_member_scope("main::Widget") != nullptr);
+}
+
+TEST_CASE("Resolution does not depend on the number of threads")
+{
+	// Arrange
+	CorpusOptions options{};
+	options.file_count = 20;
+
+	std::vector<SourceFile> files;
+	for(CorpusFile& file : CorpusGenerator{options}.generate())
+	{
+		files.push_back(SourceFile{std::move(file.name), std::move(file.source)});
+	}
+
+	std::shared_ptr<Root> root_node = parse(files);
+	concurrency::WorkStealingPool sequential_pool{1};
+	concurrency::WorkStealingPool parallel_pool{4};
+
+	// Act
+	const std::shared_ptr<const Resolution> sequential = NameResolver{sequential_pool}.run(*root_node);
+	const std::shared_ptr<const Resolution> parallel = NameResolver{parallel_pool}.run(*root_node);
+
+	// Assert
+	CHECK(sequential->get_resolved_count() > 0);
+	CHECK(parallel->get_resolved_count() == sequential->get_resolved_count());
+	CHECK(parallel->get_unresolved_count() == sequential->get_unresolved_count());
+	CHECK(parallel->get_unresolved_names() == sequential->get_unresolved_names());
+
+	REQUIRE(parallel->get_declaration_count() == sequential->get_declaration_count());
+	for(DeclarationId id = 0; id < sequential->get_declaration_count(); ++id)
+	{
+		CHECK(parallel->get_declaration(id).name == sequential->get_declaration(id).name);
+		CHECK(parallel->get_declaration(id).nodes == sequential->get_declaration(id).nodes);
+	}
+}
@@ -0,0 +1,62 @@
+#include "../../../libs/doctest/doctest.hpp"
+
+#include <string>
+#include <vector>
+#include "../../../neon_compiler/resolution/scope.hpp"
+
+using namespace neon_compiler::resolution;
+
+TEST_CASE("Lookups find the innermost declaration of a name")
+{
+	// Arrange
+	Scope package_scope{ScopeKind::PACKAGE, nullptr};
+	Scope method_scope{ScopeKind::METHOD, &package_scope};
+	Scope block_scope{ScopeKind::BLOCK, &method_scope};
+
+	package_scope.declare("speed", 1);
+	package_scope.declare("colour", 2);
+	method_scope.declare("speed", 3);
+
+	// Act & Assert
+	CHECK(block_scope.lookup("speed") == 3u);
+	CHECK(block_scope.lookup("colour") == 2u);
+	CHECK(!block_scope.lookup("size").has_value());
+	CHECK(!block_scope.find("speed").has_value());
+}
+
+TEST_CASE("A name is declared once per scope")
+{
+	// Arrange
+	Scope scope{ScopeKind::BLOCK, nullptr};
+
+	// Act
+	const bool first = scope.declare("speed", 1);
+	const bool second = scope.declare("speed", 2);
+
+	// Assert
+	CHECK(first);
+	CHECK(!second);
+	CHECK(scope.find("speed") == 1u);
+}
+
+TEST_CASE("Symbol tables keep all names while growing")
+{
+	// Arrange
+	constexpr uint32_t NAME_COUNT = 1000;
+
+	std::vector<std::string> names;
+	for(uint32_t i = 0; i < NAME_COUNT; ++i) { names.push_back("name" + std::to_string(i)); }
+
+	SymbolTable table{};
+
+	// Act
+	for(uint32_t i = 0; i < NAME_COUNT; ++i) { table.insert(names[i], SymbolTable::hash(names[i]), i); }
+
+	// Assert
+	CHECK(table.size() == NAME_COUNT);
+	for(uint32_t i = 0; i < NAME_COUNT; ++i)
+	{
+		CHECK(table.find(names[i], SymbolTable::hash(names[i])) == i);
+	}
+	CHECK(!table.find("name", SymbolTable::hash("name")).has_value());
+}
@@ -0,0 +1,99 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "../../../libs/doctest/doctest.hpp"
+
+#include <chrono>
+#include <sstream>
+#include <string>
+#include "../../../neon_compiler/stats/compilation_stats.hpp"
+#include "../../../neon_compiler/stats/counters.hpp"
+
+using namespace neon_compiler::stats;
+
+TEST_CASE("File stats add up to the phase")
+{
+	// Arrange
+	CompilationStats stats{};
+
+	PhaseStats a{};
+	a.wall_time = std::chrono::milliseconds{2};
+	a.tokens = 10;
+	PhaseStats b{};
+	b.wall_time = std::chrono::milliseconds{3};
+	b.tokens = 5;
+
+	PhaseStats phase{};
+	phase.wall_time = std::chrono::milliseconds{6};
+
+	// Act
+	stats.add_file(Phase::LEX, "a.neon", a);
+	stats.add_file(Phase::LEX, "b.neon", b);
+	stats.add_file(Phase::LEX, "a.neon", a);
+	stats.add_phase(Phase::LEX, phase);
+
+	// Assert
+	CHECK(stats.get_phase(Phase::LEX).tokens == 25);
+	CHECK(stats.get_phase(Phase::LEX).wall_time == std::chrono::milliseconds{6});
+	CHECK(stats.get_phase(Phase::LEX).peak_rss > 0);
+	CHECK(stats.get_files().at("a.neon")[static_cast<std::size_t>(Phase::LEX)].tokens == 20);
+	CHECK(stats.get_files().at("a.neon")[static_cast<std::size_t>(Phase::LEX)].wall_time == std::chrono::milliseconds{4});
+	CHECK(stats.get_phase(Phase::PARSE_B).tokens == 0);
+}
+
+TEST_CASE("Folded calls are counted for the phase and printed")
+{
+	// Arrange
+	CompilationStats stats{};
+
+	PhaseStats evaluate{};
+	evaluate.folded_calls = 4;
+
+	std::ostringstream table{};
+	std::ostringstream json{};
+
+	// Act
+	stats.add_phase(Phase::EVALUATE, evaluate);
+	stats.add_phase(Phase::EVALUATE, evaluate);
+	stats.print_table(table);
+	stats.print_json(json);
+
+	// Assert
+	CHECK(stats.get_phase(Phase::EVALUATE).folded_calls == 8);
+	CHECK(table.str().find("folded") != std::string::npos);
+	CHECK(json.str().find("\"operator_match_attempts\": 0, \"folded_calls\": 8") != std::string::npos);
+}
+
+TEST_CASE("Measurements count events of the thread")
+{
+	// Arrange
+	const Measurement measurement{};
+
+	// Act
+	thread_counters.operator_match_attempts += 3;
+	const PhaseStats stats = measurement.stop();
+
+	// Assert
+	CHECK(stats.operator_match_attempts == 3);
+	CHECK(stats.wall_time >= std::chrono::nanoseconds{0});
+}
+
+TEST_CASE("Stats are printed as JSON")
+{
+	// Arrange
+	CompilationStats stats{};
+
+	PhaseStats file_stats{};
+	file_stats.ast_nodes = 7;
+	stats.add_file(Phase::PARSE_B, "dir/\"quoted\".neon", file_stats);
+
+	std::ostringstream out{};
+
+	// Act
+	stats.print_json(out);
+
+	// Assert
+	const std::string json = out.str();
+	CHECK(json.starts_with("{\"phases\": {\"parse_b\": {"));
+	CHECK(json.find("\"lex\"") == std::string::npos);
+	CHECK(json.find("\"dir/\\\"quoted\\\".neon\": {") != std::string::npos);
+	CHECK(json.find("\"parse_b\": {\"wall_ms\": 0.000, \"cpu_ms\": 0.000, \"tokens\": 0, \"ast_nodes\": 7") != std::string::npos);
+}
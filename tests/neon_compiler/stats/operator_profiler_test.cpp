@@ -0,0 +1,99 @@
+#include "../../../libs/doctest/doctest.hpp"
+
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "../../../neon_compiler/ast/nodes/nodes.hpp"
+#include "../../../neon_compiler/stats/operator_profiler.hpp"
+
+using namespace neon_compiler::ast::nodes;
+using namespace neon_compiler::stats;
+
+namespace
+{
+	OperatorDeclaration create_declaration()
+	{
+		return OperatorDeclaration
+		{
+			std::vector<OperatorSyntaxPatternElement>{OperatorSyntaxParameter{}, TokenPattern{neon_compiler::TokenType::CUSTOM_TOKEN, "+"}},
+			1,
+			OperatorAssociativity::LEFT,
+			BuiltinOperatorKind::NOT_BUILT_IN
+		};
+	}
+}
+
+TEST_CASE("Profiles of all threads are summed per declaration")
+{
+	// Arrange
+	const OperatorDeclaration declaration_a = create_declaration();
+	const OperatorDeclaration declaration_b = create_declaration();
+
+	operator_profiler::clear();
+	operator_profiler::enable();
+
+	// Act
+	operator_profiler::get_thread_profile(&declaration_a).attempts += 2;
+	operator_profiler::get_thread_profile(&declaration_b).matches += 1;
+
+	std::thread thread{[&declaration_a]
+	{
+		OperatorProfile& profile = operator_profiler::get_thread_profile(&declaration_a);
+		profile.attempts += 3;
+		profile.speculative_parses += 1;
+		profile.speculative_tokens += 4;
+	}};
+	thread.join();
+
+	const std::unordered_map<const OperatorDeclaration*, OperatorProfile> profiles = operator_profiler::collect();
+
+	operator_profiler::disable();
+
+	// Assert
+	REQUIRE(profiles.size() == 2);
+	CHECK(profiles.at(&declaration_a).attempts == 5);
+	CHECK(profiles.at(&declaration_a).speculative_parses == 1);
+	CHECK(profiles.at(&declaration_a).speculative_tokens == 4);
+	CHECK(profiles.at(&declaration_b).matches == 1);
+}
+
+TEST_CASE("Clearing removes the profiles of all threads")
+{
+	// Arrange
+	const OperatorDeclaration declaration = create_declaration();
+
+	operator_profiler::get_thread_profile(&declaration).attempts += 1;
+
+	// Act
+	operator_profiler::clear();
+
+	// Assert
+	CHECK(operator_profiler::collect().empty());
+}
+
+TEST_CASE("Report ranks operators by tokens parsed ahead, then by attempts")
+{
+	// Arrange
+	std::vector<OperatorProfileEntry> entries;
+	entries.push_back(OperatorProfileEntry{"__ = __", "", "", OperatorProfile{30, 0, 0, 0}});
+	entries.push_back(OperatorProfileEntry{"__ + __", "main::ops", "ops.neon:5:2", OperatorProfile{10, 4, 12, 2}});
+	entries.push_back(OperatorProfileEntry{"- __", "main::ops", "ops.neon:9:2", OperatorProfile{20, 1, 12, 1}});
+
+	std::ostringstream out{};
+
+	// Act
+	operator_profiler::print_report(out, entries, 2);
+
+	// Assert
+	const std::string report = out.str();
+
+	const std::size_t prefix_position = report.find("`- __` in main::ops at ops.neon:9:2");
+	const std::size_t infix_position = report.find("`__ + __` in main::ops at ops.neon:5:2");
+
+	REQUIRE(prefix_position != std::string::npos);
+	REQUIRE(infix_position != std::string::npos);
+	CHECK(prefix_position < infix_position);
+	CHECK(report.find("built-in") == std::string::npos);
+}
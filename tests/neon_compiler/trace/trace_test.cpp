@@ -0,0 +1,75 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "../../../libs/doctest/doctest.hpp"
+
+#include <sstream>
+#include <string>
+#include <thread>
+#include "../../../neon_compiler/trace/trace.hpp"
+
+using namespace neon_compiler;
+
+namespace
+{
+	std::string write_trace()
+	{
+		std::ostringstream out{};
+		trace::write_chrome_trace(out);
+		return out.str();
+	}
+}
+
+TEST_CASE("Spans are not recorded while tracing is disabled")
+{
+	// Arrange
+	trace::disable();
+	trace::clear();
+
+	// Act
+	{
+		trace::Span span{"disabled_span"};
+		CHECK(!span.is_recording());
+	}
+
+	// Assert
+	CHECK(write_trace().find("disabled_span") == std::string::npos);
+}
+
+TEST_CASE("Spans are written as complete events with their detail")
+{
+	// Arrange
+	trace::enable();
+	trace::clear();
+
+	// Act
+	{
+		trace::Span outer{"outer_span"};
+		outer.set_detail("main.neon");
+		trace::Span inner{"inner_span"};
+	}
+	trace::disable();
+
+	// Assert
+	const std::string json = write_trace();
+	CHECK(json.starts_with("{\"displayTimeUnit\": \"ms\", \"traceEvents\": ["));
+	CHECK(json.find("{\"name\": \"outer_span\", \"cat\": \"neon\", \"ph\": \"X\", \"pid\": 1, \"tid\": 1") != std::string::npos);
+	CHECK(json.find("\"args\": {\"detail\": \"main.neon\"}") != std::string::npos);
+	CHECK(json.find("inner_span") != std::string::npos);
+}
+
+TEST_CASE("Each thread gets its own track")
+{
+	// Arrange
+	trace::enable();
+	trace::clear();
+
+	// Act
+	std::thread thread{[] { trace::Span span{"worker_span"}; }};
+	thread.join();
+	trace::disable();
+
+	// Assert
+	// The main thread recorded a span first in the previous test case
+	const std::string json = write_trace();
+	CHECK(json.find("{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": 2") != std::string::npos);
+	CHECK(json.find("{\"name\": \"worker_span\", \"cat\": \"neon\", \"ph\": \"X\", \"pid\": 1, \"tid\": 2") != std::string::npos);
+}
@@ -0,0 +1,62 @@
+#include "../../../libs/doctest/doctest.hpp"
+
+#include <optional>
+#include <vector>
+#include "../../../neon_compiler/type_checking/overload_cache.hpp"
+
+using namespace neon_compiler::ast::nodes;
+using namespace neon_compiler::type_checking;
+
+/** Resolves through `cache`, counting the calls of the resolving function in `resolve_count` */
+static OverloadResolution resolve
+(
+	OverloadCache& cache,
+	DeclarationId callee,
+	const std::vector<std::optional<ValueType>>& argument_types,
+	OverloadResolution result,
+	int& resolve_count
+)
+{
+	return cache.resolve(callee, argument_types, [&] { ++resolve_count; return result; });
+}
+
+TEST_CASE("A resolution is reused for the same callee and argument types")
+{
+	// Arrange
+	OverloadCache cache{};
+	const std::vector<std::optional<ValueType>> argument_types{ValueType{3, "main::Widget"}, std::nullopt};
+	int resolve_count{0};
+
+	// Act
+	const OverloadResolution first = resolve(cache, 7, argument_types, OverloadResolution{OverloadStatus::MATCHED, 1}, resolve_count);
+	const OverloadResolution second = resolve(cache, 7, argument_types, OverloadResolution{OverloadStatus::AMBIGUOUS, 0}, resolve_count);
+
+	// Assert
+	CHECK(resolve_count == 1);
+	CHECK(first.status == OverloadStatus::MATCHED);
+	CHECK(second.status == OverloadStatus::MATCHED);
+	CHECK(second.overload_index == 1);
+	CHECK(cache.get_miss_count() == 1);
+	CHECK(cache.get_hit_count() == 1);
+}
+
+TEST_CASE("Resolutions are kept apart by callee and by each argument type")
+{
+	// Arrange
+	OverloadCache cache{};
+	const OverloadResolution result{OverloadStatus::NO_ARGUMENT_TYPES_MATCH, 0};
+	int resolve_count{0};
+
+	// Act
+	resolve(cache, 7, {ValueType{UNRESOLVED_DECLARATION, "str"}}, result, resolve_count);
+	resolve(cache, 8, {ValueType{UNRESOLVED_DECLARATION, "str"}}, result, resolve_count);
+	resolve(cache, 7, {ValueType{UNRESOLVED_DECLARATION, "num"}}, result, resolve_count);
+	// An unknown type matches any type, but the overloads it matches differ, so it is a separate key
+	resolve(cache, 7, {std::nullopt}, result, resolve_count);
+	resolve(cache, 7, {}, result, resolve_count);
+	resolve(cache, 7, {ValueType{UNRESOLVED_DECLARATION, "str"}}, result, resolve_count);
+
+	// Assert
+	CHECK(resolve_count == 5);
+	CHECK(cache.get_hit_count() == 1);
+}
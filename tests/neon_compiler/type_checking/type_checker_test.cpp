@@ -0,0 +1,209 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "../../../libs/doctest/doctest.hpp"
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "../../../concurrency/work_stealing_pool.hpp"
+#include "../../../neon_compiler/analysis/analysis_reporter.hpp"
+#include "../../../neon_compiler/ast/nodes/nodes.hpp"
+#include "../../../neon_compiler/ast/nodes/statement_nodes.hpp"
+#include "../../../neon_compiler/resolution/name_resolver.hpp"
+#include "../../../neon_compiler/type_checking/type_checker.hpp"
+#include "../../test_support/parse.hpp"
+
+using namespace neon_compiler;
+using namespace neon_compiler::analysis;
+using namespace neon_compiler::ast::nodes;
+using namespace neon_compiler::resolution;
+using namespace neon_compiler::type_checking;
+using namespace test_support;
+
+struct ReportedError
+{
+	std::string file;
+	uint32_t line;
+	std::string message;
+
+	bool operator==(const ReportedError&) const = default;
+};
+
+class CollectingAnalysisReporter : public AnalysisReporter
+{
+public:
+	std::vector<ReportedError> errors;
+
+	void report(const AnalysisEntry& entry) override
+	{
+		errors.push_back(ReportedError{std::string{entry.file}, entry.source_position.newlines_count + 1, entry.info.value_or("")});
+	}
+};
+
+static std::vector<ReportedError> check(Root& root_node, std::size_t thread_count)
+{
+	concurrency::WorkStealingPool pool{thread_count};
+	const std::shared_ptr<const Resolution> resolution = NameResolver{pool}.run(root_node);
+
+	CollectingAnalysisReporter reporter{};
+	const std::size_t error_count = TypeChecker{pool}.run(root_node, *resolution, reporter);
+
+	CHECK(error_count == reporter.errors.size());
+	return reporter.errors;
+}
+
+constexpr const char* CALLS_SOURCE =
+	"pkg main;\n"
+	"public entrypoint show(borrow num number)\n"
+	"{\n"
+	"\tprint(number);\n"
+	"}\n"
+	"public entrypoint start(borrow str text)\n"
+	"{\n"
+	"\tshow(text);\n"
+	"\tshow(text, text);\n"
+	"\tshow(length(text));\n"
+	"\ttext = text;\n"
+	"\ttext(1);\n"
+	"}\n";
+
+TEST_CASE("Calls and assignments are checked against the declarations")
+{
+	// Arrange
+	std::shared_ptr<Root> root_node = parse("main.neon", CALLS_SOURCE);
+
+	// Act
+	const std::vector<ReportedError> errors = check(*root_node, 1);
+
+	// Assert
+	const std::vector<ReportedError> expected
+	{
+		ReportedError{"main.neon", 8, std::string{type_checker_error_messages::NO_OVERLOAD_WITH_ARGUMENT_TYPES} + "show(str)"},
+		ReportedError{"main.neon", 9, std::string{type_checker_error_messages::NO_OVERLOAD_WITH_ARGUMENT_COUNT} + "show"},
+		ReportedError{"main.neon", 10, std::string{type_checker_error_messages::UNRESOLVED_CALL} + "length"},
+		ReportedError{"main.neon", 11, std::string{type_checker_error_messages::NOT_REASSIGNABLE} + "text"},
+		ReportedError{"main.neon", 12, std::string{type_checker_error_messages::NOT_CALLABLE} + "text"}
+	};
+	CHECK(errors == expected);
+}
+
+TEST_CASE("Unresolved reads and calls are reported, apart from print and intrinsics in compile functions")
+{
+	// Arrange
+	std::shared_ptr<Root> root_node = parse
+	(
+		"main.neon",
+		"pkg main;\n"
+		"public entrypoint start(borrow str text)\n"
+		"{\n"
+		"\tprint(text);\n"
+		"\tmissing(text);\n"
+		"\tprint(unknown);\n"
+		"\targument_count();\n"
+		"}\n"
+		"public entrypoint describe()\n"
+		"{\n"
+		"\tret argument_count();\n"
+		"}\n"
+	);
+
+	// Compile functions are not parsed yet
+	Entrypoint& describe = static_cast<Entrypoint&>(*root_node->package_members.at("main::describe"));
+	root_node->package_members["main::describe"] =
+		std::make_unique<CompileFunction>(describe.access, CompileFunctionScope::CODE_BLOCK, std::move(describe.body));
+
+	// Act
+	const std::vector<ReportedError> errors = check(*root_node, 1);
+
+	// Assert
+	const std::vector<ReportedError> expected
+	{
+		ReportedError{"main.neon", 5, std::string{type_checker_error_messages::UNRESOLVED_CALL} + "missing"},
+		ReportedError{"main.neon", 6, std::string{type_checker_error_messages::UNRESOLVED_READ} + "unknown"},
+		ReportedError{"main.neon", 7, std::string{type_checker_error_messages::UNRESOLVED_CALL} + "argument_count"}
+	};
+	CHECK(errors == expected);
+}
+
+TEST_CASE("Members of objects are looked up in their type")
+{
+	// Arrange
+	std::shared_ptr<Root> root_node = parse
+	(
+		"main.neon",
+		"pkg main;\n"
+		"public entrypoint start(borrow Point point, borrow num distance)\n"
+		"{\n"
+		"\tpoint.move(distance);\n"
+		"\tpoint.move(point.x);\n"
+		"\tpoint.move();\n"
+		"\tpoint.y;\n"
+		"\tpoint.x = distance;\n"
+		"}\n"
+	);
+
+	Method move{};
+	move.parameters.emplace_back(false, ReferenceType{false, MutabilityMode::BORROW, false, "num"}, "dx");
+
+	std::unique_ptr<Type> point = std::make_unique<Type>();
+	point->fields.emplace("x", Field{false, ReferenceType{false, MutabilityMode::OWN, false, "num"}});
+	point->methods["move"].push_back(std::move(move));
+	root_node->package_members["main::Point"] = std::move(point);
+
+	// Act
+	const std::vector<ReportedError> errors = check(*root_node, 1);
+
+	// Assert
+	const std::vector<ReportedError> expected
+	{
+		ReportedError{"main.neon", 6, std::string{type_checker_error_messages::NO_OVERLOAD_WITH_ARGUMENT_COUNT} + "main::Point::move"},
+		ReportedError{"main.neon", 7, std::string{type_checker_error_messages::UNKNOWN_MEMBER} + "main::Point::y"},
+		ReportedError{"main.neon", 8, std::string{type_checker_error_messages::NOT_REASSIGNABLE} + "x"}
+	};
+	CHECK(errors == expected);
+}
+
+TEST_CASE("Diagnostics are reported in the same order with any number of threads")
+{
+	// Arrange
+	std::string source = "pkg main;\npublic entrypoint show(borrow num number)\n{\n}\n";
+	for(int i = 0; i < 50; ++i)
+	{
+		source += "public entrypoint start" + std::to_string(i) + "(borrow str text)\n{\n\tshow(text);\n\tshow();\n}\n";
+	}
+
+	std::shared_ptr<Root> sequential_root = parse("main.neon", source);
+	std::shared_ptr<Root> parallel_root = parse("main.neon", source);
+
+	// Act
+	const std::vector<ReportedError> sequential = check(*sequential_root, 1);
+	const std::vector<ReportedError> parallel = check(*parallel_root, 4);
+
+	// Assert
+	CHECK(sequential.size() == 100);
+	CHECK(parallel == sequential);
+}
+
+TEST_CASE("Calls with the same callee and argument types resolve their overload once")
+{
+	// Arrange
+	std::string source = "pkg main;\npublic entrypoint show(borrow num number)\n{\n}\n";
+	for(int i = 0; i < 50; ++i)
+	{
+		source += "public entrypoint start" + std::to_string(i) + "(borrow str text, borrow num number)\n{\n"
+			"\tshow(text);\n\tshow(number);\n\tshow(number);\n}\n";
+	}
+
+	std::shared_ptr<Root> root_node = parse("main.neon", source);
+	concurrency::WorkStealingPool pool{1};
+	const std::shared_ptr<const Resolution> resolution = NameResolver{pool}.run(*root_node);
+	CollectingAnalysisReporter reporter{};
+	TypeChecker type_checker{pool};
+
+	// Act
+	type_checker.run(*root_node, *resolution, reporter);
+
+	// Assert
+	CHECK(reporter.errors.size() == 50);
+	CHECK(type_checker.get_overload_cache_miss_count() == 2);
+	CHECK(type_checker.get_overload_cache_hit_count() == 148);
+}
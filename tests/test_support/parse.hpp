@@ -0,0 +1,106 @@
+#ifndef TEST_SUPPORT_PARSE_HPP
+#define TEST_SUPPORT_PARSE_HPP
+
+#include <cstddef>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "../../logging/logger.hpp"
+#include "../../logging/impl/stream_log_sink.hpp"
+#include "../../neon_compiler/token.hpp"
+#include "../../neon_compiler/analysis/analysis_reporter.hpp"
+#include "../../neon_compiler/ast/nodes/nodes.hpp"
+#include "../../neon_compiler/lexer/lexer.hpp"
+#include "../../neon_compiler/parser/parser.hpp"
+#include "../../reading/char_reader.hpp"
+
+/** Helpers shared by the tests of the passes after parsing. Header only, so test packages need no extra sources. */
+namespace test_support
+{
+
+class IgnoringAnalysisReporter : public neon_compiler::analysis::AnalysisReporter
+{
+public:
+	void report(const neon_compiler::analysis::AnalysisEntry&) override {}
+};
+
+/** Source of one file to parse, e.g. `{"main.neon", "pkg main;\n..."}` */
+struct SourceFile
+{
+	std::string name;
+	std::string source;
+};
+
+/** Parses the files into a new AST like the compiler does: the first parsing phase of every file, so that all operator modules
+ * are known, then the second, keeping the imports of each file. Parse errors are ignored. */
+inline std::shared_ptr<neon_compiler::ast::nodes::Root> parse(const std::vector<SourceFile>& files)
+{
+	std::shared_ptr<logging::Logger> logger = std::make_shared<logging::Logger>
+	(
+		std::make_shared<logging::impl::StreamLogSink>(std::cerr),
+		logging::LogLevel::ERROR
+	);
+	std::shared_ptr<neon_compiler::analysis::AnalysisReporter> reporter = std::make_shared<IgnoringAnalysisReporter>();
+	std::shared_ptr<neon_compiler::ast::nodes::Root> root_node = std::make_shared<neon_compiler::ast::nodes::Root>();
+	std::shared_ptr<neon_compiler::parser::OperatorMap> operator_map = std::make_shared<neon_compiler::parser::OperatorMap>();
+
+	// Parsers keep a view of their tokens, so these must not move while parsing
+	std::vector<std::vector<neon_compiler::Token>> file_tokens;
+	file_tokens.reserve(files.size());
+	for(const SourceFile& file : files)
+	{
+		neon_compiler::lexer::Lexer lexer{std::make_unique<reading::CharReader>(std::make_unique<std::istringstream>(file.source))};
+		lexer.run();
+		file_tokens.push_back(lexer.take_tokens());
+	}
+
+	std::vector<neon_compiler::parser::Parser> parsers;
+	parsers.reserve(files.size());
+	for(std::size_t i = 0; i < files.size(); ++i)
+	{
+		parsers.emplace_back(logger, file_tokens[i], reporter, root_node, files[i].name, operator_map);
+	}
+
+	for(neon_compiler::parser::Parser& parser : parsers) { parser.run_a(); }
+
+	std::shared_ptr<neon_compiler::parser::OperatorTable> operator_table = std::make_shared<neon_compiler::parser::OperatorTable>();
+	for(std::size_t i = 0; i < files.size(); ++i)
+	{
+		parsers[i].run_b(operator_table);
+		root_node->file_imports[files[i].name] = parsers[i].get_imported_package_members();
+	}
+
+	return root_node;
+}
+
+/** Parses one file into a new AST, see `parse(const std::vector<SourceFile>&)` */
+inline std::shared_ptr<neon_compiler::ast::nodes::Root> parse(const std::string& file, const std::string& source)
+{
+	return parse(std::vector<SourceFile>{SourceFile{file, source}});
+}
+
+/** Like `parse`, with a type `main::Box` with the field `size` added, as types are not parsed yet */
+inline std::shared_ptr<neon_compiler::ast::nodes::Root> parse_with_box(const std::string& file, const std::string& source)
+{
+	std::shared_ptr<neon_compiler::ast::nodes::Root> root_node = parse(file, source);
+
+	std::unique_ptr<neon_compiler::ast::nodes::Type> box = std::make_unique<neon_compiler::ast::nodes::Type>();
+	box->fields.emplace
+	(
+		"size",
+		neon_compiler::ast::nodes::Field
+		{
+			true,
+			neon_compiler::ast::nodes::ReferenceType{false, neon_compiler::ast::nodes::MutabilityMode::SHARED, false, "Num"}
+		}
+	);
+	root_node->package_members["main::Box"] = std::move(box);
+
+	return root_node;
+}
+
+}
+
+#endif // TEST_SUPPORT_PARSE_HPP